@@ -0,0 +1,34 @@
+--! Physics Benchmark Build Script for premake5
+--[[
+    headless console application that steps the physics at a fixed time step and reports the timings as json,
+    it doesn't open a window so it can run on build machines without a gpu:
+
+        physics_benchmark --output report.json
+        physics_benchmark --baseline report.json
+
+    the second run exits with 1 when a stage of the physics got slower than the threshold.
+]]--
+
+
+project "physics-benchmark"
+    kind "ConsoleApp"
+    language "C++"
+    targetdir "../../bin/%{cfg.buildcfg}"
+    cppdialect "C++17"
+    includedirs { "../../legion/engine/","./" }
+	dependson { "legion-core", "legion-physics", "legion-application", "legion-rendering" }
+    links { "legion-rendering", "legion-application", "legion-physics", "legion-core", "voro++", "glfw", "GL", "OpenCL", "pthread" }
+    libdirs { "../../bin/%{cfg.buildcfg}" }
+
+    files {"**.h", "**.hpp" ,"**.c", "**.cpp"}
+
+    filter "configurations:Debug*"
+        defines {"DEBUG"}
+        symbols "On"
+
+    filter "configurations:Release*"
+        defines {"NDEBUG"}
+        optimize "On"
+		
+    filter "configurations:*64"
+       architecture "x86_64"
@@ -0,0 +1,149 @@
+#include "benchmark_report.hpp"
+
+#include <tinygltf/json.hpp>
+
+using namespace legion;
+
+const std::array<const char*, scene_result::stage_count> scene_result::stage_names{
+    "data", "broadphase", "narrowphase", "solver", "integration", "fracture", "fracture_wait", "total" };
+
+const std::array<const char*, scene_result::count_count> scene_result::count_names{
+    "broadphase_pairs", "manifolds", "contacts", "islands", "awake_rigidbodies" };
+
+void BenchmarkReport::beginScene(const std::string& name, float deltaTime, size_type physicsComponents)
+{
+    auto& result = m_results.emplace_back();
+    result.name = name;
+    result.deltaTime = deltaTime;
+    result.initialPhysicsComponents = physicsComponents;
+}
+
+void BenchmarkReport::addStep(const physics::physics_statistics& statistics, double fractureWaitTime)
+{
+    auto& result = m_results.back();
+    result.steps++;
+
+    const double timings[scene_result::stage_count]{
+        statistics.dataTime, statistics.broadphaseTime, statistics.narrowphaseTime, statistics.solverTime,
+        statistics.integrationTime, statistics.fractureTime, fractureWaitTime, statistics.totalTime + fractureWaitTime };
+
+    for (size_type i = 0; i < scene_result::stage_count; i++)
+        result.timings[i].add(timings[i]);
+
+    const size_type counts[scene_result::count_count]{
+        statistics.broadphasePairCount, statistics.manifoldCount, statistics.contactCount,
+        statistics.islandCount, statistics.awakeRigidbodyCount };
+
+    for (size_type i = 0; i < scene_result::count_count; i++)
+        result.counts[i] += static_cast<double>(counts[i]);
+}
+
+void BenchmarkReport::endScene(size_type physicsComponents, double checksum)
+{
+    auto& result = m_results.back();
+    result.finalPhysicsComponents = physicsComponents;
+    result.checksum = checksum;
+}
+
+std::string BenchmarkReport::toJson() const
+{
+    nlohmann::json scenes = nlohmann::json::array();
+
+    for (auto& result : m_results)
+    {
+        const double steps = math::max<double>(result.steps, 1.0);
+
+        nlohmann::json timings;
+        for (size_type i = 0; i < scene_result::stage_count; i++)
+        {
+            timings[scene_result::stage_names[i]] = {
+                { "mean", result.timings[i].total / steps },
+                { "max", result.timings[i].max },
+                { "total", result.timings[i].total } };
+        }
+
+        nlohmann::json counts;
+        for (size_type i = 0; i < scene_result::count_count; i++)
+        {
+            counts[scene_result::count_names[i]] = result.counts[i] / steps;
+        }
+
+        scenes.push_back({
+            { "name", result.name },
+            { "steps", result.steps },
+            { "delta_time", result.deltaTime },
+            { "initial_physics_components", result.initialPhysicsComponents },
+            { "final_physics_components", result.finalPhysicsComponents },
+            { "checksum", result.checksum },
+            { "timings_ms", timings },
+            { "counts_per_step", counts } });
+    }
+
+    nlohmann::json report{ { "scenes", scenes } };
+    return report.dump(4);
+}
+
+int BenchmarkReport::compare(const std::string& baselineJson, double threshold, double minimumDifference) const
+{
+    nlohmann::json baseline = nlohmann::json::parse(baselineJson, nullptr, false);
+    if (baseline.is_discarded() || !baseline.count("scenes") || !baseline["scenes"].is_array())
+    {
+        log::error("The baseline isn't a report of the physics benchmark");
+        return -1;
+    }
+
+    int regressions = 0;
+
+    for (auto& result : m_results)
+    {
+        auto baselineScene = std::find_if(baseline["scenes"].begin(), baseline["scenes"].end(),
+            [&](const nlohmann::json& scene) { return scene.value("name", std::string()) == result.name; });
+
+        if (baselineScene == baseline["scenes"].end())
+        {
+            log::warn("[{}] not in the baseline", result.name);
+            continue;
+        }
+
+        const double steps = math::max<double>(result.steps, 1.0);
+
+        for (size_type i = 0; i < scene_result::stage_count; i++)
+        {
+            const char* stage = scene_result::stage_names[i];
+            if (!(*baselineScene)["timings_ms"].count(stage))
+                continue;
+
+            const double before = (*baselineScene)["timings_ms"][stage].value("mean", 0.0);
+            const double after = result.timings[i].total / steps;
+
+            if (math::abs(after - before) < minimumDifference)
+                continue;
+
+            if (after > before * (1.0 + threshold))
+            {
+                log::error("[{}] {} regressed: {:.3f}ms -> {:.3f}ms per step", result.name, stage, before, after);
+                regressions++;
+            }
+            else if (after < before * (1.0 - threshold))
+            {
+                log::info("[{}] {} improved: {:.3f}ms -> {:.3f}ms per step", result.name, stage, before, after);
+            }
+        }
+
+        //a different amount of work means the simulation changed, which makes the timings hard to compare
+        for (size_type i = 0; i < scene_result::count_count; i++)
+        {
+            const char* count = scene_result::count_names[i];
+            if (!(*baselineScene)["counts_per_step"].count(count))
+                continue;
+
+            const double before = (*baselineScene)["counts_per_step"].value(count, 0.0);
+            const double after = result.counts[i] / steps;
+
+            if (math::abs(after - before) > math::max(before * threshold, 0.5))
+                log::warn("[{}] {} changed: {:.1f} -> {:.1f} per step", result.name, count, before, after);
+        }
+    }
+
+    return regressions;
+}
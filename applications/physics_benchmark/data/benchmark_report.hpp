@@ -0,0 +1,82 @@
+#pragma once
+#include <core/core.hpp>
+#include <physics/data/physics_statistics.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+/**@struct stage_timing
+ * @brief Time spent in one stage of the physics step, over all steps of a scene. In milliseconds.
+ */
+struct stage_timing
+{
+    double total = 0.0;
+    double max = 0.0;
+
+    void add(double milliseconds)
+    {
+        total += milliseconds;
+        max = legion::math::max(max, milliseconds);
+    }
+};
+
+/**@struct scene_result
+ * @brief The timings and counts of one scene of the benchmark.
+ */
+struct scene_result
+{
+    static constexpr legion::size_type stage_count = 8;
+    //the names of the stages in the json, in the order of the timings
+    static const std::array<const char*, stage_count> stage_names;
+
+    static constexpr legion::size_type count_count = 5;
+    static const std::array<const char*, count_count> count_names;
+
+    std::string name;
+    legion::size_type steps = 0;
+    float deltaTime = 0.0f;
+
+    std::array<stage_timing, stage_count> timings;
+    //sums of the counts of every step, in the order of count_names
+    std::array<double, count_count> counts{};
+
+    legion::size_type initialPhysicsComponents = 0;
+    legion::size_type finalPhysicsComponents = 0;
+    //sum of the positions of all physics components at the end, two runs of a deterministic scene give the same checksum
+    double checksum = 0.0;
+};
+
+/**@class BenchmarkReport
+ * @brief Collects the statistics of every step of the benchmark, writes them as json and compares them with a baseline.
+ */
+class BenchmarkReport
+{
+public:
+    void beginScene(const std::string& name, float deltaTime, legion::size_type physicsComponents);
+
+    /**@brief Adds the statistics of a step to the current scene.
+     * @param fractureWaitTime Time spent waiting for fracture jobs after the step, in milliseconds
+     */
+    void addStep(const legion::physics::physics_statistics& statistics, double fractureWaitTime);
+
+    void endScene(legion::size_type physicsComponents, double checksum);
+
+    L_NODISCARD std::string toJson() const;
+
+    /**@brief Compares the mean timings of every scene with the same scene in a baseline that was written by toJson.
+     *        Counts that changed are reported as well, they mean the simulation itself behaves differently.
+     * @param threshold Relative increase of a mean timing that counts as a regression, 0.1 is 10% slower
+     * @param minimumDifference Differences smaller than this many milliseconds are ignored, they're mostly noise
+     * @return The amount of regressions, -1 if the baseline couldn't be read
+     */
+    L_NODISCARD int compare(const std::string& baselineJson, double threshold, double minimumDifference) const;
+
+    const std::vector<scene_result>& results() const noexcept
+    {
+        return m_results;
+    }
+
+private:
+    std::vector<scene_result> m_results;
+};
@@ -0,0 +1,265 @@
+#include "benchmark_scenes.hpp"
+
+#include <physics/physics.hpp>
+#include <physics/components/fracturer.hpp>
+#include <physics/components/fracturecountdown.hpp>
+#include <physics/mesh_splitter_utils/mesh_splitter.hpp>
+#include <rendering/components/renderable.hpp>
+
+#include <random>
+
+using namespace legion;
+
+const std::vector<benchmark_scene>& BenchmarkScenes::all()
+{
+    static const std::vector<benchmark_scene> scenes{
+        { "box_stacks", &BenchmarkScenes::createBoxStacks },
+        { "pyramid", &BenchmarkScenes::createPyramid },
+        { "rain", &BenchmarkScenes::createRain },
+        { "fracture_barrage", &BenchmarkScenes::createFractureBarrage },
+        { "ball_pit", &BenchmarkScenes::createBallPit }
+    };
+
+    return scenes;
+}
+
+void BenchmarkScenes::createBoxStacks(ecs::EcsRegistry& registry)
+{
+    createFloor(registry, 50.0f);
+
+    for (int stackX = 0; stackX < 5; stackX++)
+    {
+        for (int stackZ = 0; stackZ < 2; stackZ++)
+        {
+            math::vec3 base(stackX * 3.0f - 6.0f, 0.5f, stackZ * 3.0f - 1.5f);
+
+            for (int height = 0; height < 10; height++)
+            {
+                createBox(registry, base + math::vec3(0.0f, height * 1.0f, 0.0f), math::identity<math::quat>(), math::vec3(1.0f), 1.0f);
+            }
+        }
+    }
+}
+
+void BenchmarkScenes::createPyramid(ecs::EcsRegistry& registry)
+{
+    createFloor(registry, 50.0f);
+
+    constexpr int baseWidth = 20;
+    constexpr float spacing = 1.05f;
+
+    for (int layer = 0; layer < baseWidth; layer++)
+    {
+        const int layerWidth = baseWidth - layer;
+        const float start = -(layerWidth - 1) * spacing * 0.5f;
+
+        for (int i = 0; i < layerWidth; i++)
+        {
+            createBox(registry, math::vec3(start + i * spacing, 0.5f + layer * 1.0f, 0.0f), math::identity<math::quat>(), math::vec3(1.0f), 1.0f);
+        }
+    }
+}
+
+void BenchmarkScenes::createRain(ecs::EcsRegistry& registry)
+{
+    createFloor(registry, 200.0f);
+
+    //a fixed seed, so every run gets the same rain
+    std::mt19937 generator(1234u);
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+    std::uniform_real_distribution<float> angle(0.0f, math::two_pi<float>());
+
+    constexpr int gridWidth = 50;
+    constexpr int layers = 4;
+
+    for (int layer = 0; layer < layers; layer++)
+    {
+        for (int x = 0; x < gridWidth; x++)
+        {
+            for (int z = 0; z < gridWidth; z++)
+            {
+                math::vec3 position((x - gridWidth * 0.5f) * 2.5f + jitter(generator),
+                    5.0f + layer * 10.0f + jitter(generator) * 8.0f,
+                    (z - gridWidth * 0.5f) * 2.5f + jitter(generator));
+
+                math::vec3 axis = math::normalize(math::vec3(jitter(generator), jitter(generator), jitter(generator)) + math::vec3(0.0f, 0.01f, 0.0f));
+
+                createBox(registry, position, math::angleAxis(angle(generator), axis), math::vec3(1.0f), 1.0f);
+            }
+        }
+    }
+}
+
+void BenchmarkScenes::createFractureBarrage(ecs::EcsRegistry& registry)
+{
+    createFloor(registry, 50.0f);
+
+    auto meshHandle = cubeMesh();
+
+    for (int x = 0; x < 5; x++)
+    {
+        for (int z = 0; z < 5; z++)
+        {
+            const int index = x * 5 + z;
+            const math::vec3 position(x * 4.0f - 8.0f, 1.0f, z * 4.0f - 8.0f);
+
+            //the collider is a unit cube that gets scaled with the entity, just like the mesh
+            auto ent = createBox(registry, position, math::identity<math::quat>(), math::vec3(1.0f), 1.0f);
+            ent.get_component_handle<scale>().write(math::vec3(2.0f));
+
+            ent.add_components<rendering::mesh_renderable>(mesh_filter(meshHandle), rendering::mesh_renderer(rendering::invalid_material_handle));
+
+            ent.add_component<physics::Fracturer>();
+
+            //the boxes explode one after the other, at a point that moves around the top of the box
+            auto countdownHandle = ent.add_component<physics::FractureCountdown>();
+            auto countdown = countdownHandle.read();
+            countdown.fractureTime = 0.1f + index * 0.1f;
+            countdown.fractureStrength = 5.0f;
+            countdown.explosionPoint = position + math::vec3(math::cos(index * 1.3f) * 0.5f, 1.0f, math::sin(index * 1.3f) * 0.5f);
+            countdownHandle.write(countdown);
+
+            auto splitterHandle = ent.add_component<physics::MeshSplitter>();
+            auto splitter = splitterHandle.read();
+            splitter.InitializePolygons(ent);
+            splitterHandle.write(splitter);
+        }
+    }
+}
+
+void BenchmarkScenes::createBallPit(ecs::EcsRegistry& registry)
+{
+    createFloor(registry, 50.0f);
+
+    //walls keep the spheres from rolling off the floor, otherwise the amount of work would depend on how long the scene runs
+    constexpr float wallDistance = 10.0f;
+    for (float side : { -1.0f, 1.0f })
+    {
+        createBox(registry, math::vec3(side * (wallDistance + 0.5f), 2.0f, 0.0f), math::identity<math::quat>(), math::vec3(1.0f, 4.0f, wallDistance * 2.0f + 2.0f), 0.0f);
+        createBox(registry, math::vec3(0.0f, 2.0f, side * (wallDistance + 0.5f)), math::identity<math::quat>(), math::vec3(wallDistance * 2.0f + 2.0f, 4.0f, 1.0f), 0.0f);
+    }
+
+    //a fixed seed, so every run gets the same shapes
+    std::mt19937 generator(4321u);
+    std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+    std::uniform_real_distribution<float> angle(0.0f, math::two_pi<float>());
+
+    constexpr int gridWidth = 10;
+    constexpr int layers = 6;
+
+    for (int layer = 0; layer < layers; layer++)
+    {
+        for (int x = 0; x < gridWidth; x++)
+        {
+            for (int z = 0; z < gridWidth; z++)
+            {
+                math::vec3 position((x - gridWidth * 0.5f) * 1.5f + jitter(generator),
+                    1.0f + layer * 2.5f,
+                    (z - gridWidth * 0.5f) * 1.5f + jitter(generator));
+
+                math::vec3 axis = math::normalize(math::vec3(jitter(generator), jitter(generator), jitter(generator)) + math::vec3(0.0f, 0.01f, 0.0f));
+                math::quat rotation = math::angleAxis(angle(generator), axis);
+
+                physics::physicsComponent physicsComp;
+
+                switch ((x + z + layer) % 3)
+                {
+                case 0:
+                    physicsComp.AddSphere(0.5f);
+                    break;
+                case 1:
+                    physicsComp.AddCapsule(0.3f, 1.4f);
+                    break;
+                default:
+                    physicsComp.AddBox(physics::cube_collider_params(0.8f, 0.8f, 0.8f));
+                    break;
+                }
+
+                createBody(registry, position, rotation, physicsComp, 1.0f);
+            }
+        }
+    }
+}
+
+ecs::entity_handle BenchmarkScenes::createBox(ecs::EcsRegistry& registry, const math::vec3& position,
+    const math::quat& rotation, const math::vec3& size, float mass)
+{
+    physics::physicsComponent physicsComp;
+    physicsComp.AddBox(physics::cube_collider_params(size.x, size.z, size.y));
+
+    return createBody(registry, position, rotation, physicsComp, mass);
+}
+
+ecs::entity_handle BenchmarkScenes::createBody(ecs::EcsRegistry& registry, const math::vec3& position,
+    const math::quat& rotation, const physics::physicsComponent& physicsComp, float mass)
+{
+    auto ent = registry.createEntity();
+
+    auto [positionH, rotationH, scaleH] = registry.createComponents<transform>(ent);
+    positionH.write(position);
+    rotationH.write(rotation);
+    scaleH.write(math::vec3(1.0f));
+
+    auto physicsH = ent.add_component<physics::physicsComponent>();
+    physicsH.write(physicsComp);
+
+    if (mass > 0.0f)
+    {
+        auto rigidbodyH = ent.add_component<physics::rigidbody>();
+        auto rb = rigidbodyH.read();
+        rb.setMass(mass);
+        rigidbodyH.write(rb);
+    }
+
+    return ent;
+}
+
+void BenchmarkScenes::createFloor(ecs::EcsRegistry& registry, float size)
+{
+    createBox(registry, math::vec3(0.0f, -0.5f, 0.0f), math::identity<math::quat>(), math::vec3(size, 1.0f, size), 0.0f);
+}
+
+core::mesh_handle BenchmarkScenes::cubeMesh()
+{
+    static const core::mesh_handle handle = []()
+    {
+        mesh cube;
+        cube.filePath = "physics_benchmark_cube";
+
+        const math::vec3 normals[6] = {
+            math::vec3(1, 0, 0), math::vec3(-1, 0, 0),
+            math::vec3(0, 1, 0), math::vec3(0, -1, 0),
+            math::vec3(0, 0, 1), math::vec3(0, 0, -1) };
+
+        for (auto& normal : normals)
+        {
+            //two axes along the face that form a right handed basis with the normal, so the triangles face outwards
+            math::vec3 tangent = math::abs(normal.y) > 0.5f ? math::vec3(0, 0, 1) : math::vec3(0, 1, 0);
+            math::vec3 bitangent = math::cross(normal, tangent);
+
+            const uint first = static_cast<uint>(cube.vertices.size());
+            const math::vec2 corners[4] = { math::vec2(-1, -1), math::vec2(1, -1), math::vec2(1, 1), math::vec2(-1, 1) };
+
+            for (auto& corner : corners)
+            {
+                cube.vertices.push_back((normal + tangent * corner.x + bitangent * corner.y) * 0.5f);
+                cube.normals.push_back(normal);
+                cube.uvs.push_back(corner * 0.5f + math::vec2(0.5f));
+            }
+
+            for (uint index : { 0u, 1u, 2u, 0u, 2u, 3u })
+                cube.indices.push_back(first + index);
+        }
+
+        mesh::calculate_tangents(&cube);
+
+        sub_mesh submesh;
+        submesh.indexCount = cube.indices.size();
+        submesh.indexOffset = 0;
+        cube.submeshes.push_back(submesh);
+
+        return core::MeshCache::create_mesh(cube.filePath, cube);
+    }();
+
+    return handle;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <core/core.hpp>
+
+#include <string>
+#include <vector>
+
+namespace legion::physics
+{
+    struct physicsComponent;
+}
+
+/**@struct benchmark_scene
+ * @brief A scene the physics benchmark can run. Building a scene always results in the same entities in the same order,
+ *        so the only thing that differs between runs is the time the physics takes.
+ */
+struct benchmark_scene
+{
+    std::string name;
+    void(*create)(legion::ecs::EcsRegistry& registry);
+};
+
+/**@class BenchmarkScenes
+ * @brief The scenes of the physics benchmark. They only use primitive colliders and a cube mesh that is generated in code,
+ *        so they don't need any assets or a window.
+ */
+class BenchmarkScenes
+{
+public:
+    /**@brief Every scene, in the order they are run in.
+     */
+    static const std::vector<benchmark_scene>& all();
+
+    /**@brief 10 stacks of 10 boxes on a static floor, measures how well stable stacks go to sleep.
+     */
+    static void createBoxStacks(legion::ecs::EcsRegistry& registry);
+
+    /**@brief A pyramid of 210 boxes, a single large island that can't be solved in parallel.
+     */
+    static void createPyramid(legion::ecs::EcsRegistry& registry);
+
+    /**@brief 10000 boxes that fall onto a floor from random heights and rotations, measures the broadphase and integration.
+     */
+    static void createRain(legion::ecs::EcsRegistry& registry);
+
+    /**@brief 25 fracturable boxes that explode one after the other, measures the fracture jobs and the debris they leave.
+     */
+    static void createFractureBarrage(legion::ecs::EcsRegistry& registry);
+
+    /**@brief 600 spheres, capsules and boxes that fall into a walled pit, measures the closed form collision tests of the primitive colliders.
+     */
+    static void createBallPit(legion::ecs::EcsRegistry& registry);
+
+private:
+    /**@brief Creates a box with a collider of the given size, the box only gets a rigidbody if it has a mass.
+     */
+    static legion::ecs::entity_handle createBox(legion::ecs::EcsRegistry& registry, const legion::math::vec3& position,
+        const legion::math::quat& rotation, const legion::math::vec3& size, float mass);
+
+    /**@brief Creates an entity with the given colliders, the entity only gets a rigidbody if it has a mass.
+     */
+    static legion::ecs::entity_handle createBody(legion::ecs::EcsRegistry& registry, const legion::math::vec3& position,
+        const legion::math::quat& rotation, const legion::physics::physicsComponent& physicsComp, float mass);
+
+    static void createFloor(legion::ecs::EcsRegistry& registry, float size);
+
+    /**@brief A unit cube with hard edges, created in the mesh cache the first time it's needed.
+     */
+    static legion::core::mesh_handle cubeMesh();
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include <core/core.hpp>
+#include <physics/components/physics_component.hpp>
+#include <physics/components/rigidbody.hpp>
+#include <physics/data/identifier.hpp>
+#include <physics/components/fracturer.hpp>
+#include <physics/components/fracturecountdown.hpp>
+#include <physics/mesh_splitter_utils/mesh_splitter.hpp>
+#include <rendering/components/renderable.hpp>
+
+#include "../systems/physics_benchmark_system.hpp"
+
+/**@class PhysicsBenchmarkModule
+ * @brief Reports the components of the physics without the physics process chain, the benchmark steps the physics itself.
+ */
+class PhysicsBenchmarkModule : public legion::Module
+{
+public:
+    PhysicsBenchmarkModule(const benchmark_settings& settings) : m_settings(settings) {}
+
+    virtual void setup() override
+    {
+        reportComponentType<legion::physics::physicsComponent>();
+        reportComponentType<legion::physics::rigidbody>();
+        reportComponentType<legion::physics::identifier>();
+        reportComponentType<legion::physics::MeshSplitter>();
+        reportComponentType<legion::physics::Fracturer>();
+        reportComponentType<legion::physics::FractureCountdown>();
+        reportComponentType<legion::rendering::mesh_renderer>();
+
+        reportSystem<PhysicsBenchmarkSystem>(m_settings);
+    }
+
+    virtual legion::priority_type priority() override
+    {
+        return default_priority;
+    }
+
+private:
+    benchmark_settings m_settings;
+};
@@ -0,0 +1,94 @@
+// The benchmark creates the engine itself instead of defining LEGION_ENTRY,
+// so the result of the comparison with the baseline can be returned as the exit code.
+// The log goes to the console instead of a file, build machines only keep what's printed.
+#define LEGION_KEEP_CONSOLE
+
+#include "module/physics_benchmark_module.hpp"
+
+#include <core/core.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace legion;
+
+static void printUsage()
+{
+    std::cout << "usage: physics_benchmark [options]\n"
+        << "  --steps <n>         steps per scene (default 300)\n"
+        << "  --dt <seconds>      time step (default 0.02)\n"
+        << "  --scene <name>      only run this scene, can be repeated\n"
+        << "  --output <path>     write the json report to a file instead of the console\n"
+        << "  --baseline <path>   compare with the report of an earlier run, exits with 1 when a stage regressed\n"
+        << "  --threshold <frac>  relative slowdown that counts as a regression (default 0.1)\n"
+        << "  --min-diff <ms>     ignore differences smaller than this (default 0.05)\n"
+        << "scenes:";
+
+    for (auto& scene : BenchmarkScenes::all())
+        std::cout << ' ' << scene.name;
+
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    benchmark_settings settings;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+        {
+            printUsage();
+            return 0;
+        }
+
+        if (!value)
+        {
+            std::cout << "missing value for " << arg << std::endl;
+            printUsage();
+            return 2;
+        }
+
+        if (std::strcmp(arg, "--steps") == 0)
+            settings.steps = static_cast<size_type>(std::strtoull(value, nullptr, 10));
+        else if (std::strcmp(arg, "--dt") == 0)
+            settings.deltaTime = std::strtof(value, nullptr);
+        else if (std::strcmp(arg, "--scene") == 0)
+            settings.scenes.emplace_back(value);
+        else if (std::strcmp(arg, "--output") == 0)
+            settings.outputPath = value;
+        else if (std::strcmp(arg, "--baseline") == 0)
+            settings.baselinePath = value;
+        else if (std::strcmp(arg, "--threshold") == 0)
+            settings.threshold = std::strtod(value, nullptr);
+        else if (std::strcmp(arg, "--min-diff") == 0)
+            settings.minimumDifference = std::strtod(value, nullptr);
+        else
+        {
+            std::cout << "unknown option " << arg << std::endl;
+            printUsage();
+            return 2;
+        }
+
+        i++;
+    }
+
+    if (settings.deltaTime <= 0.0f)
+    {
+        std::cout << "the time step has to be larger than 0" << std::endl;
+        return 2;
+    }
+
+    {
+        Engine engine(argc, argv);
+        engine.reportModule<PhysicsBenchmarkModule>(settings);
+        engine.init();
+        engine.run();
+    }
+
+    return PhysicsBenchmarkSystem::exitCode;
+}
@@ -0,0 +1,171 @@
+#include "physics_benchmark_system.hpp"
+
+#include <physics/physics.hpp>
+#include <physics/components/fracturer.hpp>
+#include <physics/mesh_splitter_utils/primitive_mesh.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace legion;
+
+int PhysicsBenchmarkSystem::exitCode = 0;
+
+void PhysicsBenchmarkSystem::setup()
+{
+    //fractures create their debris through these
+    physics::Fracturer::registry = m_ecs;
+    physics::PrimitiveMesh::SetECSRegistry(m_ecs);
+
+    createProcess<&PhysicsBenchmarkSystem::runBenchmark>("Update");
+}
+
+void PhysicsBenchmarkSystem::runBenchmark(time::span)
+{
+    OPTICK_EVENT();
+
+    if (m_done)
+        return;
+    m_done = true;
+
+    BenchmarkReport report;
+
+    for (auto& scene : BenchmarkScenes::all())
+    {
+        if (!m_settings.scenes.empty() && std::find(m_settings.scenes.begin(), m_settings.scenes.end(), scene.name) == m_settings.scenes.end())
+            continue;
+
+        runScene(scene, report);
+    }
+
+    if (report.results().empty())
+    {
+        log::error("None of the requested scenes exist");
+        exitCode = 2;
+    }
+    else
+    {
+        exitCode = finish(report);
+    }
+
+    raiseEvent<events::exit>(exitCode);
+}
+
+void PhysicsBenchmarkSystem::runScene(const benchmark_scene& scene, BenchmarkReport& report)
+{
+    OPTICK_EVENT();
+
+    log::info("Running {} for {} steps", scene.name, m_settings.steps);
+
+    scene.create(*m_ecs);
+
+    //every scene gets a fresh physics system, so nothing that was cached by the previous scene affects the timings
+    auto physicsSystem = std::make_unique<physics::PhysicsSystem>();
+    physicsSystem->initialize();
+
+    const time::span stepDelta(m_settings.deltaTime);
+    time::timer waitTimer;
+
+    for (size_type step = 0; step < m_settings.steps; step++)
+    {
+        physicsSystem->fixedUpdate(stepDelta);
+
+        //the step only starts the fracture jobs, waiting for them here makes every run commit them in the same step
+        waitTimer.start();
+        physicsSystem->waitForFractures();
+        const double waitTime = waitTimer.elapsedTime().milliseconds();
+
+        auto& statistics = physicsSystem->getStatistics();
+
+        if (step == 0)
+            report.beginScene(scene.name, m_settings.deltaTime, statistics.physicsComponentCount);
+
+        report.addStep(statistics, waitTime);
+    }
+
+    if (m_settings.steps == 0)
+        report.beginScene(scene.name, m_settings.deltaTime, 0);
+
+    auto& statistics = physicsSystem->getStatistics();
+    report.endScene(statistics.physicsComponentCount, calculateChecksum());
+
+    auto& result = report.results().back();
+    log::info("{}: {:.3f}ms per step", scene.name, result.timings[scene_result::stage_count - 1].total / math::max<double>(result.steps, 1.0));
+
+    clearScene();
+}
+
+double PhysicsBenchmarkSystem::calculateChecksum()
+{
+    auto query = createQuery<physics::physicsComponent, position>();
+    query.queryEntities();
+
+    double checksum = 0.0;
+    for (auto& pos : query.get<position>())
+        checksum += static_cast<double>(pos.x) + static_cast<double>(pos.y) + static_cast<double>(pos.z);
+
+    return checksum;
+}
+
+void PhysicsBenchmarkSystem::clearScene()
+{
+    auto query = createQuery<physics::physicsComponent>();
+    query.queryEntities();
+
+    std::vector<id_type> entities;
+    entities.reserve(query.size());
+    for (auto ent : query)
+        entities.push_back(ent);
+
+    for (id_type id : entities)
+        m_ecs->destroyEntity(id);
+}
+
+int PhysicsBenchmarkSystem::finish(const BenchmarkReport& report)
+{
+    const std::string json = report.toJson();
+
+    if (m_settings.outputPath.empty())
+    {
+        std::cout << json << std::endl;
+    }
+    else
+    {
+        std::ofstream file(m_settings.outputPath);
+        if (!file.is_open())
+        {
+            log::error("Couldn't write the report to {}", m_settings.outputPath);
+            return 2;
+        }
+
+        file << json;
+        log::info("Wrote the report to {}", m_settings.outputPath);
+    }
+
+    if (m_settings.baselinePath.empty())
+        return 0;
+
+    std::ifstream file(m_settings.baselinePath);
+    if (!file.is_open())
+    {
+        log::error("Couldn't read the baseline {}", m_settings.baselinePath);
+        return 2;
+    }
+
+    std::stringstream baseline;
+    baseline << file.rdbuf();
+
+    const int regressions = report.compare(baseline.str(), m_settings.threshold, m_settings.minimumDifference);
+    if (regressions < 0)
+        return 2;
+
+    if (regressions > 0)
+    {
+        log::error("{} stage(s) regressed compared to {}", regressions, m_settings.baselinePath);
+        return 1;
+    }
+
+    log::info("No regressions compared to {}", m_settings.baselinePath);
+    return 0;
+}
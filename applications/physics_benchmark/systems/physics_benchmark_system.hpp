@@ -0,0 +1,59 @@
+#pragma once
+#include <core/core.hpp>
+
+#include "../data/benchmark_report.hpp"
+#include "../data/benchmark_scenes.hpp"
+
+#include <string>
+#include <vector>
+
+/**@struct benchmark_settings
+ * @brief What the physics benchmark runs and what it compares against, filled in from the command line.
+ */
+struct benchmark_settings
+{
+    legion::size_type steps = 300;
+    float deltaTime = 0.02f;
+    //names of the scenes to run, every scene is run when this is empty
+    std::vector<std::string> scenes;
+    //the report is written to the console when there's no output path
+    std::string outputPath;
+    std::string baselinePath;
+    double threshold = 0.1;
+    double minimumDifference = 0.05;
+};
+
+/**@class PhysicsBenchmarkSystem
+ * @brief Runs every scene of the benchmark for a fixed amount of steps on its own PhysicsSystem and stops the engine when it's done.
+ *        The physics is stepped directly instead of on the physics process chain, so every run simulates exactly the same steps.
+ */
+class PhysicsBenchmarkSystem final : public legion::System<PhysicsBenchmarkSystem>
+{
+public:
+    //0 when the benchmark ran and didn't regress, 1 when it regressed and 2 when it couldn't run
+    static int exitCode;
+
+    PhysicsBenchmarkSystem(const benchmark_settings& settings) : m_settings(settings) {}
+
+    virtual void setup() override;
+
+private:
+    benchmark_settings m_settings;
+    bool m_done = false;
+
+    void runBenchmark(legion::time::span deltaTime);
+
+    void runScene(const benchmark_scene& scene, BenchmarkReport& report);
+
+    /**@brief Sum of the positions of every entity with a physics component.
+     */
+    double calculateChecksum();
+
+    /**@brief Destroys every entity with a physics component, which includes the debris of fractures.
+     */
+    void clearScene();
+
+    /**@brief Writes the report and compares it with the baseline, returns the exit code.
+     */
+    int finish(const BenchmarkReport& report);
+};
@@ -14,6 +14,17 @@
 
 #include "doctest.h"
 #include "test_filesystem.hpp"
+#include "test_rw_spinlock.hpp"
+#include "test_eventbus.hpp"
+#include "test_archetype_storage.hpp"
+#include "test_job_queues.hpp"
+#include "test_query_view.hpp"
+#include "test_entity_query.hpp"
+#include "test_hierarchy.hpp"
+#include "test_command_buffer.hpp"
+#include "test_mesh_splitter.hpp"
+#include "test_process_chain.hpp"
+#include "test_fracture_pattern_cache.hpp"
 
 using namespace legion;
 
@@ -0,0 +1,165 @@
+#pragma once
+#include <core/ecs/archetype_storage.hpp>
+#include <core/ecs/component_pool.hpp>
+#include <core/events/eventbus.hpp>
+
+#include <sstream>
+#include <vector>
+
+#include "doctest.h"
+
+inline namespace {
+
+    struct storage_test_position
+    {
+        float x = 0.f, y = 0.f, z = 0.f;
+
+        template<typename Archive>
+        void serialize(Archive& archive)
+        {
+            archive(cereal::make_nvp("X", x), cereal::make_nvp("Y", y), cereal::make_nvp("Z", z));
+        }
+    };
+
+    struct storage_test_velocity
+    {
+        float value = 0.f;
+    };
+}
+
+TEST_CASE("[core:ecs] archetype_storage create, fetch and erase")
+{
+    using namespace ::legion::core;
+    using namespace ::legion::core::ecs;
+
+    archetype_storage storage;
+    storage.report_type<storage_test_position>();
+    storage.report_type<storage_test_velocity>();
+
+    const id_type positionId = typeHash<storage_test_position>();
+    const id_type velocityId = typeHash<storage_test_velocity>();
+
+    constexpr id_type entityCount = 1000; // More than fits in one chunk.
+
+    async::readwrite_guard guard(storage.get_lock());
+    for (id_type entity = 1; entity <= entityCount; entity++)
+        static_cast<storage_test_position*>(storage.create_component(entity, positionId))->x = static_cast<float>(entity);
+
+    // Adding a second component moves the entities to another table, the values need to move with them.
+    for (id_type entity = 1; entity <= entityCount; entity += 2)
+        static_cast<storage_test_velocity*>(storage.create_component(entity, velocityId))->value = static_cast<float>(entity) * 2.f;
+
+    for (id_type entity = 1; entity <= entityCount; entity++)
+    {
+        REQUIRE(storage.has_component(entity, positionId));
+        CHECK_EQ(static_cast<storage_test_position*>(storage.get_component(entity, positionId))->x, static_cast<float>(entity));
+        CHECK_EQ(storage.has_component(entity, velocityId), entity % 2 == 1);
+    }
+
+    // Erasing fills the hole with the last row, the entity that got moved needs to keep its components.
+    for (id_type entity = 1; entity <= entityCount; entity += 3)
+        storage.destroy_component(entity, positionId);
+
+    for (id_type entity = 1; entity <= entityCount; entity++)
+    {
+        if ((entity - 1) % 3 == 0)
+        {
+            CHECK_FALSE(storage.has_component(entity, positionId));
+            CHECK_EQ(storage.get_component(entity, positionId), nullptr);
+        }
+        else
+            CHECK_EQ(static_cast<storage_test_position*>(storage.get_component(entity, positionId))->x, static_cast<float>(entity));
+
+        if (entity % 2 == 1)
+            CHECK_EQ(static_cast<storage_test_velocity*>(storage.get_component(entity, velocityId))->value, static_cast<float>(entity) * 2.f);
+    }
+
+    size_type iterated = 0;
+    hashed_sparse_set<id_type> typeIds;
+    typeIds.insert(positionId);
+    storage.for_each_chunk<const storage_test_position>(typeIds, [&](size_type count, const entity_handle* entities, const storage_test_position* positions)
+        {
+            for (size_type i = 0; i < count; i++)
+                CHECK_EQ(positions[i].x, static_cast<float>(entities[i].get_id()));
+            iterated += count;
+        });
+
+    CHECK_EQ(iterated, entityCount - (entityCount + 2) / 3);
+
+    for (id_type entity = 1; entity <= entityCount; entity++)
+        storage.destroy_entity(entity);
+
+    for (id_type entity = 1; entity <= entityCount; entity++)
+        CHECK_FALSE(storage.has_component(entity, velocityId));
+}
+
+TEST_CASE("[core:ecs] component_pool in archetype mode")
+{
+    using namespace ::legion::core;
+    using namespace ::legion::core::ecs;
+
+    events::EventBus bus;
+    archetype_storage storage;
+    storage.report_type<storage_test_position>();
+
+    component_pool<storage_test_position> pool(nullptr, &bus, &storage);
+
+    storage_test_position value{ 1.f, 2.f, 3.f };
+    pool.create_component(1, &value);
+    pool.create_component(2);
+
+    CHECK(pool.has_component(1));
+    CHECK(pool.has_component(2));
+    CHECK_FALSE(pool.has_component(3));
+
+    {
+        family_guard<const storage_test_position> guard(pool);
+        CHECK_EQ(pool.get_component(1).z, 3.f);
+        CHECK_EQ(pool.get_component(2).z, 0.f);
+    }
+
+    pool.clone_component(3, 1);
+    pool.destroy_component(1);
+
+    CHECK_FALSE(pool.has_component(1));
+    {
+        family_guard<const storage_test_position> guard(pool);
+        CHECK_EQ(pool.get_component(3).y, 2.f);
+    }
+}
+
+TEST_CASE("[core:ecs] component_pool serializes entities without the component")
+{
+    using namespace ::legion::core;
+    using namespace ::legion::core::ecs;
+
+    events::EventBus bus;
+    archetype_storage storage;
+    storage.report_type<storage_test_position>();
+
+    component_pool<storage_test_position> sparsePool(nullptr, &bus);
+    component_pool<storage_test_position> archetypePool(nullptr, &bus, &storage);
+
+    for (component_pool<storage_test_position>* pool : { &sparsePool, &archetypePool })
+    {
+        storage_test_position value{ 1.f, 2.f, 3.f };
+        pool->create_component(1, &value);
+
+        std::stringstream stream;
+        {
+            cereal::JSONOutputArchive archive(stream);
+            pool->serialize(archive, 1);
+        }
+
+        {
+            std::stringstream emptyStream;
+            cereal::JSONOutputArchive archive(emptyStream);
+            CHECK_NOTHROW(pool->serialize(archive, 2));
+        }
+
+        // Entity 2 doesn't have the component, the data still needs to be read without touching the pool.
+        cereal::JSONInputArchive archive(stream);
+        CHECK_NOTHROW(pool->serialize(archive, 2));
+        CHECK_FALSE(pool->has_component(2));
+    }
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <core/ecs/ecs.hpp>
+#include <core/ecs/command_buffer.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+#include "test_system.hpp"
+
+inline namespace {
+
+    struct command_test_value
+    {
+        int value = 0;
+    };
+
+    struct command_test_tag
+    {
+        bool set = true;
+    };
+}
+
+TEST_CASE("[core:ecs] command_buffer playback order")
+{
+    using namespace ::legion::core;
+
+    test_system system;
+    auto* registry = system.registry();
+    registry->reportComponentType<command_test_value>();
+    registry->reportComponentType<command_test_tag>();
+
+    ecs::command_buffer commands(registry);
+
+    SUBCASE("Entities exist before their components get added")
+    {
+        auto entity = commands.create_entity(false);
+        commands.add_component(entity, command_test_value{ 5 });
+        commands.add_component<command_test_tag>(entity);
+
+        CHECK_EQ(commands.size(), 3);
+        CHECK_FALSE(registry->validateEntity(entity.get_id()));
+
+        commands.playback();
+        CHECK(commands.empty());
+        REQUIRE(registry->validateEntity(entity.get_id()));
+        CHECK(entity.has_component<command_test_tag>());
+        REQUIRE(entity.has_component<command_test_value>());
+        CHECK_EQ(entity.read_component<command_test_value>().value, 5);
+
+        entity.destroy();
+    }
+
+    SUBCASE("Removals get applied after additions")
+    {
+        auto entity = commands.create_entity(false);
+        commands.remove_component<command_test_tag>(entity);
+        commands.add_component<command_test_tag>(entity);
+        commands.add_component(entity, command_test_value{ 1 });
+
+        commands.playback();
+        REQUIRE(registry->validateEntity(entity.get_id()));
+        CHECK(entity.has_component<command_test_value>());
+        CHECK_FALSE(entity.has_component<command_test_tag>());
+
+        entity.destroy();
+    }
+
+    SUBCASE("Destruction gets applied last")
+    {
+        auto entity = commands.create_entity(false);
+        commands.destroy_entity(entity);
+        commands.add_component(entity, command_test_value{ 2 });
+
+        commands.playback();
+        CHECK_FALSE(registry->validateEntity(entity.get_id()));
+    }
+}
+
+TEST_CASE("[core:ecs] command_buffer concurrent recording")
+{
+    using namespace ::legion::core;
+
+    test_system system;
+    auto* registry = system.registry();
+    registry->reportComponentType<command_test_value>();
+
+    constexpr int threadCount = 4;
+    constexpr size_type entitiesPerThread = 250;
+
+    ecs::command_buffer commands(registry);
+    std::vector<std::vector<ecs::entity_handle>> entities(threadCount);
+    std::atomic<int> finished{ 0 };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++)
+        threads.emplace_back([&, t]()
+            {
+                for (size_type i = 0; i < entitiesPerThread; i++)
+                {
+                    auto entity = commands.create_entity(false);
+                    commands.add_component(entity, command_test_value{ t });
+                    entities[t].push_back(entity);
+                }
+                finished.fetch_add(1, std::memory_order_release);
+            });
+
+    // Reading the size while the other threads are recording has to be safe.
+    size_type lastSize = 0;
+    bool shrunk = false;
+    while (finished.load(std::memory_order_acquire) < threadCount)
+    {
+        size_type size = commands.size();
+        shrunk |= size < lastSize;
+        lastSize = size;
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    CHECK_FALSE(shrunk);
+    CHECK_EQ(commands.size(), threadCount * entitiesPerThread * 2);
+
+    commands.playback();
+    CHECK(commands.empty());
+
+    size_type mismatches = 0;
+    for (int t = 0; t < threadCount; t++)
+        for (auto& entity : entities[t])
+        {
+            if (!registry->validateEntity(entity.get_id()) || !entity.has_component<command_test_value>() || entity.read_component<command_test_value>().value != t)
+                mismatches++;
+        }
+
+    CHECK_EQ(mismatches, 0);
+
+    for (auto& threadEntities : entities)
+        for (auto& entity : threadEntities)
+            entity.destroy();
+}
@@ -0,0 +1,226 @@
+#pragma once
+#include <core/ecs/ecs.hpp>
+
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "doctest.h"
+#include "test_system.hpp"
+
+inline namespace {
+
+    struct parallel_test_input
+    {
+        ::legion::core::size_type value = 0;
+    };
+
+    struct parallel_test_output
+    {
+        ::legion::core::size_type value = 0;
+    };
+}
+
+TEST_CASE("[core:ecs] EntityQuery::parallel_for")
+{
+    using namespace ::legion::core;
+
+    test_system system;
+    system.registry()->reportComponentType<parallel_test_input>();
+    system.registry()->reportComponentType<parallel_test_output>();
+
+    constexpr size_type entityCount = 5000;
+
+    std::vector<ecs::entity_handle> entities;
+    for (size_type i = 0; i < entityCount; i++)
+    {
+        auto entity = system.createEntity(false);
+        entity.add_component(parallel_test_input{ i + 1 });
+        entity.add_component<parallel_test_output>();
+        entities.push_back(entity);
+    }
+
+    auto query = system.createQuery<parallel_test_input, parallel_test_output>();
+
+    SUBCASE("Every entity gets processed once")
+    {
+        for (size_type batchSize : { size_type(0), size_type(1), size_type(64), entityCount * 2 })
+        {
+            query.parallel_for<const parallel_test_input, parallel_test_output>(batchSize,
+                [](ecs::entity_handle, const parallel_test_input& input, parallel_test_output& output)
+                {
+                    output.value += input.value * 2;
+                });
+        }
+
+        size_type mismatches = 0;
+        auto view = query.view<const parallel_test_input, const parallel_test_output>();
+        CHECK_EQ(view.size(), entityCount);
+        for (auto [entity, input, output] : view)
+            if (output.value != input.value * 8)
+                mismatches++;
+
+        CHECK_EQ(mismatches, 0);
+    }
+
+    SUBCASE("Indices match the view")
+    {
+        auto view = query.view<const parallel_test_input>();
+        std::vector<size_type> results(view.size(), 0);
+
+        query.parallel_for(view, 16, [&](size_type index, ecs::entity_handle, const parallel_test_input& input)
+            {
+                results[index] += input.value;
+            });
+
+        size_type mismatches = 0;
+        for (size_type i = 0; i < view.size(); i++)
+            if (results[i] != view.get<const parallel_test_input>(i).value)
+                mismatches++;
+
+        CHECK_EQ(mismatches, 0);
+    }
+
+    SUBCASE("Views only lock written pools for write")
+    {
+        auto view = query.view<const parallel_test_input, parallel_test_output>();
+
+        bool inputReadable = false;
+        bool outputReadable = true;
+        std::thread([&]()
+            {
+                auto& inputLock = system.registry()->getFamily<parallel_test_input>()->get_lock();
+                auto& outputLock = system.registry()->getFamily<parallel_test_output>()->get_lock();
+
+                inputReadable = inputLock.try_lock(async::lock_state::read);
+                if (inputReadable)
+                    inputLock.unlock(async::lock_state::read);
+
+                outputReadable = outputLock.try_lock(async::lock_state::read);
+                if (outputReadable)
+                    outputLock.unlock(async::lock_state::read);
+            }).join();
+
+        CHECK(inputReadable);
+        CHECK_FALSE(outputReadable);
+
+        // The view references the components in their pools.
+        auto* inputPool = system.registry()->getFamily<parallel_test_input>();
+        size_type mismatches = 0;
+        for (auto [entity, input, output] : view)
+            if (&input != &inputPool->get_component(entity))
+                mismatches++;
+
+        CHECK_EQ(mismatches, 0);
+    }
+
+    for (auto& entity : entities)
+        entity.destroy();
+}
+
+TEST_CASE("[core:ecs] EntityQuery::forEachChunk")
+{
+    using namespace ::legion::core;
+
+    test_system system;
+    system.registry()->reportComponentType<parallel_test_input>();
+    system.registry()->reportComponentType<parallel_test_output>();
+
+    constexpr size_type entityCount = 5000;
+
+    std::vector<ecs::entity_handle> entities;
+    for (size_type i = 0; i < entityCount; i++)
+    {
+        auto entity = system.createEntity(false);
+        entity.add_component(parallel_test_input{ i + 1 });
+        entity.add_component<parallel_test_output>();
+        entities.push_back(entity);
+    }
+
+    auto query = system.createQuery<parallel_test_input, parallel_test_output>();
+
+    size_type visited = 0;
+    std::unordered_set<id_type> visitedIds;
+
+    query.forEachChunk<const parallel_test_input, parallel_test_output>(
+        [&](size_type count, const ecs::entity_handle* chunkEntities, const parallel_test_input* inputs, parallel_test_output* outputs)
+        {
+            for (size_type i = 0; i < count; i++)
+            {
+                outputs[i].value = inputs[i].value * 2;
+                visitedIds.insert(chunkEntities[i].get_id());
+            }
+            visited += count;
+        });
+
+    CHECK_EQ(visited, entityCount);
+    CHECK_EQ(visitedIds.size(), entityCount);
+
+    // The arrays of a chunk line up with its entities, and writes to the non-const types end up in the registry.
+    size_type mismatches = 0;
+    for (auto& entity : entities)
+        if (entity.read_component<parallel_test_output>().value != entity.read_component<parallel_test_input>().value * 2)
+            mismatches++;
+
+    CHECK_EQ(mismatches, 0);
+
+    for (auto& entity : entities)
+        entity.destroy();
+}
+
+TEST_CASE("[core:ecs] QueryRegistry concurrent structural changes")
+{
+    using namespace ::legion::core;
+
+    test_system system;
+    system.registry()->reportComponentType<parallel_test_input>();
+    system.registry()->reportComponentType<parallel_test_output>();
+
+    constexpr size_type threadCount = 4;
+    constexpr size_type entitiesPerThread = 500;
+
+    auto query = system.createQuery<parallel_test_input, parallel_test_output>();
+
+    std::vector<std::vector<ecs::entity_handle>> entities(threadCount);
+    for (auto& threadEntities : entities)
+        for (size_type i = 0; i < entitiesPerThread; i++)
+            threadEntities.push_back(system.createEntity(false));
+
+    // Every thread changes its own entities, changes to different entities don't have to wait on each other but all of them have to end up in the query.
+    std::vector<std::thread> threads;
+    for (size_type t = 0; t < threadCount; t++)
+        threads.emplace_back([&, t]()
+            {
+                for (auto& entity : entities[t])
+                {
+                    entity.add_component<parallel_test_input>();
+                    entity.add_component<parallel_test_output>();
+                }
+
+                // Every other entity loses a component again.
+                for (size_type i = 0; i < entitiesPerThread; i += 2)
+                    entities[t][i].remove_component<parallel_test_output>();
+            });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    query.queryEntities();
+    CHECK_EQ(query.size(), threadCount * entitiesPerThread / 2);
+
+    std::unordered_set<id_type> found;
+    for (auto entity : query)
+        found.insert(entity.get_id());
+
+    size_type mismatches = 0;
+    for (auto& threadEntities : entities)
+        for (size_type i = 0; i < entitiesPerThread; i++)
+            if (found.count(threadEntities[i].get_id()) != (i % 2))
+                mismatches++;
+
+    CHECK_EQ(mismatches, 0);
+
+    for (auto& threadEntities : entities)
+        for (auto& entity : threadEntities)
+            entity.destroy();
+}
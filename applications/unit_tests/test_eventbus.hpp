@@ -0,0 +1,165 @@
+#pragma once
+#include <core/events/eventbus.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+inline namespace {
+
+    struct test_event : public ::legion::core::events::event<test_event>
+    {
+        int value = 0;
+
+        test_event() = default;
+        test_event(int value) : value(value) {}
+
+        virtual bool persistent() override { return false; }
+        virtual bool unique() override { return false; }
+    };
+
+    int eventSum = 0;
+    int eventCount = 0;
+
+    void onTestEvent(test_event* event)
+    {
+        eventSum += event->value;
+        eventCount++;
+    }
+
+    std::vector<const test_event*> deliveredEvents;
+
+    void onTestEventAddress(test_event* event)
+    {
+        deliveredEvents.push_back(event);
+    }
+
+    ::legion::core::events::EventBus* bindingBus = nullptr;
+    int bindCount = 0;
+
+    // Binds another subscriber to the event it's being notified of.
+    void onBindingEvent(test_event*)
+    {
+        using namespace ::legion::core;
+        bindCount++;
+        for (int i = 0; i < 64; i++) // Enough to make the invocation list reallocate.
+            bindingBus->bindToEvent<test_event>(delegate<void(test_event*)>::create<&onTestEvent>());
+    }
+}
+
+TEST_CASE("[core:events] EventBus deferred dispatch")
+{
+    using namespace ::legion::core;
+
+    events::EventBus bus;
+    bus.bindToEvent<test_event>(delegate<void(test_event*)>::create<&onTestEvent>());
+    eventSum = 0;
+    eventCount = 0;
+
+    SUBCASE("Immediate delivery")
+    {
+        bus.raiseEvent<test_event>(2);
+        CHECK_EQ(eventCount, 1);
+        CHECK_EQ(eventSum, 2);
+    }
+
+    SUBCASE("Deferred delivery from multiple threads")
+    {
+        constexpr int threadCount = 4;
+        constexpr int eventsPerThread = 1000; // More than the capacity so the overflow gets used as well.
+
+        bus.deferEvent<test_event>("Update", 256);
+        CHECK(bus.isDeferred<test_event>());
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; t++)
+            threads.emplace_back([&]()
+                {
+                    for (int i = 0; i < eventsPerThread; i++)
+                        bus.raiseEvent<test_event>(1);
+                });
+
+        for (auto& thread : threads)
+            thread.join();
+
+        CHECK_EQ(eventCount, 0);
+        CHECK_EQ(bus.dispatchEvents(nameHash("Physics")), 0);
+
+        size_type delivered = 0;
+        size_type batch;
+        while ((batch = bus.dispatchEvents(nameHash("Update"))))
+            delivered += batch;
+
+        CHECK_EQ(delivered, threadCount * eventsPerThread);
+        CHECK_EQ(eventSum, threadCount * eventsPerThread);
+    }
+
+    SUBCASE("Bulk raise")
+    {
+        std::vector<test_event> batch{ 1, 2, 3, 4 };
+        bus.raiseEvents(batch);
+        CHECK_EQ(eventCount, 4);
+        CHECK_EQ(eventSum, 10);
+
+        bus.deferEvent<test_event>("Update");
+        bus.raiseEvents(batch);
+        CHECK_EQ(eventCount, 4);
+
+        bus.undeferEvent<test_event>(); // Remaining events get delivered immediately.
+        CHECK_EQ(eventCount, 8);
+        CHECK_FALSE(bus.isDeferred<test_event>());
+    }
+
+    SUBCASE("Bulk raise delivers from the source")
+    {
+        bus.bindToEvent<test_event>(delegate<void(test_event*)>::create<&onTestEventAddress>());
+        deliveredEvents.clear();
+
+        // Immediately delivered events don't get copied, subscribers see the elements of the batch itself.
+        std::vector<test_event> batch{ 1, 2, 3 };
+        bus.raiseEvents(batch);
+        REQUIRE_EQ(deliveredEvents.size(), batch.size());
+        for (size_type i = 0; i < batch.size(); i++)
+            CHECK_EQ(deliveredEvents[i], &batch[i]);
+
+        // Moved batches can be queued as well.
+        bus.deferEvent<test_event>("Update");
+        bus.raiseEvents(std::move(batch));
+        CHECK_EQ(bus.dispatchEvents(nameHash("Update")), 3);
+        CHECK_EQ(eventSum, 12);
+    }
+}
+
+TEST_CASE("[core:events] EventBus binding from inside a subscriber")
+{
+    using namespace ::legion::core;
+
+    events::EventBus bus;
+    bindingBus = &bus;
+    bindCount = 0;
+    eventSum = 0;
+    eventCount = 0;
+
+    bus.bindToEvent<test_event>(delegate<void(test_event*)>::create<&onBindingEvent>());
+
+    // Subscribers bound during the raise only get notified of the next event.
+    bus.raiseEvent<test_event>(1);
+    CHECK_EQ(bindCount, 1);
+    CHECK_EQ(eventCount, 0);
+
+    bus.raiseEvent<test_event>(1);
+    CHECK_EQ(bindCount, 2);
+    CHECK_EQ(eventCount, 64);
+
+    SUBCASE("Deferred")
+    {
+        bus.deferEvent<test_event>("Update");
+        bus.raiseEvent<test_event>(1);
+        CHECK_EQ(bus.dispatchEvents(nameHash("Update")), 1);
+        CHECK_EQ(bindCount, 3);
+        CHECK_EQ(eventCount, 64 + 128);
+    }
+
+    bindingBus = nullptr;
+}
@@ -0,0 +1,206 @@
+#pragma once
+#include <core/core.hpp>
+#include <core/filesystem/filesystem.hpp>
+#include <physics/data/fracture_pattern_cache.hpp>
+
+#include <vector>
+
+#include "doctest.h"
+
+inline namespace {
+
+    // Writes a pattern file field by field in the layout of FracturePatternCache::store, remembering where every field ends.
+    struct fracture_pattern_test_file
+    {
+        ::legion::core::byte_vec data;
+        std::vector<::legion::core::size_type> boundaries;
+
+        template<typename T>
+        void append(T value)
+        {
+            ::legion::core::appendBinaryData(&value, data);
+            boundaries.push_back(data.size());
+        }
+    };
+
+    // A box around the offset of a fragment, used both as its hull and as its mesh.
+    std::vector<::legion::core::math::vec3> fracturePatternTestBox(const ::legion::core::math::vec3& center, float halfExtent)
+    {
+        using namespace ::legion::core;
+
+        std::vector<math::vec3> corners;
+        for (int i = 0; i < 8; i++)
+            corners.push_back(center + math::vec3(i & 1 ? halfExtent : -halfExtent, i & 2 ? halfExtent : -halfExtent, i & 4 ? halfExtent : -halfExtent));
+        return corners;
+    }
+
+    // Two patterns with a different amount of fragments, so it's visible which one a fracture picked.
+    fracture_pattern_test_file fracturePatternTestData()
+    {
+        using namespace ::legion::core;
+
+        fracture_pattern_test_file file;
+        for (char item : std::string_view("\xabLEGION FRACTURE\xbb\r\n\x13\n"))
+            file.data.push_back(static_cast<byte>(item));
+        file.boundaries.push_back(file.data.size());
+
+        file.append(math::vec3(1.f));
+        file.append(uint64(2));
+
+        const std::vector<std::pair<math::vec3, std::vector<math::vec3>>> patterns{
+            { math::vec3(1.f, 0.f, 0.f), { math::vec3(.25f, 0.f, 0.f), math::vec3(-.25f, 0.f, 0.f) } },
+            { math::vec3(-1.f, 0.f, 0.f), { math::vec3(0.f, .5f, 0.f) } }
+        };
+
+        for (auto& [impactPoint, offsets] : patterns)
+        {
+            file.append(impactPoint);
+            file.append(uint64(offsets.size()));
+
+            for (auto& offset : offsets)
+            {
+                file.append(offset);
+                file.append(fracturePatternTestBox(offset, .25f));
+
+                mesh fragmentMesh;
+                fragmentMesh.vertices = fracturePatternTestBox(offset, .25f);
+                fragmentMesh.indices = { 0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5 };
+
+                filesystem::basic_resource meshResource(nullptr);
+                mesh::to_resource(&meshResource, fragmentMesh);
+                file.append(meshResource.get());
+            }
+        }
+
+        return file;
+    }
+
+    ::legion::core::filesystem::view fracturePatternTestView(const std::string& name)
+    {
+        namespace fs = ::legion::core::filesystem;
+
+        static bool registered = false;
+        if (!registered)
+        {
+            fs::provider_registry::domain_create_resolver<fs::basic_resolver>("fracture_test://", "./assets");
+            registered = true;
+        }
+
+        return fs::view("fracture_test://" + name);
+    }
+
+    // Fills the task with the fragments of the pattern closest to the impact, for a source that has the mesh and scale of the patterns.
+    bool fracturePatternTestInstantiate(::legion::core::id_type meshId, const ::legion::core::math::vec3& impactPoint, std::vector<::legion::physics::fracture_fragment>& fragments)
+    {
+        using namespace ::legion::core;
+        using namespace ::legion::physics;
+
+        fracture_task task{ ecs::entity_handle(), FractureParams(impactPoint) };
+
+        fracture_source& source = task.sources.emplace_back();
+        source.transform = math::mat4(1.f);
+        source.rotation = math::identity<math::quat>();
+        source.scale = math::vec3(1.f);
+        source.meshId = meshId;
+
+        if (!FracturePatternCache::instantiate(task))
+            return false;
+
+        fragments = std::move(task.cellFragments[0]);
+        return true;
+    }
+}
+
+TEST_CASE("[physics] FracturePatternCache store and load round trip")
+{
+    using namespace ::legion::core;
+    using namespace ::legion::physics;
+
+    const id_type meshId = nameHash("fracture_pattern_test_round_trip");
+    FracturePatternCache::clear();
+
+    auto file = fracturePatternTestData();
+    auto source = fracturePatternTestView("fracture_pattern_source.bin");
+    REQUIRE_FALSE(source.set(filesystem::basic_resource(file.data)).has_err());
+    REQUIRE(FracturePatternCache::load(meshId, source));
+    CHECK(FracturePatternCache::has(meshId));
+
+    std::vector<fracture_fragment> loadedRight;
+    std::vector<fracture_fragment> loadedLeft;
+    REQUIRE(fracturePatternTestInstantiate(meshId, math::vec3(2.f, 0.f, 0.f), loadedRight));
+    REQUIRE(fracturePatternTestInstantiate(meshId, math::vec3(-2.f, .1f, 0.f), loadedLeft));
+    REQUIRE_EQ(loadedRight.size(), 2);
+    REQUIRE_EQ(loadedLeft.size(), 1);
+    CHECK_EQ(loadedLeft[0].localOffset, math::vec3(0.f, .5f, 0.f));
+
+    auto stored = fracturePatternTestView("fracture_pattern_stored.bin");
+    REQUIRE(FracturePatternCache::store(meshId, stored));
+
+    FracturePatternCache::clear();
+    CHECK_FALSE(FracturePatternCache::has(meshId));
+    REQUIRE(FracturePatternCache::load(meshId, stored));
+
+    std::vector<fracture_fragment> reloadedRight;
+    REQUIRE(fracturePatternTestInstantiate(meshId, math::vec3(2.f, 0.f, 0.f), reloadedRight));
+    REQUIRE_EQ(reloadedRight.size(), loadedRight.size());
+
+    for (size_type i = 0; i < loadedRight.size(); i++)
+    {
+        auto& before = loadedRight[i];
+        auto& after = reloadedRight[i];
+
+        CHECK_EQ(before.localOffset, after.localOffset);
+        CHECK_EQ(before.collider->GetVertices().size(), after.collider->GetVertices().size());
+
+        // The reloaded patterns get meshes of their own, their contents have to be the same.
+        CHECK_NE(before.meshHandle.id, after.meshHandle.id);
+        auto [beforeLock, beforeMesh] = before.meshHandle.get();
+        auto [afterLock, afterMesh] = after.meshHandle.get();
+        CHECK_EQ(beforeMesh.vertices, afterMesh.vertices);
+        CHECK_EQ(beforeMesh.indices, afterMesh.indices);
+    }
+
+    FracturePatternCache::clear();
+}
+
+TEST_CASE("[physics] FracturePatternCache rejects truncated files")
+{
+    using namespace ::legion::core;
+    using namespace ::legion::physics;
+
+    const id_type meshId = nameHash("fracture_pattern_test_truncated");
+    const id_type loadedMeshId = nameHash("fracture_pattern_test_loaded");
+    FracturePatternCache::clear();
+
+    auto file = fracturePatternTestData();
+    auto target = fracturePatternTestView("fracture_pattern_truncated.bin");
+
+    REQUIRE_FALSE(target.set(filesystem::basic_resource(file.data)).has_err());
+    REQUIRE(FracturePatternCache::load(loadedMeshId, target));
+
+    // Cut the file off at the end of every field and one byte into the next, except for the end of the last field.
+    file.boundaries.pop_back();
+    size_type accepted = 0;
+
+    for (size_type boundary : file.boundaries)
+    {
+        for (size_type size : { boundary, boundary + 1 })
+        {
+            byte_vec truncated(file.data.begin(), file.data.begin() + size);
+            REQUIRE_FALSE(target.set(filesystem::basic_resource(truncated)).has_err());
+
+            if (FracturePatternCache::load(meshId, target))
+                accepted++;
+        }
+    }
+
+    CHECK_EQ(accepted, 0);
+    CHECK_FALSE(FracturePatternCache::has(meshId));
+
+    // Rejected files don't touch the patterns that were already loaded.
+    std::vector<fracture_fragment> fragments;
+    REQUIRE(fracturePatternTestInstantiate(loadedMeshId, math::vec3(2.f, 0.f, 0.f), fragments));
+    CHECK_EQ(fragments.size(), 2);
+
+    FracturePatternCache::clear();
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <core/ecs/ecs.hpp>
+#include <core/defaults/hierarchysystem.hpp>
+
+#include <vector>
+
+#include "doctest.h"
+#include "test_system.hpp"
+
+TEST_CASE("[core:defaults] HierarchySystem updates children before the handler returns")
+{
+    using namespace ::legion::core;
+
+    test_system system;
+    system.registry()->reportComponentType<position>();
+    system.registry()->reportComponentType<rotation>();
+    system.registry()->reportComponentType<scale>();
+
+    // The handlers get called directly, binding them would leave a dangling delegate on the engine's event bus.
+    HierarchySystem hierarchySystem;
+
+    constexpr size_type childCount = 300; // More than a single job's worth of children.
+
+    auto parent = system.createEntity(false);
+    parent.add_component(position(0.f, 0.f, 0.f));
+
+    std::vector<ecs::entity_handle> children;
+    for (size_type i = 0; i < childCount; i++)
+    {
+        auto child = system.createEntity(false);
+        child.add_component(position(static_cast<float>(i), 0.f, 0.f));
+        child.set_parent(parent);
+        children.push_back(child);
+    }
+
+    SUBCASE("Single modification")
+    {
+        position oldPos = parent.read_component<position>();
+        position newPos(0.f, 2.f, 0.f);
+        parent.write_component(newPos);
+
+        events::component_modification<position> event(parent, oldPos, newPos);
+        hierarchySystem.onPositionModified(&event);
+
+        for (size_type i = 0; i < childCount; i++)
+        {
+            position childPos = children[i].read_component<position>();
+            CHECK_EQ(childPos.x, doctest::Approx(static_cast<float>(i)));
+            CHECK_EQ(childPos.y, doctest::Approx(2.f));
+        }
+    }
+
+    SUBCASE("Consecutive modifications")
+    {
+        // Every write has to see the result of the previous one, otherwise updates get lost.
+        for (int step = 1; step <= 4; step++)
+        {
+            position oldPos = parent.read_component<position>();
+            position newPos(0.f, 0.f, static_cast<float>(step));
+            parent.write_component(newPos);
+
+            events::component_modification<position> event(parent, oldPos, newPos);
+            hierarchySystem.onPositionModified(&event);
+        }
+
+        for (size_type i = 0; i < childCount; i++)
+            CHECK_EQ(children[i].read_component<position>().z, doctest::Approx(4.f));
+    }
+
+    SUBCASE("Bulk modification")
+    {
+        ecs::entity_container entities{ parent };
+        ecs::component_container<position> oldValues{ parent.read_component<position>() };
+        ecs::component_container<position> newValues{ position(1.f, 0.f, 0.f) };
+        parent.write_component(newValues[0]);
+
+        events::bulk_component_modification<position> event(entities, oldValues, newValues);
+        hierarchySystem.onPositionBulkModified(&event);
+
+        for (size_type i = 0; i < childCount; i++)
+            CHECK_EQ(children[i].read_component<position>().x, doctest::Approx(static_cast<float>(i) + 1.f));
+    }
+
+    parent.destroy();
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include <core/async/work_stealing_deque.hpp>
+#include <core/async/mpmc_queue.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+TEST_CASE("[core:async] work_stealing_deque concurrent push, pop and steal")
+{
+    using namespace ::legion::core;
+
+    constexpr size_type itemCount = 100000;
+    constexpr size_type thiefCount = 3;
+
+    std::vector<size_type> items(itemCount);
+    std::vector<std::atomic<size_type>> taken(itemCount);
+    for (size_type i = 0; i < itemCount; i++)
+    {
+        items[i] = i;
+        taken[i].store(0, std::memory_order_relaxed);
+    }
+
+    async::work_stealing_deque<size_type> deque(16); // Small on purpose, the deque has to grow while it's being stolen from.
+    std::atomic_bool done{ false };
+    std::atomic<size_type> takenCount{ 0 };
+
+    std::vector<std::thread> thieves;
+    for (size_type t = 0; t < thiefCount; t++)
+        thieves.emplace_back([&]()
+            {
+                while (!done.load(std::memory_order_acquire) || !deque.empty())
+                {
+                    if (size_type* item = deque.steal())
+                    {
+                        taken[*item].fetch_add(1, std::memory_order_relaxed);
+                        takenCount.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+
+    // The owner pushes everything and pops some of it back, like a worker that queues jobs and works on them itself.
+    for (size_type i = 0; i < itemCount; i++)
+    {
+        deque.push(&items[i]);
+
+        if (i % 3 == 0)
+            if (size_type* item = deque.pop())
+            {
+                taken[*item].fetch_add(1, std::memory_order_relaxed);
+                takenCount.fetch_add(1, std::memory_order_relaxed);
+            }
+    }
+
+    while (size_type* item = deque.pop())
+    {
+        taken[*item].fetch_add(1, std::memory_order_relaxed);
+        takenCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    done.store(true, std::memory_order_release);
+    for (auto& thief : thieves)
+        thief.join();
+
+    // Every item needs to have been taken exactly once, by either the owner or one of the thieves.
+    CHECK_EQ(takenCount.load(), itemCount);
+
+    size_type duplicates = 0;
+    for (size_type i = 0; i < itemCount; i++)
+        if (taken[i].load(std::memory_order_relaxed) != 1)
+            duplicates++;
+
+    CHECK_EQ(duplicates, 0);
+}
+
+TEST_CASE("[core:async] mpmc_queue concurrent push and pop")
+{
+    using namespace ::legion::core;
+
+    constexpr size_type producerCount = 4;
+    constexpr size_type consumerCount = 4;
+    constexpr size_type itemsPerProducer = 50000;
+    constexpr size_type itemCount = producerCount * itemsPerProducer;
+
+    std::vector<size_type> items(itemCount);
+    std::vector<std::atomic<size_type>> taken(itemCount);
+    for (size_type i = 0; i < itemCount; i++)
+    {
+        items[i] = i;
+        taken[i].store(0, std::memory_order_relaxed);
+    }
+
+    async::mpmc_queue<size_type> queue(64); // Small on purpose, producers have to wait for the consumers to make room.
+    std::atomic<size_type> poppedCount{ 0 };
+
+    std::vector<std::thread> threads;
+    for (size_type p = 0; p < producerCount; p++)
+        threads.emplace_back([&, p]()
+            {
+                for (size_type i = p * itemsPerProducer; i < (p + 1) * itemsPerProducer; i++)
+                    while (!queue.try_push(&items[i]))
+                        std::this_thread::yield();
+            });
+
+    for (size_type c = 0; c < consumerCount; c++)
+        threads.emplace_back([&]()
+            {
+                while (poppedCount.load(std::memory_order_relaxed) < itemCount)
+                {
+                    if (size_type* item = queue.try_pop())
+                    {
+                        taken[*item].fetch_add(1, std::memory_order_relaxed);
+                        poppedCount.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    else
+                        std::this_thread::yield();
+                }
+            });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    CHECK(queue.empty());
+    CHECK_EQ(poppedCount.load(), itemCount);
+
+    size_type duplicates = 0;
+    for (size_type i = 0; i < itemCount; i++)
+        if (taken[i].load(std::memory_order_relaxed) != 1)
+            duplicates++;
+
+    CHECK_EQ(duplicates, 0);
+}
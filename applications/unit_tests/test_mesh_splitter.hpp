@@ -0,0 +1,196 @@
+#pragma once
+#include <core/core.hpp>
+#include <physics/mesh_splitter_utils/indexed_mesh_splitter.hpp>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "doctest.h"
+
+inline namespace {
+
+    // Adds a prism with a counter clockwise outline, every face gets its own vertices like a mesh with hard edges.
+    // The caps are fanned from the first point of the outline, so that point has to see the whole outline.
+    void addSplitterTestPrism(::legion::core::mesh& result, const std::vector<::legion::core::math::vec2>& outline, float bottom, float top, bool inverted = false)
+    {
+        using namespace ::legion::core;
+
+        auto addTriangle = [&](const math::vec3& a, const math::vec3& b, const math::vec3& c)
+        {
+            uint first = static_cast<uint>(result.vertices.size());
+            result.vertices.push_back(a);
+            result.vertices.push_back(inverted ? c : b);
+            result.vertices.push_back(inverted ? b : c);
+
+            for (uint i = 0; i < 3; i++)
+            {
+                result.uvs.emplace_back(0.f);
+                result.indices.push_back(first + i);
+            }
+        };
+
+        const size_type size = outline.size();
+        for (size_type i = 0; i < size; i++)
+        {
+            const math::vec2& from = outline[i];
+            const math::vec2& to = outline[(i + 1) % size];
+
+            addTriangle(math::vec3(from, bottom), math::vec3(to, bottom), math::vec3(to, top));
+            addTriangle(math::vec3(from, bottom), math::vec3(to, top), math::vec3(from, top));
+        }
+
+        for (size_type i = 1; i + 1 < size; i++)
+        {
+            addTriangle(math::vec3(outline[0], top), math::vec3(outline[i], top), math::vec3(outline[i + 1], top));
+            addTriangle(math::vec3(outline[0], bottom), math::vec3(outline[i + 1], bottom), math::vec3(outline[i], bottom));
+        }
+    }
+
+    float splitterTestVolume(const ::legion::physics::split_mesh_data& island)
+    {
+        using namespace ::legion::core;
+
+        float volume = 0.f;
+        for (size_type i = 0; i < island.indices.size(); i += 3)
+        {
+            volume += math::dot(island.position(island.indices[i]),
+                math::cross(island.position(island.indices[i + 1]), island.position(island.indices[i + 2])));
+        }
+        return volume / 6.f;
+    }
+
+    // A mesh is closed when every edge between two welds is used as often in one direction as in the other.
+    bool splitterTestIsClosed(const ::legion::physics::split_mesh_data& island)
+    {
+        using namespace ::legion::core;
+
+        std::map<std::pair<uint, uint>, int> edges;
+        for (size_type i = 0; i < island.indices.size(); i += 3)
+        {
+            for (size_type corner = 0; corner < 3; corner++)
+            {
+                uint from = island.welds[island.indices[i + corner]];
+                uint to = island.welds[island.indices[i + (corner + 1) % 3]];
+                edges[{ from, to }]++;
+                edges[{ to, from }]--;
+            }
+        }
+
+        for (auto& [edge, balance] : edges)
+        {
+            if (balance != 0)
+                return false;
+        }
+        return true;
+    }
+
+    // Counts the triangles that lie on the plane through 'point' but don't face along 'normal'.
+    ::legion::core::size_type splitterTestInvertedCapTriangles(const ::legion::physics::split_mesh_data& island, const ::legion::core::math::vec3& point, const ::legion::core::math::vec3& normal)
+    {
+        using namespace ::legion::core;
+
+        size_type inverted = 0;
+        for (size_type i = 0; i < island.indices.size(); i += 3)
+        {
+            math::vec3 a = island.position(island.indices[i]);
+            math::vec3 b = island.position(island.indices[i + 1]);
+            math::vec3 c = island.position(island.indices[i + 2]);
+
+            bool onPlane = math::abs(math::dot(a - point, normal)) < 1e-4f
+                && math::abs(math::dot(b - point, normal)) < 1e-4f
+                && math::abs(math::dot(c - point, normal)) < 1e-4f;
+
+            if (onPlane && math::dot(math::cross(b - a, c - a), normal) <= 0.f)
+                inverted++;
+        }
+        return inverted;
+    }
+}
+
+TEST_CASE("[physics] IndexedMeshSplitter caps the holes it cuts")
+{
+    using namespace ::legion::core;
+    using namespace ::legion::physics;
+
+    const math::mat4 transform(1.f);
+    mesh source;
+    std::vector<split_mesh_data> islands;
+    IndexedMeshSplitter splitter;
+
+    SUBCASE("Cube")
+    {
+        addSplitterTestPrism(source, { { -1.f, -1.f }, { 1.f, -1.f }, { 1.f, 1.f }, { -1.f, 1.f } }, -1.f, 1.f);
+
+        split_mesh_data splitMesh;
+        IndexedMeshSplitter::FromMesh(source, splitMesh);
+        REQUIRE_EQ(splitterTestVolume(splitMesh), doctest::Approx(8.f));
+
+        // Any plane through the center halves the cube.
+        const math::vec3 normal = math::normalize(math::vec3(1.f, 2.f, 3.f));
+        splitter.Split(splitMesh, { MeshSplitParams(math::vec3(0.f), normal) }, transform, islands);
+
+        REQUIRE_EQ(islands.size(), 1);
+        CHECK_EQ(splitterTestVolume(islands[0]), doctest::Approx(4.f));
+        CHECK(splitterTestIsClosed(islands[0]));
+        CHECK_EQ(splitterTestInvertedCapTriangles(islands[0], math::vec3(0.f), normal), 0);
+    }
+
+    SUBCASE("Concave outline")
+    {
+        // The average of this outline lies outside of it.
+        addSplitterTestPrism(source, { { 0.f, 0.f }, { 4.f, 0.f }, { 4.f, 1.f }, { 1.f, 1.f }, { 1.f, 4.f }, { 0.f, 4.f } }, -1.f, 1.f);
+
+        split_mesh_data splitMesh;
+        IndexedMeshSplitter::FromMesh(source, splitMesh);
+
+        const math::vec3 normal(0.f, 0.f, 1.f);
+        splitter.Split(splitMesh, { MeshSplitParams(math::vec3(0.f), normal) }, transform, islands);
+
+        REQUIRE_EQ(islands.size(), 1);
+        CHECK_EQ(splitterTestVolume(islands[0]), doctest::Approx(7.f));
+        CHECK(splitterTestIsClosed(islands[0]));
+        CHECK_EQ(splitterTestInvertedCapTriangles(islands[0], math::vec3(0.f), normal), 0);
+    }
+
+    SUBCASE("Hollow cube")
+    {
+        addSplitterTestPrism(source, { { -1.f, -1.f }, { 1.f, -1.f }, { 1.f, 1.f }, { -1.f, 1.f } }, -1.f, 1.f);
+        addSplitterTestPrism(source, { { -.5f, -.5f }, { .5f, -.5f }, { .5f, .5f }, { -.5f, .5f } }, -.5f, .5f, true);
+
+        split_mesh_data splitMesh;
+        IndexedMeshSplitter::FromMesh(source, splitMesh);
+        REQUIRE_EQ(splitterTestVolume(splitMesh), doctest::Approx(7.f));
+
+        // The cap is a square with a square hole, which connects the inside and the outside of the shell.
+        const math::vec3 normal(0.f, 0.f, 1.f);
+        splitter.Split(splitMesh, { MeshSplitParams(math::vec3(0.f), normal) }, transform, islands);
+
+        REQUIRE_EQ(islands.size(), 1);
+        CHECK_EQ(splitterTestVolume(islands[0]), doctest::Approx(3.5f));
+        CHECK(splitterTestIsClosed(islands[0]));
+        CHECK_EQ(splitterTestInvertedCapTriangles(islands[0], math::vec3(0.f), normal), 0);
+    }
+
+    SUBCASE("Holes that touch each other")
+    {
+        // Both prisms share an edge, so the hole has a weld that two of its edges start at.
+        addSplitterTestPrism(source, { { 0.f, 0.f }, { 1.f, 0.f }, { 1.f, 1.f }, { 0.f, 1.f } }, -1.f, 1.f);
+        addSplitterTestPrism(source, { { -1.f, -1.f }, { 0.f, -1.f }, { 0.f, 0.f }, { -1.f, 0.f } }, -1.f, 1.f);
+
+        split_mesh_data splitMesh;
+        IndexedMeshSplitter::FromMesh(source, splitMesh);
+
+        const math::vec3 normal(0.f, 0.f, 1.f);
+        splitter.Split(splitMesh, { MeshSplitParams(math::vec3(0.f), normal) }, transform, islands);
+
+        float volume = 0.f;
+        for (auto& island : islands)
+        {
+            volume += splitterTestVolume(island);
+            CHECK(splitterTestIsClosed(island));
+            CHECK_EQ(splitterTestInvertedCapTriangles(island, math::vec3(0.f), normal), 0);
+        }
+        CHECK_EQ(volume, doctest::Approx(2.f));
+    }
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include <core/scheduling/process.hpp>
+#include <core/scheduling/processchain.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "doctest.h"
+#include "test_system.hpp"
+
+inline namespace {
+
+    struct process_test_first {};
+    struct process_test_second {};
+
+    // Waits a while for another process to get to a certain point, which only happens if both processes run at the same time.
+    bool waitForProcess(const std::atomic_bool& flag)
+    {
+        auto start = std::chrono::steady_clock::now();
+        while (!flag.load(std::memory_order_acquire))
+        {
+            if (std::chrono::steady_clock::now() - start > std::chrono::seconds(2))
+                return false;
+            std::this_thread::yield();
+        }
+        return true;
+    }
+}
+
+TEST_CASE("[core:scheduling] ProcessChain runs processes that don't conflict concurrently")
+{
+    using namespace ::legion::core;
+    using operation_type = delegate<void(time::time_span<fast_time>)>;
+
+    test_system system;
+    scheduling::ProcessChain chain("ProcessGraphTest", system.scheduler());
+
+    std::atomic_bool firstStarted{ false };
+    std::atomic_bool secondStarted{ false };
+    std::atomic_bool firstDone{ false };
+    bool firstSawSecond = false;
+    bool secondSawFirst = false;
+    bool conflictingRan = false;
+    bool conflictingSawFirstDone = false;
+    bool boundRan = false;
+    std::thread::id boundThread;
+
+    scheduling::Process first("ProcessGraphTestFirst");
+    first.writes<process_test_first>();
+    first.setOperation(operation_type::create([&](time::time_span<fast_time>)
+        {
+            firstStarted.store(true, std::memory_order_release);
+            firstSawSecond = waitForProcess(secondStarted);
+            firstDone.store(true, std::memory_order_release);
+        }));
+
+    scheduling::Process second("ProcessGraphTestSecond");
+    second.writes<process_test_second>();
+    second.setOperation(operation_type::create([&](time::time_span<fast_time>)
+        {
+            secondStarted.store(true, std::memory_order_release);
+            secondSawFirst = waitForProcess(firstStarted);
+        }));
+
+    // Reads what the first process writes, so it has to wait for the first process to finish.
+    scheduling::Process conflicting("ProcessGraphTestConflicting");
+    conflicting.reads<process_test_first>();
+    conflicting.setOperation(operation_type::create([&](time::time_span<fast_time>)
+        {
+            conflictingRan = true;
+            conflictingSawFirstDone = firstDone.load(std::memory_order_acquire);
+        }));
+
+    scheduling::Process bound("ProcessGraphTestBound");
+    bound.reads<process_test_second>()->bindToChainThread();
+    bound.setOperation(operation_type::create([&](time::time_span<fast_time>)
+        {
+            boundRan = true;
+            boundThread = std::this_thread::get_id();
+        }));
+
+    CHECK_FALSE(first.conflictsWith(second));
+    CHECK(first.conflictsWith(conflicting));
+    CHECK_FALSE(second.conflictsWith(conflicting));
+    CHECK(second.conflictsWith(bound));
+    CHECK(bound.chainThreadBound());
+    CHECK_FALSE(first.chainThreadBound());
+
+    chain.addProcess(&first);
+    chain.addProcess(&second);
+    chain.addProcess(&conflicting);
+    chain.addProcess(&bound);
+
+    chain.runInCurrentThread();
+
+    CHECK(firstSawSecond);
+    CHECK(secondSawFirst);
+    REQUIRE(conflictingRan);
+    CHECK(conflictingSawFirstDone);
+    REQUIRE(boundRan);
+    CHECK_EQ(boundThread, std::this_thread::get_id());
+
+    chain.removeProcess(&first);
+    chain.removeProcess(&second);
+    chain.removeProcess(&conflicting);
+    chain.removeProcess(&bound);
+}
+
+TEST_CASE("[core:scheduling] ProcessChain keeps running after a process got removed")
+{
+    using namespace ::legion::core;
+    using operation_type = delegate<void(time::time_span<fast_time>)>;
+
+    test_system system;
+    scheduling::ProcessChain chain("ProcessGraphRemovalTest", system.scheduler());
+
+    int firstRuns = 0;
+    int secondRuns = 0;
+
+    scheduling::Process first("ProcessGraphRemovalTestFirst");
+    first.writes<process_test_first>();
+    first.setOperation(operation_type::create([&](time::time_span<fast_time>) { firstRuns++; }));
+
+    scheduling::Process second("ProcessGraphRemovalTestSecond");
+    second.writes<process_test_second>();
+    second.setOperation(operation_type::create([&](time::time_span<fast_time>) { secondRuns++; }));
+
+    chain.addProcess(&first);
+    chain.addProcess(&second);
+    chain.runInCurrentThread();
+
+    // The graph still has a node for the removed process, the chain may only wait for the processes that are still hooked.
+    chain.removeProcess(&second);
+    chain.runInCurrentThread();
+
+    CHECK_EQ(firstRuns, 2);
+    CHECK_EQ(secondRuns, 1);
+
+    chain.removeProcess(&first);
+    chain.runInCurrentThread();
+
+    CHECK_EQ(firstRuns, 2);
+}
@@ -0,0 +1,186 @@
+#pragma once
+#include <core/ecs/query_view.hpp>
+#include <core/ecs/component_pool.hpp>
+#include <core/ecs/archetype_storage.hpp>
+#include <core/events/eventbus.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+inline namespace {
+
+    struct view_test_position
+    {
+        float x = 0.f, y = 0.f, z = 0.f;
+    };
+
+    struct view_test_velocity
+    {
+        float value = 0.f;
+    };
+
+    int bulkModificationCount = 0;
+    float bulkModificationOldSum = 0.f;
+
+    void onVelocityBulkModified(::legion::core::events::bulk_component_modification<view_test_velocity>* event)
+    {
+        bulkModificationCount++;
+        for (auto& old : event->oldValues)
+            bulkModificationOldSum += old.value;
+    }
+
+    // Whether another thread is able to lock the pool at this moment.
+    template<typename pool_type>
+    bool canLock(pool_type& pool, ::legion::core::async::lock_state state)
+    {
+        bool locked = false;
+        std::thread([&]()
+            {
+                locked = pool.get_lock().try_lock(state);
+                if (locked)
+                    pool.get_lock().unlock(state);
+            }).join();
+        return locked;
+    }
+
+    template<typename pool_type>
+    bool canWriteLock(pool_type& pool)
+    {
+        return canLock(pool, ::legion::core::async::lock_state::write);
+    }
+
+    template<typename pool_type>
+    void testQueryView(pool_type& positions, ::legion::core::ecs::component_pool<view_test_velocity>& velocities)
+    {
+        using namespace ::legion::core;
+        using namespace ::legion::core::ecs;
+
+        constexpr id_type entityCount = 100;
+
+        entity_container entities;
+        for (id_type id = 1; id <= entityCount; id++)
+        {
+            view_test_position position{ static_cast<float>(id), 0.f, 0.f };
+            positions.create_component(id, &position);
+
+            // Only the even entities match the "query".
+            if (id % 2 == 0)
+            {
+                velocities.create_component(id);
+                entities.push_back(entity_handle(id));
+            }
+        }
+
+        {
+            query_view<const view_test_position, view_test_velocity> view(entities, &positions, &velocities);
+            REQUIRE_EQ(view.size(), entities.size());
+
+            // The written family stays locked for as long as the view exists, the family that is only read from can still be read by others.
+            CHECK_FALSE(canWriteLock(velocities));
+            CHECK_FALSE(canLock(velocities, async::lock_state::read));
+            CHECK(canLock(positions, async::lock_state::read));
+            CHECK_FALSE(canWriteLock(positions));
+
+            size_type visited = 0;
+            for (auto [entity, position, velocity] : view)
+            {
+                CHECK_EQ(position.x, static_cast<float>(entity.get_id()));
+                velocity.value = position.x * 2.f;
+                visited++;
+            }
+            CHECK_EQ(visited, entities.size());
+
+            view.for_each([](entity_handle, const view_test_position& position, view_test_velocity& velocity)
+                {
+                    velocity.value += position.x;
+                });
+        }
+
+        CHECK(canWriteLock(velocities));
+
+        // Writes through the view happened directly in the pool.
+        family_guard<const view_test_velocity> guard(velocities);
+        for (auto& entity : entities)
+            CHECK_EQ(velocities.get_component(entity).value, static_cast<float>(entity.get_id()) * 3.f);
+    }
+}
+
+TEST_CASE("[core:ecs] query_view references components in place")
+{
+    using namespace ::legion::core;
+    using namespace ::legion::core::ecs;
+
+    events::EventBus bus;
+
+    SUBCASE("Sparse storage")
+    {
+        component_pool<view_test_position> positions(nullptr, &bus);
+        component_pool<view_test_velocity> velocities(nullptr, &bus);
+        testQueryView(positions, velocities);
+    }
+
+    SUBCASE("Archetype storage")
+    {
+        archetype_storage storage;
+        storage.report_type<view_test_position>();
+        storage.report_type<view_test_velocity>();
+
+        component_pool<view_test_position> positions(nullptr, &bus, &storage);
+        component_pool<view_test_velocity> velocities(nullptr, &bus, &storage);
+        testQueryView(positions, velocities);
+    }
+}
+
+TEST_CASE("[core:ecs] modification events are opt-in")
+{
+    using namespace ::legion::core;
+    using namespace ::legion::core::ecs;
+
+    events::EventBus bus;
+    bus.bindToEvent<events::bulk_component_modification<view_test_velocity>>(
+        delegate<void(events::bulk_component_modification<view_test_velocity>*)>::create<&onVelocityBulkModified>());
+    bulkModificationCount = 0;
+    bulkModificationOldSum = 0.f;
+
+    component_pool<view_test_velocity> velocities(nullptr, &bus);
+    CHECK_FALSE(velocities.has_change_events());
+
+    entity_container entities;
+    component_container<view_test_velocity> values;
+    for (id_type id = 1; id <= 10; id++)
+    {
+        velocities.create_component(id);
+        entities.push_back(entity_handle(id));
+        values.push_back(view_test_velocity{ 1.f });
+    }
+
+    // Without change events the values get written but nobody gets notified.
+    velocities.set_components(entities, values);
+    CHECK_EQ(bulkModificationCount, 0);
+    {
+        family_guard<const view_test_velocity> guard(velocities);
+        CHECK_EQ(velocities.get_component(entities.back()).value, 1.f);
+    }
+
+    velocities.set_change_events(true);
+    CHECK(velocities.has_change_events());
+
+    for (auto& value : values)
+        value.value = 2.f;
+
+    velocities.set_components(entities, values);
+    CHECK_EQ(bulkModificationCount, 1);
+    CHECK_EQ(bulkModificationOldSum, 10.f);
+
+    // Views write in place and never raise events, even with change events enabled.
+    {
+        query_view<view_test_velocity> view(entities, &velocities);
+        view.for_each([](entity_handle, view_test_velocity& velocity) { velocity.value = 3.f; });
+    }
+    CHECK_EQ(bulkModificationCount, 1);
+
+    family_guard<const view_test_velocity> guard(velocities);
+    CHECK_EQ(velocities.get_component(entities.front()).value, 3.f);
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <core/async/rw_spinlock.hpp>
+#include <core/logging/logging.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "doctest.h"
+
+inline namespace {
+
+    using namespace ::legion::core;
+
+    // Hammers a lock from several threads, every writeInterval-th iteration writes while all others read.
+    // Returns the time it took in milliseconds and the final value of the protected counter in result.
+    template<typename lock_type>
+    double contend_lock(size_type threadCount, size_type iterations, size_type writeInterval, size_type& result)
+    {
+        lock_type lock;
+        size_type value = 0;
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        std::vector<std::thread> threads;
+        for (size_type t = 0; t < threadCount; t++)
+            threads.emplace_back([&]()
+                {
+                    volatile size_type sink = 0;
+                    for (size_type i = 0; i < iterations; i++)
+                    {
+                        if (i % writeInterval == 0)
+                        {
+                            async::readwrite_guard guard(lock);
+                            value++;
+                        }
+                        else
+                        {
+                            async::readonly_guard guard(lock);
+                            sink = value;
+                        }
+                    }
+                });
+
+        for (auto& thread : threads)
+            thread.join();
+
+        result = value;
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+}
+
+TEST_CASE("[core:async] rw_spinlock reentrancy")
+{
+    async::rw_spinlock lock;
+
+    {
+        async::readonly_guard outer(lock);
+        async::readonly_guard inner(lock);
+        {
+            async::readwrite_guard upgrade(lock); // Elevates the read lock of this thread to write.
+            async::readonly_guard nested(lock);
+        }
+    }
+
+    // Lock should be fully released again, another thread needs to be able to write.
+    bool locked = false;
+    std::thread([&]() { locked = lock.try_lock(async::lock_state::write); if (locked) lock.unlock(async::lock_state::write); }).join();
+    CHECK(locked);
+}
+
+TEST_CASE("[core:async] fast_rw_spinlock exclusion")
+{
+    async::fast_rw_spinlock lock;
+
+    lock.lock(async::lock_state::read);
+    CHECK(lock.try_lock(async::lock_state::read));
+    CHECK_FALSE(lock.try_lock(async::lock_state::write));
+    lock.unlock(async::lock_state::read);
+    lock.unlock(async::lock_state::read);
+
+    CHECK(lock.try_lock(async::lock_state::write));
+    CHECK_FALSE(lock.try_lock(async::lock_state::read));
+    lock.unlock(async::lock_state::write);
+}
+
+TEST_CASE("[core:async] rw_spinlock contention benchmark")
+{
+    constexpr size_type iterations = 100000;
+    constexpr size_type writeInterval = 10;
+
+    for (size_type threadCount : { 1, 2, 4, 8 })
+    {
+        size_type reentrantResult;
+        size_type fastResult;
+        double reentrantTime = contend_lock<async::rw_spinlock>(threadCount, iterations, writeInterval, reentrantResult);
+        double fastTime = contend_lock<async::fast_rw_spinlock>(threadCount, iterations, writeInterval, fastResult);
+
+        // Every write needs to have been exclusive, otherwise increments get lost.
+        CHECK_EQ(reentrantResult, threadCount * iterations / writeInterval);
+        CHECK_EQ(fastResult, threadCount * iterations / writeInterval);
+
+        log::info("rw_spinlock {} threads: reentrant {:.2f}ms, fast {:.2f}ms", threadCount, reentrantTime, fastTime);
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include <core/engine/system.hpp>
+#include <core/ecs/ecs.hpp>
+#include <core/scheduling/scheduler.hpp>
+
+inline namespace {
+
+    // Gives tests access to the registry and the scheduler of the engine.
+    // Creating a second registry would take over the global entity handles, and the worker threads of the engine's scheduler are already running while the tests run.
+    class test_system : public ::legion::core::System<test_system>
+    {
+    public:
+        void setup() override {}
+
+        using System::createEntity;
+        using System::createQuery;
+
+        static ::legion::core::ecs::EcsRegistry* registry() { return m_ecs; }
+        static ::legion::core::scheduling::Scheduler* scheduler() { return m_scheduler; }
+    };
+}
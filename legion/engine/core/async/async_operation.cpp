@@ -14,14 +14,32 @@ namespace legion::core::async
         return m_progress.load(std::memory_order_relaxed);
     }
 
+    void async_progress::invoke_continuations()
+    {
+        std::vector<std::function<void()>> continuations;
+
+        {
+            async::readwrite_guard guard(m_continuationLock);
+            m_continuationsInvoked = true;
+            continuations.swap(m_continuations);
+        }
+
+        for (auto& continuation : continuations)
+            continuation();
+    }
+
     void async_progress::complete() noexcept
     {
-        m_progress.store(m_size, std::memory_order_release);
+        size_type previous = m_progress.exchange(m_size, std::memory_order_acq_rel);
+        if (previous < m_size)
+            invoke_continuations();
     }
 
     void async_progress::advance_progress(size_type progress) noexcept
     {
-        m_progress.fetch_add(progress, std::memory_order_release);
+        size_type previous = m_progress.fetch_add(progress, std::memory_order_acq_rel);
+        if (previous < m_size && previous + progress >= m_size) // Only the thread that finishes the operation invokes the continuations.
+            invoke_continuations();
     }
 
     bool async_progress::is_done() const noexcept
@@ -29,6 +47,21 @@ namespace legion::core::async
         return m_progress.load(std::memory_order_relaxed) >= m_size;
     }
 
+    void async_progress::on_complete(std::function<void()>&& continuation)
+    {
+        if (m_size) // Empty operations are done from the start and never invoke their continuations.
+        {
+            async::readwrite_guard guard(m_continuationLock);
+            if (!m_continuationsInvoked)
+            {
+                m_continuations.push_back(std::move(continuation));
+                return;
+            }
+        }
+
+        continuation();
+    }
+
     float async_progress::progress() const noexcept
     {
         return ((float)m_progress.load(std::memory_order_relaxed)) / m_size;
@@ -2,9 +2,12 @@
 #include <core/platform/platform.hpp>
 #include <core/types/types.hpp>
 #include <core/async/wait_priority.hpp>
+#include <core/async/rw_spinlock.hpp>
 #include <atomic>
 #include <memory>
 #include <thread>
+#include <functional>
+#include <vector>
 
 namespace legion::core::async
 {
@@ -14,6 +17,12 @@ namespace legion::core::async
         size_type m_size;
         std::atomic<size_type> m_progress;
 
+        fast_rw_spinlock m_continuationLock;
+        bool m_continuationsInvoked = false;
+        std::vector<std::function<void()>> m_continuations;
+
+        void invoke_continuations();
+
     public:
         async_progress(size_type size) : m_size(size), m_progress(0) {}
 
@@ -24,6 +33,11 @@ namespace legion::core::async
         void advance_progress(size_type progress = 1) noexcept;
         bool is_done() const noexcept;
         float progress() const noexcept;
+
+        /**@brief Register a function to call once the operation is done, gets called immediately if the operation is already done.
+         * @note Continuations run on the thread that finishes the operation, so keep them short or use them to queue more work.
+         */
+        void on_complete(std::function<void()>&& continuation);
     };
 
     template<typename Func>
@@ -40,7 +54,7 @@ namespace legion::core::async
 
         bool is_done() const noexcept
         {
-            return m_progress->is_done();
+            return !m_progress || m_progress->is_done();
         }
 
         float progress() const noexcept
@@ -69,6 +83,17 @@ namespace legion::core::async
             }
         }
 
+        /**@brief Register a function to call once the operation is done without blocking the current thread.
+         * @ref async_progress::on_complete()
+         */
+        void on_complete(std::function<void()>&& continuation) const
+        {
+            if (m_progress)
+                m_progress->on_complete(std::move(continuation));
+            else
+                continuation();
+        }
+
         template<typename... Args>
         auto then(Args&&... args) const
         {
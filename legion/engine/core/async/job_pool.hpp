@@ -1,16 +1,62 @@
 #pragma once
 #include <core/async/async_operation.hpp>
+#include <core/async/rw_spinlock.hpp>
 #include <core/containers/runnable.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+
 namespace legion::core::async
 {
+    /**@brief Amount of time an adaptively sized range job should take, long enough to hide the cost of fetching a job, short enough to still balance the load.
+     */
+    constexpr float range_job_target_duration_ns = 25000.f;
+
     template<typename Func>
     struct job_pool;
 
+    template<typename Func>
+    struct range_job_pool;
+
+    /**@class job_range
+     * @brief Contiguous range of indices [start, stop) that a single job should process.
+     */
+    struct job_range
+    {
+        size_type start;
+        size_type stop;
+
+        struct iterator
+        {
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = size_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const size_type*;
+            using reference = size_type;
+
+            size_type index;
+
+            size_type operator*() const noexcept { return index; }
+            iterator& operator++() noexcept { index++; return *this; }
+            iterator operator++(int) noexcept { iterator prev = *this; index++; return prev; }
+            bool operator==(const iterator& other) const noexcept { return index == other.index; }
+            bool operator!=(const iterator& other) const noexcept { return index != other.index; }
+        };
+
+        L_NODISCARD size_type size() const noexcept { return stop - start; }
+        L_NODISCARD iterator begin() const noexcept { return iterator{ start }; }
+        L_NODISCARD iterator end() const noexcept { return iterator{ stop }; }
+    };
+
     struct this_job
     {
         template<typename T>
         friend struct job_pool;
+        template<typename T>
+        friend struct range_job_pool;
     private:
         static thread_local id_type m_id;
     public:
@@ -21,19 +67,40 @@ namespace legion::core::async
     {
     protected:
         std::shared_ptr<async_progress> m_progress;
+        std::atomic_bool m_ready{ true };
     public:
         job_pool_base(size_type count) : m_progress(new async_progress(count)) {}
 
+        /**@brief Pools that wait on another operation aren't ready until that operation is done, waiting on them won't execute any of their jobs until then.
+         */
+        void set_ready(bool ready) noexcept
+        {
+            m_ready.store(ready, std::memory_order_release);
+        }
+
+        bool is_ready() const noexcept
+        {
+            return m_ready.load(std::memory_order_acquire);
+        }
+
         std::shared_ptr<async_progress> get_progress() const noexcept
         {
             return m_progress;
         }
 
-        virtual runnable_base* pop_job() LEGION_PURE;
+        /**@brief Reserve the next job of the pool.
+         * @param range [out] Range of items the job should process.
+         * @return bool False if all jobs were already taken.
+         */
+        virtual bool pop_job(job_range& range) LEGION_PURE;
+
+        /**@brief Execute a job previously reserved with pop_job.
+         */
+        virtual void execute_job(const job_range& range) LEGION_PURE;
 
-        void complete_job()
+        void complete_job(const job_range& range)
         {
-            m_progress->advance_progress();
+            m_progress->advance_progress(range.size());
         }
 
         bool is_done() const noexcept
@@ -53,11 +120,14 @@ namespace legion::core::async
         void execute_job() const noexcept
         {
             OPTICK_EVENT();
-            auto* job = jobPoolPtr->pop_job();
-            if (job)
+            if (!jobPoolPtr->is_ready())
+                return;
+
+            job_range range;
+            if (jobPoolPtr->pop_job(range))
             {
-                job->execute();
-                jobPoolPtr->complete_job();
+                jobPoolPtr->execute_job(range);
+                jobPoolPtr->complete_job(range);
             }
 
             if (jobPoolPtr->is_done())
@@ -112,34 +182,133 @@ namespace legion::core::async
         const Func&, const CompletionFunc&) -> job_operation<Func, CompletionFunc>;
 #endif
 
+    /**@class reduce_operation
+     * @brief Operation of a parallel reduction, the result becomes available once all jobs are done.
+     * @tparam T Type of the reduced value.
+     * @tparam OperationType Operation of the jobs that perform the reduction.
+     */
+    template<typename T, typename OperationType>
+    struct reduce_operation : public OperationType
+    {
+    private:
+        std::shared_ptr<T> m_result;
+
+    public:
+        reduce_operation(const OperationType& operation, const std::shared_ptr<T>& result) : OperationType(operation), m_result(result) {}
+
+        /**@brief Wait for the reduction to finish and get the result.
+         */
+        L_NODISCARD const T& get(wait_priority priority = wait_priority_normal) const noexcept
+        {
+            this->wait(priority);
+            return *m_result;
+        }
+    };
+
     template<typename Func>
     struct job_pool : public job_pool_base
     {
     private:
-        std::atomic<size_type> m_index;
-        std::vector<runnable<Func>> m_jobs;
+        std::atomic<size_type> m_index{ 0 };
+        const size_type m_count;
+        Func m_func;
 
     public:
-        job_pool(size_type count, const Func& func) : job_pool_base(count), m_index(count)
+        job_pool(size_type count, const Func& func) : job_pool_base(count), m_count(count), m_func(func) {}
+
+        virtual bool pop_job(job_range& range) override
         {
-            m_jobs.resize(count, runnable<Func>(func));
+            size_type idx = m_index.fetch_add(1, std::memory_order_acquire);
+            if (idx >= m_count)
+                return false;
+
+            range = { idx, idx + 1 };
+            return true;
+        }
+
+        virtual void execute_job(const job_range& range) override
+        {
+            this_job::m_id = range.start;
+            std::invoke(m_func);
+        }
+
+        virtual bool empty() const noexcept override
+        {
+            return m_index.load(std::memory_order_relaxed) >= m_count;
         }
+    };
+
+    /**@class range_job_pool
+     * @brief Pool that hands out contiguous blocks of indices instead of single indices, so the per-job overhead gets spread over many items.
+     * @note With a grain size of 0 the size of the blocks adapts to the measured cost per item.
+     *       The measurements are shared by all pools of the same function type, so loops that run every frame start with a good estimate.
+     * @tparam Func Function that takes an async::job_range.
+     */
+    template<typename Func>
+    struct range_job_pool : public job_pool_base
+    {
+    private:
+        inline static std::atomic<float> m_itemCost{ 0.f }; // Average time per item in nanoseconds, 0 if it wasn't measured yet.
+
+        std::atomic<size_type> m_next;
+        const size_type m_start;
+        const size_type m_stop;
+        const size_type m_grain;
+        const size_type m_concurrency;
+        Func m_func;
 
-        virtual runnable_base* pop_job() override
+        size_type adaptive_grain(size_type next) const noexcept
         {
-            size_type idx = m_index.fetch_sub(1, std::memory_order_acquire);
-            if (idx < 1 || idx > m_jobs.size())
-                return nullptr;
+            size_type remaining = next < m_stop ? m_stop - next : 0;
+            size_type fairShare = std::max<size_type>(remaining / m_concurrency, 1);
+
+            float cost = m_itemCost.load(std::memory_order_relaxed);
+            if (cost <= 0.f) // Nothing measured yet, start with a few jobs per worker to get a measurement.
+                return std::max<size_type>((m_stop - m_start) / (m_concurrency * 8), 1);
+
+            size_type grain = static_cast<size_type>(range_job_target_duration_ns / cost);
+            return std::clamp<size_type>(grain, 1, fairShare); // Never take more than a fair share of the remaining work so all workers finish around the same time.
+        }
+
+    public:
+        range_job_pool(size_type start, size_type stop, size_type grain, size_type concurrency, const Func& func)
+            : job_pool_base(stop - start), m_next(start), m_start(start), m_stop(stop), m_grain(grain), m_concurrency(std::max<size_type>(concurrency, 1)), m_func(func) {}
+
+        virtual bool pop_job(job_range& range) override
+        {
+            size_type grain = m_grain ? m_grain : adaptive_grain(m_next.load(std::memory_order_relaxed));
+
+            size_type start = m_next.fetch_add(grain, std::memory_order_acquire);
+            if (start >= m_stop)
+                return false;
+
+            range = { start, std::min(start + grain, m_stop) };
+            return true;
+        }
+
+        virtual void execute_job(const job_range& range) override
+        {
+            this_job::m_id = range.start;
+
+            if (m_grain)
+            {
+                std::invoke(m_func, range);
+                return;
+            }
+
+            auto begin = std::chrono::high_resolution_clock::now();
+            std::invoke(m_func, range);
+            float duration = std::chrono::duration<float, std::nano>(std::chrono::high_resolution_clock::now() - begin).count();
 
-            size_type id = m_jobs.size() - idx;
-            this_job::m_id = id;
-            return &m_jobs[idx - 1];
+            // Is fine because concurrent updates only lose a sample of a running average.
+            float sample = duration / static_cast<float>(range.size());
+            float cost = m_itemCost.load(std::memory_order_relaxed);
+            m_itemCost.store(cost > 0.f ? cost * 0.75f + sample * 0.25f : sample, std::memory_order_relaxed);
         }
 
         virtual bool empty() const noexcept override
         {
-            size_type idx = m_index.load(std::memory_order_relaxed);
-            return idx < 1 || idx > m_jobs.size();
+            return m_next.load(std::memory_order_relaxed) >= m_stop;
         }
     };
 }
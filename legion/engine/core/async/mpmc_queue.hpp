@@ -0,0 +1,122 @@
+#pragma once
+#include <core/types/primitives.hpp>
+#include <core/platform/platform.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @file mpmc_queue.hpp
+ */
+
+namespace legion::core::async
+{
+    /**@class mpmc_queue
+     * @brief Bounded lock-free multi-producer multi-consumer FIFO queue of pointers.
+     *        Every slot carries a sequence number that tells producers and consumers whose turn it is, so neither side ever has to lock.
+     * @tparam T Type of the objects pointed to, the queue never takes ownership.
+     */
+    template<typename T>
+    class mpmc_queue
+    {
+    private:
+        struct slot
+        {
+            std::atomic<size_type> sequence;
+            T* item;
+        };
+
+        const size_type m_mask;
+        std::unique_ptr<slot[]> m_slots;
+
+        // Producers and consumers live on separate cache lines so they don't invalidate each other.
+        alignas(64) std::atomic<size_type> m_enqueuePos{ 0 };
+        alignas(64) std::atomic<size_type> m_dequeuePos{ 0 };
+
+        static size_type round_capacity(size_type capacity) noexcept
+        {
+            size_type cap = 2;
+            while (cap < capacity)
+                cap <<= 1;
+            return cap;
+        }
+
+    public:
+        explicit mpmc_queue(size_type capacity = 4096) : m_mask(round_capacity(capacity) - 1), m_slots(new slot[m_mask + 1])
+        {
+            for (size_type i = 0; i <= m_mask; i++)
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        mpmc_queue(const mpmc_queue&) = delete;
+        mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+        /**@brief Try to push an item to the back of the queue.
+         * @return bool False if the queue was full.
+         */
+        L_NODISCARD bool try_push(T* item) noexcept
+        {
+            size_type pos = m_enqueuePos.load(std::memory_order_relaxed);
+            slot* target;
+
+            while (true)
+            {
+                target = &m_slots[pos & m_mask];
+                size_type sequence = target->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+                if (diff == 0)
+                {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0) // Slot still holds an item from the previous lap.
+                    return false;
+                else
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+
+            target->item = item;
+            target->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**@brief Try to pop an item from the front of the queue.
+         * @return T* Item or nullptr if the queue was empty.
+         */
+        L_NODISCARD T* try_pop() noexcept
+        {
+            size_type pos = m_dequeuePos.load(std::memory_order_relaxed);
+            slot* target;
+
+            while (true)
+            {
+                target = &m_slots[pos & m_mask];
+                size_type sequence = target->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+
+                if (diff == 0)
+                {
+                    if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0) // Slot hasn't been filled yet.
+                    return nullptr;
+                else
+                    pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+
+            T* item = target->item;
+            target->sequence.store(pos + m_mask + 1, std::memory_order_release);
+            return item;
+        }
+
+        /**@brief Check whether the queue is empty, the result might be outdated immediately.
+         */
+        L_NODISCARD bool empty() const noexcept
+        {
+            return m_dequeuePos.load(std::memory_order_relaxed) >= m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    };
+}
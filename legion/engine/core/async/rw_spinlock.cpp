@@ -7,9 +7,129 @@ namespace legion::core::async
     bool rw_spinlock::m_forceRelease = false;
     std::atomic_uint rw_spinlock::m_lastId = { 1 };
 
-    thread_local std::unordered_map<uint, int> rw_spinlock::m_localWriters;
-    thread_local std::unordered_map<uint, int> rw_spinlock::m_localReaders;
-    thread_local std::unordered_map<uint, lock_state> rw_spinlock::m_localState;
+    thread_local std::vector<rw_spinlock::local_record> rw_spinlock::m_localRecords;
+
+    void adaptive_backoff(uint& attempt, wait_priority priority) noexcept
+    {
+        constexpr uint spin_attempts = 8;   // Up to 2^8 pause instructions per attempt.
+        constexpr uint yield_attempts = 64;
+        constexpr auto sleep_period = std::chrono::microseconds(50);
+
+        if (priority == wait_priority::sleep)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(1));
+            return;
+        }
+
+        if (attempt < spin_attempts)
+        {
+            for (uint i = 0; i < (1u << attempt); i++)
+                L_PAUSE_INSTRUCTION();
+        }
+        else if (attempt < yield_attempts || priority == wait_priority::real_time)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            // The lock is heavily contended or held for a long time, sleep instead of burning the core. Nothing wakes us early, see the header.
+            std::this_thread::sleep_for(sleep_period);
+        }
+
+        if (attempt < yield_attempts)
+            attempt++;
+    }
+
+    void fast_rw_spinlock::lock(lock_state permissionLevel, wait_priority priority) const noexcept
+    {
+        uint attempt = 0;
+        int state;
+
+        switch (permissionLevel)
+        {
+        case lock_state::read:
+            while (true)
+            {
+                // Wait for both active and waiting writers, otherwise a steady stream of readers could keep writers out forever.
+                while ((state = m_lockState.load(std::memory_order_relaxed)) == (int)lock_state::write || m_waitingWriters.load(std::memory_order_relaxed))
+                    adaptive_backoff(attempt, priority);
+
+                if (m_lockState.compare_exchange_weak(state, state + (int)lock_state::read, std::memory_order_acquire, std::memory_order_relaxed))
+                    return;
+            }
+        case lock_state::write:
+            m_waitingWriters.fetch_add(1, std::memory_order_relaxed);
+            while (true)
+            {
+                while ((state = m_lockState.load(std::memory_order_relaxed)) != (int)lock_state::idle)
+                    adaptive_backoff(attempt, priority);
+
+                if (m_lockState.compare_exchange_weak(state, (int)lock_state::write, std::memory_order_acquire, std::memory_order_relaxed))
+                    break;
+            }
+            m_waitingWriters.fetch_sub(1, std::memory_order_relaxed);
+            return;
+        default:
+            return;
+        }
+    }
+
+    bool fast_rw_spinlock::try_lock(lock_state permissionLevel) const noexcept
+    {
+        int state = m_lockState.load(std::memory_order_relaxed);
+
+        switch (permissionLevel)
+        {
+        case lock_state::read:
+            return state != (int)lock_state::write && m_lockState.compare_exchange_strong(state, state + (int)lock_state::read, std::memory_order_acquire, std::memory_order_relaxed);
+        case lock_state::write:
+            return state == (int)lock_state::idle && m_lockState.compare_exchange_strong(state, (int)lock_state::write, std::memory_order_acquire, std::memory_order_relaxed);
+        default:
+            return false;
+        }
+    }
+
+    void fast_rw_spinlock::unlock(lock_state permissionLevel) const noexcept
+    {
+        switch (permissionLevel)
+        {
+        case lock_state::read:
+            m_lockState.fetch_sub((int)lock_state::read, std::memory_order_release);
+            return;
+        case lock_state::write:
+            m_lockState.store((int)lock_state::idle, std::memory_order_release);
+            return;
+        default:
+            return;
+        }
+    }
+
+    rw_spinlock::local_record* rw_spinlock::find_record() const noexcept
+    {
+        for (auto& record : m_localRecords)
+            if (record.id == m_id)
+                return &record;
+        return nullptr;
+    }
+
+    rw_spinlock::local_record& rw_spinlock::get_record() const
+    {
+        if (local_record* record = find_record())
+            return *record;
+
+        return m_localRecords.emplace_back(local_record{ m_id, 0, 0, lock_state::idle });
+    }
+
+    void rw_spinlock::remove_record() const noexcept
+    {
+        for (size_type i = 0; i < m_localRecords.size(); i++)
+            if (m_localRecords[i].id == m_id)
+            {
+                m_localRecords[i] = m_localRecords.back();
+                m_localRecords.pop_back();
+                return;
+            }
+    }
 
     void rw_spinlock::read_lock(wait_priority priority) const
     {
@@ -17,13 +137,16 @@ namespace legion::core::async
         if (m_forceRelease)
             return;
 
-        if (m_localState.at(m_id) != lock_state::idle) // If we're either already reading or writing then the lock doesn't need to be reacquired.
+        local_record& record = get_record();
+
+        if (record.state != lock_state::idle) // If we're either already reading or writing then the lock doesn't need to be reacquired.
         {
             // Report another local reader to the lock.
-            m_localReaders.at(m_id)++;
+            record.readers++;
             return;
         }
 
+        uint attempt = 0;
         int state;
 
         while (true)
@@ -32,20 +155,7 @@ namespace legion::core::async
             while ((state = m_lockState.load(std::memory_order_relaxed)) == (int)lock_state::write)
             {
                 OPTICK_EVENT("Acquire read lock");
-
-                switch (priority)
-                {
-                case wait_priority::sleep:
-                    std::this_thread::sleep_for(std::chrono::microseconds(1));
-                    break;
-                case wait_priority::normal:
-                    std::this_thread::yield();
-                    break;
-                case wait_priority::real_time:
-                default:
-                    L_PAUSE_INSTRUCTION();
-                    break;
-                }
+                adaptive_backoff(attempt, priority);
             }
 
             // Try to add a reader to the lock state. If the lock succeeded then we can continue.
@@ -54,8 +164,8 @@ namespace legion::core::async
         }
 
         // Report another reader to the lock.
-        m_localReaders.at(m_id)++;
-        m_localState.at(m_id) = lock_state::read; // Set thread_local state to read.
+        record.readers++;
+        record.state = lock_state::read; // Set thread_local state to read.
     }
 
     bool rw_spinlock::read_try_lock() const
@@ -64,23 +174,27 @@ namespace legion::core::async
         if (m_forceRelease)
             return true;
 
-        if (m_localState.at(m_id) != lock_state::idle) // If we're either already reading or writing then the lock doesn't need to be reacquired.
+        local_record& record = get_record();
+
+        if (record.state != lock_state::idle) // If we're either already reading or writing then the lock doesn't need to be reacquired.
         {
             // Report another local reader to the lock.
-            m_localReaders.at(m_id)++;
+            record.readers++;
             return true;
         }
 
-        // Expect idle as default.
         int state;
 
         if ((state = m_lockState.load(std::memory_order_relaxed)) == (int)lock_state::write || // Check if we can lock at all first to reduce LSU abuse on SMT CPUs if this occurs in a try_lock loop.
             !m_lockState.compare_exchange_strong(state, state + (int)lock_state::read, std::memory_order_acquire, std::memory_order_relaxed)) // Try to add a reader to the lock state.
+        {
+            remove_record();
             return false;
+        }
 
         // Report another reader to the lock.
-        m_localReaders.at(m_id)++;
-        m_localState.at(m_id) = lock_state::read; // Set thread_local state to read.
+        record.readers++;
+        record.state = lock_state::read; // Set thread_local state to read.
         return true;
     }
 
@@ -90,17 +204,20 @@ namespace legion::core::async
         if (m_forceRelease)
             return;
 
-        if (m_localState.at(m_id) == lock_state::read) // If we're currently only acquired for read we need to stop reading before requesting rw.
+        local_record& record = get_record();
+
+        if (record.state == lock_state::read) // If we're currently only acquired for read we need to stop reading before requesting rw.
         {
-            read_unlock();
-            m_localReaders.at(m_id)++;
+            m_lockState.fetch_sub((int)lock_state::read, std::memory_order_release);
+            record.state = lock_state::idle;
         }
-        else if (m_localState.at(m_id) == lock_state::write) // If we're already writing then we don't need to reacquire the lock.
+        else if (record.state == lock_state::write) // If we're already writing then we don't need to reacquire the lock.
         {
-            m_localWriters.at(m_id)++;
+            record.writers++;
             return;
         }
 
+        uint attempt = 0;
         int state;
 
         while (true)
@@ -109,20 +226,7 @@ namespace legion::core::async
             while ((state = m_lockState.load(std::memory_order_relaxed)) != (int)lock_state::idle)
             {
                 OPTICK_EVENT("Acquire write lock");
-
-                switch (priority)
-                {
-                case wait_priority::sleep:
-                    std::this_thread::sleep_for(std::chrono::microseconds(1));
-                    break;
-                case wait_priority::normal:
-                    std::this_thread::yield();
-                    break;
-                case wait_priority::real_time:
-                default:
-                    L_PAUSE_INSTRUCTION();
-                    break;
-                }
+                adaptive_backoff(attempt, priority);
             }
 
             // Try to set the lock state to write. If the lock succeeded then we can continue.
@@ -130,10 +234,9 @@ namespace legion::core::async
                 break;
         }
 
-
         m_writer = std::this_thread::get_id();
-        m_localWriters.at(m_id)++;
-        m_localState.at(m_id) = lock_state::write; // Set thread_local state to write.
+        record.writers++;
+        record.state = lock_state::write; // Set thread_local state to write.
     }
 
     bool rw_spinlock::write_try_lock() const
@@ -142,36 +245,45 @@ namespace legion::core::async
         if (m_forceRelease)
             return true;
 
+        local_record& record = get_record();
+
         bool relock = false;
-        if (m_localState.at(m_id) == lock_state::read) // If we're currently only acquired for read we need to stop reading before requesting rw.
+        if (record.state == lock_state::read) // If we're currently only acquired for read we need to stop reading before requesting rw.
         {
             relock = true;
-            read_unlock();
-            m_localReaders.at(m_id)++;
+            m_lockState.fetch_sub((int)lock_state::read, std::memory_order_release);
+            record.state = lock_state::idle;
         }
-        else if (m_localState.at(m_id) == lock_state::write) // If we're already writing then we don't need to reacquire the lock.
+        else if (record.state == lock_state::write) // If we're already writing then we don't need to reacquire the lock.
         {
-            m_localWriters.at(m_id)++;
+            record.writers++;
             return true;
         }
 
-        // Expect idle as default.
-        int state = (int)lock_state::idle;
+        int state;
 
         if ((state = m_lockState.load(std::memory_order_relaxed)) != (int)lock_state::idle || // Check if we can lock at all first to reduce LSU abuse on SMT CPUs if this occurs in a try_lock loop.
             !m_lockState.compare_exchange_strong(state, (int)lock_state::write, std::memory_order_acquire, std::memory_order_relaxed)) // Try to set the lock state to write.
         {
-            if (relock)
+            if (relock) // Get our read permission back.
+            {
+                uint attempt = 0;
+                while ((state = m_lockState.load(std::memory_order_relaxed)) == (int)lock_state::write ||
+                    !m_lockState.compare_exchange_weak(state, state + (int)lock_state::read, std::memory_order_acquire, std::memory_order_relaxed))
+                    adaptive_backoff(attempt, wait_priority::real_time);
+
+                record.state = lock_state::read;
+            }
+            else
             {
-                m_localReaders.at(m_id)--;
-                read_lock();
+                remove_record();
             }
             return false;
         }
 
         m_writer = std::this_thread::get_id();
-        m_localWriters.at(m_id)++;
-        m_localState.at(m_id) = lock_state::write; // Set thread_local state to write.
+        record.writers++;
+        record.state = lock_state::write; // Set thread_local state to write.
         return true;
     }
 
@@ -181,17 +293,17 @@ namespace legion::core::async
         if (m_forceRelease)
             return;
 
-        auto& localReaders = m_localReaders.at(m_id);
-        localReaders--;
+        local_record* record = find_record();
+        if (!record)
+            return;
 
-        if (localReaders > 0 || m_localWriters.at(m_id) > 0) // Another local guard is still alive that will unlock the lock for this thread.
-        {
+        record->readers--;
+
+        if (record->readers > 0 || record->writers > 0) // Another local guard is still alive that will unlock the lock for this thread.
             return;
-        }
 
         m_lockState.fetch_sub((int)lock_state::read, std::memory_order_release);
-
-        m_localState.at(m_id) = lock_state::idle; // Set thread_local state to idle.
+        remove_record(); // Thread is idle on this lock.
     }
 
     void rw_spinlock::write_unlock() const
@@ -200,22 +312,25 @@ namespace legion::core::async
         if (m_forceRelease)
             return;
 
-        auto& localWriters = m_localWriters.at(m_id);
-        localWriters--;
+        local_record* record = find_record();
+        if (!record)
+            return;
+
+        record->writers--;
 
-        if (localWriters > 0) // Another local guard is still alive that will unlock the lock for this thread.
+        if (record->writers > 0) // Another local guard is still alive that will unlock the lock for this thread.
         {
             return;
         }
-        else if (m_localReaders.at(m_id) > 0)
+        else if (record->readers > 0)
         {
             m_lockState.store((int)lock_state::read, std::memory_order_release);
-            m_localState.at(m_id) = lock_state::read; // Set thread_local state to idle.
+            record->state = lock_state::read; // Return to read state.
             return;
         }
 
         m_lockState.store((int)lock_state::idle, std::memory_order_release);
-        m_localState.at(m_id) = lock_state::idle; // Set thread_local state to idle.
+        remove_record(); // Thread is idle on this lock.
     }
 
     void rw_spinlock::force_release(bool release)
@@ -248,13 +363,6 @@ namespace legion::core::async
         if (m_forceRelease)
             return;
 
-        if (!m_localState.count(m_id))
-        {
-            m_localWriters.emplace(m_id, 0);
-            m_localReaders.emplace(m_id, 0);
-            m_localState.emplace(m_id, lock_state_idle);
-        }
-
         switch (permissionLevel)
         {
         case lock_state::read:
@@ -272,13 +380,6 @@ namespace legion::core::async
         if (m_forceRelease)
             return true;
 
-        if (!m_localState.count(m_id))
-        {
-            m_localWriters.emplace(m_id, 0);
-            m_localReaders.emplace(m_id, 0);
-            m_localState.emplace(m_id, lock_state_idle);
-        }
-
         switch (permissionLevel)
         {
         case lock_state::read:
@@ -5,6 +5,7 @@
 #include <array>
 #include <thread>
 #include <functional>
+#include <vector>
 #include <core/types/primitives.hpp>
 #include <core/platform/platform.hpp>
 #include <core/containers/sparse_set.hpp>
@@ -23,8 +24,54 @@ namespace legion::core::async
     inline constexpr lock_state lock_state_read = lock_state::read;
     inline constexpr lock_state lock_state_write = lock_state::write;
 
+    /**@brief Adaptive back-off used by the spinlocks while they wait for a lock to become available.
+     *        Spins with an exponentially growing amount of pause instructions first, then yields and finally falls back to short fixed sleeps.
+     * @note The sleeps are a plain timed back-off, unlocking doesn't wake sleeping threads. This keeps unlocking a single atomic operation,
+     *       at the cost of a thread possibly oversleeping a release by up to one sleep period under heavy contention.
+     * @param attempt Amount of times the caller has already waited, gets incremented.
+     * @param priority Real-time never sleeps, sleep skips straight to sleeping.
+     */
+    void adaptive_backoff(uint& attempt, wait_priority priority) noexcept;
+
+    /**@class fast_rw_spinlock
+     * @brief Non-reentrant reader-writer spinlock without any per-thread bookkeeping, locking is a single atomic operation in the uncontended case.
+     * @note Locking the same fast_rw_spinlock twice from the same thread, or upgrading from read to write, deadlocks. Use rw_spinlock if reentrancy is needed.
+     * @note Waiting writers block new readers to prevent writer starvation.
+     */
+    struct fast_rw_spinlock final
+    {
+    private:
+        // State of the lock. -1 means that a thread has write permission. 0 means that the lock is unlocked. 1+ means that there are N amount of readers.
+        mutable std::atomic_int m_lockState = { 0 };
+        mutable std::atomic_int m_waitingWriters = { 0 };
+
+    public:
+        fast_rw_spinlock() = default;
+
+        fast_rw_spinlock(const fast_rw_spinlock&) = delete;
+        fast_rw_spinlock& operator=(const fast_rw_spinlock&) = delete;
+
+        /**@brief Lock for a certain permission level. (locking for idle does nothing)
+         */
+        void lock(lock_state permissionLevel = lock_state::write, wait_priority priority = wait_priority::real_time) const noexcept;
+
+        /**@brief Try to lock for a certain permission level. (locking for idle does nothing)
+         * @return bool True when locked.
+         */
+        L_NODISCARD bool try_lock(lock_state permissionLevel = lock_state::write) const noexcept;
+
+        /**@brief Unlock from a certain permission level.
+         */
+        void unlock(lock_state permissionLevel = lock_state::write) const noexcept;
+
+        void lock_shared() const noexcept { lock(lock_state::read); }
+        L_NODISCARD bool try_lock_shared() const noexcept { return try_lock(lock_state::read); }
+        void unlock_shared() const noexcept { unlock(lock_state::read); }
+    };
+
     /**@class rw_spinlock
-     * @brief Lock used with ::async::readonly_guard and ::async::readwrite_guard.
+     * @brief Reentrant lock used with ::async::readonly_guard and ::async::readwrite_guard.
+     * @note Reentrancy costs a scan over the locks the calling thread currently holds, use fast_rw_spinlock for locks that are never taken recursively.
      * @note Read-only operations can happen simultaneously without waiting for each other.
      *		 Read-only operations will only wait for Read-Write operations to be finished.
      * @note Read-Write operations cannot happen simultaneously and will wait for each other.
@@ -41,9 +88,21 @@ namespace legion::core::async
         static bool m_forceRelease;
         static std::atomic_uint m_lastId;
 
-        static thread_local std::unordered_map<uint, int> m_localWriters;
-        static thread_local std::unordered_map<uint, int> m_localReaders;
-        static thread_local std::unordered_map<uint, lock_state> m_localState;
+        // Bookkeeping of a single lock held by this thread.
+        struct local_record
+        {
+            uint id;
+            int readers;
+            int writers;
+            lock_state state;
+        };
+
+        // Only the locks the thread currently holds have a record, so lookups are a short linear scan instead of a hash lookup.
+        static thread_local std::vector<local_record> m_localRecords;
+
+        local_record* find_record() const noexcept;
+        local_record& get_record() const;
+        void remove_record() const noexcept;
 
         uint m_id = m_lastId.fetch_add(1, std::memory_order_relaxed);
         // State of the lock. -1 means that a thread has write permission. 0 means that the lock is unlocked. 1+ means that there are N amount of readers.
@@ -123,20 +182,21 @@ namespace legion::core::async
     };
 
     /**@class readonly_guard
-     * @brief RAII guard that uses ::async::rw_spinlock to lock for read-only.
+     * @brief RAII guard that uses ::async::rw_spinlock or ::async::fast_rw_spinlock to lock for read-only.
      * @note Read-only operations can happen simultaneously without waiting for each other.
      *		 Read-only operations will only wait for Read-Write operations to be finished.
      * @ref legion::core::async::rw_spinlock
      */
+    template<typename lock_type = rw_spinlock>
     class readonly_guard final
     {
     private:
-        const rw_spinlock& m_lock;
+        const lock_type& m_lock;
 
     public:
         /**@brief Creates readonly guard and locks for Read-only.
          */
-        readonly_guard(const rw_spinlock& lock, wait_priority priority = wait_priority::real_time) : m_lock(lock)
+        readonly_guard(const lock_type& lock, wait_priority priority = wait_priority::real_time) : m_lock(lock)
         {
             m_lock.lock(lock_state::read, priority);
         }
@@ -184,11 +244,11 @@ namespace legion::core::async
                 lastLocked = -1;
 
                 // Try to lock all locks.
-                for (int i = 0; i < m_locks.size(); i++)
+                for (size_type i = 0; i < m_locks.size(); i++)
                 {
                     if (m_locks[i]->try_lock(lock_state::read))
                     {
-                        lastLocked = i;
+                        lastLocked = static_cast<int>(i);
                     }
                     else
                     {
@@ -217,20 +277,21 @@ namespace legion::core::async
     readonly_multiguard(types...)->readonly_multiguard<sizeof...(types)>;
 #endif
     /**@class readwrite_guard
-     * @brief RAII guard that uses ::async::rw_spinlock to lock for read-write.
+     * @brief RAII guard that uses ::async::rw_spinlock or ::async::fast_rw_spinlock to lock for read-write.
      * @note Read-Write operations cannot happen simultaneously and will wait for each other.
      *		 Read-Write operations will also wait for any Read-only operations to be finished.
      * @ref legion::core::async::rw_spinlock
      */
+    template<typename lock_type = rw_spinlock>
     class readwrite_guard final
     {
     private:
-        const rw_spinlock& m_lock;
+        const lock_type& m_lock;
 
     public:
         /**@brief Creates read-write guard and locks for Read-Write.
          */
-        readwrite_guard(const rw_spinlock& lock, wait_priority priority = wait_priority::real_time) : m_lock(lock)
+        readwrite_guard(const lock_type& lock, wait_priority priority = wait_priority::real_time) : m_lock(lock)
         {
             m_lock.lock(lock_state::write, priority);
         }
@@ -279,11 +340,11 @@ namespace legion::core::async
                 lastLocked = -1;
 
                 // Try to lock all locks.
-                for (int i = 0; i < m_locks.size(); i++)
+                for (size_type i = 0; i < m_locks.size(); i++)
                 {
                     if (m_locks[i]->try_lock(lock_state::write))
                     {
-                        lastLocked = i;
+                        lastLocked = static_cast<int>(i);
                     }
                     else
                     {
@@ -364,11 +425,11 @@ namespace legion::core::async
                 lastLocked = -1;
 
                 // Try to lock all locks.
-                for (int i = 0; i < m_locks.size(); i++)
+                for (size_type i = 0; i < m_locks.size(); i++)
                 {
                     if (m_locks[i]->try_lock(m_states[i]))
                     {
-                        lastLocked = i;
+                        lastLocked = static_cast<int>(i);
                     }
                     else
                     {
@@ -386,7 +447,7 @@ namespace legion::core::async
          */
         ~mixed_multiguard()
         {
-            for (int i = 0; i < m_locks.size(); i++)
+            for (size_type i = 0; i < m_locks.size(); i++)
                 m_locks[i]->unlock(m_states[i]);
         }
 
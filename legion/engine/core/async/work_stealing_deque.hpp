@@ -0,0 +1,143 @@
+#pragma once
+#include <core/types/primitives.hpp>
+#include <core/platform/platform.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * @file work_stealing_deque.hpp
+ */
+
+namespace legion::core::async
+{
+    /**@class work_stealing_deque
+     * @brief Lock-free Chase-Lev deque of pointers.
+     *        The owning thread pushes and pops at the bottom (LIFO), any other thread can steal from the top (FIFO).
+     * @tparam T Type of the objects pointed to, the deque never takes ownership.
+     * @note push and pop may only be called by the owning thread, steal and empty can be called from any thread.
+     */
+    template<typename T>
+    class work_stealing_deque
+    {
+    private:
+        struct ring_buffer
+        {
+            const size_type capacity;
+            const size_type mask;
+            std::unique_ptr<std::atomic<T*>[]> items;
+
+            explicit ring_buffer(size_type cap) : capacity(cap), mask(cap - 1), items(new std::atomic<T*>[cap]) {}
+
+            T* get(int64 index) const noexcept { return items[static_cast<size_type>(index) & mask].load(std::memory_order_relaxed); }
+            void put(int64 index, T* item) noexcept { items[static_cast<size_type>(index) & mask].store(item, std::memory_order_relaxed); }
+
+            std::unique_ptr<ring_buffer> grow(int64 bottom, int64 top) const
+            {
+                auto buffer = std::make_unique<ring_buffer>(capacity * 2);
+                for (int64 i = top; i != bottom; i++)
+                    buffer->put(i, get(i));
+                return buffer;
+            }
+        };
+
+        // Top and bottom live on separate cache lines so thieves and the owner don't invalidate each other.
+        alignas(64) std::atomic<int64> m_top{ 0 };
+        alignas(64) std::atomic<int64> m_bottom{ 0 };
+        alignas(64) std::atomic<ring_buffer*> m_buffer;
+
+        // Thieves might still be reading from old buffers, so they only get cleaned up together with the deque.
+        std::vector<std::unique_ptr<ring_buffer>> m_buffers;
+
+    public:
+        explicit work_stealing_deque(size_type capacity = 256)
+        {
+            size_type cap = 1;
+            while (cap < capacity)
+                cap <<= 1;
+
+            m_buffers.push_back(std::make_unique<ring_buffer>(cap));
+            m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+        }
+
+        work_stealing_deque(const work_stealing_deque&) = delete;
+        work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+        /**@brief Push an item to the bottom of the deque, grows the deque if needed.
+         * @note Owner thread only.
+         */
+        void push(T* item)
+        {
+            int64 bottom = m_bottom.load(std::memory_order_relaxed);
+            int64 top = m_top.load(std::memory_order_acquire);
+            ring_buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+            if (bottom - top > static_cast<int64>(buffer->capacity) - 1)
+            {
+                m_buffers.push_back(buffer->grow(bottom, top));
+                buffer = m_buffers.back().get();
+                m_buffer.store(buffer, std::memory_order_release);
+            }
+
+            buffer->put(bottom, item);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        /**@brief Pop the most recently pushed item from the bottom of the deque.
+         * @note Owner thread only.
+         * @return T* Item or nullptr if the deque was empty.
+         */
+        L_NODISCARD T* pop() noexcept
+        {
+            int64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            ring_buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+            m_bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64 top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom) // Empty.
+            {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            T* item = buffer->get(bottom);
+            if (top == bottom) // Last item, race against thieves for it.
+            {
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    item = nullptr;
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+
+            return item;
+        }
+
+        /**@brief Steal the oldest item from the top of the deque.
+         * @return T* Item or nullptr if the deque was empty or another thread won the race for the item.
+         */
+        L_NODISCARD T* steal() noexcept
+        {
+            int64 top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64 bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+                return nullptr;
+
+            T* item = m_buffer.load(std::memory_order_consume)->get(top);
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+
+            return item;
+        }
+
+        /**@brief Check whether the deque is empty, the result might be outdated immediately.
+         */
+        L_NODISCARD bool empty() const noexcept
+        {
+            return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+        }
+    };
+}
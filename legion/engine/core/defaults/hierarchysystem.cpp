@@ -8,12 +8,13 @@ void legion::core::HierarchySystem::onPositionModified(events::component_modific
 
     position diff = event->newValue - event->oldValue;
     auto children = event->entity.children();
+    size_type count = children.size();
 
-    m_scheduler->queueJobs(children.size(), [&]()
+    updateChildren(count, [&children, diff](size_type i)
         {
-            auto& child = children[async::this_job::get_id()];
+            ecs::entity_handle child = children[i];
             child.write_component<position>(child.read_component<position>() + diff);
-        }).wait();
+        });
 }
 
 void legion::core::HierarchySystem::onRotationModified(events::component_modification<rotation>* event)
@@ -25,12 +26,14 @@ void legion::core::HierarchySystem::onRotationModified(events::component_modific
     rotation diff = event->newValue * math::inverse(event->oldValue);
     position pos = event->entity.read_component<position>();
     auto children = event->entity.children();
-    m_scheduler->queueJobs(children.size(), [&]()
+    size_type count = children.size();
+
+    updateChildren(count, [&children, diff, pos](size_type i)
         {
-            auto& child = children[async::this_job::get_id()];
+            ecs::entity_handle child = children[i];
             child.write_component<position>(pos + (math::toMat3(diff) * (child.read_component<position>() - pos)));
             child.write_component<rotation>(diff * child.read_component<rotation>());
-        }).wait();
+        });
 }
 
 void legion::core::HierarchySystem::onScaleModified(events::component_modification<scale>* event)
@@ -42,12 +45,14 @@ void legion::core::HierarchySystem::onScaleModified(events::component_modificati
     scale diff = event->newValue / event->oldValue;
     position pos = event->entity.read_component<position>();
     auto children = event->entity.children();
-    m_scheduler->queueJobs(children.size(), [&]()
+    size_type count = children.size();
+
+    updateChildren(count, [&children, diff, pos](size_type i)
         {
-            auto& child = children[async::this_job::get_id()];
+            ecs::entity_handle child = children[i];
             child.write_component<position>(pos + (diff * (child.read_component<position>() - pos)));
             child.write_component<scale>(child.read_component<scale>() * diff);
-        }).wait();
+        });
 }
 
 void legion::core::HierarchySystem::onPositionBulkModified(events::bulk_component_modification<position>* event)
@@ -68,35 +73,36 @@ void legion::core::HierarchySystem::onPositionBulkModified(events::bulk_componen
     std::vector<ecs::entity_set> children;
     children.resize(count);
 
-    m_scheduler->queueJobs(count, [&]()
+    m_scheduler->queueRangeJobs(0, count, 0, [&](const async::job_range& range)
         {
-            auto i = async::this_job::get_id();
-            if (entities[i].has_component<hierarchy>())
+            for (size_type i : range)
             {
-                children[i] = entities[i].read_component<hierarchy>().children;
-                hasChildren[i] = children[i].size() > 0;
-            }
-            else
-                hasChildren[i] = false;
-        }).then(count, [&]()
-            {
-                auto i = async::this_job::get_id();
+                if (entities[i].has_component<hierarchy>())
+                {
+                    children[i] = entities[i].read_component<hierarchy>().children;
+                    hasChildren[i] = children[i].size() > 0;
+                }
+                else
+                    hasChildren[i] = false;
+
                 if (hasChildren[i])
                     diffs[i] = newValues[i] - oldValues[i];
-            }).wait();
+            }
+        }).wait();
 
-        for (int i = 0; i < count; i++)
-        {
-            OPTICK_EVENT("Update child");
-            if (!hasChildren[i])
-                continue;
+    // Update all children in a single pool instead of waiting for a separate pool per parent.
+    std::vector<std::pair<ecs::entity_handle, size_type>> targets;
+    for (size_type i = 0; i < count; i++)
+        if (hasChildren[i])
+            for (auto& child : children[i])
+                targets.emplace_back(child, i);
 
-            m_scheduler->queueJobs(children[i].size(), [&]()
-                {
-                    auto& child = children[i][async::this_job::get_id()];
-                    child.write_component<position>(child.read_component<position>() + diffs[i]);
-                }).wait();
-        }
+    size_type targetCount = targets.size();
+    updateChildren(targetCount, [&targets, &diffs](size_type target)
+        {
+            auto [child, i] = targets[target];
+            child.write_component<position>(child.read_component<position>() + diffs[i]);
+        });
 }
 
 void legion::core::HierarchySystem::onRotationBulkModified(events::bulk_component_modification<rotation>* event)
@@ -117,38 +123,43 @@ void legion::core::HierarchySystem::onRotationBulkModified(events::bulk_componen
     std::vector<ecs::entity_set> children;
     children.resize(count);
 
-    m_scheduler->queueJobs(count, [&]()
+    m_scheduler->queueRangeJobs(0, count, 0, [&](const async::job_range& range)
         {
-            auto i = async::this_job::get_id();
-            if (entities[i].has_component<hierarchy>())
+            for (size_type i : range)
             {
-                children[i] = entities[i].read_component<hierarchy>().children;
-                hasChildren[i] = children[i].size() > 0;
-            }
-            else
-                hasChildren[i] = false;
-        }).then(count, [&]()
-            {
-                auto i = async::this_job::get_id();
+                if (entities[i].has_component<hierarchy>())
+                {
+                    children[i] = entities[i].read_component<hierarchy>().children;
+                    hasChildren[i] = children[i].size() > 0;
+                }
+                else
+                    hasChildren[i] = false;
+
                 if (hasChildren[i])
                     diffs[i] = newValues[i] * math::inverse(oldValues[i]);
-            }).wait();
+            }
+        }).wait();
 
-        for (int i = 0; i < count; i++)
+    // Update all children in a single pool instead of waiting for a separate pool per parent.
+    std::vector<std::pair<ecs::entity_handle, size_type>> targets;
+    std::vector<position> positions;
+    positions.resize(count);
+    for (size_type i = 0; i < count; i++)
+        if (hasChildren[i])
         {
-            OPTICK_EVENT("Update child");
-            if (!hasChildren[i])
-                continue;
-
-            position pos = entities[i].read_component<position>();
-
-            m_scheduler->queueJobs(children[i].size(), [&]()
-                {
-                    auto& child = children[i][async::this_job::get_id()];
-                    child.write_component<position>(pos + (math::toMat3(diffs[i]) * (child.read_component<position>() - pos)));
-                    child.write_component<rotation>(diffs[i] * child.read_component<rotation>());
-                }).wait();
+            positions[i] = entities[i].read_component<position>();
+            for (auto& child : children[i])
+                targets.emplace_back(child, i);
         }
+
+    size_type targetCount = targets.size();
+    updateChildren(targetCount, [&targets, &diffs, &positions](size_type target)
+        {
+            auto [child, i] = targets[target];
+            const position& pos = positions[i];
+            child.write_component<position>(pos + (math::toMat3(diffs[i]) * (child.read_component<position>() - pos)));
+            child.write_component<rotation>(diffs[i] * child.read_component<rotation>());
+        });
 }
 
 void legion::core::HierarchySystem::onScaleBulkModified(events::bulk_component_modification<scale>* event)
@@ -169,43 +180,52 @@ void legion::core::HierarchySystem::onScaleBulkModified(events::bulk_component_m
     std::vector<ecs::entity_set> children;
     children.resize(count);
 
-    m_scheduler->queueJobs(count, [&]()
+    m_scheduler->queueRangeJobs(0, count, 0, [&](const async::job_range& range)
         {
-            auto i = async::this_job::get_id();
-            if (entities[i].has_component<hierarchy>())
-            {
-                children[i] = entities[i].read_component<hierarchy>().children;
-                hasChildren[i] = children[i].size() > 0;
-            }
-            else
-                hasChildren[i] = false;
-        }).then(count, [&]()
+            for (size_type i : range)
             {
-                auto i = async::this_job::get_id();
+                if (entities[i].has_component<hierarchy>())
+                {
+                    children[i] = entities[i].read_component<hierarchy>().children;
+                    hasChildren[i] = children[i].size() > 0;
+                }
+                else
+                    hasChildren[i] = false;
+
                 if (hasChildren[i])
                     diffs[i] = newValues[i] / oldValues[i];
-            }).wait();
+            }
+        }).wait();
 
-        for (int i = 0; i < count; i++)
+    // Update all children in a single pool instead of waiting for a separate pool per parent.
+    std::vector<std::pair<ecs::entity_handle, size_type>> targets;
+    std::vector<position> positions;
+    positions.resize(count);
+    for (size_type i = 0; i < count; i++)
+        if (hasChildren[i])
         {
-            OPTICK_EVENT("Update child");
-
-            if (!hasChildren[i])
-                continue;
-
-            position pos = entities[i].read_component<position>();
-
-            m_scheduler->queueJobs(children[i].size(), [&]()
-                {
-                    auto& child = children[i][async::this_job::get_id()];
-                    child.write_component<position>(pos + (diffs[i] * (child.read_component<position>() - pos)));
-                    child.write_component<scale>(child.read_component<scale>() * diffs[i]);
-                }).wait();
+            positions[i] = entities[i].read_component<position>();
+            for (auto& child : children[i])
+                targets.emplace_back(child, i);
         }
+
+    size_type targetCount = targets.size();
+    updateChildren(targetCount, [&targets, &diffs, &positions](size_type target)
+        {
+            auto [child, i] = targets[target];
+            const position& pos = positions[i];
+            child.write_component<position>(pos + (diffs[i] * (child.read_component<position>() - pos)));
+            child.write_component<scale>(child.read_component<scale>() * diffs[i]);
+        });
 }
 
 void legion::core::HierarchySystem::setup()
 {
+    // Change events are opt-in, the hierarchy needs them to propagate transform changes to children.
+    m_ecs->setChangeEvents<position>();
+    m_ecs->setChangeEvents<rotation>();
+    m_ecs->setChangeEvents<scale>();
+
     bindToEvent<events::component_modification<position>, &HierarchySystem::onPositionModified>();
     bindToEvent<events::component_modification<rotation>, &HierarchySystem::onRotationModified>();
     bindToEvent<events::component_modification<scale>, &HierarchySystem::onScaleModified>();
@@ -6,6 +6,27 @@ namespace legion::core
 {
     class HierarchySystem : public System<HierarchySystem>
     {
+    private:
+        // Amount of children a single job updates.
+        static constexpr size_type childUpdateGrain = 64;
+
+        /**@brief Call func for every index in [0, count) on the job pool and wait until all of them are done.
+         *        Whoever wrote the parent expects the children to be up to date as soon as the write returns,
+         *        so the update can't be left running in the background. Waiting helps execute the jobs.
+         */
+        template<typename Func>
+        void updateChildren(size_type count, const Func& func)
+        {
+            if (!count)
+                return;
+
+            m_scheduler->queueRangeJobs(0, count, childUpdateGrain, [&](const async::job_range& range)
+                {
+                    for (size_type i : range)
+                        func(i);
+                }).wait();
+        }
+
     public:
         void onPositionModified(events::component_modification<position>* event);
         void onRotationModified(events::component_modification<rotation>* event);
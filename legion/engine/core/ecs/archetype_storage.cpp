@@ -0,0 +1,254 @@
+#include <core/ecs/archetype_storage.hpp>
+#include <algorithm>
+
+namespace legion::core::ecs
+{
+    // Chunks are aligned to cache lines so that the first element of every component array starts on a fresh line.
+    constexpr size_type chunk_alignment = 64;
+
+    archetype_chunk::archetype_chunk(size_type byteSize)
+        : m_data(static_cast<byte*>(::operator new(byteSize, std::align_val_t(chunk_alignment))))
+    {
+    }
+
+    archetype_chunk::~archetype_chunk()
+    {
+        ::operator delete(m_data, std::align_val_t(chunk_alignment));
+    }
+
+    archetype_table::archetype_table(std::vector<const component_type_info*>&& types) : m_types(std::move(types))
+    {
+        std::sort(m_types.begin(), m_types.end(), [](const component_type_info* a, const component_type_info* b) { return a->typeId < b->typeId; });
+
+        size_type rowSize = 0;
+        size_type padding = 0;
+        for (auto* info : m_types)
+        {
+            m_composition.push_back(info->typeId);
+            rowSize += info->size;
+            padding += info->alignment;
+        }
+
+        // Fit as many rows as possible into a single chunk while leaving room for the alignment of every array.
+        m_chunkCapacity = rowSize ? (archetype_chunk_size > padding ? (archetype_chunk_size - padding) / rowSize : 0) : archetype_chunk_size;
+        if (m_chunkCapacity == 0)
+            m_chunkCapacity = 1;
+
+        size_type offset = 0;
+        for (auto* info : m_types)
+        {
+            offset = (offset + info->alignment - 1) / info->alignment * info->alignment;
+            m_offsets.push_back(offset);
+            offset += info->size * m_chunkCapacity;
+        }
+
+        m_chunkBytes = std::max<size_type>(offset, chunk_alignment);
+    }
+
+    archetype_table::~archetype_table()
+    {
+        for (size_type row = 0; row < m_entities.size(); row++)
+            for (size_type column = 0; column < m_types.size(); column++)
+                m_types[column]->destroy(get(row, column));
+    }
+
+    size_type archetype_table::column(id_type typeId) const noexcept
+    {
+        auto itr = std::lower_bound(m_composition.begin(), m_composition.end(), typeId);
+        if (itr == m_composition.end() || *itr != typeId)
+            return npos;
+        return static_cast<size_type>(itr - m_composition.begin());
+    }
+
+    bool archetype_table::contains(const hashed_sparse_set<id_type>& typeIds) const noexcept
+    {
+        for (id_type typeId : typeIds)
+            if (!contains(typeId))
+                return false;
+        return true;
+    }
+
+    size_type archetype_table::chunk_size(size_type chunk) const noexcept
+    {
+        size_type start = chunk * m_chunkCapacity;
+        if (start >= m_entities.size())
+            return 0;
+        return std::min(m_chunkCapacity, m_entities.size() - start);
+    }
+
+    size_type archetype_table::push_back(entity_handle entity)
+    {
+        size_type row = m_entities.size();
+        if (row / m_chunkCapacity >= m_chunks.size())
+            m_chunks.push_back(std::make_unique<archetype_chunk>(m_chunkBytes));
+
+        m_entities.push_back(entity);
+        return row;
+    }
+
+    entity_handle archetype_table::swap_pop(size_type row)
+    {
+        size_type last = m_entities.size() - 1;
+        entity_handle moved;
+
+        if (row != last)
+        {
+            for (size_type column = 0; column < m_types.size(); column++)
+                m_types[column]->relocate(get(row, column), get(last, column));
+
+            moved = m_entities[last];
+            m_entities[row] = moved;
+        }
+
+        m_entities.pop_back();
+
+        // Keep a single spare chunk around to prevent thrashing when an entity moves back and forth around a chunk boundary.
+        while (m_chunks.size() > chunk_count() + 1)
+            m_chunks.pop_back();
+
+        return moved;
+    }
+
+    archetype_table* archetype_storage::get_table(const std::vector<id_type>& composition)
+    {
+        OPTICK_EVENT();
+        auto itr = m_tables.find(composition);
+        if (itr != m_tables.end())
+            return itr->second.get();
+
+        std::vector<const component_type_info*> types;
+        types.reserve(composition.size());
+        for (id_type typeId : composition)
+            types.push_back(&m_typeInfos.at(typeId));
+
+        return m_tables.emplace(composition, std::make_unique<archetype_table>(std::move(types))).first->second.get();
+    }
+
+    archetype_table* archetype_storage::get_add_edge(archetype_table* source, id_type typeId)
+    {
+        if (!source)
+            return get_table({ typeId });
+
+        auto itr = source->m_addEdges.find(typeId);
+        if (itr != source->m_addEdges.end())
+            return itr->second;
+
+        std::vector<id_type> composition = source->m_composition;
+        composition.insert(std::upper_bound(composition.begin(), composition.end(), typeId), typeId);
+
+        archetype_table* destination = get_table(composition);
+        source->m_addEdges.emplace(typeId, destination);
+        destination->m_removeEdges.emplace(typeId, source);
+        return destination;
+    }
+
+    archetype_table* archetype_storage::get_remove_edge(archetype_table* source, id_type typeId)
+    {
+        auto itr = source->m_removeEdges.find(typeId);
+        if (itr != source->m_removeEdges.end())
+            return itr->second;
+
+        std::vector<id_type> composition = source->m_composition;
+        composition.erase(std::find(composition.begin(), composition.end(), typeId));
+
+        if (composition.empty()) // Entities without components aren't stored.
+            return nullptr;
+
+        archetype_table* destination = get_table(composition);
+        source->m_removeEdges.emplace(typeId, destination);
+        destination->m_addEdges.emplace(typeId, source);
+        return destination;
+    }
+
+    void archetype_storage::move_entity(id_type entityId, entity_location& location, archetype_table* destination)
+    {
+        OPTICK_EVENT();
+        archetype_table* source = location.table;
+        size_type newRow = destination ? destination->push_back(entity_handle(entityId)) : 0;
+
+        if (source)
+        {
+            for (size_type column = 0; column < source->m_types.size(); column++)
+            {
+                void* src = source->get(location.row, column);
+                size_type destColumn = destination ? destination->column(source->m_composition[column]) : archetype_table::npos;
+
+                if (destColumn != archetype_table::npos)
+                    source->m_types[column]->relocate(destination->get(newRow, destColumn), src);
+                else
+                    source->m_types[column]->destroy(src);
+            }
+
+            entity_handle moved = source->swap_pop(location.row);
+            if (moved.get_id() != invalid_id)
+                m_locations.at(moved.get_id()).row = location.row; // The last entity of the source table got moved into our old row.
+        }
+
+        location.table = destination;
+        location.row = newRow;
+    }
+
+    bool archetype_storage::has_component(id_type entityId, id_type typeId) const
+    {
+        auto itr = m_locations.find(entityId);
+        return itr != m_locations.end() && itr->second.table->contains(typeId);
+    }
+
+    void* archetype_storage::get_component(id_type entityId, id_type typeId) const
+    {
+        auto itr = m_locations.find(entityId);
+        if (itr == m_locations.end())
+            return nullptr;
+
+        auto& [table, row] = itr->second;
+        size_type column = table->column(typeId);
+        if (column == archetype_table::npos)
+            return nullptr;
+
+        return table->get(row, column);
+    }
+
+    void* archetype_storage::create_component(id_type entityId, id_type typeId)
+    {
+        OPTICK_EVENT();
+        entity_location& location = m_locations[entityId];
+
+        if (location.table)
+        {
+            size_type column = location.table->column(typeId);
+            if (column != archetype_table::npos)
+                return location.table->get(location.row, column);
+        }
+
+        archetype_table* destination = get_add_edge(location.table, typeId);
+        move_entity(entityId, location, destination);
+
+        void* component = destination->get(location.row, destination->column(typeId));
+        destination->m_types[destination->column(typeId)]->construct(component);
+        return component;
+    }
+
+    void archetype_storage::destroy_component(id_type entityId, id_type typeId)
+    {
+        OPTICK_EVENT();
+        auto itr = m_locations.find(entityId);
+        if (itr == m_locations.end() || !itr->second.table->contains(typeId))
+            return;
+
+        move_entity(entityId, itr->second, get_remove_edge(itr->second.table, typeId));
+
+        if (!itr->second.table)
+            m_locations.erase(itr);
+    }
+
+    void archetype_storage::destroy_entity(id_type entityId)
+    {
+        OPTICK_EVENT();
+        auto itr = m_locations.find(entityId);
+        if (itr == m_locations.end())
+            return;
+
+        move_entity(entityId, itr->second, nullptr);
+        m_locations.erase(itr);
+    }
+}
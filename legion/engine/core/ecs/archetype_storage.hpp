@@ -0,0 +1,274 @@
+#pragma once
+#include <core/types/primitives.hpp>
+#include <core/types/type_util.hpp>
+#include <core/platform/platform.hpp>
+#include <core/async/rw_spinlock.hpp>
+#include <core/containers/hashed_sparse_set.hpp>
+#include <core/ecs/entity_handle.hpp>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Optick/optick.h>
+
+/**
+ * @file archetype_storage.hpp
+ */
+
+namespace legion::core::ecs
+{
+    /**@brief Storage layout the EcsRegistry uses for component data.
+     * @note sparse: Every component family lives in its own sparse_map inside of its component_pool.
+     * @note archetype: Entities with the same component composition live together in fixed size chunks of contiguous per-type arrays.
+     * @note Define LEGION_ECS_ARCHETYPE_STORAGE to make the engine create its registry in archetype mode.
+     */
+    enum struct storage_mode : int { sparse = 0, archetype = 1 };
+
+    /**@brief Size in bytes of a single chunk of archetype storage.
+     */
+    constexpr size_type archetype_chunk_size = 16 * 1024;
+
+    /**@class component_type_info
+     * @brief Type erased description of a component type. Allows archetype storage to construct, relocate and destroy components without knowing their type.
+     */
+    struct component_type_info
+    {
+        id_type typeId = invalid_id;
+        size_type size = 0;
+        size_type alignment = 1;
+
+        // Default constructs a component in uninitialized memory.
+        void(*construct)(void* dst) = nullptr;
+        // Move constructs a component in uninitialized memory and destroys the source.
+        void(*relocate)(void* dst, void* src) = nullptr;
+        // Destroys a component.
+        void(*destroy)(void* ptr) = nullptr;
+
+        template<typename component_type>
+        static component_type_info create()
+        {
+            component_type_info info;
+            info.typeId = typeHash<component_type>();
+            info.size = sizeof(component_type);
+            info.alignment = alignof(component_type);
+            info.construct = [](void* dst) { new (dst) component_type(); };
+            info.relocate = [](void* dst, void* src)
+            {
+                component_type* source = static_cast<component_type*>(src);
+                new (dst) component_type(std::move(*source));
+                source->~component_type();
+            };
+            info.destroy = [](void* ptr) { static_cast<component_type*>(ptr)->~component_type(); };
+            return info;
+        }
+    };
+
+    /**@class archetype_chunk
+     * @brief Single aligned block of memory that holds the component arrays for a range of rows of an archetype_table.
+     */
+    class archetype_chunk
+    {
+    private:
+        byte* m_data;
+
+    public:
+        explicit archetype_chunk(size_type byteSize);
+        ~archetype_chunk();
+
+        archetype_chunk(const archetype_chunk&) = delete;
+        archetype_chunk& operator=(const archetype_chunk&) = delete;
+
+        L_NODISCARD byte* data() const noexcept { return m_data; }
+    };
+
+    /**@class archetype_table
+     * @brief Storage of all entities with exactly the same component composition.
+     *        Rows are kept densely packed, row N lives in chunk N / chunk_capacity().
+     */
+    class archetype_table
+    {
+        friend class archetype_storage;
+    public:
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    private:
+        std::vector<id_type> m_composition; // Sorted type ids.
+        std::vector<const component_type_info*> m_types;
+        std::vector<size_type> m_offsets; // Offset of each component array within a chunk.
+        size_type m_chunkBytes = 0;
+        size_type m_chunkCapacity = 0;
+
+        std::vector<std::unique_ptr<archetype_chunk>> m_chunks;
+        std::vector<entity_handle> m_entities;
+
+        // Cached transitions to the tables with one component type more or less.
+        std::unordered_map<id_type, archetype_table*> m_addEdges;
+        std::unordered_map<id_type, archetype_table*> m_removeEdges;
+
+    public:
+        explicit archetype_table(std::vector<const component_type_info*>&& types);
+        ~archetype_table();
+
+        archetype_table(const archetype_table&) = delete;
+        archetype_table& operator=(const archetype_table&) = delete;
+
+        L_NODISCARD const std::vector<id_type>& composition() const noexcept { return m_composition; }
+
+        /**@brief Index of the component array of a certain type, or npos if this table doesn't store that type.
+         */
+        L_NODISCARD size_type column(id_type typeId) const noexcept;
+
+        L_NODISCARD bool contains(id_type typeId) const noexcept { return column(typeId) != npos; }
+        L_NODISCARD bool contains(const hashed_sparse_set<id_type>& typeIds) const noexcept;
+
+        L_NODISCARD size_type size() const noexcept { return m_entities.size(); }
+        L_NODISCARD size_type chunk_count() const noexcept { return (m_entities.size() + m_chunkCapacity - 1) / m_chunkCapacity; }
+        L_NODISCARD size_type chunk_capacity() const noexcept { return m_chunkCapacity; }
+
+        /**@brief Amount of occupied rows in a certain chunk.
+         */
+        L_NODISCARD size_type chunk_size(size_type chunk) const noexcept;
+
+        /**@brief Start of the contiguous array of a component type within a chunk.
+         */
+        L_NODISCARD void* column_data(size_type chunk, size_type column) const noexcept
+        {
+            return m_chunks[chunk]->data() + m_offsets[column];
+        }
+
+        /**@brief Start of the entities stored in a chunk.
+         */
+        L_NODISCARD const entity_handle* entities(size_type chunk) const noexcept
+        {
+            return m_entities.data() + chunk * m_chunkCapacity;
+        }
+
+        L_NODISCARD void* get(size_type row, size_type column) const noexcept
+        {
+            return m_chunks[row / m_chunkCapacity]->data() + m_offsets[column] + (row % m_chunkCapacity) * m_types[column]->size;
+        }
+
+    private:
+        /**@brief Reserves a new row at the end of the table. The components in the row are left uninitialized.
+         */
+        size_type push_back(entity_handle entity);
+
+        /**@brief Fills the hole at a row with the last row of the table and shrinks the table.
+         * @note The components at the given row must already have been destroyed or relocated.
+         * @return entity_handle The entity that got moved into the given row, or an invalid handle if the last row was removed.
+         */
+        entity_handle swap_pop(size_type row);
+    };
+
+    /**@class archetype_storage
+     * @brief Chunked component storage used by the EcsRegistry when running in storage_mode::archetype.
+     * @note All functions except report_type are thread unsafe, lock get_lock() at least for read before calling them.
+     *       Structural changes (creating or destroying components) need the lock for write.
+     */
+    class archetype_storage
+    {
+    private:
+        struct entity_location
+        {
+            archetype_table* table = nullptr;
+            size_type row = 0;
+        };
+
+        mutable async::rw_spinlock m_lock;
+        std::unordered_map<id_type, component_type_info> m_typeInfos;
+        std::map<std::vector<id_type>, std::unique_ptr<archetype_table>> m_tables;
+        std::unordered_map<id_type, entity_location> m_locations;
+
+        archetype_table* get_table(const std::vector<id_type>& composition);
+        archetype_table* get_add_edge(archetype_table* source, id_type typeId);
+        archetype_table* get_remove_edge(archetype_table* source, id_type typeId);
+
+        /**@brief Moves an entity into another table, relocating all the components both tables share and destroying the others.
+         */
+        void move_entity(id_type entityId, entity_location& location, archetype_table* destination);
+
+    public:
+        archetype_storage() = default;
+        archetype_storage(const archetype_storage&) = delete;
+        archetype_storage& operator=(const archetype_storage&) = delete;
+
+        /**@brief Makes a component type known to the storage. Thread-safe.
+         */
+        template<typename component_type>
+        void report_type()
+        {
+            async::readwrite_guard guard(m_lock);
+            m_typeInfos.try_emplace(typeHash<component_type>(), component_type_info::create<component_type>());
+        }
+
+        /**@brief Get the lock that guards all tables. Structural changes lock it for write, access to components only for read next to the lock of their family.
+         * @ref legion::core::ecs::family_guard
+         */
+        L_NODISCARD async::rw_spinlock& get_lock() const noexcept { return m_lock; }
+
+        L_NODISCARD bool has_component(id_type entityId, id_type typeId) const;
+
+        /**@brief Get a pointer to a component, or nullptr if the entity doesn't have the component.
+         */
+        L_NODISCARD void* get_component(id_type entityId, id_type typeId) const;
+
+        /**@brief Default constructs a component and moves the entity to the table of its new composition.
+         * @return void* Pointer to the new component, or the existing one if the entity already had a component of this type.
+         */
+        void* create_component(id_type entityId, id_type typeId);
+
+        /**@brief Destroys a component and moves the entity to the table of its new composition.
+         */
+        void destroy_component(id_type entityId, id_type typeId);
+
+        /**@brief Destroys all components of an entity.
+         */
+        void destroy_entity(id_type entityId);
+
+        /**@brief Iterate over all chunks of all tables that contain at least the given component types.
+         * @tparam component_types Types of the component arrays to pass to the function. May be const qualified.
+         * @param typeIds Component types a table needs to contain in order to be iterated.
+         * @param func Function with signature void(size_type count, const entity_handle* entities, component_types*... components).
+         */
+        template<typename... component_types, typename Func>
+        void for_each_chunk(const hashed_sparse_set<id_type>& typeIds, Func&& func) const
+        {
+            OPTICK_EVENT();
+            constexpr size_type typeCount = sizeof...(component_types);
+            const std::array<id_type, typeCount> columnTypeIds{ { typeHash<std::remove_const_t<component_types>>()... } };
+            std::array<size_type, typeCount> columns;
+
+            for (auto& [_, table] : m_tables)
+            {
+                if (!table->size() || !table->contains(typeIds))
+                    continue;
+
+                // Columns are looked up once per table, all chunks of a table share the same layout.
+                bool valid = true;
+                for (size_type i = 0; i < typeCount; i++)
+                {
+                    columns[i] = table->column(columnTypeIds[i]);
+                    valid &= columns[i] != archetype_table::npos;
+                }
+
+                if (!valid)
+                    continue;
+
+                for (size_type chunk = 0; chunk < table->chunk_count(); chunk++)
+                    invoke_chunk<component_types...>(*table, chunk, columns, func, std::index_sequence_for<component_types...>{});
+            }
+        }
+
+    private:
+        template<typename... component_types, typename Func, size_type... I>
+        static void invoke_chunk(const archetype_table& table, size_type chunk, const std::array<size_type, sizeof...(component_types)>& columns, Func& func, std::index_sequence<I...>)
+        {
+            func(table.chunk_size(chunk), table.entities(chunk), static_cast<component_types*>(table.column_data(chunk, columns[I]))...);
+        }
+    };
+}
@@ -0,0 +1,127 @@
+#include <core/ecs/command_buffer.hpp>
+#include <core/ecs/ecsregistry.hpp>
+
+#include <algorithm>
+
+#include <Optick/optick.h>
+
+namespace legion::core::ecs
+{
+    void command_buffer::record(command&& cmd)
+    {
+        std::thread::id threadId = std::this_thread::get_id();
+
+        {
+            async::readonly_guard guard(m_lock);
+            auto itr = m_streams.find(threadId);
+            if (itr != m_streams.end())
+            {
+                command_stream& stream = *itr->second;
+                async::readwrite_guard streamGuard(stream.lock); // Only this thread writes its own stream, the lock keeps size() from reading it mid push.
+                stream.commands.push_back(std::move(cmd));
+                return;
+            }
+        }
+
+        async::readwrite_guard guard(m_lock);
+        auto& stream = m_streams[threadId];
+        if (!stream)
+            stream = std::make_unique<command_stream>();
+        stream->commands.push_back(std::move(cmd));
+    }
+
+    entity_handle command_buffer::create_entity(bool worldChild)
+    {
+        id_type entityId = EcsRegistry::reserveEntityId();
+        record(command{ command_type::create_entity, entityId, invalid_id, worldChild, nullptr });
+        return entity_handle(entityId);
+    }
+
+    void command_buffer::destroy_entity(entity_handle entity, bool recurse)
+    {
+        record(command{ command_type::destroy_entity, entity.get_id(), invalid_id, recurse, nullptr });
+    }
+
+    size_type command_buffer::size() const
+    {
+        async::readonly_guard guard(m_lock);
+        size_type count = 0;
+        for (auto& [_, stream] : m_streams)
+        {
+            async::readonly_guard streamGuard(stream->lock);
+            count += stream->commands.size();
+        }
+        return count;
+    }
+
+    void command_buffer::playback()
+    {
+        OPTICK_EVENT();
+        std::vector<command> commands;
+
+        {
+            async::readwrite_guard guard(m_lock); // Nobody can reach the streams while the buffer is write locked.
+            for (auto& [_, stream] : m_streams)
+            {
+                std::move(stream->commands.begin(), stream->commands.end(), std::back_inserter(commands));
+                stream->commands.clear();
+            }
+        }
+
+        if (commands.empty())
+            return;
+
+        {
+            OPTICK_EVENT("Sort commands");
+            std::stable_sort(commands.begin(), commands.end(), [](const command& a, const command& b)
+                {
+                    if (a.type != b.type)
+                        return a.type < b.type;
+                    return a.componentTypeId < b.componentTypeId;
+                });
+        }
+
+        std::vector<id_type> entities;
+        std::vector<void*> values;
+
+        size_type start = 0;
+        while (start < commands.size())
+        {
+            // Find the range of commands that can be applied as a single batch.
+            size_type end = start + 1;
+            while (end < commands.size() && commands[end].type == commands[start].type && commands[end].componentTypeId == commands[start].componentTypeId)
+                end++;
+
+            switch (commands[start].type)
+            {
+            case command_type::create_entity:
+                for (size_type i = start; i < end; i++)
+                    (void)m_registry->createEntity(commands[i].flag, commands[i].entityId);
+                break;
+            case command_type::add_component:
+                entities.clear();
+                values.clear();
+                for (size_type i = start; i < end; i++)
+                {
+                    entities.push_back(commands[i].entityId);
+                    values.push_back(commands[i].value ? commands[i].value->data() : nullptr);
+                }
+                m_registry->bulkCreateComponent(commands[start].componentTypeId, entities, values);
+                break;
+            case command_type::remove_component:
+                entities.clear();
+                for (size_type i = start; i < end; i++)
+                    entities.push_back(commands[i].entityId);
+                m_registry->bulkDestroyComponent(commands[start].componentTypeId, entities);
+                break;
+            case command_type::destroy_entity:
+                for (size_type i = start; i < end; i++)
+                    if (m_registry->validateEntity(commands[i].entityId)) // The entity might have been destroyed already as the child of another entity.
+                        m_registry->destroyEntity(commands[i].entityId, commands[i].flag);
+                break;
+            }
+
+            start = end;
+        }
+    }
+}
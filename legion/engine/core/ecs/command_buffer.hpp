@@ -0,0 +1,132 @@
+#pragma once
+#include <core/types/primitives.hpp>
+#include <core/types/type_util.hpp>
+#include <core/platform/platform.hpp>
+#include <core/async/rw_spinlock.hpp>
+#include <core/ecs/entity_handle.hpp>
+
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file command_buffer.hpp
+ */
+
+namespace legion::core::ecs
+{
+    class EcsRegistry;
+
+    /**@class command_buffer
+     * @brief Records structural changes to the ECS so they can be applied later in a single batched pass.
+     *        Recording is thread-safe and cheap, every thread records into its own stream. Use it to spawn or destroy entities from inside jobs.
+     * @note Playback sorts all recorded commands: first all entities get created, then all components get added grouped by type,
+     *       then all components get removed grouped by type and finally all entities get destroyed.
+     *       Every component family gets locked once per type of operation instead of once per component.
+     * @note Commands recorded by a single thread keep their relative order within each of these phases.
+     */
+    class command_buffer
+    {
+    private:
+        enum struct command_type : int { create_entity = 0, add_component = 1, remove_component = 2, destroy_entity = 3 };
+
+        struct component_value_base
+        {
+            virtual void* data() noexcept LEGION_PURE;
+            virtual ~component_value_base() = default;
+        };
+
+        template<typename component_type>
+        struct component_value final : public component_value_base
+        {
+            component_type value;
+
+            component_value(component_type&& v) : value(std::move(v)) {}
+            component_value(const component_type& v) : value(v) {}
+
+            void* data() noexcept override { return &value; }
+        };
+
+        struct command
+        {
+            command_type type;
+            id_type entityId;
+            id_type componentTypeId;
+            bool flag; // worldChild for create_entity, recurse for destroy_entity.
+            std::unique_ptr<component_value_base> value;
+        };
+
+        /**@brief Commands recorded by a single thread.
+         */
+        struct command_stream
+        {
+            mutable async::fast_rw_spinlock lock; // Only contended when the size of the buffer is requested while recording.
+            std::vector<command> commands;
+        };
+
+        EcsRegistry* m_registry;
+
+        mutable async::fast_rw_spinlock m_lock; // Guards the existence of the streams, not their content.
+        std::unordered_map<std::thread::id, std::unique_ptr<command_stream>> m_streams;
+
+        void record(command&& cmd);
+
+    public:
+        explicit command_buffer(EcsRegistry* registry) : m_registry(registry) {}
+
+        command_buffer(const command_buffer&) = delete;
+        command_buffer& operator=(const command_buffer&) = delete;
+
+        /**@brief Record the creation of an entity.
+         * @return entity_handle Handle with the id the entity will get. The entity doesn't exist until the buffer is played back,
+         *         but the handle can already be used to record more commands for it.
+         */
+        entity_handle create_entity(bool worldChild = true);
+
+        /**@brief Record the destruction of an entity.
+         * @param recurse Whether the children of the entity should be destroyed as well.
+         */
+        void destroy_entity(entity_handle entity, bool recurse = true);
+
+        /**@brief Record adding a default constructed component to an entity.
+         */
+        template<typename component_type>
+        void add_component(entity_handle entity)
+        {
+            record(command{ command_type::add_component, entity.get_id(), typeHash<component_type>(), false, nullptr });
+        }
+
+        /**@brief Record adding a component with a starting value to an entity.
+         * @param value Starting value of the component, gets copied or moved into the buffer.
+         */
+        template<typename component_type>
+        void add_component(entity_handle entity, component_type&& value)
+        {
+            using value_type = std::remove_cv_t<std::remove_reference_t<component_type>>;
+            record(command{ command_type::add_component, entity.get_id(), typeHash<value_type>(), false,
+                std::make_unique<component_value<value_type>>(std::forward<component_type>(value)) });
+        }
+
+        /**@brief Record removing a component from an entity.
+         */
+        template<typename component_type>
+        void remove_component(entity_handle entity)
+        {
+            record(command{ command_type::remove_component, entity.get_id(), typeHash<component_type>(), false, nullptr });
+        }
+
+        /**@brief Amount of commands that are waiting to be played back.
+         * @note Safe to call while other threads are recording, the result might be outdated by the time it returns though.
+         */
+        L_NODISCARD size_type size() const;
+
+        L_NODISCARD bool empty() const { return size() == 0; }
+
+        /**@brief Apply all recorded commands to the registry and clear the buffer.
+         * @warning Should be called from a sync point, commands recorded during playback by other threads might end up in the next playback.
+         */
+        void playback();
+    };
+}
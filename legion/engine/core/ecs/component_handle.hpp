@@ -97,7 +97,7 @@ namespace legion::core::ecs
             OPTICK_EVENT();
             component_pool<component_type>* family = m_registry->getFamily<component_type>();
 
-            async::readonly_guard rguard(family->get_lock());
+            family_guard<const component_type> rguard(*family);
 
             return family->get_component(entity);
         }
@@ -105,6 +105,7 @@ namespace legion::core::ecs
         /**@brief Thread-safe write of component.
          * @param value Value you wish to write.
          * @returns component_type Current value of component.
+         * @note Only raises events::component_modification if change events were enabled with EcsRegistry::setChangeEvents.
          */
         component_type write(component_type&& value)
         {
@@ -113,8 +114,9 @@ namespace legion::core::ecs
             component_pool<component_type>* family = m_registry->getFamily<component_type>();
 
             component_type old;
+            const bool notify = family->has_change_events();
             {
-                async::readonly_guard rguard(family->get_lock());
+                family_guard<const component_type> rguard(*family);
 
 #ifdef LGN_SAFE_MODE
                 if (!family->has_component(entity))
@@ -122,16 +124,19 @@ namespace legion::core::ecs
 #endif
 
                 component_type& ref = family->get_component(entity);
-                old = ref;
+                if (notify)
+                    old = ref;
                 ref = value;
             }
-            m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), std::cref(value));
+            if (notify)
+                m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), std::cref(value));
             return value;
         }
 
         /**@brief Thread-safe write of component.
          * @param value Value you wish to write.
          * @returns component_type Current value of component.
+         * @note Only raises events::component_modification if change events were enabled with EcsRegistry::setChangeEvents.
          */
         component_type write(const component_type& value)
         {
@@ -140,8 +145,9 @@ namespace legion::core::ecs
             component_pool<component_type>* family = m_registry->getFamily<component_type>();
 
             component_type old;
+            const bool notify = family->has_change_events();
             {
-                async::readonly_guard rguard(family->get_lock());
+                family_guard<const component_type> rguard(*family);
 
 #ifdef LGN_SAFE_MODE
                 if (!family->has_component(entity))
@@ -149,10 +155,12 @@ namespace legion::core::ecs
 #endif
 
                 component_type& ref = family->get_component(entity);
-                old = ref;
+                if (notify)
+                    old = ref;
                 ref = value;
             }
-            m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), value);
+            if (notify)
+                m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), value);
             return value;
         }
 
@@ -169,8 +177,9 @@ namespace legion::core::ecs
 
             component_type ret;
             component_type old;
+            const bool notify = family->has_change_events();
             {
-                async::readonly_guard rguard(family->get_lock());
+                family_guard<const component_type> rguard(*family);
 
 #ifdef LGN_SAFE_MODE
                 if (!family->has_component(entity))
@@ -178,11 +187,13 @@ namespace legion::core::ecs
 #endif
 
                 component_type& comp = family->get_component(entity);
-                old = comp;
+                if (notify)
+                    old = comp;
                 modifier(comp);
                 ret = comp;
             }
-            m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), ret);
+            if (notify)
+                m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), ret);
             return ret;
         }
 
@@ -195,8 +206,9 @@ namespace legion::core::ecs
 
             component_type ret;
             component_type old;
+            const bool notify = family->has_change_events();
             {
-                async::readonly_guard rguard(family->get_lock());
+                family_guard<const component_type> rguard(*family);
 
 #ifdef LGN_SAFE_MODE
                 if (!family->has_component(entity))
@@ -204,11 +216,13 @@ namespace legion::core::ecs
 #endif
 
                 component_type& comp = family->get_component(entity);
-                old = comp;
+                if (notify)
+                    old = comp;
                 modifier(comp);
                 ret = comp;
             }
-            m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), ret);
+            if (notify)
+                m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), ret);
             return ret;
         }
 
@@ -224,8 +238,9 @@ namespace legion::core::ecs
 
             component_type ret;
             component_type old;
+            const bool notify = family->has_change_events();
             {
-                async::readonly_guard rguard(family->get_lock());
+                family_guard<const component_type> rguard(*family);
 
 #ifdef LGN_SAFE_MODE
                 if (!family->has_component(entity))
@@ -233,11 +248,13 @@ namespace legion::core::ecs
 #endif
 
                 component_type& comp = family->get_component(entity);
-                old = comp;
+                if (notify)
+                    old = comp;
                 comp = comp + value;
                 ret = comp;
             }
-            m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), ret);
+            if (notify)
+                m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), ret);
             return ret;
         }
 
@@ -253,8 +270,9 @@ namespace legion::core::ecs
 
             component_type ret;
             component_type old;
+            const bool notify = family->has_change_events();
             {
-                async::readonly_guard rguard(family->get_lock());
+                family_guard<const component_type> rguard(*family);
 
 #ifdef LGN_SAFE_MODE
                 if (!family->has_component(entity))
@@ -262,11 +280,13 @@ namespace legion::core::ecs
 #endif
 
                 component_type& comp = family->get_component(entity);
-                old = comp;
+                if (notify)
+                    old = comp;
                 comp = comp + value;
                 ret = comp;
             }
-            m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), ret);
+            if (notify)
+                m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), ret);
             return ret;
         }
 
@@ -282,8 +302,9 @@ namespace legion::core::ecs
 
             component_type ret;
             component_type old;
+            const bool notify = family->has_change_events();
             {
-                async::readonly_guard rguard(family->get_lock());
+                family_guard<const component_type> rguard(*family);
 
 #ifdef LGN_SAFE_MODE
                 if (!family->has_component(entity))
@@ -291,11 +312,13 @@ namespace legion::core::ecs
 #endif
 
                 component_type& comp = family->get_component(entity);
-                old = comp;
+                if (notify)
+                    old = comp;
                 comp = comp * value;
                 ret = comp;
             }
-            m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), ret);
+            if (notify)
+                m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), ret);
             return ret;
         }
 
@@ -311,8 +334,9 @@ namespace legion::core::ecs
 
             component_type ret;
             component_type old;
+            const bool notify = family->has_change_events();
             {
-                async::readonly_guard rguard(family->get_lock());
+                family_guard<const component_type> rguard(*family);
 
 #ifdef LGN_SAFE_MODE
                 if (!family->has_component(entity))
@@ -320,11 +344,13 @@ namespace legion::core::ecs
 #endif
 
                 component_type& comp = family->get_component(entity);
-                old = comp;
+                if (notify)
+                    old = comp;
                 comp = comp * value;
                 ret = comp;
             }
-            m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), ret);
+            if (notify)
+                m_eventBus->raiseEvent<events::component_modification<component_type>>(entity, std::move(old), ret);
             return ret;
         }
 
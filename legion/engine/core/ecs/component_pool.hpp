@@ -8,6 +8,7 @@
 #include <core/events/events.hpp>
 #include <core/ecs/component_meta.hpp>
 #include <core/ecs/component_container.hpp>
+#include <core/ecs/archetype_storage.hpp>
 
 #include <cereal/types/unordered_map.hpp>
 #include <cereal/types/memory.hpp>
@@ -17,6 +18,10 @@
 #include <core/serialization/serializationmeta.hpp>
 
 #include <functional>
+#include <atomic>
+#include <array>
+#include <tuple>
+#include <type_traits>
 
 #include <Optick/optick.h>
 
@@ -30,6 +35,9 @@ namespace legion::core::ecs
 
     using entity_container = std::vector<entity_handle>;
 
+    template<typename... component_types>
+    class family_guard;
+
     /**@class component_pool_base
      * @brief Base class of legion::core::ecs::component_pool
      */
@@ -45,8 +53,16 @@ namespace legion::core::ecs
         virtual void create_component(id_type entityId, void* value) LEGION_PURE;
         virtual void destroy_component(id_type entityId) LEGION_PURE;
 
+        virtual void create_components(const std::vector<id_type>& entities, const std::vector<void*>& values) LEGION_PURE;
+        virtual void destroy_components(const std::vector<id_type>& entities) LEGION_PURE;
+
         virtual void clone_component(id_type dst, id_type src) LEGION_PURE;
 
+        /**@brief Enable or disable raising modification events for this component type.
+         */
+        virtual void set_change_events(bool enabled) noexcept LEGION_PURE;
+        L_NODISCARD virtual bool has_change_events() const noexcept LEGION_PURE;
+
         virtual void serialize(cereal::JSONOutputArchive& oarchive, id_type entityId) LEGION_PURE;
         virtual void serialize(cereal::BinaryOutputArchive& oarchive, id_type entityId) LEGION_PURE;
 
@@ -66,13 +82,63 @@ namespace legion::core::ecs
     private:
         sparse_map<id_type, component_type> m_components;
         mutable async::rw_spinlock m_lock;
+        archetype_storage* m_storage = nullptr; // Only set when the registry runs in storage_mode::archetype.
+        std::atomic_bool m_changeEvents{ false };
 
         events::EventBus* m_eventBus;
         EcsRegistry* m_registry;
         component_type m_nullComp;
     public:
         component_pool() = default;
-        component_pool(EcsRegistry* registry, events::EventBus* eventBus) : m_eventBus(eventBus), m_registry(registry) {}
+        component_pool(EcsRegistry* registry, events::EventBus* eventBus, archetype_storage* storage = nullptr) : m_storage(storage), m_eventBus(eventBus), m_registry(registry) {}
+
+    private:
+        // Thread unsafe accessors that abstract over the sparse and the archetype backend.
+        L_NODISCARD bool contains(id_type entityId) const
+        {
+            if (m_storage)
+                return m_storage->has_component(entityId, typeHash<component_type>());
+            return m_components.contains(entityId);
+        }
+
+        L_NODISCARD component_type& fetch(id_type entityId)
+        {
+            if (m_storage)
+                return *static_cast<component_type*>(m_storage->get_component(entityId, typeHash<component_type>()));
+            return m_components.at(entityId);
+        }
+
+        L_NODISCARD const component_type& fetch(id_type entityId) const
+        {
+            if (m_storage)
+                return *static_cast<const component_type*>(m_storage->get_component(entityId, typeHash<component_type>()));
+            return m_components.at(entityId);
+        }
+
+        component_type& insert(id_type entityId)
+        {
+            if (m_storage)
+                return *static_cast<component_type*>(m_storage->create_component(entityId, typeHash<component_type>()));
+            return m_components[entityId];
+        }
+
+        void erase(id_type entityId)
+        {
+            if (m_storage)
+                m_storage->destroy_component(entityId, typeHash<component_type>());
+            else
+                m_components.erase(entityId);
+        }
+
+        // Creating or destroying components in archetype mode moves the components of other families as well, so it needs the lock of the whole storage.
+        L_NODISCARD async::rw_spinlock& get_structure_lock() const noexcept
+        {
+            if (m_storage)
+                return m_storage->get_lock();
+            return m_lock;
+        }
+
+    public:
 
         void serialize(cereal::JSONOutputArchive& oarchive, id_type entityId) override
         {
@@ -85,15 +151,17 @@ namespace legion::core::ecs
 
             if constexpr (serialization::has_serialize<component_type, void(cereal::JSONOutputArchive&)>::value)
             {
-                async::readonly_guard guard(m_lock);
+                family_guard<const component_type> guard(*this);
                 oarchive(cereal::make_nvp("Component Name", componentType));
-                m_components[entityId].serialize(oarchive);
+                if (contains(entityId))
+                    fetch(entityId).serialize(oarchive);
             }
             else if constexpr (serialization::has_save<component_type, void(cereal::JSONOutputArchive&)>::value)
             {
-                async::readonly_guard guard(m_lock);
+                family_guard<const component_type> guard(*this);
                 oarchive(cereal::make_nvp("Component Name", componentType));
-                m_components[entityId].save(oarchive);
+                if (contains(entityId))
+                    fetch(entityId).save(oarchive);
             }
             else
             {
@@ -111,15 +179,17 @@ namespace legion::core::ecs
 
             if constexpr (serialization::has_serialize<component_type, void(cereal::BinaryOutputArchive&)>::value)
             {
-                async::readonly_guard guard(m_lock);
+                family_guard<const component_type> guard(*this);
                 oarchive(cereal::make_nvp("Component Name", componentType));
-                m_components[entityId].serialize(oarchive);
+                if (contains(entityId))
+                    fetch(entityId).serialize(oarchive);
             }
             else if constexpr (serialization::has_save<component_type, void(cereal::BinaryOutputArchive&)>::value)
             {
-                async::readonly_guard guard(m_lock);
+                family_guard<const component_type> guard(*this);
                 oarchive(cereal::make_nvp("Component Name", componentType));
-                m_components[entityId].save(oarchive);
+                if (contains(entityId))
+                    fetch(entityId).save(oarchive);
             }
             else
             {
@@ -138,15 +208,21 @@ namespace legion::core::ecs
             std::string componentType = std::string(nameOfType<component_type>());
             if constexpr (serialization::has_serialize<component_type, void(cereal::JSONOutputArchive&)>::value)
             {
-                async::readonly_guard guard(m_lock);
+                family_guard<const component_type> guard(*this);
                 iarchive(cereal::make_nvp("Component Name", componentType));
-                m_components[entityId].serialize(iarchive);
+                if (contains(entityId))
+                    fetch(entityId).serialize(iarchive);
+                else
+                    component_type().serialize(iarchive); // Still consume the data so the archive stays in sync.
             }
             else if constexpr (serialization::has_load<component_type, void(cereal::JSONInputArchive&)>::value)
             {
-                async::readonly_guard guard(m_lock);
+                family_guard<const component_type> guard(*this);
                 iarchive(cereal::make_nvp("Component Name", componentType));
-                m_components[entityId].load(iarchive);
+                if (contains(entityId))
+                    fetch(entityId).load(iarchive);
+                else
+                    component_type().load(iarchive); // Still consume the data so the archive stays in sync.
             }
             else
             {
@@ -165,15 +241,21 @@ namespace legion::core::ecs
             std::string componentType = std::string(nameOfType<component_type>());
             if constexpr (serialization::has_serialize<component_type, void(cereal::BinaryInputArchive&)>::value)
             {
-                async::readonly_guard guard(m_lock);
+                family_guard<const component_type> guard(*this);
                 iarchive(cereal::make_nvp("Component Name", componentType));
-                m_components[entityId].serialize(iarchive);
+                if (contains(entityId))
+                    fetch(entityId).serialize(iarchive);
+                else
+                    component_type().serialize(iarchive); // Still consume the data so the archive stays in sync.
             }
             else if constexpr (serialization::has_load<component_type, void(cereal::BinaryInputArchive&)>::value)
             {
-                async::readonly_guard guard(m_lock);
+                family_guard<const component_type> guard(*this);
                 iarchive(cereal::make_nvp("Component Name", componentType));
-                m_components[entityId].load(iarchive);
+                if (contains(entityId))
+                    fetch(entityId).load(iarchive);
+                else
+                    component_type().load(iarchive); // Still consume the data so the archive stays in sync.
             }
             else
             {
@@ -181,28 +263,36 @@ namespace legion::core::ecs
             }
         }
 
-        /**@brief Get the rw_spinlock of this container.
+        /**@brief Get the rw_spinlock of this component family.
+         * @note In archetype mode the components are only safe to access while the lock of the storage is held for read as well, use family_guard to lock both.
          */
         async::rw_spinlock& get_lock() const noexcept
         {
             return m_lock;
         }
 
+        /**@brief Get the lock of the archetype storage the components live in, or nullptr in sparse mode.
+         */
+        L_NODISCARD async::rw_spinlock* get_storage_lock() const noexcept
+        {
+            return m_storage ? &m_storage->get_lock() : nullptr;
+        }
+
         component_container_base* get_components(const entity_container& entities) const override
         {
             OPTICK_EVENT();
             auto* container = new component_container<component_type>();
             container->resize(entities.size());
 
-            async::readonly_guard guard(m_lock);
-            for (int i = 0; i < entities.size(); i++)
+            family_guard<const component_type> guard(*this);
+            for (size_type i = 0; i < entities.size(); i++)
             {
                 OPTICK_EVENT("Get component");
 #ifdef LGN_SAFE_MODE
-                if (m_components.contains(entities[i]))
-                    container->at(i) = m_components.at(entities[i]);
+                if (contains(entities[i]))
+                    container->at(i) = fetch(entities[i]);
 #else
-                container->at(i) = m_components.at(entities[i]);
+                container->at(i) = fetch(entities[i]);
 #endif
             }
 
@@ -221,15 +311,15 @@ namespace legion::core::ecs
                 return;
 #endif
 
-            async::readonly_guard guard(m_lock);
-            for (int i = 0; i < entities.size(); i++)
+            family_guard<const component_type> guard(*this);
+            for (size_type i = 0; i < entities.size(); i++)
             {
                 OPTICK_EVENT("Get component");
 #ifdef LGN_SAFE_MODE
-                if (m_components.contains(entities[i]))
-                    container[i] = m_components.at(entities[i]);
+                if (contains(entities[i]))
+                    container[i] = fetch(entities[i]);
 #else
-                container[i] = m_components.at(entities[i]);
+                container[i] = fetch(entities[i]);
 #endif
             }
         }
@@ -244,17 +334,30 @@ namespace legion::core::ecs
                 return;
 #endif
 
+            if (!has_change_events())
+            {
+                // Nobody is interested in the old values, so we can skip copying them.
+                family_guard<const component_type> guard(*this);
+                for (size_type i = 0; i < entities.size(); i++)
+                {
+                    auto& ent = entities[i];
+                    if (contains(ent))
+                        fetch(ent) = container[i];
+                }
+                return;
+            }
+
             component_container<component_type> modifications;
             modifications.resize(entities.size());
 
             {
-                async::readonly_guard guard(m_lock);
-                for (int i = 0; i < entities.size(); i++)
+                family_guard<const component_type> guard(*this);
+                for (size_type i = 0; i < entities.size(); i++)
                 {
                     auto& ent = entities[i];
-                    if (m_components.contains(ent))
+                    if (contains(ent))
                     {
-                        component_type& ref = m_components.at(ent);
+                        component_type& ref = fetch(ent);
                         modifications[i] = ref;
                         ref = container[i];
                     }
@@ -264,42 +367,88 @@ namespace legion::core::ecs
             m_eventBus->raiseEvent<events::bulk_component_modification<component_type>>(entities, modifications, container);
         }
 
+        /**@brief Enable or disable raising events::component_modification and events::bulk_component_modification for this component type.
+         * @note Change events are opt-in, while they're disabled writes don't need to copy the old values of components.
+         */
+        void set_change_events(bool enabled) noexcept override
+        {
+            m_changeEvents.store(enabled, std::memory_order_relaxed);
+        }
+
+        L_NODISCARD bool has_change_events() const noexcept override
+        {
+            return m_changeEvents.load(std::memory_order_relaxed);
+        }
+
         /**@brief Thread-safe check for whether an entity has the component.
          * @param entityId ID of the entity you wish to check for.
          */
         L_NODISCARD bool has_component(id_type entityId) const override
         {
             OPTICK_EVENT();
-            async::readonly_guard guard(m_lock);
-            return m_components.contains(entityId);
+            family_guard<const component_type> guard(*this);
+            return contains(entityId);
         }
 
-        /**@brief Thread unsafe component fetch, use component_pool::get_lock and lock for at least read_only before calling this function.
+        /**@brief Thread unsafe component fetch, lock the family with a family_guard for at least read_only before calling this function.
          * @param entityId ID of entity you want to get the component from.
-         * @ref component_pool::get_lock()
-         * @ref legion::core::async::rw_spinlock
+         * @ref legion::core::ecs::family_guard
          */
         L_NODISCARD component_type& get_component(id_type entityId)
         {
             OPTICK_EVENT();
-            if (m_components.contains(entityId))
-                return m_components.at(entityId);
+            if (contains(entityId))
+                return fetch(entityId);
             return m_nullComp;
         }
 
-        /**@brief Thread unsafe component fetch, use component_pool::get_lock and lock for at least read_only before calling this function.
+        /**@brief Thread unsafe component fetch, lock the family with a family_guard for at least read_only before calling this function.
          * @param entityId ID of entity you want to get the component from.
-         * @ref component_pool::get_lock()
-         * @ref legion::core::async::rw_spinlock
+         * @ref legion::core::ecs::family_guard
          */
         L_NODISCARD const component_type& get_component(id_type entityId) const
         {
             OPTICK_EVENT();
-            if (m_components.contains(entityId))
-                return m_components.at(entityId);
+            if (contains(entityId))
+                return fetch(entityId);
             return m_nullComp;
         }
 
+        /**@brief Thread unsafe, resolves the addresses of the components of multiple entities at once so they can be accessed without any further lookups.
+         *        Lock the family with a family_guard for at least read_only before calling this function, and keep it locked for as long as the addresses are in use.
+         * @note Entities without the component resolve to the null component, just like get_component.
+         * @param entities Entities to resolve the components of.
+         * @param addresses Receives the address of the component of every entity, in the same order as the entities.
+         */
+        void get_component_addresses(const entity_container& entities, std::vector<component_type*>& addresses)
+        {
+            OPTICK_EVENT();
+            addresses.resize(entities.size());
+
+            if (m_storage)
+            {
+                const id_type typeId = typeHash<component_type>();
+                for (size_type i = 0; i < entities.size(); i++)
+                {
+                    void* comp = m_storage->get_component(entities[i], typeId);
+                    addresses[i] = comp ? static_cast<component_type*>(comp) : &m_nullComp;
+                }
+                return;
+            }
+
+            // Entity lists of single family queries are usually in the same order as the dense storage of the family, which makes resolving them a linear walk.
+            auto& keys = m_components.keys();
+            auto& values = m_components.values();
+            const size_type denseSize = m_components.size();
+
+            size_type i = 0;
+            for (; i < entities.size() && i < denseSize && keys[i] == static_cast<id_type>(entities[i]); i++)
+                addresses[i] = &values[i];
+
+            for (; i < entities.size(); i++)
+                addresses[i] = contains(entities[i]) ? &fetch(entities[i]) : &m_nullComp;
+        }
+
         /**@brief Creates component in a thread-safe way.
          * @note Calls component_type::init if it exists.
          * @note Raises the events::component_creation<component_type>> event.
@@ -309,19 +458,19 @@ namespace legion::core::ecs
         {
             OPTICK_EVENT();
             {
-                async::readwrite_guard guard(m_lock);
-                m_components.emplace(entityId);
+                async::readwrite_guard guard(get_structure_lock());
+                insert(entityId);
             }
 
             if constexpr (detail::has_init<component_type, void(component_type&, entity_handle)>::value)
             {
-                async::readonly_guard rguard(m_lock);
-                component_type::init(m_components[entityId], entity_handle(entityId));
+                family_guard<const component_type> rguard(*this);
+                component_type::init(fetch(entityId), entity_handle(entityId));
             }
             else if constexpr (detail::has_init<component_type, void(component_type&)>::value)
             {
-                async::readonly_guard rguard(m_lock);
-                component_type::init(m_components[entityId]);
+                family_guard<const component_type> rguard(*this);
+                component_type::init(fetch(entityId));
             }
 
             m_eventBus->raiseEvent<events::component_creation<component_type>>(entity_handle(entityId));
@@ -337,19 +486,19 @@ namespace legion::core::ecs
         {
             OPTICK_EVENT();
             {
-                async::readwrite_guard guard(m_lock);
-                m_components[entityId] = *reinterpret_cast<component_type*>(value);
+                async::readwrite_guard guard(get_structure_lock());
+                insert(entityId) = *reinterpret_cast<component_type*>(value);
             }
 
             if constexpr (detail::has_init<component_type, void(component_type&, entity_handle)>::value)
             {
-                async::readonly_guard rguard(m_lock);
-                component_type::init(m_components[entityId], entity_handle(entityId));
+                family_guard<const component_type> rguard(*this);
+                component_type::init(fetch(entityId), entity_handle(entityId));
             }
             else if constexpr (detail::has_init<component_type, void(component_type&)>::value)
             {
-                async::readonly_guard rguard(m_lock);
-                component_type::init(m_components[entityId]);
+                family_guard<const component_type> rguard(*this);
+                component_type::init(fetch(entityId));
             }
 
             m_eventBus->raiseEvent<events::component_creation<component_type>>(entity_handle(entityId));
@@ -368,12 +517,73 @@ namespace legion::core::ecs
 
             if constexpr (detail::has_destroy<component_type, void(component_type&)>::value)
             {
-                async::readonly_guard rguard(m_lock);
-                component_type::destroy(m_components[entityId]);
+                family_guard<const component_type> rguard(*this);
+                if (contains(entityId))
+                    component_type::destroy(fetch(entityId));
+            }
+
+            async::readwrite_guard wguard(get_structure_lock());
+            erase(entityId);
+        }
+
+        /**@brief Creates components for multiple entities while only locking the container once.
+         * @note Calls component_type::init if it exists.
+         * @note Raises the events::component_creation<component_type>> event for every component.
+         * @param entities IDs of the entities you wish to add the component to.
+         * @param values Pointers to component_type values to move into the new components, nullptr entries get default constructed.
+         */
+        void create_components(const std::vector<id_type>& entities, const std::vector<void*>& values) override
+        {
+            OPTICK_EVENT();
+            {
+                async::readwrite_guard guard(get_structure_lock());
+                for (size_type i = 0; i < entities.size(); i++)
+                {
+                    component_type& comp = insert(entities[i]);
+                    if (values[i])
+                        comp = std::move(*reinterpret_cast<component_type*>(values[i]));
+                }
+            }
+
+            if constexpr (detail::has_init<component_type, void(component_type&, entity_handle)>::value)
+            {
+                family_guard<const component_type> rguard(*this);
+                for (id_type entityId : entities)
+                    component_type::init(fetch(entityId), entity_handle(entityId));
+            }
+            else if constexpr (detail::has_init<component_type, void(component_type&)>::value)
+            {
+                family_guard<const component_type> rguard(*this);
+                for (id_type entityId : entities)
+                    component_type::init(fetch(entityId));
             }
 
-            async::readwrite_guard wguard(m_lock);
-            m_components.erase(entityId);
+            for (id_type entityId : entities)
+                m_eventBus->raiseEvent<events::component_creation<component_type>>(entity_handle(entityId));
+        }
+
+        /**@brief Destroys the components of multiple entities while only locking the container once.
+         * @note Calls component_type::destroy if it exists.
+         * @note Raises the events::component_destruction<component_type>> event for every component.
+         * @param entities IDs of the entities you wish to remove the component from.
+         */
+        void destroy_components(const std::vector<id_type>& entities) override
+        {
+            OPTICK_EVENT();
+            for (id_type entityId : entities)
+                m_eventBus->raiseEvent<events::component_destruction<component_type>>(entity_handle(entityId));
+
+            if constexpr (detail::has_destroy<component_type, void(component_type&)>::value)
+            {
+                family_guard<const component_type> rguard(*this);
+                for (id_type entityId : entities)
+                    if (contains(entityId))
+                        component_type::destroy(fetch(entityId));
+            }
+
+            async::readwrite_guard wguard(get_structure_lock());
+            for (id_type entityId : entities)
+                erase(entityId);
         }
 
         /**
@@ -386,11 +596,69 @@ namespace legion::core::ecs
                 "cannot copy component, therefore component cannot be cloned onto new entity!");
 
             {
-                async::readwrite_guard guard(m_lock);
-                m_components[dst] = m_components[src];
+                async::readwrite_guard guard(get_structure_lock());
+                // Insert first, creating dst can relocate src within archetype storage.
+                component_type& target = insert(dst);
+                target = fetch(src);
             }
 
             m_eventBus->raiseEvent<events::component_creation<component_type>>(entity_handle(dst));
         }
     };
+
+    /**@class family_guard
+     * @brief RAII guard that locks one or more component families for access to their components.
+     *        Const qualified types are locked for read-only, the others for read-write.
+     * @note In archetype mode the shared storage gets locked for read-only as well, so no structural change can relocate the components while the guard is alive.
+     * @note Locks are taken with the same try-lock back-off as async::mixed_multiguard, families can be locked in any order without deadlocking.
+     * @tparam component_types Types of the families to lock, const qualify the types you only read from.
+     */
+    template<typename... component_types>
+    class family_guard
+    {
+        static_assert(sizeof...(component_types) > 0, "A family guard needs at least one component type.");
+
+    private:
+        static constexpr size_type lock_count = sizeof...(component_types) + 1;
+
+        std::array<const async::rw_spinlock*, lock_count> m_locks;
+        std::array<async::lock_state, lock_count> m_states{ { async::lock_state::read, (std::is_const_v<component_types> ? async::lock_state::read : async::lock_state::write)... } };
+
+    public:
+        explicit family_guard(const component_pool<std::remove_const_t<component_types>>&... families)
+            : m_locks{ { std::get<0>(std::forward_as_tuple(families...)).get_storage_lock(), &families.get_lock()... } }
+        {
+            uint attempt = 0;
+            bool locked;
+            do
+            {
+                locked = true;
+                size_type lastLocked = 0;
+                for (; lastLocked < lock_count; lastLocked++)
+                    if (m_locks[lastLocked] && !m_locks[lastLocked]->try_lock(m_states[lastLocked]))
+                    {
+                        locked = false;
+                        break;
+                    }
+
+                if (!locked)
+                {
+                    for (size_type i = 0; i < lastLocked; i++)
+                        if (m_locks[i])
+                            m_locks[i]->unlock(m_states[i]);
+                    async::adaptive_backoff(attempt, async::wait_priority::normal);
+                }
+            } while (!locked);
+        }
+
+        family_guard(const family_guard&) = delete;
+        family_guard& operator=(const family_guard&) = delete;
+
+        ~family_guard()
+        {
+            for (size_type i = lock_count; i > 0; i--)
+                if (m_locks[i - 1])
+                    m_locks[i - 1]->unlock(m_states[i - 1]);
+        }
+    };
 }
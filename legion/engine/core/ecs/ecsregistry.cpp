@@ -8,7 +8,7 @@
 namespace legion::core::ecs
 {
     // 2 because the world entity is 1 and 0 is invalid_id
-    id_type EcsRegistry::m_nextEntityId = 2;
+    std::atomic<id_type> EcsRegistry::m_nextEntityId(2);
     entity_handle EcsRegistry::world = entity_handle(world_entity_id);
 
     void EcsRegistry::recursiveDestroyEntityInternal(id_type entityId)
@@ -50,7 +50,7 @@ namespace legion::core::ecs
         }
     }
 
-    EcsRegistry::EcsRegistry(events::EventBus* eventBus) : m_families(), m_entityData(), m_entities(), m_queryRegistry(*this), m_eventBus(eventBus)
+    EcsRegistry::EcsRegistry(events::EventBus* eventBus, storage_mode mode) : m_families(), m_storageMode(mode), m_archetypes(), m_entityData(), m_entities(), m_queryRegistry(*this), m_eventBus(eventBus)
     {
         entity_handle::m_registry = this;
         entity_handle::m_eventBus = eventBus;
@@ -168,6 +168,58 @@ namespace legion::core::ecs
         }
     }
 
+    void EcsRegistry::bulkCreateComponent(id_type componentTypeId, const std::vector<id_type>& entities, const std::vector<void*>& values)
+    {
+        OPTICK_EVENT();
+        std::vector<id_type> validEntities;
+        std::vector<void*> validValues;
+        validEntities.reserve(entities.size());
+        validValues.reserve(values.size());
+
+        for (size_type i = 0; i < entities.size(); i++)
+            if (validateEntity(entities[i]))
+            {
+                validEntities.push_back(entities[i]);
+                validValues.push_back(values[i]);
+            }
+
+        if (validEntities.empty())
+            return;
+
+        getFamily(componentTypeId)->create_components(validEntities, validValues);
+
+        {
+            async::readonly_guard guard(m_entityDataLock);
+            for (id_type entityId : validEntities)
+                m_entityData[entityId].components.insert(componentTypeId); // Is fine because the lock only locks order changes in the container, not the values themselves.
+        }
+
+        m_queryRegistry.evaluateEntityChanges(validEntities, componentTypeId, false);
+    }
+
+    void EcsRegistry::bulkDestroyComponent(id_type componentTypeId, const std::vector<id_type>& entities)
+    {
+        OPTICK_EVENT();
+        std::vector<id_type> validEntities;
+        validEntities.reserve(entities.size());
+
+        for (id_type entityId : entities)
+            if (validateEntity(entityId))
+                validEntities.push_back(entityId);
+
+        if (validEntities.empty())
+            return;
+
+        m_queryRegistry.evaluateEntityChanges(validEntities, componentTypeId, true);
+        getFamily(componentTypeId)->destroy_components(validEntities);
+
+        {
+            async::readonly_guard guard(m_entityDataLock);
+            for (id_type entityId : validEntities)
+                m_entityData[entityId].components.erase(componentTypeId); // Is fine because the lock only locks order changes in the container, not the values themselves.
+        }
+    }
+
     L_NODISCARD bool EcsRegistry::validateEntity(id_type entityId)
     {
         OPTICK_EVENT();
@@ -182,11 +234,13 @@ namespace legion::core::ecs
         OPTICK_EVENT();
         id_type id;
         if (!entityId)
-            id = m_nextEntityId++;
+            id = m_nextEntityId.fetch_add(1, std::memory_order_relaxed);
         else
         {
             id = entityId;
-            m_nextEntityId = entityId + 1;
+            // Only move forward, lower ids might have been reserved but not created yet.
+            id_type next = m_nextEntityId.load(std::memory_order_relaxed);
+            while (next <= entityId && !m_nextEntityId.compare_exchange_weak(next, entityId + 1, std::memory_order_relaxed));
         }
 
         if (validateEntity(id))
@@ -203,7 +257,7 @@ namespace legion::core::ecs
         {
             component_pool<hierarchy>* family = getFamily<hierarchy>();
             {
-                async::readonly_guard rguard(family->get_lock());
+                family_guard<const hierarchy> rguard(*family);
                 family->get_component(world_entity_id).children.insert(id);
             }
         }
@@ -4,8 +4,10 @@
 #include <core/common/common.hpp>
 #include <core/async/async.hpp>
 #include <core/ecs/component_pool.hpp>
+#include <core/ecs/archetype_storage.hpp>
 #include <core/ecs/queryregistry.hpp>
 #include <core/ecs/entityquery.hpp>
+#include <core/ecs/query_view.hpp>
 #include <core/ecs/entity_handle.hpp>
 #include <core/ecs/archetype.hpp>
 
@@ -13,6 +15,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <atomic>
 
 /**
  * @file ecsregistry.hpp
@@ -41,12 +44,14 @@ namespace legion::core::ecs
     class EcsRegistry
     {
     private:
-        static id_type m_nextEntityId;
+        static std::atomic<id_type> m_nextEntityId;
 
         mutable async::rw_spinlock m_familyLock;
         std::unordered_map<id_type, std::unique_ptr<component_pool_base>> m_families;
         std::unordered_map<id_type, std::string> m_componentNames;
 
+        storage_mode m_storageMode;
+        archetype_storage m_archetypes;
 
         mutable async::rw_spinlock m_entityDataLock;
         std::unordered_map<id_type, entity_data> m_entityData;
@@ -66,8 +71,23 @@ namespace legion::core::ecs
         static entity_handle world;
 
         /**@brief Constructor initializes everything for the ECS and creates world entity.
+         * @param mode Storage layout of component data, see legion::core::ecs::storage_mode.
          */
-        EcsRegistry(events::EventBus* eventBus);
+        EcsRegistry(events::EventBus* eventBus, storage_mode mode = storage_mode::sparse);
+
+        /**@brief Get the storage layout this registry was created with.
+         */
+        L_NODISCARD storage_mode getStorageMode() const noexcept
+        {
+            return m_storageMode;
+        }
+
+        /**@brief Get the chunked component storage. Only contains data when the storage mode is storage_mode::archetype.
+         */
+        L_NODISCARD const archetype_storage& getArchetypeStorage() const noexcept
+        {
+            return m_archetypes;
+        }
 
         /**@brief Reports component type to the registry so that it can be stored managed and recognized as a component.
          * @tparam component_type Type of struct you with to add as a component.
@@ -83,7 +103,14 @@ namespace legion::core::ecs
             OPTICK_EVENT();
             async::readwrite_guard guard(m_familyLock);
             if (!m_families.count(typeHash<component_type>())) {
-                m_families[typeHash<component_type>()] = std::make_unique<component_pool<component_type>>(this, m_eventBus);
+                archetype_storage* storage = nullptr;
+                if (m_storageMode == storage_mode::archetype)
+                {
+                    m_archetypes.report_type<component_type>();
+                    storage = &m_archetypes;
+                }
+
+                m_families[typeHash<component_type>()] = std::make_unique<component_pool<component_type>>(this, m_eventBus, storage);
                 if (name.has_value())
                 {
                     m_componentNames[typeHash<component_type>()] = name.value();
@@ -105,6 +132,18 @@ namespace legion::core::ecs
             return static_cast<component_pool<component_type>*>(getFamily(typeHash<component_type>()));
         }
 
+        /**@brief Enable or disable modification events for a component type.
+         * @tparam component_type Type of the component to change the event settings of, gets reported if it wasn't already.
+         * @param enabled Whether events::component_modification and events::bulk_component_modification should be raised.
+         * @note Change events are opt-in, writes to component types without change events skip copying the old values.
+         */
+        template<typename component_type>
+        void setChangeEvents(bool enabled = true)
+        {
+            reportComponentType<component_type>();
+            getFamily<component_type>()->set_change_events(enabled);
+        }
+
         async::rw_spinlock& getEntityLock() const
         {
             return m_entityLock;
@@ -293,6 +332,21 @@ namespace legion::core::ecs
          */
         void destroyComponent(id_type entityId, id_type componentTypeId);
 
+        /**@brief Create components of a certain type on multiple entities while locking the component family only once.
+         * @param componentTypeId Type id of the components you wish to create.
+         * @param entities Ids of the entities you wish to attach the components to.
+         * @param values Pointers to the starting values of the components, values get moved from. nullptr entries get default constructed.
+         * @note Invalid entities are skipped.
+         */
+        void bulkCreateComponent(id_type componentTypeId, const std::vector<id_type>& entities, const std::vector<void*>& values);
+
+        /**@brief Destroy components of a certain type on multiple entities while locking the component family only once.
+         * @param componentTypeId Type id of the components you wish to destroy.
+         * @param entities Ids of the entities you wish to remove the components from.
+         * @note Invalid entities are skipped.
+         */
+        void bulkDestroyComponent(id_type componentTypeId, const std::vector<id_type>& entities);
+
         /**@brief Destroy component of a certain type attached to a certain entity.
          * @tparam component_type Type of component you wish to destroy.
          * @param entityId Id of the entity you wish to remove the component from.
@@ -330,6 +384,14 @@ namespace legion::core::ecs
 
         L_NODISCARD entity_handle createEntity(id_type entityId, bool worldChild = true);
 
+        /**@brief Reserve an entity id without creating the entity yet. Thread-safe.
+         * @note Pass the id to createEntity to actually create the entity.
+         */
+        L_NODISCARD static id_type reserveEntityId() noexcept
+        {
+            return m_nextEntityId.fetch_add(1, std::memory_order_relaxed);
+        }
+
         /**@brief Destroys entity and all of its components.
          * @param entityId Id of entity you wish to destroy.
          * @param recurse Do you wish to destroy all children and children of children etc as well? True by default.
@@ -403,3 +465,4 @@ namespace legion::core::ecs
 
 #include <core/ecs/entity_handle.inl>
 #include <core/ecs/archetype.inl>
+#include <core/ecs/entityquery.inl>
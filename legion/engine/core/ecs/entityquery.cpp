@@ -8,6 +8,8 @@
 
 namespace legion::core::ecs
 {
+    scheduling::Scheduler* EntityQuery::m_scheduler = nullptr;
+
     EntityQuery::EntityQuery(id_type id, QueryRegistry* registry, EcsRegistry* ecsRegistry) : m_registry(registry), m_ecsRegistry(ecsRegistry), m_id(id)
     {
         m_registry->addReference(m_id);
@@ -11,9 +11,21 @@
  * @file entityquery.hpp
  */
 
+namespace legion::core
+{
+    class Engine;
+}
+
+namespace legion::core::scheduling
+{
+    class Scheduler;
+}
+
 namespace legion::core::ecs
 {
     class QueryRegistry;
+    template<typename... component_types>
+    class query_view;
     class EcsRegistry;
     using entity_container = std::vector<entity_handle>;
 
@@ -22,7 +34,10 @@ namespace legion::core::ecs
      */
     class EntityQuery
     {
+        friend class legion::core::Engine;
     private:
+        static scheduling::Scheduler* m_scheduler;
+
         QueryRegistry* m_registry;
         EcsRegistry* m_ecsRegistry;
         id_type m_id;
@@ -59,6 +74,55 @@ namespace legion::core::ecs
          */
         void queryEntities();
 
+        /**@brief Create a zero-copy view over the components of the queried entities.
+         * @tparam component_types Types of the components to view, const qualify the types you only read from.
+         * @note Also updates the local copy of the entity list, like queryEntities but without copying any components.
+         * @ref legion::core::ecs::query_view
+         */
+        template<typename... component_types>
+        L_NODISCARD query_view<component_types...> view();
+
+        /**@brief Create a zero-copy view over the entities found by the last call to queryEntities or view, without updating the entity list.
+         *        The indices of the view match the indices of the local component containers returned by get.
+         * @tparam component_types Types of the components to view, const qualify the types you only read from.
+         */
+        template<typename... component_types>
+        L_NODISCARD query_view<component_types...> localView();
+
+        /**@brief Iterate over the queried components in contiguous arrays.
+         * @tparam component_types Types of the components to pass to the function, const qualify the types you only read from.
+         * @param func Function with signature void(size_type count, const entity_handle* entities, component_types*... components).
+         * @note In archetype storage mode the function is called once per chunk with pointers directly into the storage,
+         *       writes through these pointers do not raise modification events.
+         * @note In sparse storage mode the function is called once with copies of only the requested components,
+         *       the non-const component types are written back afterwards. Also updates the local copy of the entity list.
+         * @note The component types need to be unique.
+         */
+        template<typename... component_types, typename Func>
+        void forEachChunk(Func&& func);
+
+        /**@brief Call a function for every queried entity in parallel using the job pool of the scheduler.
+         *        The entity range gets split into batches that are each handled by a single job.
+         * @tparam component_types Types of the components to pass to the function, const qualify the types you only read from.
+         * @param batchSize Amount of entities per job, 0 picks a batch size that makes the components of a batch fit in L1 cache.
+         * @param func Function with signature void(entity_handle entity, component_types&... components),
+         *        or void(size_type index, entity_handle entity, component_types&... components) to also get the index of the entity in the query.
+         * @note Components are accessed through a query_view, so the same restrictions apply:
+         *       no structural changes during the iteration and writes do not raise modification events.
+         * @note The pools of the non-const types stay locked for write by the calling thread, jobs must not lock them through component handles.
+         * @note Blocks until all batches are done, the calling thread helps executing jobs in the meantime.
+         */
+        template<typename... component_types, typename Func>
+        void parallel_for(size_type batchSize, Func&& func);
+
+        /**@brief Call a function for every entity of an existing view in parallel, like parallel_for(size_type, Func&&).
+         *        Use this when the results of the function need to be matched up with the entities of the view afterwards,
+         *        creating a second view of the same query on the same thread could update the entity list in between.
+         * @param components View of this query that stays alive for at least the duration of the call.
+         */
+        template<typename... component_types, typename Func>
+        void parallel_for(const query_view<component_types...>& components, size_type batchSize, Func&& func);
+
         /**@brief Get begin iterator for entity handles to the queried entities.
          */
         entity_container::const_iterator begin() const;
@@ -0,0 +1,101 @@
+#pragma once
+#include <core/scheduling/scheduler.hpp>
+
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+
+namespace legion::core::ecs
+{
+    template<typename... component_types>
+    inline query_view<component_types...> EntityQuery::view()
+    {
+        OPTICK_EVENT();
+        m_localcopy = &m_registry->getEntityList(m_id);
+        return query_view<component_types...>(*m_localcopy, m_ecsRegistry->getFamily<std::remove_const_t<component_types>>()...);
+    }
+
+    template<typename... component_types>
+    inline query_view<component_types...> EntityQuery::localView()
+    {
+        OPTICK_EVENT();
+        return query_view<component_types...>(*m_localcopy, m_ecsRegistry->getFamily<std::remove_const_t<component_types>>()...);
+    }
+
+    template<typename... component_types, typename Func>
+    inline void EntityQuery::forEachChunk(Func&& func)
+    {
+        OPTICK_EVENT();
+        if (m_ecsRegistry->getStorageMode() == storage_mode::archetype)
+        {
+            const archetype_storage& storage = m_ecsRegistry->getArchetypeStorage();
+            family_guard<component_types...> guard(*m_ecsRegistry->getFamily<std::remove_const_t<component_types>>()...);
+            storage.for_each_chunk<component_types...>(m_registry->getComponentTypes(m_id), func);
+            return;
+        }
+
+        m_localcopy = &m_registry->getEntityList(m_id);
+        const entity_container& entities = *m_localcopy;
+        if (entities.empty())
+            return;
+
+        // Only the requested component types get copied, instead of every type of the query like queryEntities does.
+        std::tuple<component_pool<std::remove_const_t<component_types>>*...> families{ m_ecsRegistry->getFamily<std::remove_const_t<component_types>>()... };
+        std::tuple<component_container<std::remove_const_t<component_types>>...> components;
+
+        (std::get<component_pool<std::remove_const_t<component_types>>*>(families)->get_components(entities,
+            std::get<component_container<std::remove_const_t<component_types>>>(components)), ...);
+
+        func(entities.size(), entities.data(), std::get<component_container<std::remove_const_t<component_types>>>(components).data()...);
+
+        ([&]()
+            {
+                if constexpr (!std::is_const_v<component_types>)
+                    std::get<component_pool<component_types>*>(families)->set_components(entities, std::get<component_container<component_types>>(components));
+            }(), ...);
+    }
+
+    template<typename... component_types, typename Func>
+    inline void EntityQuery::parallel_for(size_type batchSize, Func&& func)
+    {
+        parallel_for(view<component_types...>(), batchSize, std::forward<Func>(func));
+    }
+
+    template<typename... component_types, typename Func>
+    inline void EntityQuery::parallel_for(const query_view<component_types...>& components, size_type batchSize, Func&& func)
+    {
+        OPTICK_EVENT();
+        const size_type count = components.size();
+        if (!count)
+            return;
+
+        if (!batchSize)
+        {
+            constexpr size_type batchBytes = 32 * 1024; // Conservative L1 data cache size.
+            constexpr size_type entityBytes = (sizeof(entity_handle) + ... + sizeof(component_types));
+            batchSize = std::max<size_type>(batchBytes / entityBytes, 1);
+        }
+
+        auto processEntity = [&](size_type i)
+        {
+            if constexpr (std::is_invocable_v<Func&, size_type, entity_handle, component_types&...>)
+                func(i, components.entity(i), components.template get<component_types>(i)...);
+            else
+                func(components.entity(i), components.template get<component_types>(i)...);
+        };
+
+        if (count <= batchSize || !m_scheduler)
+        {
+            for (size_type i = 0; i < count; i++)
+                processEntity(i);
+            return;
+        }
+
+        // A single range job pool hands out the batches, instead of a job per batch that each need to be queued and tracked.
+        m_scheduler->queueRangeJobs(0, count, batchSize, [&](const async::job_range& range)
+            {
+                for (size_type i : range)
+                    processEntity(i);
+            }).wait();
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <core/types/primitives.hpp>
+#include <core/platform/platform.hpp>
+#include <core/async/rw_spinlock.hpp>
+#include <core/ecs/entity_handle.hpp>
+#include <core/ecs/component_pool.hpp>
+
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <Optick/optick.h>
+
+/**
+ * @file query_view.hpp
+ */
+
+namespace legion::core::ecs
+{
+    /**@class query_view
+     * @brief Zero-copy view over the components of the entities found by an EntityQuery.
+     *        Components are referenced directly in their component_pool instead of being copied into the local containers of the query.
+     * @tparam component_types Types of the components to view, const qualify the types you only read from.
+     * @note The locks of all viewed component pools are held for read-only for the entire lifetime of the view.
+     *       Values can be modified in place, but creating or destroying components or entities while a view is alive is not allowed.
+     * @note Writes through a view do not raise any modification events.
+     * @note Calling EntityQuery::queryEntities or creating another view of the same query on the same thread invalidates the entity list of the view.
+     */
+    template<typename... component_types>
+    class query_view
+    {
+        static_assert(sizeof...(component_types) > 0, "A query view needs at least one component type.");
+
+    public:
+        template<typename component_type>
+        using pool_type = component_pool<std::remove_const_t<component_type>>;
+
+        /**@class iterator
+         * @brief Iterator that dereferences into a tuple of the entity and references to all its viewed components.
+         *        Allows for structured bindings: for (auto [entity, pos, rot] : view)
+         */
+        class iterator
+        {
+        private:
+            const query_view* m_view;
+            size_type m_index;
+
+        public:
+            iterator(const query_view* view, size_type index) noexcept : m_view(view), m_index(index) {}
+
+            L_NODISCARD std::tuple<entity_handle, component_types&...> operator*() const
+            {
+                return std::tuple_cat(std::make_tuple(m_view->entity(m_index)), (*m_view)[m_index]);
+            }
+
+            iterator& operator++() noexcept { m_index++; return *this; }
+            L_NODISCARD bool operator==(const iterator& other) const noexcept { return m_index == other.m_index; }
+            L_NODISCARD bool operator!=(const iterator& other) const noexcept { return m_index != other.m_index; }
+        };
+
+    private:
+        template<typename component_type>
+        using address_container = std::vector<std::remove_const_t<component_type>*>;
+
+        const entity_container& m_entities;
+        std::tuple<pool_type<component_types>*...> m_pools;
+        family_guard<component_types...> m_guard;
+        std::tuple<address_container<component_types>...> m_addresses;
+
+    public:
+        query_view(const entity_container& entities, pool_type<component_types>*... pools) : m_entities(entities), m_pools(pools...), m_guard(*pools...)
+        {
+            (std::get<pool_type<component_types>*>(m_pools)->get_component_addresses(m_entities, std::get<address_container<component_types>>(m_addresses)), ...);
+        }
+
+        query_view(const query_view&) = delete;
+        query_view& operator=(const query_view&) = delete;
+
+        /**@brief Amount of entities in the view.
+         */
+        L_NODISCARD size_type size() const noexcept { return m_entities.size(); }
+
+        /**@brief Get the entity at a certain index.
+         */
+        L_NODISCARD entity_handle entity(size_type index) const { return m_entities[index]; }
+
+        /**@brief Get a reference to a single component of the entity at a certain index.
+         * @tparam component_type One of the viewed component types, const qualifiers should match the ones of the view.
+         */
+        template<typename component_type>
+        L_NODISCARD component_type& get(size_type index) const
+        {
+            return *std::get<address_container<component_type>>(m_addresses)[index];
+        }
+
+        /**@brief Get references to all viewed components of the entity at a certain index.
+         */
+        L_NODISCARD std::tuple<component_types&...> operator[](size_type index) const
+        {
+            return std::tuple<component_types&...>(get<component_types>(index)...);
+        }
+
+        /**@brief Call a function for every entity in the view.
+         * @param func Function with signature void(entity_handle entity, component_types&... components).
+         */
+        template<typename Func>
+        void for_each(Func&& func) const
+        {
+            OPTICK_EVENT();
+            for (size_type i = 0; i < m_entities.size(); i++)
+                func(m_entities[i], get<component_types>(i)...);
+        }
+
+        L_NODISCARD iterator begin() const noexcept { return iterator(this, 0); }
+        L_NODISCARD iterator end() const noexcept { return iterator(this, m_entities.size()); }
+    };
+}
@@ -2,6 +2,7 @@
 #include <core/ecs/ecsregistry.hpp>
 #include <core/ecs/entity_handle.hpp>
 #include <core/ecs/entityquery.hpp>
+#include <core/common/exception.hpp>
 #include <algorithm>
 
 namespace legion::core::ecs
@@ -12,119 +13,237 @@ namespace legion::core::ecs
     thread_local std::unordered_map<id_type, std::unordered_map<id_type, std::unique_ptr<component_container_base>>> QueryRegistry::m_localComponents;
     time::clock<fast_time> QueryRegistry::m_clock;
 
-    void QueryRegistry::addComponentType(id_type queryId, id_type componentTypeId)
+    size_type QueryRegistry::getComponentBit(id_type componentTypeId)
     {
-        OPTICK_EVENT();
         {
-            async::readwrite_guard guard(m_componentLock); // In this case the lock handles both the sparse_map and the contained hashed_sparse_sets
-            m_componentTypes.at(queryId).insert(componentTypeId); // We insert the new component type we wish to track.
+            async::readonly_guard guard(m_bitLock);
+            auto itr = m_componentBits.find(componentTypeId);
+            if (itr != m_componentBits.end())
+                return itr->second;
         }
 
-        bool modified = false;
+        async::readwrite_guard guard(m_bitLock);
+        auto itr = m_componentBits.find(componentTypeId); // Another thread might have assigned a bit in the meantime.
+        if (itr != m_componentBits.end())
+            return itr->second;
 
-        // First we need to erase all the entities that no longer apply to the new query.
-        std::vector<entity_handle> toRemove;
+        size_type bit = m_componentBits.size();
+        if (bit >= max_component_types)
+            throw legion_exception_msg("Too many component types for the query component masks, increase legion::core::ecs::max_component_types.");
 
+        m_componentBits.emplace(componentTypeId, bit);
+        return bit;
+    }
+
+    component_mask QueryRegistry::createMask(const hashed_sparse_set<id_type>& componentTypes)
+    {
+        component_mask mask;
+        for (id_type componentTypeId : componentTypes)
+            mask.set(getComponentBit(componentTypeId));
+        return mask;
+    }
+
+    void QueryRegistry::updateQueryMask(id_type queryId, const component_mask& newMask)
+    {
+        m_queryMasks[queryId] = newMask;
+
+        for (auto& [componentTypeId, queries] : m_componentQueries) // Remove the query from the inverted index entries of types it no longer contains.
+            if (!m_componentTypes[queryId].contains(componentTypeId))
+                queries.erase(std::remove(queries.begin(), queries.end(), queryId), queries.end());
+
+        for (id_type componentTypeId : m_componentTypes[queryId])
         {
-            async::readonly_multiguard mguard(m_entityLock, m_componentLock);
-            auto& [_, entityList] = m_entityLists.at(queryId);
-            for (int i = 0; i < entityList.size(); i++) // Iterate over all tracked entities.
-            {
-                entity_handle entity = entityList.at(i); // Get the id from the keys of the map.
-                if (!m_registry.getEntityData(entity).components.contains(m_componentTypes[queryId])) // Check component composition
-                    toRemove.push_back(entity); // Mark for erasure if the component composition doesn't overlap with the query.
-            }
+            auto& queries = m_componentQueries[componentTypeId];
+            if (std::find(queries.begin(), queries.end(), queryId) == queries.end())
+                queries.push_back(queryId);
         }
+    }
+
+    component_mask QueryRegistry::updateEntityMask(mask_shard& shard, id_type entityId, size_type bit, bool removal)
+    {
+        component_mask& mask = shard.masks[entityId];
+        mask.set(bit, !removal);
+        return mask;
+    }
+
+    void QueryRegistry::updateQueryLists(id_type componentTypeId, const entity_container& entities, const std::vector<component_mask>& entityMasks)
+    {
+        // Only the queries that contain the changed component type can be affected.
+        auto queriesItr = m_componentQueries.find(componentTypeId);
+        if (queriesItr == m_componentQueries.end())
+            return;
 
-        if (toRemove.size() > 0)
+        for (id_type queryId : queriesItr->second)
         {
-            modified = true;
-            async::readwrite_guard guard(m_entityLock);
-            auto& [_, entityList] = m_entityLists.at(queryId);
-            for (entity_handle entity : toRemove)
-                entityList.erase(entity); // Erase all entities marked for erasure.
+            const component_mask& queryMask = m_queryMasks.at(queryId);
+            entity_list& list = *m_entityLists.at(queryId);
+            bool modified = false;
+
+            async::readwrite_guard listGuard(list.lock);
+            for (size_type i = 0; i < entities.size(); i++)
+            {
+                bool match = matches(queryMask, entityMasks[i]);
+                if (list.entities.contains(entities[i]))
+                {
+                    if (!match)
+                    {
+                        list.entities.erase(entities[i]); // Erase the entity from the query's tracking list if the component was removed from the entity.
+                        modified = true;
+                    }
+                }
+                else if (match)
+                {
+                    list.entities.insert(entities[i]); // If the entity also contains all the other required components for this query, then add this entity to the tracking list.
+                    modified = true;
+                }
+            }
+
+            if (modified)
+                list.lastModified = m_clock.elapsedTime();
         }
+    }
 
-        // Next we need to filter through all the entities to get all the new ones that apply to the new query.
+    void QueryRegistry::refilterEntities(id_type queryId, const component_mask& queryMask)
+    {
+        OPTICK_EVENT();
+        async::readonly_guard entguard(m_entityLock);
+        entity_list& list = *m_entityLists.at(queryId);
+
+        // All shards are locked before the list lock, the same order as the entity change evaluation. Shards always get locked in ascending order.
+        for (auto& shard : m_maskShards)
+            shard.lock.lock_shared();
 
-        auto [entities, entitiesLock] = m_registry.getEntities(); // getEntities returns a pair of both the container as well as the lock that should be locked by you when operating on it.
-        async::mixed_multiguard mguard(entitiesLock, async::lock_state_read, m_componentLock, async::lock_state_read, m_entityLock, async::lock_state_write); // Lock locks.
-        auto& [lastModified, entityList] = m_entityLists.at(queryId);
-        for (entity_handle entity : entities) // Iterate over all entities.
         {
-            if (entityList.contains(entity)) // If the entity is already tracked, continue to the next entity.
-                continue;
+            bool modified = false;
+            async::readwrite_guard listGuard(list.lock);
+
+            { // First we need to erase all the entities that no longer apply to the query.
+                std::vector<entity_handle> toRemove;
+                for (entity_handle entity : list.entities)
+                {
+                    auto& masks = getMaskShard(entity.get_id()).masks;
+                    auto itr = masks.find(entity.get_id());
+                    if (itr == masks.end() || !matches(queryMask, itr->second))
+                        toRemove.push_back(entity);
+                }
+
+                for (entity_handle entity : toRemove)
+                    list.entities.erase(entity);
 
-            if (m_registry.getEntityData(entity).components.contains(m_componentTypes[queryId])) // Check if the queried components completely overlaps the components in the entity.
+                modified = !toRemove.empty();
+            }
+
+            // Next we need to insert all the entities that newly apply to the query.
+            if (queryMask.none())
+            { // A query without any component types matches every entity, including the ones without any components.
+                auto [entities, entitiesLock] = m_registry.getEntities(); // getEntities returns a pair of both the container as well as the lock that should be locked by you when operating on it.
+                async::readonly_guard guard(entitiesLock);
+                for (entity_handle entity : entities)
+                    if (!list.entities.contains(entity))
+                    {
+                        list.entities.insert(entity);
+                        modified = true;
+                    }
+            }
+            else
             {
-                modified = true;
-                entityList.insert(entity); // Insert entity into tracking list.
+                for (auto& shard : m_maskShards)
+                    for (auto& [entityId, entityMask] : shard.masks)
+                        if (matches(queryMask, entityMask) && !list.entities.contains(entityId))
+                        {
+                            list.entities.insert(entity_handle(entityId));
+                            modified = true;
+                        }
             }
+
+            if (modified)
+                list.lastModified = m_clock.elapsedTime();
         }
 
-        if (modified)
-            lastModified = m_clock.elapsedTime();
+        for (auto& shard : m_maskShards)
+            shard.lock.unlock_shared();
     }
 
-    void QueryRegistry::removeComponentType(id_type queryId, id_type componentTypeId)
+    void QueryRegistry::addComponentType(id_type queryId, id_type componentTypeId)
     {
         OPTICK_EVENT();
+        component_mask queryMask;
+
         {
-            async::readwrite_guard guard(m_componentLock);
-            m_componentTypes[queryId].erase(componentTypeId); // Remove component from query list.
+            async::readwrite_guard guard(m_componentLock); // In this case the lock handles both the sparse_map and the contained hashed_sparse_sets
+            m_componentTypes.at(queryId).insert(componentTypeId); // We insert the new component type we wish to track.
+            queryMask = m_queryMasks[queryId];
+            queryMask.set(getComponentBit(componentTypeId));
+            updateQueryMask(queryId, queryMask);
         }
 
-        // Then we remove all the entities that no longer overlap with the query.
-        std::vector<entity_handle> toRemove;
+        refilterEntities(queryId, queryMask);
+    }
 
-        {
-            async::readonly_multiguard mguard(m_entityLock, m_componentLock);
-            auto& [_, entityList] = m_entityLists.at(queryId);
-            for (int i = 0; i < entityList.size(); i++) // Iterate over all tracked entities.
-            {
-                entity_handle entity = entityList.at(i); // Get the id from the keys of the map.
-                if (!m_registry.getEntity(entity).component_composition().contains(m_componentTypes[queryId])) // Check component composition
-                    toRemove.push_back(entity); // Mark for erasure if the component composition doesn't overlap with the query.
-            }
-        }
+    void QueryRegistry::removeComponentType(id_type queryId, id_type componentTypeId)
+    {
+        OPTICK_EVENT();
+        component_mask queryMask;
 
-        if (toRemove.size() > 0)
         {
-            async::readwrite_guard guard(m_entityLock);
-            auto& [lastModified, entityList] = m_entityLists.at(queryId);
-            lastModified = m_clock.elapsedTime();
-            for (entity_handle entity : toRemove)
-                entityList.erase(entity); // Erase all entities marked for erasure.
+            async::readwrite_guard guard(m_componentLock);
+            m_componentTypes[queryId].erase(componentTypeId); // Remove component from query list.
+            queryMask = m_queryMasks[queryId];
+            queryMask.reset(getComponentBit(componentTypeId));
+            updateQueryMask(queryId, queryMask);
         }
+
+        refilterEntities(queryId, queryMask);
     }
 
     void QueryRegistry::evaluateEntityChange(id_type entityId, id_type componentTypeId, bool removal)
     {
         OPTICK_EVENT();
-        entity_handle entity(entityId);
+        size_type bit = getComponentBit(componentTypeId);
+
+        async::readonly_multiguard mguard(m_entityLock, m_componentLock);
 
-        async::mixed_multiguard mmguard(m_entityLock, async::lock_state_write, m_componentLock, async::lock_state_read); // We lock now so that we don't need to reacquire the locks every iteration.
+        // Only the shard of this entity gets locked, changes to entities in other shards can be evaluated at the same time.
+        mask_shard& shard = getMaskShard(entityId);
+        async::readwrite_guard shardGuard(shard.lock);
 
-        for (int i = 0; i < m_entityLists.size(); i++)
+        entity_container entities{ entity_handle(entityId) };
+        std::vector<component_mask> entityMasks{ updateEntityMask(shard, entityId, bit, removal) };
+        updateQueryLists(componentTypeId, entities, entityMasks);
+    }
+
+    void QueryRegistry::evaluateEntityChanges(const std::vector<id_type>& entities, id_type componentTypeId, bool removal)
+    {
+        OPTICK_EVENT();
+        size_type bit = getComponentBit(componentTypeId);
+
+        // Group the entities per shard so every shard, and every affected query list per shard, only gets locked once.
+        std::array<std::vector<id_type>, mask_shard_count> shardEntities;
+        for (id_type entityId : entities)
+            shardEntities[entityId % mask_shard_count].push_back(entityId);
+
+        async::readonly_multiguard mguard(m_entityLock, m_componentLock);
+
+        entity_container handles;
+        std::vector<component_mask> entityMasks;
+
+        for (size_type i = 0; i < mask_shard_count; i++)
         {
-            id_type queryId = m_entityLists.keys()[i];
-            if (!m_componentTypes[queryId].contains(componentTypeId)) // This query doesn't care about this component type.
+            if (shardEntities[i].empty())
                 continue;
 
-            auto& [lastModified, entityList] = m_entityLists.at(queryId);
-            if (entityList.contains(entity))
-            {
-                if (removal)
-                {
-                    entityList.erase(entity); // Erase the entity from the query's tracking list if the component was removed from the entity.
-                    lastModified = m_clock.elapsedTime();
-                }
-            }
-            else if (m_registry.getEntityData(entityId).components.contains(m_componentTypes[queryId]))
+            mask_shard& shard = m_maskShards[i];
+            async::readwrite_guard shardGuard(shard.lock);
+
+            handles.clear();
+            entityMasks.clear();
+            for (id_type entityId : shardEntities[i])
             {
-                entityList.insert(entity); // If the entity also contains all the other required components for this query, then add this entity to the tracking list.
-                lastModified = m_clock.elapsedTime();
+                handles.emplace_back(entityId);
+                entityMasks.push_back(updateEntityMask(shard, entityId, bit, removal));
             }
+
+            updateQueryLists(componentTypeId, handles, entityMasks);
         }
     }
 
@@ -133,15 +252,30 @@ namespace legion::core::ecs
         OPTICK_EVENT();
         entity_handle entity(entityId);
 
-        async::readwrite_guard guard(m_entityLock);
-        for (int i = 0; i < m_entityLists.size(); i++) // Iterate over all query tracking lists.
+        async::readonly_multiguard mguard(m_entityLock, m_componentLock);
+
+        mask_shard& shard = getMaskShard(entityId);
+        async::readwrite_guard shardGuard(shard.lock);
+
+        component_mask entityMask;
+        auto itr = shard.masks.find(entityId);
+        if (itr != shard.masks.end())
+        {
+            entityMask = itr->second;
+            shard.masks.erase(itr);
+        }
+
+        for (auto& [queryId, queryMask] : m_queryMasks) // Only queries that match the composition of the entity can contain the entity.
         {
-            id_type queryId = m_entityLists.keys()[i];
-            auto& [lastModified, entityList] = m_entityLists.at(queryId);
-            if (entityList.contains(entity))
+            if (!matches(queryMask, entityMask))
+                continue;
+
+            entity_list& list = *m_entityLists.at(queryId);
+            async::readwrite_guard listGuard(list.lock);
+            if (list.entities.contains(entity))
             {
-                entityList.erase(entity); // Erase entity from tracking list if it's present.
-                lastModified = m_clock.elapsedTime();
+                list.entities.erase(entity); // Erase entity from tracking list if it's present.
+                list.lastModified = m_clock.elapsedTime();
             }
         }
     }
@@ -184,30 +318,27 @@ namespace legion::core::ecs
     {
         OPTICK_EVENT();
         id_type queryId;
+        component_mask queryMask = createMask(componentTypes);
 
         { // Write permitted critical section for m_entityLists
             async::readwrite_multiguard mguard(m_referenceLock, m_entityLock, m_componentLock);
 
             queryId = m_lastQueryId++;
-            m_entityLists.emplace(queryId); // Create a new entity tracking list.
+            m_entityLists.emplace(queryId, std::make_unique<entity_list>()); // Create a new entity tracking list.
 
             m_references.emplace(queryId); // Create a new reference count.
 
             m_componentTypes.emplace(queryId, componentTypes); // Insert component type list for query.
+            updateQueryMask(queryId, queryMask);
         }
 
-        { // Next we need to filter through all the entities to get all the new ones that apply to the new query.
-            auto [entities, entitiesLock] = m_registry.getEntities(); // getEntities returns a pair of both the container as well as the lock that should be locked by you when operating on it.
-            async::mixed_multiguard mguard(entitiesLock, async::lock_state_read, m_entityLock, async::lock_state_write); // Lock locks.
-            auto& [lastModified, entityList] = m_entityLists.at(queryId);
-
-            for (entity_handle entity : entities) // Iterate over all entities.
-                if (m_registry.getEntityData(entity).components.contains(componentTypes)) // Check if the queried components completely overlaps the components in the entity.
-                {
-                    entityList.insert(entity); // Insert entity into tracking list.
-                }
+        refilterEntities(queryId, queryMask); // Next we need to filter through all the entities to get all the new ones that apply to the new query.
 
-            lastModified = m_clock.elapsedTime();
+        {
+            async::readonly_guard guard(m_entityLock);
+            entity_list& list = *m_entityLists.at(queryId);
+            async::readwrite_guard listGuard(list.lock);
+            list.lastModified = m_clock.elapsedTime();
         }
 
         return queryId;
@@ -217,16 +348,23 @@ namespace legion::core::ecs
     {
         OPTICK_EVENT();
         async::readonly_multiguard entguard(m_entityLock, m_componentLock);
-        auto& [lastModified, entityList] = m_entityLists.at(queryId);
+        entity_list& list = *m_entityLists.at(queryId);
         auto& [localModified, localList] = m_localCopies[queryId];
-        if (lastModified > localModified)
+        bool outdated;
+
         {
+            OPTICK_EVENT("Get entities");
+            async::readonly_guard listGuard(list.lock);
+            outdated = list.lastModified > localModified;
+            if (outdated)
             {
-                OPTICK_EVENT("Get entities");
                 localList.clear();
-                localList.assign(entityList.begin(), entityList.end());
+                localList.assign(list.entities.begin(), list.entities.end());
             }
+        }
 
+        if (outdated)
+        {
             auto& localComps = m_localComponents[queryId];
             auto& compTypes = m_componentTypes.at(queryId);
 
@@ -256,6 +394,22 @@ namespace legion::core::ecs
         return localList;
     }
 
+    const entity_container& QueryRegistry::getEntityList(id_type queryId)
+    {
+        OPTICK_EVENT();
+        async::readonly_guard entguard(m_entityLock);
+        entity_list& list = *m_entityLists.at(queryId);
+        auto& [localModified, localList] = m_localCopies[queryId];
+        async::readonly_guard listGuard(list.lock);
+        if (list.lastModified > localModified)
+        {
+            localList.clear();
+            localList.assign(list.entities.begin(), list.entities.end());
+        }
+
+        return localList;
+    }
+
     component_container_base& QueryRegistry::getComponents(id_type queryId, id_type componentTypeId)
     {
         return *m_localComponents.at(queryId).at(componentTypeId);
@@ -295,6 +449,9 @@ namespace legion::core::ecs
             m_references.erase(queryId);
             m_entityLists.erase(queryId);
             m_componentTypes.erase(queryId);
+            m_queryMasks.erase(queryId);
+            for (auto& [componentTypeId, queries] : m_componentQueries)
+                queries.erase(std::remove(queries.begin(), queries.end(), queryId), queries.end());
         }
     }
 
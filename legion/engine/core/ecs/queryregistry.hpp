@@ -7,6 +7,12 @@
 #include <core/ecs/component_container.hpp>
 #include <core/time/clock.hpp>
 
+#include <array>
+#include <bitset>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 /**
  * @file queryregistry.hpp
  */
@@ -19,6 +25,14 @@ namespace legion::core::ecs
     using entity_set = hashed_sparse_set<entity_handle>;
     using entity_container = std::vector<entity_handle>;
 
+    /**@brief Maximum amount of different component types that queries can distinguish between.
+     */
+    constexpr size_type max_component_types = 256;
+
+    /**@brief Component composition of an entity or query, every component type gets assigned its own bit.
+     */
+    using component_mask = std::bitset<max_component_types>;
+
     /**@class QueryRegistry
      * @brief Main manager and owner of all queries and query related objects.
      */
@@ -28,8 +42,17 @@ namespace legion::core::ecs
     private:
         EcsRegistry& m_registry;
 
+        /**@brief Tracking list of the entities that match a single query.
+         */
+        struct entity_list
+        {
+            mutable async::rw_spinlock lock; // Guards the content of this list, m_entityLock only guards the existence of the list.
+            float lastModified = 0.f;
+            entity_set entities;
+        };
+
         mutable async::rw_spinlock m_entityLock;
-        sparse_map<id_type, std::pair<float, entity_set>> m_entityLists;
+        std::unordered_map<id_type, std::unique_ptr<entity_list>> m_entityLists;
 
         static thread_local std::unordered_map<id_type, std::pair<float, entity_container>> m_localCopies;
         static thread_local std::unordered_map<id_type, std::unordered_map<id_type, std::unique_ptr<component_container_base>>> m_localComponents;
@@ -40,6 +63,25 @@ namespace legion::core::ecs
 
         mutable async::rw_spinlock m_componentLock;
         sparse_map<id_type, hashed_sparse_set<id_type>> m_componentTypes;
+        std::unordered_map<id_type, component_mask> m_queryMasks;
+        std::unordered_map<id_type, std::vector<id_type>> m_componentQueries; // Inverted index from component type to the queries that contain it.
+
+        mutable async::rw_spinlock m_bitLock;
+        std::unordered_map<id_type, size_type> m_componentBits;
+
+        /**@brief Part of the compositions of all entities. Entities are spread over the shards by id,
+         *        so structural changes to different entities rarely wait on each other.
+         */
+        struct mask_shard
+        {
+            mutable async::fast_rw_spinlock lock; // Stays locked until the query lists are updated, so changes to one entity reach the lists in order.
+            std::unordered_map<id_type, component_mask> masks;
+        };
+
+        static constexpr size_type mask_shard_count = 64;
+        std::array<mask_shard, mask_shard_count> m_maskShards;
+
+        mask_shard& getMaskShard(id_type entityId) noexcept { return m_maskShards[entityId % mask_shard_count]; }
 
         id_type m_lastQueryId = 1;
 
@@ -53,10 +95,46 @@ namespace legion::core::ecs
          */
         id_type addQuery(const hashed_sparse_set<id_type>& componentTypes);
 
+        /**@brief Get the bit that represents a component type in a component_mask, assigns a new bit to unknown types.
+         * @throws legion::core::exception When more than max_component_types component types are in use.
+         */
+        size_type getComponentBit(id_type componentTypeId);
+
+        /**@brief Get the component_mask of a set of component types.
+         */
+        component_mask createMask(const hashed_sparse_set<id_type>& componentTypes);
+
+        /**@brief Set the mask and inverted index entries of a query.
+         * @note m_componentLock needs to be locked for write.
+         */
+        void updateQueryMask(id_type queryId, const component_mask& newMask);
+
+        /**@brief Set or clear a single bit of the composition of an entity.
+         * @return component_mask The new composition of the entity.
+         * @note The lock of the shard needs to be locked for write.
+         */
+        static component_mask updateEntityMask(mask_shard& shard, id_type entityId, size_type bit, bool removal);
+
+        /**@brief Insert the entities into, or erase them from the lists of the queries that contain a certain component type.
+         * @note m_entityLock, m_componentLock and the locks of the shards of the entities need to be locked.
+         */
+        void updateQueryLists(id_type componentTypeId, const entity_container& entities, const std::vector<component_mask>& entityMasks);
+
+        /**@brief Erase all entities that don't match the query anymore from the list and insert all entities that do.
+         */
+        void refilterEntities(id_type queryId, const component_mask& queryMask);
+
+        /**@brief Check whether an entity with a certain composition is relevant to a query.
+         */
+        static bool matches(const component_mask& queryMask, const component_mask& entityMask) noexcept
+        {
+            return (queryMask & ~entityMask).none();
+        }
+
     public:
         static bool isValid(QueryRegistry* reg) { return m_validRegistries.contains(reg); }
 
-        QueryRegistry(EcsRegistry& registry) : m_registry(registry), m_entityLists(), m_componentTypes() { m_validRegistries.insert(this); }
+        QueryRegistry(EcsRegistry& registry) : m_registry(registry), m_entityLists(), m_componentTypes(), m_queryMasks(), m_componentQueries() { m_validRegistries.insert(this); }
 
         ~QueryRegistry()
         {
@@ -90,6 +168,13 @@ namespace legion::core::ecs
          */
         void evaluateEntityChange(id_type entityId, id_type componentTypeId, bool removal);
 
+        /**@brief Mark the same change in component composition for multiple entities, only locking every affected query once.
+         * @param entities Ids of the entities in question.
+         * @param componentTypeId Type id of component that was added or removed.
+         * @param removal Whether the component was added or removed.
+         */
+        void evaluateEntityChanges(const std::vector<id_type>& entities, id_type componentTypeId, bool removal);
+
         /**@brief Mark an entity destruction. (removes entity from all queries.
          * @param entityId Id of the entity in question.
          */
@@ -151,6 +236,12 @@ namespace legion::core::ecs
          */
         const entity_container& getEntities(id_type queryId);
 
+        /**@brief Get the handles of all entities that have all components of the query without copying any of their components.
+         * @param queryId Id of the query to get the entities from.
+         * @return const entity_container& Thread local copy of the entity list, shared with getEntities.
+         */
+        const entity_container& getEntityList(id_type queryId);
+
         component_container_base& getComponents(id_type queryId, id_type componentTypeId);
         void submit(id_type queryId, id_type componentTypeId);
 
@@ -44,7 +44,13 @@ namespace legion::core
 
         inline static events::EventBus* eventbus;
 
-        Engine(int argc, char** argv) : m_modules(), m_eventbus(), m_ecs(&m_eventbus), m_cliargs(argv, argv + argc),
+        Engine(int argc, char** argv) : m_modules(), m_eventbus(),
+#if defined(LEGION_ECS_ARCHETYPE_STORAGE)
+            m_ecs(&m_eventbus, ecs::storage_mode::archetype),
+#else
+            m_ecs(&m_eventbus),
+#endif
+            m_cliargs(argv, argv + argc),
 #if defined(LEGION_LOW_POWER)
             m_scheduler(&m_eventbus, true, LEGION_MIN_THREADS)
 #else
@@ -61,6 +67,7 @@ namespace legion::core
             SystemBase::m_scheduler = &m_scheduler;
             ecs::component_handle_base::m_registry = &m_ecs;
             ecs::component_handle_base::m_eventBus = &m_eventbus;
+            ecs::EntityQuery::m_scheduler = &m_scheduler;
             scenemanagement::SceneManager::m_ecs = &m_ecs;
 
             reportModule<CoreModule>();
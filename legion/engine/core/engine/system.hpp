@@ -38,8 +38,11 @@ namespace legion::core
     class System : public SystemBase
     {
     protected:
+        /**@brief Create a process that executes a member function of the system and hook it into a process-chain.
+         * @return scheduling::Process* The created process, use it to declare component access or ordering so it can run concurrently with other processes.
+         */
         template <void(SelfType::* func_type)(time::time_span<fast_time>), size_type charc>
-        void createProcess(const char(&processChainName)[charc], time::time_span<fast_time> interval = 0)
+        scheduling::Process* createProcess(const char(&processChainName)[charc], time::time_span<fast_time> interval = 0)
         {
             OPTICK_EVENT();
             std::string name = std::string(processChainName) + nameOfType<SelfType>() + std::to_string(interval) + std::to_string(force_cast<intptr_t>(func_type)[0]);
@@ -49,9 +52,10 @@ namespace legion::core
             m_processes.insert(id, std::move(process));
 
             m_scheduler->hookProcess<charc>(processChainName, m_processes[id].get());
+            return m_processes[id].get();
         }
 
-        void createProcess(cstring processChainName, delegate<void(time::time_span<fast_time>)>&& operation, time::time_span<fast_time> interval = 0)
+        scheduling::Process* createProcess(cstring processChainName, delegate<void(time::time_span<fast_time>)>&& operation, time::time_span<fast_time> interval = 0)
         {
             OPTICK_EVENT();
             std::string name = std::string(processChainName) + nameOfType<SelfType>() + std::to_string(interval);
@@ -62,6 +66,7 @@ namespace legion::core
             m_processes.insert(id, std::move(process));
 
             m_scheduler->hookProcess(processChainName, m_processes[id].get());
+            return m_processes[id].get();
         }
 
         void destroyProcess(cstring processChainName, time::time_span<fast_time> interval = 0)
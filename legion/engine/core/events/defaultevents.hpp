@@ -41,6 +41,11 @@ namespace legion::core::events
 
     };
 
+    /**@struct component_modification
+     * @brief Raised when a component gets written through a component_handle.
+     * @note Opt-in, only raised for component types that enabled change events with EcsRegistry::setChangeEvents.
+     *       Writes through a query_view or EntityQuery::parallel_for never raise it.
+     */
     template<typename component_type>
     struct component_modification : public event<component_modification<component_type>>
     {
@@ -57,6 +62,10 @@ namespace legion::core::events
 
     };
 
+    /**@struct bulk_component_modification
+     * @brief Raised when the components of a query get submitted with EntityQuery::submit.
+     * @note Opt-in just like component_modification.
+     */
     template<typename component_type>
     struct bulk_component_modification : public event<bulk_component_modification<component_type>>
     {
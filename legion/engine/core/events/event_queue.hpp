@@ -0,0 +1,151 @@
+#pragma once
+#include <core/types/primitives.hpp>
+#include <core/types/type_util.hpp>
+#include <core/platform/platform.hpp>
+#include <core/containers/delegate.hpp>
+#include <core/async/rw_spinlock.hpp>
+#include <core/async/mpmc_queue.hpp>
+#include <core/events/event.hpp>
+
+#include <Optick/optick.h>
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file event_queue.hpp
+ */
+
+namespace legion::core::events
+{
+    /**@brief Amount of events a deferred event queue can hold before it spills over to the heap.
+     */
+    constexpr size_type default_event_queue_capacity = 1024;
+
+    /**@class event_queue_base
+     * @brief Type erased base of event_queue so the EventBus can flush all queues without knowing their types.
+     */
+    class event_queue_base
+    {
+    protected:
+        id_type m_dispatchPoint;
+        std::atomic_bool m_deferred = { true };
+
+    public:
+        explicit event_queue_base(id_type dispatchPoint) : m_dispatchPoint(dispatchPoint) {}
+        virtual ~event_queue_base() = default;
+
+        /**@brief Id of the process-chain at the end of which the queued events get delivered.
+         */
+        L_NODISCARD id_type dispatchPoint() const noexcept { return m_dispatchPoint; }
+        void setDispatchPoint(id_type dispatchPoint) noexcept { m_dispatchPoint = dispatchPoint; }
+
+        /**@brief Whether new events of this type should be queued or delivered immediately.
+         *        Queues are never destroyed while the bus is alive, so a producer that raced with a change of this flag can still safely push.
+         */
+        L_NODISCARD bool deferred() const noexcept { return m_deferred.load(std::memory_order_relaxed); }
+        void setDeferred(bool deferred) noexcept { m_deferred.store(deferred, std::memory_order_relaxed); }
+
+        /**@brief Deliver all queued events to the subscribers and return their storage to the pool.
+         * @param callbacks Subscribers of the event type, may be nullptr in which case the events are just discarded.
+         * @return size_type Amount of events that were delivered.
+         */
+        virtual size_type flush(const multicast_delegate<void(event_base*)>* callbacks) LEGION_PURE;
+    };
+
+    /**@class event_queue
+     * @brief Lock-free queue of events of a single type that get delivered in one batch by a single consumer.
+     *        Event storage is allocated once up front and recycled, producers only take a free slot and publish it.
+     * @note Only when more events are raised between two flushes than the capacity allows are the remaining events allocated on the heap.
+     *       Those overflowing events are delivered after the pooled ones, so ordering is only guaranteed within the capacity of the queue.
+     * @tparam event_type Type of the events in the queue.
+     */
+    template<typename event_type>
+    class event_queue final : public event_queue_base
+    {
+    private:
+        using storage_type = std::aligned_storage_t<sizeof(event_type), alignof(event_type)>;
+
+        const size_type m_capacity;
+        std::unique_ptr<storage_type[]> m_pool;
+        async::mpmc_queue<storage_type> m_free;
+        async::mpmc_queue<event_type> m_pending;
+
+        async::fast_rw_spinlock m_overflowLock;
+        std::vector<std::unique_ptr<event_type>> m_overflow;
+
+    public:
+        event_queue(id_type dispatchPoint, size_type capacity = default_event_queue_capacity)
+            : event_queue_base(dispatchPoint), m_capacity(capacity), m_pool(new storage_type[capacity]), m_free(capacity), m_pending(capacity)
+        {
+            for (size_type i = 0; i < capacity; i++)
+                (void)m_free.try_push(&m_pool[i]); // Is fine because the free list has at least capacity slots.
+        }
+
+        event_queue(const event_queue&) = delete;
+        event_queue& operator=(const event_queue&) = delete;
+
+        ~event_queue()
+        {
+            while (event_type* event = m_pending.try_pop())
+                event->~event_type();
+        }
+
+        /**@brief Construct an event in the queue. Safe to call from any amount of threads simultaneously.
+         */
+        template<typename... Args>
+        void emplace(Args&&... arguments)
+        {
+            if (storage_type* slot = m_free.try_pop())
+            {
+                event_type* event = new (slot) event_type(std::forward<Args>(arguments)...);
+                (void)m_pending.try_push(event); // Is fine because the pending queue is at least as large as the pool.
+                return;
+            }
+
+            auto event = std::make_unique<event_type>(std::forward<Args>(arguments)...);
+            async::readwrite_guard guard(m_overflowLock);
+            m_overflow.push_back(std::move(event));
+        }
+
+        size_type flush(const multicast_delegate<void(event_base*)>* callbacks) override
+        {
+            OPTICK_EVENT();
+            OPTICK_TAG("Event", nameOfType<event_type>());
+
+            // Same reinterpretation as EventBus::raiseEvent, subscribers were bound using the concrete event type.
+            auto* typedCallbacks = reinterpret_cast<const multicast_delegate<void(event_type*)>*>(callbacks);
+            size_type count = 0;
+
+            // Subscribers might raise events of the same type, limit the batch so that can't keep us here forever.
+            event_type* event;
+            while (count < m_capacity && (event = m_pending.try_pop()))
+            {
+                if (typedCallbacks)
+                    typedCallbacks->invoke(event);
+
+                event->~event_type();
+                (void)m_free.try_push(reinterpret_cast<storage_type*>(event)); // Is fine because every slot comes from the pool.
+                count++;
+            }
+
+            std::vector<std::unique_ptr<event_type>> overflow;
+            {
+                async::readwrite_guard guard(m_overflowLock);
+                overflow.swap(m_overflow);
+            }
+
+            for (auto& overflowed : overflow)
+            {
+                if (typedCallbacks)
+                    typedCallbacks->invoke(overflowed.get());
+                count++;
+            }
+
+            return count;
+        }
+    };
+}
@@ -0,0 +1,41 @@
+#include <core/events/eventbus.hpp>
+
+namespace legion::core::events
+{
+    void EventBus::notifyUnsafe(event_base* value, id_type id)
+    {
+        if (auto callbacks = getCallbacks(id))
+        {
+            OPTICK_EVENT("Event callbacks");
+            OPTICK_TAG("Event", detail::eventNames[id].c_str());
+            callbacks->invoke(value);
+        }
+    }
+
+    size_type EventBus::flushQueue(event_queue_base* queue, id_type id)
+    {
+        auto callbacks = getCallbacks(id);
+        return queue->flush(callbacks.get());
+    }
+
+    size_type EventBus::dispatchEvents(id_type dispatchPoint)
+    {
+        OPTICK_EVENT();
+
+        // Collect the queues first so subscribers can defer other event types while we're dispatching.
+        std::vector<std::pair<id_type, event_queue_base*>> queues;
+
+        {
+            async::readonly_guard guard(m_queueLock);
+            for (auto [id, queue] : m_queues)
+                if (dispatchPoint == invalid_id || queue->dispatchPoint() == dispatchPoint)
+                    queues.emplace_back(id, queue.get());
+        }
+
+        size_type count = 0;
+        for (auto [id, queue] : queues)
+            count += flushQueue(queue, id);
+
+        return count;
+    }
+}
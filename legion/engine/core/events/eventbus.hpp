@@ -4,10 +4,15 @@
 #include <core/containers/hashed_sparse_set.hpp>
 #include <core/types/types.hpp>
 #include <core/events/event.hpp>
+#include <core/events/event_queue.hpp>
+#include <core/async/rw_spinlock.hpp>
 
 #include <Optick/optick.h>
 
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <vector>
 
 /**@file eventbus.hpp
  */
@@ -19,12 +24,82 @@ namespace legion::core::events
      */
     class EventBus
     {
+        mutable async::fast_rw_spinlock m_eventLock;
         sparse_map<id_type, hashed_sparse_set<std::shared_ptr<event_base>>> m_events;
-        sparse_map<id_type, multicast_delegate<void(event_base*)>> m_eventCallbacks;
+
+        using callback_list = multicast_delegate<void(event_base*)>;
+
+        // Invocation lists are copy-on-write, binding swaps in a new list so subscribers can be invoked without holding the lock.
+        // That way subscribers are free to raise events and bind new subscribers themselves.
+        mutable async::fast_rw_spinlock m_callbackLock;
+        sparse_map<id_type, std::shared_ptr<const callback_list>> m_eventCallbacks;
+
+        mutable async::fast_rw_spinlock m_queueLock;
+        sparse_map<id_type, std::unique_ptr<event_queue_base>> m_queues;
+
+        /**@brief Get the queue of an event type if the type is currently deferred.
+         */
+        template<typename event_type>
+        event_queue<event_type>* getDeferredQueue() const
+        {
+            async::readonly_guard guard(m_queueLock);
+            if (!m_queues.contains(event_type::id))
+                return nullptr;
+
+            auto* queue = m_queues[event_type::id].get();
+            return queue->deferred() ? static_cast<event_queue<event_type>*>(queue) : nullptr;
+        }
+
+        /**@brief Get a snapshot of the subscribers of an event type, nullptr if there are none.
+         *        The snapshot stays valid and unchanged if subscribers get bound while it's being invoked.
+         */
+        std::shared_ptr<const callback_list> getCallbacks(id_type id) const
+        {
+            async::readonly_guard guard(m_callbackLock);
+            if (!m_eventCallbacks.contains(id))
+                return nullptr;
+            return m_eventCallbacks[id];
+        }
+
+        /**@brief Store the event if it's persistent and either queue it or notify all subscribers.
+         * @param event Event to deliver. Rvalues get moved from when the event needs to be stored or queued, lvalues get copied
+         *        and are otherwise handed to the subscribers in place.
+         * @param callbacks Snapshot of the subscribers from getCallbacks, may be nullptr.
+         */
+        template<typename event_type, typename source_type>
+        void deliverEvent(source_type&& event, event_queue<event_type>* queue, const callback_list* callbacks)
+        {
+            static_assert(!std::is_const_v<std::remove_reference_t<source_type>>, "Subscribers receive mutable events, read-only events need to be copied first.");
+            event_type* eventptr = &event;
+
+            if (event.persistent())
+            {
+                async::readwrite_guard guard(m_eventLock);
+                if (!(event.unique() && m_events.contains(event_type::id) && m_events[event_type::id].size()))
+                {
+                    eventptr = new event_type(std::forward<source_type>(event));
+                    m_events[event_type::id].emplace(eventptr); // If it's persistent keep the event stored. (Or at least keep it somewhere fetch able.)
+                }
+            }
+            else if (queue)
+            {
+                queue->emplace(std::forward<source_type>(event)); // Subscribers get notified when the queue is flushed.
+                return;
+            }
+
+            if (callbacks)
+            {
+                OPTICK_EVENT("Event callbacks");
+                OPTICK_TAG("Event", nameOfType<event_type>());
+                // Reinterpret instead of force_value_cast to avoid copying the entire invocation list on every raise.
+                reinterpret_cast<const multicast_delegate<void(event_type*)>*>(callbacks)->invoke(eventptr); // Notify.
+            }
+        }
 
     public:
 
         /**@brief Insert event into bus and notify all subscribers.
+         * @note Safe to call from any thread. If the event type is deferred and not persistent then the subscribers only get notified when the queue gets dispatched.
          * @tparam event_type Event type to raise.
          * @param arguments Arguments to pass to the constructor of the event.
          */
@@ -32,58 +107,158 @@ namespace legion::core::events
         void raiseEvent(Args&&... arguments)
         {
             OPTICK_EVENT();
-            event_type* eventptr;
-
             event_type event(arguments...); // Create new event.
-            if (event.persistent() && !(event.unique() && m_events[event_type::id].size()))
-            {
-                eventptr = new event_type(std::move(event));
-                m_events[event_type::id].emplace(eventptr); // If it's persistent keep the event stored. (Or at least keep it somewhere fetch able.)
-            }
-            else
-                eventptr = &event;
+            event_queue<event_type>* queue = getDeferredQueue<event_type>();
+
+            std::shared_ptr<const callback_list> callbacks;
+            if (!queue || event.persistent()) // Queued events only need the subscribers once they get dispatched.
+                callbacks = getCallbacks(event_type::id);
+
+            deliverEvent<event_type>(std::move(event), queue, callbacks.get());
+        }
 
-            if (m_eventCallbacks.contains(event_type::id))
+        /**@brief Raise a batch of events of the same type, the locks and queue are only looked up once for the entire batch.
+         * @note Events are delivered straight from the range. Subscribers get pointers to the elements of mutable ranges,
+         *       events that need to be stored or queued are moved out of the range when using std::make_move_iterator and copied otherwise.
+         *       Only read-only ranges need a copy of every event.
+         * @tparam event_type Event type to raise.
+         * @param first Iterator to the first event to raise.
+         * @param last Iterator past the last event to raise.
+         */
+        template<typename event_type, typename Iterator, typename = inherits_from<event_type, event<event_type>>>
+        void raiseEvents(Iterator first, Iterator last)
+        {
+            OPTICK_EVENT();
+            event_queue<event_type>* queue = getDeferredQueue<event_type>();
+
+            // A single snapshot of the subscribers serves the entire batch.
+            std::shared_ptr<const callback_list> callbacks = getCallbacks(event_type::id);
+
+            for (; first != last; ++first)
             {
-                OPTICK_EVENT("Event callbacks");
-                OPTICK_TAG("Event", nameOfType<event_type>());
-                force_value_cast<multicast_delegate<void(event_type*)>>(m_eventCallbacks[event_type::id]).invoke(eventptr); // Notify.
+                if constexpr (std::is_const_v<std::remove_reference_t<decltype(*first)>>)
+                {
+                    event_type event(*first);
+                    deliverEvent<event_type>(std::move(event), queue, callbacks.get());
+                }
+                else
+                    deliverEvent<event_type>(*first, queue, callbacks.get());
             }
         }
 
+        /**@brief Raise a batch of events of the same type, subscribers receive the elements of the vector in place.
+         * @ref raiseEvents(Iterator first, Iterator last)
+         */
+        template<typename event_type, typename = inherits_from<event_type, event<event_type>>>
+        void raiseEvents(std::vector<event_type>& events)
+        {
+            raiseEvents<event_type>(events.begin(), events.end());
+        }
+
+        /**@brief Raise a batch of events of the same type, events that need to be stored or queued are moved out of the vector.
+         * @ref raiseEvents(Iterator first, Iterator last)
+         */
+        template<typename event_type, typename = inherits_from<event_type, event<event_type>>>
+        void raiseEvents(std::vector<event_type>&& events)
+        {
+            raiseEvents<event_type>(std::make_move_iterator(events.begin()), std::make_move_iterator(events.end()));
+        }
+
+        /**@brief Raise a batch of events of the same type, every event gets copied.
+         * @ref raiseEvents(Iterator first, Iterator last)
+         */
+        template<typename event_type, typename = inherits_from<event_type, event<event_type>>>
+        void raiseEvents(const std::vector<event_type>& events)
+        {
+            raiseEvents<event_type>(events.begin(), events.end());
+        }
+
         void raiseEvent(std::unique_ptr<event_base>&& value)
         {
             OPTICK_EVENT();
-            if (value->persistent() && !(value->unique() && m_events[value->get_id()].size()))
-            {
-                m_events[value->get_id()].emplace(value.release()); // If it's persistent keep the event stored. (Or at least keep it somewhere fetch able.)
-            }
+            raiseEventUnsafe(std::move(value), value->get_id());
+        }
+
+        void raiseEventUnsafe(std::unique_ptr<event_base>&& value, id_type id)
+        {
+            OPTICK_EVENT();
+
+            event_base* eventptr = value.get();
 
-            if (m_eventCallbacks.contains(value->get_id()))
+            if (value->persistent())
             {
-                OPTICK_EVENT("Event callbacks");
-                OPTICK_TAG("Event", detail::eventNames[value->get_id()].c_str());
-                m_eventCallbacks[value->get_id()].invoke(value.get());
+                async::readwrite_guard guard(m_eventLock);
+                if (!(value->unique() && m_events.contains(id) && m_events[id].size()))
+                    m_events[id].emplace(value.release()); // If it's persistent keep the event stored. (Or at least keep it somewhere fetch able.)
             }
+
+            notifyUnsafe(eventptr, id);
         }
 
-        void raiseEventUnsafe(std::unique_ptr<event_base>&& value, id_type id)
+        /**@brief Make events of a certain type get queued instead of being delivered immediately to the subscribers.
+         *        All queued events are delivered in one batch at the end of the chosen process-chain's iteration.
+         * @note Persistent events are never deferred.
+         * @note Deferred events are moved into a pre-allocated pool, so event types that reference data owned by the raising code (like bulk_component_modification) shouldn't be deferred.
+         * @tparam event_type Event type to defer.
+         * @param dispatchPoint Id of the process-chain after which the events should be delivered, see ProcessChain::id().
+         * @param capacity Amount of events that can be queued between dispatches without heap allocations. Only applies the first time a type gets deferred.
+         */
+        template<typename event_type, typename = inherits_from<event_type, event<event_type>>>
+        void deferEvent(id_type dispatchPoint, size_type capacity = default_event_queue_capacity)
         {
             OPTICK_EVENT();
-
-            if (value->persistent() && !(value->unique() && m_events[id].size()))
+            async::readwrite_guard guard(m_queueLock);
+            if (m_queues.contains(event_type::id))
             {
-                m_events[id].emplace(value.release()); // If it's persistent keep the event stored. (Or at least keep it somewhere fetch able.)
+                auto& queue = m_queues[event_type::id];
+                queue->setDispatchPoint(dispatchPoint);
+                queue->setDeferred(true);
             }
+            else
+                m_queues[event_type::id] = std::make_unique<event_queue<event_type>>(dispatchPoint, capacity);
+        }
+
+        template<typename event_type, size_type charc, typename = inherits_from<event_type, event<event_type>>>
+        void deferEvent(const char(&processChainName)[charc], size_type capacity = default_event_queue_capacity)
+        {
+            deferEvent<event_type>(nameHash<charc>(processChainName), capacity);
+        }
 
-            if (m_eventCallbacks.contains(id))
+        /**@brief Stop deferring an event type, any events that are still queued get delivered immediately.
+         * @tparam event_type Event type to deliver immediately again.
+         */
+        template<typename event_type, typename = inherits_from<event_type, event<event_type>>>
+        void undeferEvent()
+        {
+            OPTICK_EVENT();
+            event_queue_base* queue;
             {
-                OPTICK_EVENT("Event callbacks");
-                OPTICK_TAG("Event", detail::eventNames[value->get_id()].c_str());
-                m_eventCallbacks[id].invoke(value.get());
+                async::readonly_guard guard(m_queueLock);
+                if (!m_queues.contains(event_type::id))
+                    return;
+
+                queue = m_queues[event_type::id].get();
+                queue->setDeferred(false);
             }
+
+            flushQueue(queue, event_type::id);
         }
 
+        /**@brief Check whether events of a certain type are currently being deferred.
+         */
+        template<typename event_type, typename = inherits_from<event_type, event<event_type>>>
+        L_NODISCARD bool isDeferred() const
+        {
+            return getDeferredQueue<event_type>() != nullptr;
+        }
+
+        /**@brief Deliver all queued events that should be dispatched at a certain process-chain.
+         * @note Gets called by every process-chain after each iteration, only one thread may dispatch a dispatch point at a time.
+         * @param dispatchPoint Id of the process-chain, or invalid_id to deliver all queued events regardless of where they should be dispatched.
+         * @return size_type Amount of events delivered.
+         */
+        size_type dispatchEvents(id_type dispatchPoint = invalid_id);
+
         /**@brief Check if an event is active.
          * @tparam event_type Event type to check for.
          */
@@ -91,6 +266,7 @@ namespace legion::core::events
         bool checkEvent() const
         {
             OPTICK_EVENT();
+            async::readonly_guard guard(m_eventLock);
             return m_events.contains(event_type::id) && m_events[event_type::id].size();
         }
 
@@ -101,6 +277,7 @@ namespace legion::core::events
         size_type getEventCount() const
         {
             OPTICK_EVENT();
+            async::readonly_guard guard(m_eventLock);
             if (m_events.contains(event_type::id))
                 return m_events[event_type::id].size();
             return 0;
@@ -170,12 +347,23 @@ namespace legion::core::events
         void bindToEvent(delegate<void(event_type*)> callback)
         {
             OPTICK_EVENT();
-            m_eventCallbacks[event_type::id] += force_value_cast<delegate<void(event_base*)>>(callback);
+            bindToEventUnsafe(event_type::id, force_value_cast<delegate<void(event_base*)>>(callback));
         }
 
+        /**@brief Link a type erased callback to an event type.
+         * @note Safe to call from inside a subscriber, the new callback only gets notified of events raised after the bind.
+         */
         void bindToEventUnsafe(id_type id, delegate<void(event_base*)> callback)
         {
-            m_eventCallbacks[id] += callback;
+            async::readwrite_guard guard(m_callbackLock);
+            // Copy the list instead of modifying it, it might be getting invoked on another thread or further up this thread's stack.
+            auto callbacks = m_eventCallbacks.contains(id) ? std::make_shared<callback_list>(*m_eventCallbacks[id]) : std::make_shared<callback_list>();
+            *callbacks += callback;
+            m_eventCallbacks[id] = std::move(callbacks);
         }
+
+    private:
+        void notifyUnsafe(event_base* value, id_type id);
+        size_type flushQueue(event_queue_base* queue, id_type id);
     };
 }
@@ -1,4 +1,5 @@
 #pragma once
 #include <core/events/event.hpp>
 #include <core/events/defaultevents.hpp>
+#include <core/events/event_queue.hpp>
 #include <core/events/eventbus.hpp>
\ No newline at end of file
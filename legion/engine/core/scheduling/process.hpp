@@ -28,6 +28,14 @@ namespace legion::core::scheduling
         time::clock<fast_time> m_clock;
         bool m_fixedTimeStep;
         bool firstStep = true;
+
+        hashed_sparse_set<id_type> m_reads;
+        hashed_sparse_set<id_type> m_writes;
+        hashed_sparse_set<id_type> m_runAfter;
+        hashed_sparse_set<id_type> m_runBefore;
+        bool m_declaredAccess = false;
+        bool m_chainThreadBound = false;
+
     public:
 
         template<size_type charc>
@@ -46,6 +54,92 @@ namespace legion::core::scheduling
 
         bool inUse() const { return m_hooks.size(); }
 
+        /**@brief Declare component types the operation of this process reads from.
+         * @note Processes that declared their component access can run concurrently with other processes in the same chain that don't conflict with them.
+         *       Processes that never declared anything are assumed to touch everything and always run on the thread of the chain, in hook order.
+         */
+        template<typename... component_types>
+        Process* reads()
+        {
+            (m_reads.insert(typeHash<component_types>()), ...);
+            m_declaredAccess = true;
+            return this;
+        }
+
+        /**@brief Declare component types the operation of this process writes to, creates or destroys.
+         * @ref Process::reads()
+         */
+        template<typename... component_types>
+        Process* writes()
+        {
+            (m_writes.insert(typeHash<component_types>()), ...);
+            m_declaredAccess = true;
+            return this;
+        }
+
+        /**@brief Make sure this process only runs after another process in the same chain has finished.
+         */
+        Process* runAfter(id_type processId)
+        {
+            m_runAfter.insert(processId);
+            return this;
+        }
+
+        Process* runAfter(const Process* process) { return runAfter(process->id()); }
+
+        /**@brief Make sure this process has finished before another process in the same chain starts.
+         */
+        Process* runBefore(id_type processId)
+        {
+            m_runBefore.insert(processId);
+            return this;
+        }
+
+        Process* runBefore(const Process* process) { return runBefore(process->id()); }
+
+        /**@brief Keep the process on the thread of its chain, for operations that need resources that belong to that thread like a graphics context.
+         * @note The declared access is still used to order the process, it just won't be handed to the worker threads.
+         */
+        Process* bindToChainThread()
+        {
+            m_chainThreadBound = true;
+            return this;
+        }
+
+        /**@brief Whether the process has to run on the thread of its chain.
+         */
+        bool chainThreadBound() const { return m_chainThreadBound || !m_declaredAccess; }
+
+        /**@brief Whether the process declared which components it accesses and is thus allowed to run concurrently with other processes.
+         */
+        bool declaredAccess() const { return m_declaredAccess; }
+
+        /**@brief Check if this process is explicitly ordered to run before another process.
+         */
+        bool isOrderedBefore(const Process& other) const
+        {
+            return m_runBefore.contains(other.m_nameHash) || other.m_runAfter.contains(m_nameHash);
+        }
+
+        /**@brief Check if this process and another process can't safely run at the same time.
+         *        Processes conflict if either of them hasn't declared its access or if one of them writes to a component the other one accesses.
+         */
+        bool conflictsWith(const Process& other) const
+        {
+            if (!m_declaredAccess || !other.m_declaredAccess)
+                return true;
+
+            for (id_type typeId : m_writes)
+                if (other.m_writes.contains(typeId) || other.m_reads.contains(typeId))
+                    return true;
+
+            for (id_type typeId : other.m_writes)
+                if (m_reads.contains(typeId))
+                    return true;
+
+            return false;
+        }
+
         /**@brief Set the operation for the process to execute at the set interval.
          */
         void setOperation(delegate<void(time::time_span<fast_time>)>&& operation)
@@ -99,21 +99,152 @@ namespace legion::core::scheduling
             m_onFrameStart();
         }
 
-        hashed_sparse_set<id_type> finishedProcesses;
-        async::readonly_guard guard(m_processesLock); // Hooking more processes whilst executing isn't allowed.
-        do
         {
-            for (auto [id, process] : m_processes)
-                if (!finishedProcesses.contains(id))
-                    if (process->execute(m_scheduler->getTimeScale())) // If the process wasn't finished then execute it and check if it's finished now.
-                        finishedProcesses.insert(id);
+            async::readonly_guard guard(m_processesLock); // Hooking more processes whilst executing isn't allowed.
+            m_timeScale = m_scheduler->getTimeScale();
 
-        } while (finishedProcesses.size() != m_processes.size() && !m_exit->load(std::memory_order_acquire));
+            if (buildGraph())
+            {
+                // The graph keeps the nodes of removed processes around for reuse, only the ones of hooked processes get executed.
+                m_pendingNodes->store(m_processes.size(), std::memory_order_release);
+
+                for (size_type i = 0; i < m_processes.size(); i++)
+                    m_graph[i]->dependencies.store(m_graph[i]->dependencyCount, std::memory_order_relaxed);
+
+                for (size_type i = 0; i < m_processes.size(); i++)
+                    if (!m_graph[i]->dependencyCount)
+                        dispatchNode(m_graph[i].get());
+
+                // Jobs reference this chain, so we need to wait for all of them even if we're exiting.
+                while (m_pendingNodes->load(std::memory_order_acquire))
+                {
+                    if (graph_node* node = m_chainQueue->try_pop())
+                    {
+                        executeNode(node);
+                    }
+                    else
+                    {
+                        L_PAUSE_INSTRUCTION();
+                        std::this_thread::yield();
+                    }
+                }
+            }
+            else
+            {
+                for (auto [id, process] : m_processes)
+                    while (!process->execute(m_timeScale) && !m_exit->load(std::memory_order_acquire)); // If the process wasn't finished then execute it again until it is.
+            }
+        }
 
         {
             async::readonly_guard guard(m_callbackLock);
             m_onFrameEnd();
         }
+
+        m_scheduler->m_eventBus->dispatchEvents(m_nameHash); // Deliver the events that were deferred to this chain.
+    }
+
+    bool ProcessChain::buildGraph()
+    {
+        OPTICK_EVENT();
+        size_type processCount = m_processes.size();
+
+        while (m_graph.size() < processCount)
+            m_graph.push_back(std::make_unique<graph_node>());
+
+        if (!m_chainQueue || m_chainQueueCapacity < processCount)
+        {
+            m_chainQueueCapacity = processCount;
+            m_chainQueue = std::make_unique<async::mpmc_queue<graph_node>>(processCount);
+        }
+
+        size_type i = 0;
+        for (auto [id, process] : m_processes)
+        {
+            graph_node& node = *m_graph[i++];
+            node.process = process;
+            node.index = i - 1;
+            node.successors.clear();
+            node.dependencyCount = 0;
+            node.chainBound = process->chainThreadBound() || !m_scheduler;
+        }
+
+        // Conflicting processes run in hook order unless they were explicitly ordered the other way around.
+        for (i = 0; i < processCount; i++)
+            for (size_type j = i + 1; j < processCount; j++)
+            {
+                graph_node* first = m_graph[i].get();
+                graph_node* second = m_graph[j].get();
+
+                if (second->process->isOrderedBefore(*first->process))
+                    std::swap(first, second);
+                else if (!first->process->isOrderedBefore(*second->process) && !first->process->conflictsWith(*second->process))
+                    continue;
+
+                first->successors.push_back(second);
+                second->dependencyCount++;
+            }
+
+        { // Check for cycles caused by explicit ordering.
+            std::vector<size_type> dependencies;
+            std::vector<graph_node*> ready;
+            dependencies.reserve(processCount);
+
+            for (i = 0; i < processCount; i++)
+            {
+                dependencies.push_back(m_graph[i]->dependencyCount);
+                if (!m_graph[i]->dependencyCount)
+                    ready.push_back(m_graph[i].get());
+            }
+
+            size_type visited = 0;
+            while (!ready.empty())
+            {
+                graph_node* node = ready.back();
+                ready.pop_back();
+                visited++;
+
+                for (graph_node* successor : node->successors)
+                    if (--dependencies[successor->index] == 0)
+                        ready.push_back(successor);
+            }
+
+            if (visited != processCount)
+            {
+                if (!m_cycleReported)
+                    log::error("Process chain {} has a cycle in the ordering of its processes, running processes serially instead.", m_name);
+                m_cycleReported = true;
+                return false;
+            }
+        }
+
+        m_cycleReported = false;
+        return true;
+    }
+
+    void ProcessChain::dispatchNode(graph_node* node)
+    {
+        if (node->chainBound)
+        {
+            // Is fine because every node only gets dispatched once per iteration and the queue has room for all of them.
+            (void)m_chainQueue->try_push(node);
+        }
+        else
+        {
+            m_scheduler->queueJobs(1, [this, node]() { executeNode(node); });
+        }
+    }
+
+    void ProcessChain::executeNode(graph_node* node)
+    {
+        // If the process wasn't finished then execute it again until it is.
+        while (!node->process->execute(m_timeScale) && !m_exit->load(std::memory_order_acquire));
+
+        for (graph_node* successor : node->successors)
+            if (successor->dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                dispatchNode(successor);
+
+        m_pendingNodes->fetch_sub(1, std::memory_order_acq_rel);
     }
 
     void ProcessChain::addProcess(Process* process)
@@ -4,8 +4,11 @@
 #include <core/types/type_util.hpp>
 #include <core/containers/containers.hpp>
 #include <core/async/transferable_atomic.hpp>
+#include <core/async/mpmc_queue.hpp>
 
 #include <thread>
+#include <memory>
+#include <vector>
 
 /**@file processchain.hpp
  */
@@ -18,10 +21,29 @@ namespace legion::core::scheduling
 	/**@class ProcessChain
 	 * @brief Chain of processes that either run in a separate thread or on the main thread.
 	 * @note If chain is to run on a separate thread, then the chain has it's own program loop. ProcessChain::exit() needs to be called in order to end the thread.
+	 * @note Every iteration the chain builds a dependency graph of its processes using their declared component access and explicit ordering.
+	 *       Processes that don't depend on each other run concurrently on the worker threads of the scheduler.
 	 */
 	class ProcessChain
 	{
 	private:
+		struct graph_node
+		{
+			Process* process;
+			size_type index;
+			std::vector<graph_node*> successors;
+			size_type dependencyCount;
+			std::atomic<size_type> dependencies;
+			bool chainBound; // Processes without declared access or that were bound to the chain thread stay on the thread of the chain.
+		};
+
+		std::vector<std::unique_ptr<graph_node>> m_graph;
+		std::unique_ptr<async::mpmc_queue<graph_node>> m_chainQueue;
+		size_type m_chainQueueCapacity = 0;
+		async::transferable_atomic<size_type> m_pendingNodes;
+		float m_timeScale = 1.f;
+		bool m_cycleReported = false;
+
 		std::string m_name;
 		id_type m_nameHash = invalid_id;
 		std::thread::id m_threadId;
@@ -104,10 +126,26 @@ namespace legion::core::scheduling
 		void exit();
 
 		/**@brief Runs one iteration of the process-chains program loop without creating a new thread.
-		 * @note Loops through all hooked processes and executes them until they are all finished.
+		 * @note Executes all hooked processes until they are all finished, independent processes get executed concurrently on the worker threads.
 		 */
 		void runInCurrentThread();
 
+	private:
+		/**@brief Rebuild the dependency graph of the hooked processes.
+		 * @return bool False if the declared ordering contains a cycle, in which case the processes need to run serially.
+		 */
+		bool buildGraph();
+
+		/**@brief Hand a process that has no unfinished dependencies left to either the chain thread or the worker threads.
+		 */
+		void dispatchNode(graph_node* node);
+
+		/**@brief Execute a process and dispatch all processes that were only waiting on it.
+		 */
+		void executeNode(graph_node* node);
+
+	public:
+
 		/**@brief Hook a process for execution with this chain.
 		 */
 		void addProcess(Process* process);
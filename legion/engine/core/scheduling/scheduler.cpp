@@ -13,15 +13,152 @@ namespace legion::core::scheduling
     async::rw_spinlock Scheduler::m_availabilityLock;
     uint Scheduler::m_availableThreads = static_cast<uint>(math::ceil((m_maxThreadCount * 0.5f) - reserved_threads) + math::epsilon<float>()); // subtract OS and this_thread, and then leave some extra for miscellaneous processes.
 
-    async::rw_spinlock Scheduler::m_jobQueueLock;
-    std::queue<std::shared_ptr<async::job_pool_base>> Scheduler::m_jobs;
-    std::unordered_map<std::thread::id, async::rw_spinlock> Scheduler::m_commandLocks;
-    std::unordered_map<std::thread::id, std::queue<std::unique_ptr<runnable_base>>> Scheduler::m_commands;
+    async::fast_rw_spinlock Scheduler::m_workersLock;
+    std::unordered_map<std::thread::id, std::unique_ptr<Scheduler::worker_state>> Scheduler::m_workers;
+    std::vector<Scheduler::worker_state*> Scheduler::m_workerList;
+    thread_local Scheduler::worker_state* Scheduler::m_localWorker = nullptr;
 
-    void Scheduler::threadMain(bool* exit, bool* start, bool lowPower)
+    async::mpmc_queue<Scheduler::job_ref> Scheduler::m_injectionQueue;
+    async::mpmc_queue<Scheduler::job_ref> Scheduler::m_freeJobRefs;
+
+    std::mutex Scheduler::m_parkLock;
+    std::condition_variable Scheduler::m_parkSignal;
+    std::atomic<size_type> Scheduler::m_workEpoch = { 0 };
+    std::atomic<uint> Scheduler::m_parkedWorkers = { 0 };
+
+    // Amount of failed searches for work before a worker parks itself.
+    constexpr uint spin_rounds = 64;
+    constexpr uint low_power_spin_rounds = 4;
+
+    Scheduler::worker_state* Scheduler::getWorker(std::thread::id id)
+    {
+        {
+            async::readonly_guard guard(m_workersLock);
+            auto itr = m_workers.find(id);
+            if (itr != m_workers.end())
+                return itr->second.get();
+        }
+
+        async::readwrite_guard guard(m_workersLock);
+        auto& worker = m_workers[id];
+        if (!worker)
+            worker = std::make_unique<worker_state>();
+        return worker.get();
+    }
+
+    Scheduler::job_ref* Scheduler::acquireJobRef(const std::shared_ptr<async::job_pool_base>& jobPool)
+    {
+        if (job_ref* ref = m_freeJobRefs.try_pop())
+        {
+            *ref = jobPool;
+            return ref;
+        }
+
+        return new job_ref(jobPool);
+    }
+
+    void Scheduler::releaseJobRef(job_ref* ref)
+    {
+        ref->reset(); // Don't keep finished pools alive while the job_ref waits to be reused.
+        if (!m_freeJobRefs.try_push(ref))
+            delete ref;
+    }
+
+    void Scheduler::pushJobPool(job_ref* jobPool)
+    {
+        if (m_localWorker)
+        {
+            m_localWorker->jobs.push(jobPool);
+        }
+        else
+        {
+            while (!m_injectionQueue.try_push(jobPool)) // Queue is full, the workers will make room soon.
+                std::this_thread::yield();
+        }
+
+        wakeWorkers();
+    }
+
+    Scheduler::job_ref* Scheduler::findJobPool(worker_state* self, size_type& victim)
     {
-        std::thread::id id = std::this_thread::get_id();
+        OPTICK_EVENT();
+        if (job_ref* jobPool = self->jobs.pop())
+            return jobPool;
+
+        if (job_ref* jobPool = m_injectionQueue.try_pop())
+            return jobPool;
+
+        // m_workerList doesn't change after the workers have started so it can be read without locking.
+        for (size_type i = 0; i < m_workerList.size(); i++)
+        {
+            worker_state* other = m_workerList[victim];
+            victim = (victim + 1) % m_workerList.size();
+
+            if (other == self)
+                continue;
+
+            if (job_ref* jobPool = other->jobs.steal())
+                return jobPool;
+        }
+
+        return nullptr;
+    }
+
+    void Scheduler::runJob(worker_state* self, job_ref* jobPool)
+    {
+        job_ref pool = *jobPool; // Keep the pool alive, once requeued another worker might delete the job_ref.
+
+        async::job_range range;
+        if (!pool->pop_job(range))
+        {
+            releaseJobRef(jobPool); // Remaining jobs are all taken, pool can be dropped from the queues.
+            return;
+        }
+
+        if (pool->empty())
+        {
+            releaseJobRef(jobPool);
+        }
+        else
+        {
+            self->jobs.push(jobPool);
+
+            // Hand out an extra reference to the pool so that woken workers can help out instead of stealing the only reference.
+            if (m_parkedWorkers.load(std::memory_order_relaxed))
+            {
+                self->jobs.push(acquireJobRef(pool));
+                wakeWorkers();
+            }
+        }
+
+        {
+            OPTICK_EVENT("Executing job");
+            pool->execute_job(range);
+        }
+
+        pool->complete_job(range);
+    }
 
+    void Scheduler::wakeWorkers(bool all)
+    {
+        m_workEpoch.fetch_add(1, std::memory_order_seq_cst);
+
+        if (m_parkedWorkers.load(std::memory_order_seq_cst))
+        {
+            // Taking the lock makes sure a worker that's about to park either sees the new epoch or is already waiting for the signal.
+            {
+                std::lock_guard guard(m_parkLock);
+            }
+
+            if (all)
+                m_parkSignal.notify_all();
+            else
+                m_parkSignal.notify_one();
+        }
+    }
+
+    void Scheduler::threadMain(bool* exit, bool* start, bool lowPower)
+    {
         while (!(*start))
         {
             if (lowPower)
@@ -30,88 +167,80 @@ namespace legion::core::scheduling
                 std::this_thread::yield();
         }
 
+        worker_state* self = getWorker(std::this_thread::get_id());
+
+        size_type victim = 0;
+        for (size_type i = 0; i < m_workerList.size(); i++)
+            if (m_workerList[i] == self)
+                victim = (i + 1) % m_workerList.size();
+
+        const uint maxSpinRounds = lowPower ? low_power_spin_rounds : spin_rounds;
+        uint spinRounds = 0;
+
+        m_localWorker = self;
 
         while (!(*exit))
         {
             OPTICK_EVENT();
-            runnable_base* instruction = nullptr;
 
+            if (self->commandCount.load(std::memory_order_acquire))
             {
-                OPTICK_EVENT("Fetching command");
-                async::readonly_guard guard(m_commandLocks[id], async::wait_priority_normal);
-                if (!m_commands[id].empty())
-                    instruction = m_commands[id].front().get();
-            }
+                std::unique_ptr<runnable_base> instruction;
 
-            if (instruction)
-            {
                 {
-                    OPTICK_EVENT("Executing command");
-                    instruction->execute();
+                    OPTICK_EVENT("Fetching command");
+                    async::readwrite_guard guard(self->commandLock);
+                    instruction = std::move(self->commands.front());
+                    self->commands.pop();
                 }
 
-                {
-                    async::readwrite_guard guard(m_commandLocks[id], async::wait_priority_normal);
-                    m_commands[id].pop();
-                }
-                instruction = nullptr;
-            }
+                self->commandCount.fetch_sub(1, std::memory_order_relaxed);
 
-            {
-                OPTICK_EVENT("Fetching job");
-                async::readonly_guard guard(m_jobQueueLock, async::wait_priority_normal);
-                if (!m_jobs.empty())
+                // Commands can take over the thread (process chains do), jobs queued from a command shouldn't end up in a deque nobody pops from.
+                m_localWorker = nullptr;
                 {
-                    instruction = m_jobs.front()->pop_job();
+                    OPTICK_EVENT("Executing command");
+                    instruction->execute();
                 }
+                m_localWorker = self;
             }
 
-            if (instruction)
-            {
-                async::readonly_guard guard(m_jobQueueLock);
-                auto pool = m_jobs.front();
-                while (instruction && !pool->is_done())
-                {
-                    {
-                        OPTICK_EVENT("Executing job");
-                        instruction->execute();
-                    }
+            size_type epoch = m_workEpoch.load(std::memory_order_seq_cst);
 
-                    {
-                        OPTICK_EVENT("Fetching job");
-                        pool->complete_job();
-                        instruction = pool->pop_job();
-                        if (!instruction)
-                        {
-                            tryCompleteJobPool();
-                        }
-                    }
-                }
+            if (job_ref* jobPool = findJobPool(self, victim))
+            {
+                runJob(self, jobPool);
+                spinRounds = 0;
+                continue;
             }
-            else
+
+            if (spinRounds++ < maxSpinRounds)
             {
                 if (lowPower)
-                {
-                    std::this_thread::sleep_for(std::chrono::microseconds(1));
-                }
-                else
-                {
                     std::this_thread::yield();
-                }
+                else
+                    L_PAUSE_INSTRUCTION();
+                continue;
             }
-        }
-    }
 
-    void Scheduler::tryCompleteJobPool()
-    {
-        async::readwrite_guard wguard(m_jobQueueLock);
-        if (!m_jobs.empty())
-        {
-            if (m_jobs.front()->is_done())
+            spinRounds = 0;
+
             {
-                m_jobs.pop();
+                OPTICK_EVENT("Parked");
+                std::unique_lock lock(m_parkLock);
+                m_parkedWorkers.fetch_add(1, std::memory_order_seq_cst);
+
+                // Wakes up on new work, new commands or engine exit. The timeout only catches steals that lost a race right before parking.
+                m_parkSignal.wait_for(lock, std::chrono::milliseconds(10), [&]()
+                    {
+                        return *exit || m_workEpoch.load(std::memory_order_seq_cst) != epoch || self->commandCount.load(std::memory_order_acquire);
+                    });
+
+                m_parkedWorkers.fetch_sub(1, std::memory_order_relaxed);
             }
         }
+
+        m_localWorker = nullptr;
     }
 
     Scheduler::Scheduler(events::EventBus* eventBus, bool lowPower, uint minThreads) : m_eventBus(eventBus), m_lowPower(lowPower)
@@ -130,10 +259,7 @@ namespace legion::core::scheduling
 
         std::thread::id id;
         while ((id = createThread(threadMain, &m_threadsShouldTerminate, &m_threadsShouldStart, m_lowPower)) != invalid_thread_id)
-        {
-            m_commands[id];
-            m_commandLocks[id];
-        }
+            m_workerList.push_back(getWorker(id));
 
         m_threadsShouldStart = true;
 
@@ -146,9 +272,21 @@ namespace legion::core::scheduling
             processChain.exit();
 
         m_threadsShouldTerminate = true;
+        wakeWorkers(true);
 
         for (auto [_, thread] : m_threads)
             thread->join();
+
+        // Clean up the references to pools that never got picked up.
+        while (job_ref* jobPool = m_injectionQueue.try_pop())
+            delete jobPool;
+
+        for (auto* worker : m_workerList)
+            while (job_ref* jobPool = worker->jobs.pop())
+                delete jobPool;
+
+        while (job_ref* ref = m_freeJobRefs.try_pop())
+            delete ref;
     }
 
     void Scheduler::run()
@@ -257,6 +395,7 @@ namespace legion::core::scheduling
             processChain.exit();
 
         m_threadsShouldTerminate = true;
+        wakeWorkers(true);
         m_syncLock.force_release();
 
         size_type exits;
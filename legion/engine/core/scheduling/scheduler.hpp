@@ -10,6 +10,8 @@
 #include <core/async/job_pool.hpp>
 #include <core/async/async_runnable.hpp>
 #include <core/async/thread_util.hpp>
+#include <core/async/work_stealing_deque.hpp>
+#include <core/async/mpmc_queue.hpp>
 
 #include <Optick/optick.h>
 
@@ -19,6 +21,8 @@
 #include <sstream>
 #include <limits>
 #include <queue>
+#include <mutex>
+#include <condition_variable>
 
 /**@file scheduler.hpp
  */
@@ -37,6 +41,7 @@ namespace legion::core::scheduling
     {
     private:
         friend struct legion::core::async::job_pool_base;
+        friend class ProcessChain;
         struct thread_error
         {
             std::string message;
@@ -76,14 +81,64 @@ namespace legion::core::scheduling
         static async::rw_spinlock m_availabilityLock;
         static uint m_availableThreads;
 
-        static async::rw_spinlock m_jobQueueLock;
-        static std::queue<std::shared_ptr<async::job_pool_base>> m_jobs;
-        static std::unordered_map<std::thread::id, async::rw_spinlock> m_commandLocks;
-        static std::unordered_map<std::thread::id, std::queue<std::unique_ptr<runnable_base>>> m_commands;
+        using job_ref = std::shared_ptr<async::job_pool_base>;
+
+        /**@brief State owned by a single worker thread.
+         * @note Job pools are referenced by heap allocated job_refs so they can be passed around lock-free.
+         *       Whoever takes a job_ref out of a queue or deque owns it and needs to either requeue or release it.
+         */
+        struct worker_state
+        {
+            async::work_stealing_deque<job_ref> jobs;
+            async::fast_rw_spinlock commandLock;
+            std::queue<std::unique_ptr<runnable_base>> commands;
+            std::atomic<size_type> commandCount{ 0 };
+        };
+
+        static async::fast_rw_spinlock m_workersLock;
+        static std::unordered_map<std::thread::id, std::unique_ptr<worker_state>> m_workers;
+        static std::vector<worker_state*> m_workerList;
+        static thread_local worker_state* m_localWorker;
+
+        static async::mpmc_queue<job_ref> m_injectionQueue;
+        static async::mpmc_queue<job_ref> m_freeJobRefs; // Released job_refs, reused so queueing a pool doesn't allocate one.
+
+        static std::mutex m_parkLock;
+        static std::condition_variable m_parkSignal;
+        static std::atomic<size_type> m_workEpoch;
+        static std::atomic<uint> m_parkedWorkers;
 
         static void threadMain(bool* exit, bool* start, bool lowPower);
 
-        static void tryCompleteJobPool();
+        /**@brief Get the state of a thread, creates the state if the thread didn't have any yet.
+         */
+        static worker_state* getWorker(std::thread::id id);
+
+        /**@brief Get a job_ref to a pool from the free list, only allocates a new one if the free list is empty.
+         */
+        static job_ref* acquireJobRef(const std::shared_ptr<async::job_pool_base>& jobPool);
+
+        /**@brief Drop the reference to the pool and return the job_ref to the free list, deletes it if the free list is full.
+         */
+        static void releaseJobRef(job_ref* ref);
+
+        /**@brief Hand a job pool to the workers. Jobs queued from a worker thread go into that worker's own deque,
+         *        jobs queued from any other thread go into the shared injection queue.
+         */
+        static void pushJobPool(job_ref* jobPool);
+
+        /**@brief Find a job pool to work on, looks in the local deque first, then the injection queue and then tries to steal from other workers.
+         * @param victim Index of the next worker to try and steal from, gets updated so consecutive searches spread out over all workers.
+         */
+        static job_ref* findJobPool(worker_state* self, size_type& victim);
+
+        /**@brief Execute a single job from a job pool and requeue the pool if it has jobs left.
+         */
+        static void runJob(worker_state* self, job_ref* jobPool);
+
+        /**@brief Wake parked workers after new work or commands became available.
+         */
+        static void wakeWorkers(bool all = false);
 
     public:
 
@@ -149,24 +204,113 @@ namespace legion::core::scheduling
         {
             OPTICK_EVENT("legion::core::scheduling::Scheduler::sendCommand<T>");
             async::async_runnable<Func>* command = new async::async_runnable<Func>(func);
-            async::readwrite_guard guard(m_commandLocks[id]);
-            m_commands[id].push(std::unique_ptr<runnable_base>(command));
+            worker_state* worker = getWorker(id);
+            {
+                async::readwrite_guard guard(worker->commandLock);
+                worker->commands.push(std::unique_ptr<runnable_base>(command));
+            }
+            worker->commandCount.fetch_add(1, std::memory_order_release);
+            wakeWorkers(true); // Commands are meant for one specific thread, we can't tell which one parked thread will wake up.
             return command->getOperation([&](std::thread::id id, auto func) { return sendCommand(id, func); });
         }
 
+        /**@brief Queue a pool of jobs that all execute the same function, use async::this_job::get_id() to find out which job is running.
+         * @note Pools get distributed over the workers through work stealing, multiple independent pools can be in flight at the same time.
+         * @return async::job_operation Operation that can be waited on, waiting with normal or real-time priority helps execute the jobs.
+         */
         template<typename Func>
         auto queueJobs(size_type count, const Func& func)
         {
             auto repeater = [&](size_type count, auto func) { return queueJobs(count, func); };
-            auto onComplete = [&]() {tryCompleteJobPool(); };
+            auto onComplete = []() {}; // Finished pools get dropped lazily by the workers.
 
             if (!count)
                 return async::job_operation<decltype(repeater), decltype(onComplete)>(std::shared_ptr<async::async_progress>(nullptr), std::shared_ptr<async::job_pool_base>(nullptr), repeater, onComplete);
 
             OPTICK_EVENT("legion::core::scheduling::Scheduler::queueJobs<T>");
             std::shared_ptr<async::job_pool_base> jobPool = std::shared_ptr<async::job_pool_base>(new async::job_pool<Func>(count, func));
-            async::readwrite_guard guard(m_jobQueueLock);
-            m_jobs.push(jobPool);
+            pushJobPool(acquireJobRef(jobPool));
+            return async::job_operation<decltype(repeater), decltype(onComplete)>(jobPool->get_progress(), jobPool, repeater, onComplete);
+        }
+
+        /**@brief Queue a parallel loop over the indices [start, stop) where every job processes a contiguous block of indices.
+         *        Far cheaper than queueJobs for large amounts of small items since the per-job overhead is only paid once per block.
+         * @param grain Amount of indices per job, 0 lets the block size adapt to the measured cost per item.
+         * @param func Function that takes an async::job_range, async::this_job::get_id() returns the first index of the range.
+         * @return async::job_operation Operation that can be waited on, waiting with normal or real-time priority helps execute the jobs.
+         */
+        template<typename Func>
+        auto queueRangeJobs(size_type start, size_type stop, size_type grain, const Func& func)
+        {
+            auto repeater = [&](size_type start, size_type stop, size_type grain, auto func) { return queueRangeJobs(start, stop, grain, func); };
+            auto onComplete = []() {};
+
+            if (stop <= start)
+                return async::job_operation<decltype(repeater), decltype(onComplete)>(std::shared_ptr<async::async_progress>(nullptr), std::shared_ptr<async::job_pool_base>(nullptr), repeater, onComplete);
+
+            OPTICK_EVENT("legion::core::scheduling::Scheduler::queueRangeJobs<T>");
+            std::shared_ptr<async::job_pool_base> jobPool = std::shared_ptr<async::job_pool_base>(new async::range_job_pool<Func>(start, stop, grain, m_maxThreadCount, func));
+            pushJobPool(acquireJobRef(jobPool));
+            return async::job_operation<decltype(repeater), decltype(onComplete)>(jobPool->get_progress(), jobPool, repeater, onComplete);
+        }
+
+        /**@brief Queue a parallel reduction over the indices [start, stop).
+         *        Every job reduces its own block of indices, the partial results are then merged using combine.
+         * @param grain Amount of indices per job, 0 lets the block size adapt to the measured cost per item.
+         * @param identity Value to start the result with, also the result if the range is empty.
+         * @param func Function that takes an async::job_range and returns the partial result of that range.
+         * @param combine Function that merges two results into one, needs to be associative and commutative since partial results get merged in any order.
+         * @return async::reduce_operation Operation to wait on, use get() to retrieve the result.
+         */
+        template<typename T, typename Func, typename CombineFunc>
+        auto queueRangeReduce(size_type start, size_type stop, size_type grain, const T& identity, const Func& func, const CombineFunc& combine)
+        {
+            struct reduce_state
+            {
+                async::fast_rw_spinlock lock;
+                T result;
+            };
+
+            auto state = std::make_shared<reduce_state>();
+            state->result = identity;
+            std::shared_ptr<T> result(state, &state->result);
+
+            auto operation = queueRangeJobs(start, stop, grain, [state, func, combine](const async::job_range& range)
+                {
+                    T partial = func(range);
+
+                    async::readwrite_guard guard(state->lock);
+                    state->result = combine(state->result, partial);
+                });
+
+            return async::reduce_operation<T, decltype(operation)>(operation, result);
+        }
+
+        /**@brief Queue a pool of jobs that only becomes available to the workers once another operation is done.
+         *        Unlike async_operation::then this doesn't block the calling thread, which makes it safe to use for nested parallelism from inside jobs.
+         * @param dependency Operation to wait on, anything with an on_complete member function like async_operation or job_operation.
+         * @return async::job_operation Operation of the new pool, waiting on it won't execute any jobs before the dependency is done.
+         */
+        template<typename OperationType, typename Func>
+        auto queueJobsAfter(const OperationType& dependency, size_type count, const Func& func)
+        {
+            auto repeater = [&](size_type count, auto func) { return queueJobs(count, func); };
+            auto onComplete = []() {};
+
+            if (!count)
+                return async::job_operation<decltype(repeater), decltype(onComplete)>(std::shared_ptr<async::async_progress>(nullptr), std::shared_ptr<async::job_pool_base>(nullptr), repeater, onComplete);
+
+            OPTICK_EVENT("legion::core::scheduling::Scheduler::queueJobsAfter<T>");
+            std::shared_ptr<async::job_pool_base> jobPool = std::shared_ptr<async::job_pool_base>(new async::job_pool<Func>(count, func));
+            jobPool->set_ready(false);
+
+            job_ref* entry = acquireJobRef(jobPool);
+            dependency.on_complete([entry]()
+                {
+                    (*entry)->set_ready(true);
+                    pushJobPool(entry);
+                });
+
             return async::job_operation<decltype(repeater), decltype(onComplete)>(jobPool->get_progress(), jobPool, repeater, onComplete);
         }
 
@@ -45,18 +45,6 @@ namespace legion::physics
 
     }
 
-    void HalfEdgeFace::deleteEdges()
-    {
-        HalfEdgeEdge* current = startEdge->nextEdge;
-        do
-        {
-            if (current->prevEdge->pairingEdge && current->prevEdge->pairingEdge->pairingEdge == current) current->prevEdge->pairingEdge->pairingEdge = nullptr;
-            delete current->prevEdge;
-            current = current->nextEdge;
-        } while (current != startEdge && current != nullptr);
-        startEdge = nullptr;
-    }
-
     void HalfEdgeFace::setFaceForAllEdges()
     {
         HalfEdgeEdge* current = startEdge;
@@ -377,9 +365,6 @@ namespace legion::physics
             face->centroid = faceCenter / static_cast<float>(edgeCount);
         }
 
-        delete middleEdge.pairingEdge;
-        delete& middleEdge;
-
         return face;
     }
 
@@ -394,19 +379,4 @@ namespace legion::physics
 
         forEachEdge(drawFunc);
     }
-
-    HalfEdgeFace::~HalfEdgeFace()
-    {
-        auto deleteFunc = [](HalfEdgeEdge* edge)
-        {
-            if (edge->pairingEdge && edge->pairingEdge && edge->pairingEdge->pairingEdge == edge)
-            {
-                edge->pairingEdge->pairingEdge = nullptr;
-            }
-            delete edge;
-        };
-
-        forEachEdge(deleteFunc);
-
-    }
 }
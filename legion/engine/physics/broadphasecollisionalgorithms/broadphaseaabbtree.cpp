@@ -0,0 +1,523 @@
+#include <physics/broadphasecollisionalgorithms/broadphaseaabbtree.hpp>
+
+namespace legion::physics
+{
+    const std::vector<std::vector<physics_manifold_precursor>>& BroadphaseAABBTree::collectPairs(
+        std::vector<physics_manifold_precursor>&& manifoldPrecursors)
+    {
+        OPTICK_EVENT();
+
+        std::vector<std::pair<size_type, size_type>> pairs;
+        collectUniquePairs(manifoldPrecursors, pairs);
+
+        m_groupings.resize(pairs.size());
+        for (size_type i = 0; i < pairs.size(); i++)
+        {
+            m_groupings[i].clear();
+            m_groupings[i].push_back(manifoldPrecursors[pairs[i].first]);
+            m_groupings[i].push_back(manifoldPrecursors[pairs[i].second]);
+        }
+
+        return m_groupings;
+    }
+
+    bool BroadphaseAABBTree::collectUniquePairs(const std::vector<physics_manifold_precursor>& manifoldPrecursors,
+        std::vector<std::pair<size_type, size_type>>& pairs)
+    {
+        OPTICK_EVENT();
+        m_step++;
+        m_movedLeafs.clear();
+
+        {
+            OPTICK_EVENT("Updating proxies");
+            for (size_type i = 0; i < manifoldPrecursors.size(); i++)
+            {
+                auto& precursor = manifoldPrecursors[i];
+
+                // If the entity has no colliders, it can't collide with anything
+                std::vector<PhysicsColliderPtr>& colliders = precursor.physicsComp->colliders;
+                if (colliders.size() == 0) continue;
+
+                // Combine the bounds of all colliders of this physics component
+                std::pair<math::vec3, math::vec3> aabb = colliders.at(0)->GetMinMaxWorldAABB();
+                for (size_type j = 1; j < colliders.size(); ++j)
+                    aabb = PhysicsStatics::CombineAABB(colliders.at(j)->GetMinMaxWorldAABB(), aabb);
+
+                id_type id = precursor.entity;
+                int leaf;
+
+                auto proxy = m_proxies.find(id);
+                if (proxy == m_proxies.end())
+                {
+                    // A new entity has entered the broadphase
+                    leaf = allocateNode();
+                    m_nodes[leaf].entity = id;
+                    m_proxies.emplace(id, leaf);
+                }
+                else
+                {
+                    leaf = proxy->second;
+                    tree_node& node = m_nodes[leaf];
+                    node.precursor = i;
+                    node.lastSeen = m_step;
+
+                    // As long as the tight bounds are still within the fat bounds the tree and the pairs stay valid
+                    if (math::all(math::greaterThanEqual(aabb.first, node.min)) && math::all(math::lessThanEqual(aabb.second, node.max)))
+                        continue;
+
+                    removeLeaf(leaf);
+                }
+
+                tree_node& node = m_nodes[leaf];
+                node.min = aabb.first - math::vec3(m_fatMargin);
+                node.max = aabb.second + math::vec3(m_fatMargin);
+                node.precursor = i;
+                node.lastSeen = m_step;
+                node.moved = true;
+
+                insertLeaf(leaf);
+                m_movedLeafs.push_back(leaf);
+            }
+        }
+
+        // Entities that weren't in the precursors this step left the broadphase
+        std::vector<int> removedLeafs;
+        for (auto it = m_proxies.begin(); it != m_proxies.end();)
+        {
+            if (m_nodes[it->second].lastSeen != m_step)
+            {
+                removeLeaf(it->second);
+                m_nodes[it->second].moved = true; // Makes sure the cached pairs of this leaf get dropped
+                removedLeafs.push_back(it->second);
+                it = m_proxies.erase(it);
+            }
+            else
+                ++it;
+        }
+
+        if (m_movedLeafs.size() || removedLeafs.size())
+        {
+            OPTICK_EVENT("Updating pairs");
+
+            // Drop all cached pairs of leafs that moved, they get queried again below
+            m_leafPairs.erase(std::remove_if(m_leafPairs.begin(), m_leafPairs.end(), [&](const std::pair<int, int>& pair)
+                {
+                    return m_nodes[pair.first].moved || m_nodes[pair.second].moved;
+                }), m_leafPairs.end());
+
+            for (int leaf : removedLeafs)
+                freeNode(leaf);
+
+            for (int leaf : m_movedLeafs)
+            {
+                const tree_node& query = m_nodes[leaf];
+
+                m_stack.clear();
+                m_stack.push_back(m_root);
+                while (!m_stack.empty())
+                {
+                    int index = m_stack.back();
+                    m_stack.pop_back();
+
+                    if (index == null_node)
+                        continue;
+
+                    const tree_node& node = m_nodes[index];
+                    if (!overlaps(query, node))
+                        continue;
+
+                    if (node.isLeaf())
+                    {
+                        // When both leafs moved the pair is found twice, only keep it from the leaf with the lowest index
+                        if (index == leaf || (node.moved && index < leaf))
+                            continue;
+
+                        m_leafPairs.emplace_back(std::min(leaf, index), std::max(leaf, index));
+                    }
+                    else
+                    {
+                        m_stack.push_back(node.child1);
+                        m_stack.push_back(node.child2);
+                    }
+                }
+            }
+
+            for (int leaf : m_movedLeafs)
+                m_nodes[leaf].moved = false;
+        }
+
+        pairs.clear();
+        pairs.reserve(m_leafPairs.size());
+        for (auto& [leafA, leafB] : m_leafPairs)
+            pairs.emplace_back(m_nodes[leafA].precursor, m_nodes[leafB].precursor);
+
+        return true;
+    }
+
+    bool BroadphaseAABBTree::queryAABB(const math::vec3& min, const math::vec3& max, std::vector<size_type>& precursors) const
+    {
+        OPTICK_EVENT();
+
+        tree_node query;
+        query.min = min;
+        query.max = max;
+
+        // Queries can run on multiple threads at once, so they can't share m_stack
+        std::vector<int> stack;
+        stack.push_back(m_root);
+        while (!stack.empty())
+        {
+            int index = stack.back();
+            stack.pop_back();
+
+            if (index == null_node)
+                continue;
+
+            const tree_node& node = m_nodes[index];
+            if (!overlaps(query, node))
+                continue;
+
+            if (node.isLeaf())
+            {
+                precursors.push_back(node.precursor);
+            }
+            else
+            {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+
+        return true;
+    }
+
+    bool BroadphaseAABBTree::queryRay(const math::vec3& origin, const math::vec3& direction, float maxDistance, std::vector<size_type>& precursors) const
+    {
+        OPTICK_EVENT();
+
+        const math::vec3 inverseDirection = 1.f / direction;
+
+        std::vector<int> stack;
+        stack.push_back(m_root);
+        while (!stack.empty())
+        {
+            int index = stack.back();
+            stack.pop_back();
+
+            if (index == null_node)
+                continue;
+
+            const tree_node& node = m_nodes[index];
+            if (!PhysicsStatics::RaycastAABB(origin, inverseDirection, maxDistance, node.min, node.max))
+                continue;
+
+            if (node.isLeaf())
+            {
+                precursors.push_back(node.precursor);
+            }
+            else
+            {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+
+        return true;
+    }
+
+    void BroadphaseAABBTree::debugDraw()
+    {
+        for (auto& [id, leaf] : m_proxies)
+        {
+            const tree_node& node = m_nodes[leaf];
+            debug::drawCube(node.min, node.max, math::colors::blue, 5.0f);
+        }
+    }
+
+    int BroadphaseAABBTree::allocateNode()
+    {
+        int node;
+        if (m_freeList != null_node)
+        {
+            node = m_freeList;
+            m_freeList = m_nodes[node].parent;
+            m_nodes[node] = tree_node();
+        }
+        else
+        {
+            node = static_cast<int>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+
+        m_nodes[node].height = 0;
+        return node;
+    }
+
+    void BroadphaseAABBTree::freeNode(int node)
+    {
+        m_nodes[node] = tree_node();
+        m_nodes[node].parent = m_freeList;
+        m_freeList = node;
+    }
+
+    void BroadphaseAABBTree::insertLeaf(int leaf)
+    {
+        if (m_root == null_node)
+        {
+            m_root = leaf;
+            m_nodes[leaf].parent = null_node;
+            return;
+        }
+
+        // Find the best sibling for the new leaf using the surface area heuristic
+        math::vec3 leafMin = m_nodes[leaf].min;
+        math::vec3 leafMax = m_nodes[leaf].max;
+
+        int index = m_root;
+        while (!m_nodes[index].isLeaf())
+        {
+            const tree_node& node = m_nodes[index];
+            const tree_node& child1 = m_nodes[node.child1];
+            const tree_node& child2 = m_nodes[node.child2];
+
+            float area = surfaceArea(node.min, node.max);
+            float combinedArea = surfaceArea(math::min(node.min, leafMin), math::max(node.max, leafMax));
+
+            // Cost of creating a new parent for this node and the new leaf
+            float cost = 2.f * combinedArea;
+
+            // Minimum cost of pushing the leaf further down the tree
+            float inheritanceCost = 2.f * (combinedArea - area);
+
+            auto descendCost = [&](const tree_node& child)
+            {
+                float childArea = surfaceArea(math::min(child.min, leafMin), math::max(child.max, leafMax));
+                if (child.isLeaf())
+                    return childArea + inheritanceCost;
+                return childArea - surfaceArea(child.min, child.max) + inheritanceCost;
+            };
+
+            float cost1 = descendCost(child1);
+            float cost2 = descendCost(child2);
+
+            if (cost < cost1 && cost < cost2)
+                break;
+
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        int sibling = index;
+
+        // Create a new parent for the sibling and the new leaf
+        int oldParent = m_nodes[sibling].parent;
+        int newParent = allocateNode();
+
+        tree_node& parent = m_nodes[newParent];
+        parent.parent = oldParent;
+        parent.min = math::min(leafMin, m_nodes[sibling].min);
+        parent.max = math::max(leafMax, m_nodes[sibling].max);
+        parent.height = m_nodes[sibling].height + 1;
+        parent.child1 = sibling;
+        parent.child2 = leaf;
+
+        if (oldParent != null_node)
+        {
+            if (m_nodes[oldParent].child1 == sibling)
+                m_nodes[oldParent].child1 = newParent;
+            else
+                m_nodes[oldParent].child2 = newParent;
+        }
+        else
+        {
+            m_root = newParent;
+        }
+
+        m_nodes[sibling].parent = newParent;
+        m_nodes[leaf].parent = newParent;
+
+        refitAncestors(newParent);
+    }
+
+    void BroadphaseAABBTree::removeLeaf(int leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = null_node;
+            return;
+        }
+
+        int parent = m_nodes[leaf].parent;
+        int grandParent = m_nodes[parent].parent;
+        int sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+        if (grandParent != null_node)
+        {
+            // Connect the sibling to the grand parent and destroy the parent
+            if (m_nodes[grandParent].child1 == parent)
+                m_nodes[grandParent].child1 = sibling;
+            else
+                m_nodes[grandParent].child2 = sibling;
+
+            m_nodes[sibling].parent = grandParent;
+            freeNode(parent);
+
+            refitAncestors(grandParent);
+        }
+        else
+        {
+            m_root = sibling;
+            m_nodes[sibling].parent = null_node;
+            freeNode(parent);
+        }
+
+        m_nodes[leaf].parent = null_node;
+    }
+
+    void BroadphaseAABBTree::refitAncestors(int node)
+    {
+        while (node != null_node)
+        {
+            node = balance(node);
+
+            tree_node& current = m_nodes[node];
+            const tree_node& child1 = m_nodes[current.child1];
+            const tree_node& child2 = m_nodes[current.child2];
+
+            current.height = 1 + math::max(child1.height, child2.height);
+            current.min = math::min(child1.min, child2.min);
+            current.max = math::max(child1.max, child2.max);
+
+            node = current.parent;
+        }
+    }
+
+    int BroadphaseAABBTree::balance(int iA)
+    {
+        tree_node& A = m_nodes[iA];
+        if (A.isLeaf() || A.height < 2)
+            return iA;
+
+        int iB = A.child1;
+        int iC = A.child2;
+        tree_node& B = m_nodes[iB];
+        tree_node& C = m_nodes[iC];
+
+        int balance = C.height - B.height;
+
+        // Rotate C up
+        if (balance > 1)
+        {
+            int iF = C.child1;
+            int iG = C.child2;
+            tree_node& F = m_nodes[iF];
+            tree_node& G = m_nodes[iG];
+
+            // Swap A and C
+            C.child1 = iA;
+            C.parent = A.parent;
+            A.parent = iC;
+
+            // A's old parent should point to C
+            if (C.parent != null_node)
+            {
+                if (m_nodes[C.parent].child1 == iA)
+                    m_nodes[C.parent].child1 = iC;
+                else
+                    m_nodes[C.parent].child2 = iC;
+            }
+            else
+            {
+                m_root = iC;
+            }
+
+            // Keep the highest child of C and move the other one to A
+            if (F.height > G.height)
+            {
+                C.child2 = iF;
+                A.child2 = iG;
+                G.parent = iA;
+                A.min = math::min(B.min, G.min);
+                A.max = math::max(B.max, G.max);
+                C.min = math::min(A.min, F.min);
+                C.max = math::max(A.max, F.max);
+
+                A.height = 1 + math::max(B.height, G.height);
+                C.height = 1 + math::max(A.height, F.height);
+            }
+            else
+            {
+                C.child2 = iG;
+                A.child2 = iF;
+                F.parent = iA;
+                A.min = math::min(B.min, F.min);
+                A.max = math::max(B.max, F.max);
+                C.min = math::min(A.min, G.min);
+                C.max = math::max(A.max, G.max);
+
+                A.height = 1 + math::max(B.height, F.height);
+                C.height = 1 + math::max(A.height, G.height);
+            }
+
+            return iC;
+        }
+
+        // Rotate B up
+        if (balance < -1)
+        {
+            int iD = B.child1;
+            int iE = B.child2;
+            tree_node& D = m_nodes[iD];
+            tree_node& E = m_nodes[iE];
+
+            // Swap A and B
+            B.child1 = iA;
+            B.parent = A.parent;
+            A.parent = iB;
+
+            // A's old parent should point to B
+            if (B.parent != null_node)
+            {
+                if (m_nodes[B.parent].child1 == iA)
+                    m_nodes[B.parent].child1 = iB;
+                else
+                    m_nodes[B.parent].child2 = iB;
+            }
+            else
+            {
+                m_root = iB;
+            }
+
+            // Keep the highest child of B and move the other one to A
+            if (D.height > E.height)
+            {
+                B.child2 = iD;
+                A.child1 = iE;
+                E.parent = iA;
+                A.min = math::min(C.min, E.min);
+                A.max = math::max(C.max, E.max);
+                B.min = math::min(A.min, D.min);
+                B.max = math::max(A.max, D.max);
+
+                A.height = 1 + math::max(C.height, E.height);
+                B.height = 1 + math::max(A.height, D.height);
+            }
+            else
+            {
+                B.child2 = iE;
+                A.child1 = iD;
+                D.parent = iA;
+                A.min = math::min(C.min, D.min);
+                A.max = math::max(C.max, D.max);
+                B.min = math::min(A.min, E.min);
+                B.max = math::max(A.max, E.max);
+
+                A.height = 1 + math::max(C.height, D.height);
+                B.height = 1 + math::max(A.height, E.height);
+            }
+
+            return iB;
+        }
+
+        return iA;
+    }
+}
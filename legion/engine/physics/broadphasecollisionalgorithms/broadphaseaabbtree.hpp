@@ -0,0 +1,136 @@
+#pragma once
+#include <physics/broadphasecollisionalgorithms/broadphasecollisionalgorithm.hpp>
+#include <physics/physics_statics.hpp>
+
+namespace legion::physics
+{
+    /**@class BroadphaseAABBTree
+     * @brief Implementation of broad-phase collision detection using a persistent dynamic bounding volume hierarchy.
+     * Every physics component with colliders gets a leaf in the tree with a slightly enlarged (fat) bounding box.
+     * As long as the tight bounds of an entity stay inside its fat bounds the tree isn't touched, only entities that moved out of their fat bounds get reinserted.
+     * Overlapping pairs are cached and only re-queried for entities that were reinserted, so static geometry costs almost nothing after the first step.
+     */
+    class BroadphaseAABBTree : public BroadPhaseCollisionAlgorithm
+    {
+    public:
+        /**@brief Constructor of BroadphaseAABBTree
+         * @param fatMargin The distance the bounds of every entity get enlarged by. Larger margins mean fewer reinsertions but more false positive pairs.
+         */
+        BroadphaseAABBTree(float fatMargin = 0.1f) : m_fatMargin(fatMargin)
+        {
+        }
+
+        /**@brief Collects collider pairs that have a chance of colliding and should be checked in narrow-phase collision detection
+         * @param manifoldPrecursors all the physics components
+         * @return a list-list of colliders, every list contains a single unique pair.
+         */
+        const std::vector<std::vector<physics_manifold_precursor>>& collectPairs(
+            std::vector<physics_manifold_precursor>&& manifoldPrecursors) override;
+
+        /**@brief Updates the tree and collects the unique pairs of physics components whose fat bounds overlap.
+         * @param manifoldPrecursors all the physics components
+         * @param pairs [out] indices into manifoldPrecursors of every overlapping pair
+         * @return always true
+         */
+        bool collectUniquePairs(const std::vector<physics_manifold_precursor>& manifoldPrecursors,
+            std::vector<std::pair<size_type, size_type>>& pairs) override;
+
+        /**@brief Collects the physics components whose fat bounds overlap the given bounds by walking the tree.
+         * @param precursors [out] indices into the manifold precursors of the last step
+         * @return always true
+         */
+        bool queryAABB(const math::vec3& min, const math::vec3& max, std::vector<size_type>& precursors) const override;
+
+        /**@brief Collects the physics components whose fat bounds are hit by the given ray by walking the tree.
+         * @param precursors [out] indices into the manifold precursors of the last step
+         * @return always true
+         */
+        bool queryRay(const math::vec3& origin, const math::vec3& direction, float maxDistance, std::vector<size_type>& precursors) const override;
+
+        /**@brief Sets the distance the bounds of every entity get enlarged by, only applies to entities that get (re)inserted after this.
+         */
+        void setFatMargin(float fatMargin)
+        {
+            m_fatMargin = fatMargin;
+        }
+
+        /**@brief Returns the height of the tree, mainly useful to check the balance of the tree.
+         */
+        int getHeight() const
+        {
+            return m_root == null_node ? 0 : m_nodes[m_root].height;
+        }
+
+        void debugDraw() override;
+
+    private:
+        static constexpr int null_node = -1;
+
+        struct tree_node
+        {
+            math::vec3 min;
+            math::vec3 max;
+
+            // Parent of the node, or next free node when the node is in the free list.
+            int parent = null_node;
+            int child1 = null_node;
+            int child2 = null_node;
+
+            // Leafs have height 0, free nodes -1.
+            int height = -1;
+
+            // Only valid for leafs.
+            id_type entity = invalid_id;
+            size_type precursor = 0;
+            size_type lastSeen = 0;
+            bool moved = false;
+
+            bool isLeaf() const { return child1 == null_node; }
+        };
+
+        float m_fatMargin;
+
+        std::vector<tree_node> m_nodes;
+        int m_root = null_node;
+        int m_freeList = null_node;
+
+        size_type m_step = 0;
+
+        // Leaf node of every entity in the tree.
+        std::unordered_map<id_type, int> m_proxies;
+        // Leafs that were (re)inserted this step and need to be queried for new pairs.
+        std::vector<int> m_movedLeafs;
+        // Overlapping pairs of leafs, the first leaf always has the lowest index.
+        std::vector<std::pair<int, int>> m_leafPairs;
+        // Reused stack for tree traversal.
+        std::vector<int> m_stack;
+
+        int allocateNode();
+        void freeNode(int node);
+
+        void insertLeaf(int leaf);
+        void removeLeaf(int leaf);
+
+        /**@brief Rotates the tree around a node to keep it balanced.
+         * @return the node that took the place of the given node.
+         */
+        int balance(int node);
+
+        /**@brief Walks up the tree from a node, refitting the bounds and restoring the balance of every ancestor.
+         */
+        void refitAncestors(int node);
+
+        static bool overlaps(const tree_node& a, const tree_node& b)
+        {
+            return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+                a.min.y <= b.max.y && a.max.y >= b.min.y &&
+                a.min.z <= b.max.z && a.max.z >= b.min.z;
+        }
+
+        static float surfaceArea(const math::vec3& min, const math::vec3& max)
+        {
+            math::vec3 extents = max - min;
+            return 2.f * (extents.x * extents.y + extents.y * extents.z + extents.z * extents.x);
+        }
+    };
+}
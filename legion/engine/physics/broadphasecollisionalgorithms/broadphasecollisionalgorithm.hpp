@@ -19,6 +19,39 @@ namespace legion::physics
         virtual const std::vector<std::vector<physics_manifold_precursor>>& collectPairs(
             std::vector<physics_manifold_precursor>&& manifoldPrecursors) LEGION_PURE;
 
+        /**@brief Collects unique pairs of physics components that have a chance of colliding, for algorithms that can tell the narrow-phase exactly which pairs to check.
+         * Unlike collectPairs no precursors get copied and the narrow-phase doesn't have to filter out duplicate pairs.
+         * @param manifoldPrecursors all the physics components
+         * @param pairs [out] indices into manifoldPrecursors of the pairs that should be checked, every pair is reported only once
+         * @return false if the algorithm doesn't support unique pairs, collectPairs should be used instead then
+         */
+        virtual bool collectUniquePairs(L_MAYBEUNUSED const std::vector<physics_manifold_precursor>& manifoldPrecursors,
+            L_MAYBEUNUSED std::vector<std::pair<size_type, size_type>>& pairs)
+        {
+            return false;
+        }
+
+        /**@brief Collects the physics components whose bounds might overlap the given bounds, as they were during the last time pairs were collected.
+         * @param precursors [out] indices into the manifold precursors of the last step
+         * @return false if the algorithm can't answer queries, every physics component has to be checked then
+         * @note Can be called from multiple threads at once, as long as no pairs are being collected at the same time.
+         */
+        virtual bool queryAABB(L_MAYBEUNUSED const math::vec3& min, L_MAYBEUNUSED const math::vec3& max, L_MAYBEUNUSED std::vector<size_type>& precursors) const
+        {
+            return false;
+        }
+
+        /**@brief Collects the physics components whose bounds might be hit by the given ray, as they were during the last time pairs were collected.
+         * @param direction normalized direction of the ray
+         * @param precursors [out] indices into the manifold precursors of the last step
+         * @return false if the algorithm can't answer queries, every physics component has to be checked then
+         * @note Can be called from multiple threads at once, as long as no pairs are being collected at the same time.
+         */
+        virtual bool queryRay(L_MAYBEUNUSED const math::vec3& origin, L_MAYBEUNUSED const math::vec3& direction, L_MAYBEUNUSED float maxDistance, L_MAYBEUNUSED std::vector<size_type>& precursors) const
+        {
+            return false;
+        }
+
         virtual void debugDraw()
         {
 
@@ -0,0 +1,272 @@
+#include <physics/broadphasecollisionalgorithms/broadphasesweepandprune.hpp>
+
+namespace legion::physics
+{
+    const std::vector<std::vector<physics_manifold_precursor>>& BroadphaseSweepAndPrune::collectPairs(
+        std::vector<physics_manifold_precursor>&& manifoldPrecursors)
+    {
+        OPTICK_EVENT();
+
+        std::vector<std::pair<size_type, size_type>> pairs;
+        collectUniquePairs(manifoldPrecursors, pairs);
+
+        m_groupings.resize(pairs.size());
+        for (size_type i = 0; i < pairs.size(); i++)
+        {
+            m_groupings[i].clear();
+            m_groupings[i].push_back(manifoldPrecursors[pairs[i].first]);
+            m_groupings[i].push_back(manifoldPrecursors[pairs[i].second]);
+        }
+
+        return m_groupings;
+    }
+
+    bool BroadphaseSweepAndPrune::collectUniquePairs(const std::vector<physics_manifold_precursor>& manifoldPrecursors,
+        std::vector<std::pair<size_type, size_type>>& pairs)
+    {
+        OPTICK_EVENT();
+        m_step++;
+
+        size_type newProxies = 0;
+
+        {
+            OPTICK_EVENT("Updating proxies");
+            for (size_type i = 0; i < manifoldPrecursors.size(); i++)
+            {
+                auto& precursor = manifoldPrecursors[i];
+
+                // If the entity has no colliders, it can't collide with anything
+                std::vector<PhysicsColliderPtr>& colliders = precursor.physicsComp->colliders;
+                if (colliders.size() == 0) continue;
+
+                // Combine the bounds of all colliders of this physics component
+                std::pair<math::vec3, math::vec3> aabb = colliders.at(0)->GetMinMaxWorldAABB();
+                for (size_type j = 1; j < colliders.size(); ++j)
+                    aabb = PhysicsStatics::CombineAABB(colliders.at(j)->GetMinMaxWorldAABB(), aabb);
+
+                id_type id = precursor.entity;
+
+                // Existing entities keep their place in the sorted order, new ones get sorted in from the back
+                auto existing = m_lookup.find(id);
+                if (existing != m_lookup.end())
+                {
+                    proxy& p = m_proxies[existing->second];
+                    p.min = aabb.first;
+                    p.max = aabb.second;
+                    p.precursor = i;
+                    p.lastSeen = m_step;
+                }
+                else
+                {
+                    m_proxies.push_back(proxy{ aabb.first, aabb.second, id, i, m_step });
+                    newProxies++;
+                }
+            }
+
+            // Entities that weren't in the precursors this step left the broadphase
+            m_proxies.erase(std::remove_if(m_proxies.begin(), m_proxies.end(), [&](const proxy& p)
+                {
+                    return p.lastSeen != m_step;
+                }), m_proxies.end());
+        }
+
+        {
+            OPTICK_EVENT("Sorting proxies");
+
+            // Insertion sort is only cheap when the order barely changed, a different axis or lots of new entities need a full sort
+            if (updateSortAxis() || newProxies * 4 > m_proxies.size())
+            {
+                std::sort(m_proxies.begin(), m_proxies.end(), [axis = m_sortAxis](const proxy& a, const proxy& b)
+                    {
+                        return a.min[axis] < b.min[axis];
+                    });
+            }
+            else
+            {
+                insertionSort();
+            }
+        }
+
+        const size_type count = m_proxies.size();
+
+        m_lookup.clear();
+        m_lookup.reserve(count);
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            // Padding bounds can't overlap anything and lie past everything on the sort axis, which ends the sweep
+            m_min[axis].assign(count + 4, std::numeric_limits<float>::max());
+            m_max[axis].assign(count + 4, std::numeric_limits<float>::lowest());
+        }
+        m_precursors.resize(count);
+
+        for (size_type i = 0; i < count; i++)
+        {
+            const proxy& p = m_proxies[i];
+            m_lookup.emplace(p.entity, i);
+            m_precursors[i] = p.precursor;
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                m_min[axis][i] = p.min[axis];
+                m_max[axis][i] = p.max[axis];
+            }
+        }
+
+        pairs.clear();
+        sweep(pairs);
+
+        return true;
+    }
+
+    bool BroadphaseSweepAndPrune::queryAABB(const math::vec3& min, const math::vec3& max, std::vector<size_type>& precursors) const
+    {
+        OPTICK_EVENT();
+
+        const size_type count = m_precursors.size();
+        const int s = m_sortAxis;
+
+        // Bounds are sorted on their minimum, so everything from the first bounds that starts after the query can be skipped
+        const float* minS = m_min[s].data();
+        const size_type end = std::upper_bound(minS, minS + count, max[s]) - minS;
+
+        for (size_type i = 0; i < end; i++)
+        {
+            if (m_max[s][i] >= min[s] &&
+                m_min[0][i] <= max[0] && m_max[0][i] >= min[0] &&
+                m_min[1][i] <= max[1] && m_max[1][i] >= min[1] &&
+                m_min[2][i] <= max[2] && m_max[2][i] >= min[2])
+                precursors.push_back(m_precursors[i]);
+        }
+
+        return true;
+    }
+
+    bool BroadphaseSweepAndPrune::queryRay(const math::vec3& origin, const math::vec3& direction, float maxDistance, std::vector<size_type>& precursors) const
+    {
+        math::vec3 min = origin;
+        math::vec3 max = origin;
+
+        for (int axis = 0; axis < 3; axis++)
+        {
+            // Skipping axes the ray doesn't move along avoids multiplying 0 with an infinite length
+            if (direction[axis] == 0.f)
+                continue;
+
+            float end = origin[axis] + direction[axis] * maxDistance;
+            min[axis] = math::min(min[axis], end);
+            max[axis] = math::max(max[axis], end);
+        }
+
+        return queryAABB(min, max, precursors);
+    }
+
+    void BroadphaseSweepAndPrune::debugDraw()
+    {
+        for (auto& p : m_proxies)
+        {
+            debug::drawCube(p.min, p.max, math::colors::cyan, 5.0f);
+        }
+    }
+
+    bool BroadphaseSweepAndPrune::updateSortAxis()
+    {
+        if (m_proxies.empty())
+            return false;
+
+        math::vec3 sum(0.f);
+        math::vec3 sumSquared(0.f);
+
+        for (auto& p : m_proxies)
+        {
+            math::vec3 center = (p.min + p.max) * 0.5f;
+            sum += center;
+            sumSquared += center * center;
+        }
+
+        float invCount = 1.f / static_cast<float>(m_proxies.size());
+        math::vec3 variance = sumSquared * invCount - (sum * invCount) * (sum * invCount);
+
+        int bestAxis = 0;
+        if (variance.y > variance[bestAxis]) bestAxis = 1;
+        if (variance.z > variance[bestAxis]) bestAxis = 2;
+
+        // Only switch when it's worth the full sort, otherwise entities moving around could make us switch back and forth every step
+        if (bestAxis == m_sortAxis || variance[bestAxis] < variance[m_sortAxis] * 1.5f)
+            return false;
+
+        m_sortAxis = bestAxis;
+        return true;
+    }
+
+    void BroadphaseSweepAndPrune::insertionSort()
+    {
+        const int axis = m_sortAxis;
+        for (size_type i = 1; i < m_proxies.size(); i++)
+        {
+            if (m_proxies[i - 1].min[axis] <= m_proxies[i].min[axis])
+                continue;
+
+            proxy key = m_proxies[i];
+            size_type j = i;
+            for (; j > 0 && m_proxies[j - 1].min[axis] > key.min[axis]; j--)
+                m_proxies[j] = m_proxies[j - 1];
+
+            m_proxies[j] = key;
+        }
+    }
+
+    void BroadphaseSweepAndPrune::sweep(std::vector<std::pair<size_type, size_type>>& pairs)
+    {
+        OPTICK_EVENT();
+
+        const size_type count = m_precursors.size();
+        const int s = m_sortAxis;
+        const int a = (s + 1) % 3;
+        const int b = (s + 2) % 3;
+
+        const float* minS = m_min[s].data();
+        const float* maxS = m_max[s].data();
+        const float* minA = m_min[a].data();
+        const float* maxA = m_max[a].data();
+        const float* minB = m_min[b].data();
+        const float* maxB = m_max[b].data();
+
+        for (size_type i = 0; i < count; i++)
+        {
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+            const glm_f32vec4 iMaxS = _mm_set1_ps(maxS[i]);
+            const glm_f32vec4 iMinA = _mm_set1_ps(minA[i]);
+            const glm_f32vec4 iMaxA = _mm_set1_ps(maxA[i]);
+            const glm_f32vec4 iMinB = _mm_set1_ps(minB[i]);
+            const glm_f32vec4 iMaxB = _mm_set1_ps(maxB[i]);
+
+            // Bounds after i are sorted on their minimum, so they can only overlap i on the sort axis as long as they start before i ends.
+            // Their maximum is at least i's minimum, so that side doesn't need to be checked.
+            for (size_type j = i + 1; j < count; j += 4)
+            {
+                glm_f32vec4 sortOverlap = _mm_cmple_ps(_mm_loadu_ps(minS + j), iMaxS);
+
+                glm_f32vec4 overlapA = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minA + j), iMaxA), _mm_cmpge_ps(_mm_loadu_ps(maxA + j), iMinA));
+                glm_f32vec4 overlapB = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minB + j), iMaxB), _mm_cmpge_ps(_mm_loadu_ps(maxB + j), iMinB));
+
+                int overlapMask = _mm_movemask_ps(_mm_and_ps(sortOverlap, _mm_and_ps(overlapA, overlapB)));
+                for (size_type lane = 0; overlapMask; lane++, overlapMask >>= 1)
+                    if (overlapMask & 1)
+                        pairs.emplace_back(m_precursors[i], m_precursors[j + lane]);
+
+                // Once a single entity starts past the end of i, every entity after it does as well
+                if (_mm_movemask_ps(sortOverlap) != 0xF)
+                    break;
+            }
+#else
+            for (size_type j = i + 1; j < count && minS[j] <= maxS[i]; j++)
+            {
+                if (minA[j] <= maxA[i] && maxA[j] >= minA[i] &&
+                    minB[j] <= maxB[i] && maxB[j] >= minB[i])
+                    pairs.emplace_back(m_precursors[i], m_precursors[j]);
+            }
+#endif
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <physics/broadphasecollisionalgorithms/broadphasecollisionalgorithm.hpp>
+#include <physics/physics_statics.hpp>
+
+namespace legion::physics
+{
+    /**@class BroadphaseSweepAndPrune
+     * @brief Implementation of broad-phase collision detection by sorting the bounds of all entities along one axis and sweeping over them.
+     * The sorted order is kept between steps, so re-sorting is a nearly linear insertion sort as long as entities don't move much relative to each other.
+     * The sweep tests the bounds of four entities at once using the SIMD layer of glm, which makes this algorithm a good fit for dense scenes with lots of small dynamic objects like fracture debris.
+     */
+    class BroadphaseSweepAndPrune : public BroadPhaseCollisionAlgorithm
+    {
+    public:
+        /**@brief Collects collider pairs that have a chance of colliding and should be checked in narrow-phase collision detection
+         * @param manifoldPrecursors all the physics components
+         * @return a list-list of colliders, every list contains a single unique pair.
+         */
+        const std::vector<std::vector<physics_manifold_precursor>>& collectPairs(
+            std::vector<physics_manifold_precursor>&& manifoldPrecursors) override;
+
+        /**@brief Sorts the bounds of all physics components and collects the unique pairs of overlapping bounds.
+         * @param manifoldPrecursors all the physics components
+         * @param pairs [out] indices into manifoldPrecursors of every overlapping pair
+         * @return always true
+         */
+        bool collectUniquePairs(const std::vector<physics_manifold_precursor>& manifoldPrecursors,
+            std::vector<std::pair<size_type, size_type>>& pairs) override;
+
+        /**@brief Collects the physics components whose bounds overlap the given bounds.
+         * Only the entities that start before the end of the bounds on the sort axis are checked.
+         * @param precursors [out] indices into the manifold precursors of the last step
+         * @return always true
+         */
+        bool queryAABB(const math::vec3& min, const math::vec3& max, std::vector<size_type>& precursors) const override;
+
+        /**@brief Collects the physics components whose bounds overlap the bounds of the given ray, the ray itself is not tested against the bounds.
+         * @param precursors [out] indices into the manifold precursors of the last step
+         * @return always true
+         */
+        bool queryRay(const math::vec3& origin, const math::vec3& direction, float maxDistance, std::vector<size_type>& precursors) const override;
+
+        /**@brief Returns the axis the bounds are currently sorted on, 0 for x, 1 for y and 2 for z.
+         */
+        int getSortAxis() const
+        {
+            return m_sortAxis;
+        }
+
+        void debugDraw() override;
+
+    private:
+        struct proxy
+        {
+            math::vec3 min;
+            math::vec3 max;
+            id_type entity;
+            size_type precursor;
+            size_type lastSeen;
+        };
+
+        // Proxies in sorted order of the previous step, kept around for temporal coherence.
+        std::vector<proxy> m_proxies;
+        // Position of every entity in m_proxies.
+        std::unordered_map<id_type, size_type> m_lookup;
+
+        size_type m_step = 0;
+
+        // Bounds in sorted order, one array per axis and side so the sweep can load four entities at once.
+        // Every array is padded with four empty bounds so the sweep never has to handle a partial batch.
+        std::vector<float> m_min[3];
+        std::vector<float> m_max[3];
+        std::vector<size_type> m_precursors;
+
+        int m_sortAxis = 0;
+
+        /**@brief Picks the axis along which the centers of the bounds are spread out the most.
+         * Switching axis costs a full sort, so the current axis is kept unless another axis is clearly better.
+         * @return true if the sort axis changed.
+         */
+        bool updateSortAxis();
+
+        void insertionSort();
+        void sweep(std::vector<std::pair<size_type, size_type>>& pairs);
+    };
+}
@@ -0,0 +1,232 @@
+#include <physics/colliders/capsulecollider.hpp>
+#include <physics/colliders/convexcollider.hpp>
+#include <physics/colliders/spherecollider.hpp>
+#include <physics/data/analyticpenetrationquery.hpp>
+#include <physics/physics_statics.hpp>
+#include <rendering/debugrendering.hpp>
+#include <limits>
+
+namespace legion::physics
+{
+    CapsuleCollider::CapsuleCollider(float radius, float height, const math::vec3& offset) :
+        radius(radius), height(height), halfSegmentLength(math::max(height * 0.5f - radius, 0.0f))
+    {
+        localColliderCentroid = offset;
+        UpdateLocalAABB();
+    }
+
+    void CapsuleCollider::CheckCollisionWith(ConvexCollider* convexCollider, physics_manifold& manifold)
+    {
+        OPTICK_EVENT();
+        //'this' is colliderB and 'convexCollider' is colliderA
+        if (!PhysicsStatics::CollideAABB(minMaxWorldAABB, convexCollider->GetMinMaxWorldAABB()))
+        {
+            manifold.isColliding = false;
+            return;
+        }
+
+        convexCollider->CollideWithCapsule(GetWorldCapsule(manifold.transformB), manifold, true);
+    }
+
+    void CapsuleCollider::CheckCollisionWith(SphereCollider* sphereCollider, physics_manifold& manifold)
+    {
+        OPTICK_EVENT();
+        //'this' is colliderB and 'sphereCollider' is colliderA
+        if (!PhysicsStatics::CollideAABB(minMaxWorldAABB, sphereCollider->GetMinMaxWorldAABB()))
+        {
+            manifold.isColliding = false;
+            return;
+        }
+
+        analytic_collision collision;
+        manifold.isColliding = ShapeCollision::SphereCapsule(sphereCollider->GetWorldSphere(manifold.transformA), GetWorldCapsule(manifold.transformB), collision);
+
+        if (manifold.isColliding)
+        {
+            manifold.penetrationInformation = std::make_unique<AnalyticPenetrationQuery>(collision, true);
+        }
+    }
+
+    void CapsuleCollider::CheckCollisionWith(CapsuleCollider* capsuleCollider, physics_manifold& manifold)
+    {
+        OPTICK_EVENT();
+        //'this' is colliderB and 'capsuleCollider' is colliderA
+        if (!PhysicsStatics::CollideAABB(minMaxWorldAABB, capsuleCollider->GetMinMaxWorldAABB()))
+        {
+            manifold.isColliding = false;
+            return;
+        }
+
+        analytic_collision collision;
+        manifold.isColliding = ShapeCollision::CapsuleCapsule(capsuleCollider->GetWorldCapsule(manifold.transformA), GetWorldCapsule(manifold.transformB), collision);
+
+        if (manifold.isColliding)
+        {
+            manifold.penetrationInformation = std::make_unique<AnalyticPenetrationQuery>(collision, true);
+        }
+    }
+
+    void CapsuleCollider::PopulateContactPointsWith(L_MAYBEUNUSED ConvexCollider* convexCollider, physics_manifold& manifold)
+    {
+        PopulateContactsFromPenetrationInformation(manifold);
+    }
+
+    void CapsuleCollider::PopulateContactPointsWith(L_MAYBEUNUSED SphereCollider* sphereCollider, physics_manifold& manifold)
+    {
+        PopulateContactsFromPenetrationInformation(manifold);
+    }
+
+    void CapsuleCollider::PopulateContactPointsWith(L_MAYBEUNUSED CapsuleCollider* capsuleCollider, physics_manifold& manifold)
+    {
+        PopulateContactsFromPenetrationInformation(manifold);
+    }
+
+    void CapsuleCollider::UpdateTransformedTightBoundingVolume(const math::mat4& transform)
+    {
+        world_capsule capsule = GetWorldCapsule(transform);
+        minMaxWorldAABB = std::make_pair(
+            math::min(capsule.start, capsule.end) - math::vec3(capsule.radius),
+            math::max(capsule.start, capsule.end) + math::vec3(capsule.radius));
+    }
+
+    void CapsuleCollider::UpdateLocalAABB()
+    {
+        math::vec3 extents(radius, halfSegmentLength + radius, radius);
+        minMaxLocalAABB = std::make_pair(localColliderCentroid - extents, localColliderCentroid + extents);
+    }
+
+    bool CapsuleCollider::Raycast(const math::mat4& transform, const math::vec3& origin, const math::vec3& direction, float maxDistance,
+        float& distance, math::vec3& normal) const
+    {
+        world_capsule capsule = GetWorldCapsule(transform);
+        const float radiusSquared = capsule.radius * capsule.radius;
+
+        if (math::length2(origin - ShapeCollision::ClosestPointOnSegment(capsule.start, capsule.end, origin)) <= radiusSquared)
+        {
+            //the ray starts inside of the capsule
+            distance = 0.0f;
+            normal = -direction;
+            return true;
+        }
+
+        float closest = std::numeric_limits<float>::max();
+
+        //the cylinder between the caps, only hits between both ends of the segment count
+        const math::vec3 axis = capsule.end - capsule.start;
+        const math::vec3 toOrigin = origin - capsule.start;
+
+        const float axisLength2 = math::dot(axis, axis);
+        const float axisDirection = math::dot(axis, direction);
+        const float axisOrigin = math::dot(axis, toOrigin);
+
+        const float a = axisLength2 - axisDirection * axisDirection;
+        if (a > math::epsilon<float>())
+        {
+            const float b = axisLength2 * math::dot(toOrigin, direction) - axisOrigin * axisDirection;
+            const float c = axisLength2 * math::dot(toOrigin, toOrigin) - axisOrigin * axisOrigin - radiusSquared * axisLength2;
+            const float discriminant = b * b - a * c;
+
+            if (discriminant >= 0.0f)
+            {
+                float t = (-b - math::sqrt(discriminant)) / a;
+                float alongAxis = axisOrigin + t * axisDirection;
+
+                if (t >= 0.0f && alongAxis > 0.0f && alongAxis < axisLength2)
+                {
+                    closest = t;
+                    normal = (toOrigin + direction * t - axis * (alongAxis / axisLength2)) / capsule.radius;
+                }
+            }
+        }
+
+        //the spheres of the caps
+        for (auto& capCenter : { capsule.start, capsule.end })
+        {
+            math::vec3 toCap = origin - capCenter;
+            float projection = math::dot(toCap, direction);
+            float discriminant = projection * projection - (math::dot(toCap, toCap) - radiusSquared);
+            if (discriminant < 0.0f)
+                continue;
+
+            float t = -projection - math::sqrt(discriminant);
+            if (t >= 0.0f && t < closest)
+            {
+                closest = t;
+                normal = math::normalize(origin + direction * t - capCenter);
+            }
+        }
+
+        if (closest > maxDistance)
+            return false;
+
+        distance = closest;
+        return true;
+    }
+
+    bool CapsuleCollider::OverlapsSphere(const math::mat4& transform, const math::vec3& center, float radius) const
+    {
+        world_capsule capsule = GetWorldCapsule(transform);
+        float combinedRadius = capsule.radius + radius;
+        return math::length2(center - ShapeCollision::ClosestPointOnSegment(capsule.start, capsule.end, center)) <= combinedRadius * combinedRadius;
+    }
+
+    bool CapsuleCollider::OverlapsAABB(const math::mat4& transform, const math::vec3& min, const math::vec3& max) const
+    {
+        world_capsule capsule = GetWorldCapsule(transform);
+        return ShapeCollision::SegmentAABBDistanceSquared(capsule.start, capsule.end, min, max) <= capsule.radius * capsule.radius;
+    }
+
+    void CapsuleCollider::DrawColliderRepresentation(const math::mat4& transform, math::color usedColor, float width, float time, bool ignoreDepth)
+    {
+        if (!shouldBeDrawn) { return; }
+
+        world_capsule capsule = GetWorldCapsule(transform);
+
+        math::vec3 up = capsule.end - capsule.start;
+        up = math::length2(up) > math::epsilon<float>() ? math::normalize(up) : math::normalize(math::vec3(transform[1]));
+
+        const math::vec3 right = math::normalize(math::vec3(transform[0])) * capsule.radius;
+        const math::vec3 forward = math::normalize(math::cross(right, up)) * capsule.radius;
+        const math::vec3 capUp = up * capsule.radius;
+
+        auto drawArc = [&](const math::vec3& center, const math::vec3& first, const math::vec3& second, float angle)
+        {
+            constexpr int segmentCount = 16;
+            for (int i = 0; i < segmentCount; i++)
+            {
+                float startAngle = angle * i / segmentCount;
+                float endAngle = angle * (i + 1) / segmentCount;
+
+                math::vec3 start = center + first * math::cos(startAngle) + second * math::sin(startAngle);
+                math::vec3 end = center + first * math::cos(endAngle) + second * math::sin(endAngle);
+
+                debug::user_projectDrawLine(start, end, usedColor, width, time, ignoreDepth);
+            }
+        };
+
+        //the rings where the caps meet the cylinder
+        drawArc(capsule.start, right, forward, math::two_pi<float>());
+        drawArc(capsule.end, right, forward, math::two_pi<float>());
+
+        //the half circles of the caps
+        drawArc(capsule.end, right, capUp, math::pi<float>());
+        drawArc(capsule.end, forward, capUp, math::pi<float>());
+        drawArc(capsule.start, right, -capUp, math::pi<float>());
+        drawArc(capsule.start, forward, -capUp, math::pi<float>());
+
+        for (auto& side : { right, -right, forward, -forward })
+        {
+            debug::user_projectDrawLine(capsule.start + side, capsule.end + side, usedColor, width, time, ignoreDepth);
+        }
+    }
+
+    world_capsule CapsuleCollider::GetWorldCapsule(const math::mat4& transform) const
+    {
+        const math::vec3 halfSegment(0.0f, halfSegmentLength, 0.0f);
+
+        return world_capsule{
+            transform * math::vec4(localColliderCentroid - halfSegment, 1),
+            transform * math::vec4(localColliderCentroid + halfSegment, 1),
+            radius * ShapeCollision::GetMaxScale(transform) };
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <core/core.hpp>
+#include <physics/colliders/physicscollider.hpp>
+#include <physics/shape_collision.hpp>
+
+namespace legion::physics
+{
+    /**@class CapsuleCollider
+     * @brief A capsule along the local y axis that is collided in closed form by ShapeCollision, it doesn't need a half-edge mesh.
+     * The radius is scaled by the largest scale of the entity, so the capsule stays round.
+     */
+    class CapsuleCollider : public PhysicsCollider
+    {
+    public:
+        /**@param radius The radius of the capsule before the entity is scaled
+         * @param height The height of the capsule including both caps, capsules that are lower than twice the radius are spheres
+         * @param offset The position of the center of the capsule relative to the entity
+         */
+        CapsuleCollider(float radius = 0.5f, float height = 2.0f, const math::vec3& offset = math::vec3());
+
+        void CheckCollision(PhysicsCollider* physicsCollider, physics_manifold& manifold) override
+        {
+            physicsCollider->CheckCollisionWith(this, manifold);
+        }
+
+        void CheckCollisionWith(ConvexCollider* convexCollider, physics_manifold& manifold) override;
+
+        void CheckCollisionWith(SphereCollider* sphereCollider, physics_manifold& manifold) override;
+
+        void CheckCollisionWith(CapsuleCollider* capsuleCollider, physics_manifold& manifold) override;
+
+        void PopulateContactPoints(PhysicsCollider* physicsCollider, physics_manifold& manifold) override
+        {
+            physicsCollider->PopulateContactPointsWith(this, manifold);
+        }
+
+        void PopulateContactPointsWith(ConvexCollider* convexCollider, physics_manifold& manifold) override;
+
+        void PopulateContactPointsWith(SphereCollider* sphereCollider, physics_manifold& manifold) override;
+
+        void PopulateContactPointsWith(CapsuleCollider* capsuleCollider, physics_manifold& manifold) override;
+
+        void UpdateTransformedTightBoundingVolume(const math::mat4& transform) override;
+
+        void UpdateLocalAABB() override;
+
+        /** @brief Intersects the ray with the cylinder between the caps and with the spheres of both caps.
+        */
+        bool Raycast(const math::mat4& transform, const math::vec3& origin, const math::vec3& direction, float maxDistance,
+            float& distance, math::vec3& normal) const override;
+
+        bool OverlapsSphere(const math::mat4& transform, const math::vec3& center, float radius) const override;
+
+        bool OverlapsAABB(const math::mat4& transform, const math::vec3& min, const math::vec3& max) const override;
+
+        void DrawColliderRepresentation(const math::mat4& transform, math::color usedColor, float width, float time, bool ignoreDepth = false) override;
+
+        L_NODISCARD world_capsule GetWorldCapsule(const math::mat4& transform) const;
+
+        L_NODISCARD float GetRadius() const noexcept
+        {
+            return radius;
+        }
+
+        L_NODISCARD float GetHeight() const noexcept
+        {
+            return height;
+        }
+
+    private:
+        float radius;
+        float height;
+        //half of the length of the segment between the centers of the caps
+        float halfSegmentLength;
+    };
+}
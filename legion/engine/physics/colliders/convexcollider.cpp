@@ -1,8 +1,11 @@
 #include <physics/colliders/convexcollider.hpp>
+#include <physics/colliders/spherecollider.hpp>
+#include <physics/colliders/capsulecollider.hpp>
 #include <physics/physics_statics.hpp>
 #include <physics/data/identifier.hpp>
 #include <physics/data/convexconvexpenetrationquery.hpp>
 #include <physics/data/edgepenetrationquery.hpp>
+#include <physics/data/analyticpenetrationquery.hpp>
 #include <physics/data/pointer_encapsulator.hpp>
 #include <physics/systems/physicssystem.hpp>
 #include <rendering/debugrendering.hpp>
@@ -25,9 +28,34 @@ namespace legion::physics
             return;
         }
 
+        //two boxes only need the seperating axis test of the half-edge meshes when they are close enough to touch
+        if (isBox && convexCollider->isBox && ShapeCollision::AreBoxesSeperated(
+            convexCollider->GetWorldBox(manifold.transformA), GetWorldBox(manifold.transformB), constants::boxSeperationTolerance))
+        {
+            manifold.isColliding = false;
+            return;
+        }
+
         //auto compIDA = manifold.entityA.get_component_handle<identifier>();
         //auto compIDB = manifold.entityB.get_component_handle<identifier>();
 
+        //--------------------- Check if the face that seperated these colliders last step still seperates them  --------------//
+        //'this' is colliderB and 'convexCollider' is colliderA
+        const seperating_axis& cachedAxis = manifold.cachedSeperatingAxis;
+        if (cachedAxis.isValid())
+        {
+            float cachedSeperation = cachedAxis.colliderID == convexCollider->GetColliderID() ?
+                PhysicsStatics::GetFaceSeperation(this, manifold.transformB, cachedAxis.face, manifold.transformA) :
+                PhysicsStatics::GetFaceSeperation(convexCollider, manifold.transformA, cachedAxis.face, manifold.transformB);
+
+            if (cachedSeperation > 0)
+            {
+                manifold.seperatingAxis = cachedAxis;
+                manifold.isColliding = false;
+                return;
+            }
+        }
+
         //--------------------- Check for a collision by going through the edges and faces of both polyhedrons  --------------//
         //'this' is colliderB and 'convexCollider' is colliderA
         
@@ -41,6 +69,7 @@ namespace legion::physics
             this, convexCollider, manifold.transformB,manifold.transformA,  ARefFace, ARefSeperation) || !ARefFace.ptr)
         {
             //log::debug("Not Found on A ");
+            manifold.seperatingAxis = seperating_axis{ convexCollider->GetColliderID(), ARefFace.ptr };
             manifold.isColliding = false;
             return;
         }
@@ -52,6 +81,7 @@ namespace legion::physics
             this, manifold.transformA, manifold.transformB, BRefFace, BRefSeperation, shouldDebug) || !BRefFace.ptr)
         {
             //log::debug("Not Found on B ");
+            manifold.seperatingAxis = seperating_axis{ GetColliderID(), BRefFace.ptr };
             manifold.isColliding = false;
             return;
         }
@@ -183,42 +213,135 @@ namespace legion::physics
    
     }
 
-    void ConvexCollider::PopulateContactPointsWith(ConvexCollider* convexCollider, physics_manifold& manifold)
+    void ConvexCollider::PopulateContactPointsWith(L_MAYBEUNUSED ConvexCollider* convexCollider, physics_manifold& manifold)
+    {
+        PopulateContactsFromPenetrationInformation(manifold);
+    }
+
+    void ConvexCollider::CheckCollisionWith(SphereCollider* sphereCollider, physics_manifold& manifold)
     {
         OPTICK_EVENT();
-        math::mat4& refTransform = manifold.penetrationInformation->isARef ? manifold.transformA : manifold.transformB;
-        math::mat4& incTransform = manifold.penetrationInformation->isARef ? manifold.transformB : manifold.transformA;
+        //'this' is colliderB and 'sphereCollider' is colliderA
+        if (!PhysicsStatics::CollideAABB(minMaxWorldAABB, sphereCollider->GetMinMaxWorldAABB()))
+        {
+            manifold.isColliding = false;
+            return;
+        }
 
-        physicsComponent* refPhysicsComp = manifold.penetrationInformation->isARef ? manifold.physicsCompA : manifold.physicsCompB;
-        physicsComponent* incPhysicsComp = manifold.penetrationInformation->isARef ? manifold.physicsCompB : manifold.physicsCompA;
+        CollideWithSphere(sphereCollider->GetWorldSphere(manifold.transformA), manifold, false);
+    }
 
-        PhysicsCollider* refCollider = manifold.penetrationInformation->isARef ? manifold.colliderA : manifold.colliderB;
-        PhysicsCollider* incCollider = manifold.penetrationInformation->isARef ? manifold.colliderB : manifold.colliderA;
+    void ConvexCollider::CheckCollisionWith(CapsuleCollider* capsuleCollider, physics_manifold& manifold)
+    {
+        OPTICK_EVENT();
+        //'this' is colliderB and 'capsuleCollider' is colliderA
+        if (!PhysicsStatics::CollideAABB(minMaxWorldAABB, capsuleCollider->GetMinMaxWorldAABB()))
+        {
+            manifold.isColliding = false;
+            return;
+        }
 
-        manifold.penetrationInformation->populateContactList(manifold, refTransform, incTransform, refCollider);
+        CollideWithCapsule(capsuleCollider->GetWorldCapsule(manifold.transformA), manifold, false);
+    }
 
-        rigidbody* refRB = manifold.penetrationInformation->isARef ? manifold.rigidbodyA : manifold.rigidbodyB;
-        rigidbody* incRB = manifold.penetrationInformation->isARef ? manifold.rigidbodyB : manifold.rigidbodyA;
+    void ConvexCollider::PopulateContactPointsWith(L_MAYBEUNUSED SphereCollider* sphereCollider, physics_manifold& manifold)
+    {
+        PopulateContactsFromPenetrationInformation(manifold);
+    }
+
+    void ConvexCollider::PopulateContactPointsWith(L_MAYBEUNUSED CapsuleCollider* capsuleCollider, physics_manifold& manifold)
+    {
+        PopulateContactsFromPenetrationInformation(manifold);
+    }
+
+    void ConvexCollider::CollideWithSphere(const world_sphere& sphere, physics_manifold& manifold, bool isHullA)
+    {
+        OPTICK_EVENT();
+        const math::mat4& transform = isHullA ? manifold.transformA : manifold.transformB;
 
-        math::vec3 refWorldCentroid = refTransform * math::vec4(refPhysicsComp->localCenterOfMass,1);
-        math::vec3 incWorldCentroid = incTransform * math::vec4(incPhysicsComp->localCenterOfMass,1);
+        analytic_collision collision;
+        bool isColliding;
 
-        for ( auto& contact : manifold.contacts)
+        if (isBox)
         {
-            contact.incTransform = incTransform;
-            contact.refTransform = refTransform;
+            isColliding = ShapeCollision::BoxSphere(GetWorldBox(transform), sphere, collision);
+        }
+        else
+        {
+            //the face that seperated the hull from the sphere last step probably still seperates them
+            const seperating_axis& cachedAxis = manifold.cachedSeperatingAxis;
+            if (cachedAxis.isValid() && cachedAxis.colliderID == GetColliderID() &&
+                ShapeCollision::GetFaceSeperation(cachedAxis.face, transform, sphere) >= constants::contactOffset)
+            {
+                manifold.seperatingAxis = cachedAxis;
+                manifold.isColliding = false;
+                return;
+            }
+
+            HalfEdgeFace* seperatingFace = nullptr;
+            isColliding = ShapeCollision::HullSphere(this, transform, sphere, collision, seperatingFace);
+
+            if (seperatingFace)
+            {
+                manifold.seperatingAxis = seperating_axis{ GetColliderID(), seperatingFace };
+            }
+        }
+
+        manifold.isColliding = isColliding;
+        if (isColliding)
+        {
+            manifold.penetrationInformation = std::make_unique<AnalyticPenetrationQuery>(collision, isHullA);
+        }
+    }
+
+    void ConvexCollider::CollideWithCapsule(const world_capsule& capsule, physics_manifold& manifold, bool isHullA)
+    {
+        OPTICK_EVENT();
+        const math::mat4& transform = isHullA ? manifold.transformA : manifold.transformB;
 
-            contact.rbInc = incRB;
-            contact.rbRef = refRB;
-           
-            contact.collisionNormal = manifold.penetrationInformation->normal;
+        //the face that seperated the hull from the capsule last step probably still seperates them
+        const seperating_axis& cachedAxis = manifold.cachedSeperatingAxis;
+        if (cachedAxis.isValid() && cachedAxis.colliderID == GetColliderID() &&
+            ShapeCollision::GetFaceSeperation(cachedAxis.face, transform, capsule) >= constants::contactOffset)
+        {
+            manifold.seperatingAxis = cachedAxis;
+            manifold.isColliding = false;
+            return;
+        }
+
+        analytic_collision collision;
+        HalfEdgeFace* seperatingFace = nullptr;
 
-            contact.refRBCentroid = refWorldCentroid;
-            contact.incRBCentroid = incWorldCentroid;
+        manifold.isColliding = ShapeCollision::HullCapsule(this, transform, capsule, collision, seperatingFace);
 
+        if (seperatingFace)
+        {
+            manifold.seperatingAxis = seperating_axis{ GetColliderID(), seperatingFace };
+        }
+
+        if (manifold.isColliding)
+        {
+            manifold.penetrationInformation = std::make_unique<AnalyticPenetrationQuery>(collision, isHullA);
         }
     }
 
+    world_box ConvexCollider::GetWorldBox(const math::mat4& transform) const
+    {
+        world_box box;
+        box.center = transform * math::vec4(boxCenter, 1);
+
+        for (int i = 0; i < 3; i++)
+        {
+            math::vec3 column = transform[i];
+            float scale = math::length(column);
+
+            box.axes[i] = column / scale;
+            box.halfExtents[i] = boxHalfExtents[i] * scale;
+        }
+
+        return box;
+    }
+
     void ConvexCollider::UpdateTightAABB(const math::mat4& transform)
     {
         minMaxWorldAABB = PhysicsStatics::ConstructAABBFromTransformedVertices
@@ -230,6 +353,168 @@ namespace legion::physics
         minMaxLocalAABB = PhysicsStatics::ConstructAABBFromVertices(vertices);
     }
 
+    bool ConvexCollider::Raycast(const math::mat4& transform, const math::vec3& origin, const math::vec3& direction, float maxDistance,
+        float& distance, math::vec3& normal) const
+    {
+        //the ray is clipped in the space of the collider, the transform is affine so distances along the ray stay the same
+        math::mat4 inverseTransform = math::inverse(transform);
+        math::vec3 localOrigin = inverseTransform * math::vec4(origin, 1);
+        math::vec3 localDirection = inverseTransform * math::vec4(direction, 0);
+
+        float enter = 0.0f;
+        float exit = maxDistance;
+        HalfEdgeFace* enterFace = nullptr;
+
+        for (auto face : halfEdgeFaces)
+        {
+            float approach = math::dot(face->normal, localDirection);
+            float seperation = math::dot(face->normal, localOrigin - face->centroid);
+
+            if (math::abs(approach) < math::epsilon<float>())
+            {
+                //the ray runs parallel to the face, it misses if it starts in front of it
+                if (seperation > 0.0f) return false;
+                continue;
+            }
+
+            float t = -seperation / approach;
+            if (approach < 0.0f)
+            {
+                if (t > enter)
+                {
+                    enter = t;
+                    enterFace = face;
+                }
+            }
+            else if (t < exit)
+            {
+                exit = t;
+            }
+
+            if (enter > exit) return false;
+        }
+
+        distance = enter;
+
+        if (!enterFace)
+        {
+            //the ray starts inside of the collider
+            normal = -direction;
+            return true;
+        }
+
+        math::mat3 normalMatrix = math::transpose(math::mat3(inverseTransform));
+        normal = math::normalize(normalMatrix * enterFace->normal);
+        return true;
+    }
+
+    bool ConvexCollider::OverlapsSphere(const math::mat4& transform, const math::vec3& center, float radius) const
+    {
+        math::mat3 normalMatrix = math::transpose(math::inverse(math::mat3(transform)));
+
+        bool isInside = true;
+        float closestDistanceSquared = std::numeric_limits<float>::max();
+
+        for (auto face : halfEdgeFaces)
+        {
+            math::vec3 worldNormal = math::normalize(normalMatrix * face->normal);
+            math::vec3 worldCentroid = transform * math::vec4(face->centroid, 1);
+
+            float seperation = math::dot(worldNormal, center - worldCentroid);
+            if (seperation > radius) return false;
+            if (seperation <= 0.0f) continue;
+
+            //the center is in front of this face, so the closest point of the hull might be on it
+            isInside = false;
+
+            bool isAbove = true;
+            bool isBelow = true;
+
+            HalfEdgeEdge* current = face->startEdge;
+            do
+            {
+                math::vec3 start = transform * math::vec4(current->edgePosition, 1);
+                math::vec3 end = transform * math::vec4(current->nextEdge->edgePosition, 1);
+
+                float side = math::dot(math::cross(end - start, center - start), worldNormal);
+                isAbove &= side >= 0.0f;
+                isBelow &= side <= 0.0f;
+
+                math::vec3 edge = end - start;
+                float t = math::clamp(math::dot(center - start, edge) / math::max(math::dot(edge, edge), math::epsilon<float>()), 0.0f, 1.0f);
+                math::vec3 closest = start + edge * t;
+                closestDistanceSquared = math::min(closestDistanceSquared, math::length2(center - closest));
+
+                current = current->nextEdge;
+            } while (current != face->startEdge);
+
+            //the center projects onto the face itself, the winding of the face doesn't matter as long as it's on the same side of all edges
+            if (isAbove || isBelow)
+                closestDistanceSquared = math::min(closestDistanceSquared, seperation * seperation);
+        }
+
+        return isInside || closestDistanceSquared <= radius * radius;
+    }
+
+    bool ConvexCollider::OverlapsAABB(const math::mat4& transform, const math::vec3& min, const math::vec3& max) const
+    {
+        const math::vec3 boxCenter = (min + max) * 0.5f;
+        const math::vec3 boxExtents = (max - min) * 0.5f;
+
+        std::vector<math::vec3> worldVertices;
+        worldVertices.reserve(vertices.size());
+        for (auto& vertex : vertices)
+            worldVertices.push_back(transform * math::vec4(vertex, 1));
+
+        auto isSeperatingAxis = [&](const math::vec3& axis)
+        {
+            float boxCenterProjection = math::dot(boxCenter, axis);
+            float boxRadius = math::dot(boxExtents, math::abs(axis));
+
+            float hullMin = std::numeric_limits<float>::max();
+            float hullMax = std::numeric_limits<float>::lowest();
+            for (auto& vertex : worldVertices)
+            {
+                float projection = math::dot(vertex, axis);
+                hullMin = math::min(hullMin, projection);
+                hullMax = math::max(hullMax, projection);
+            }
+
+            return hullMin > boxCenterProjection + boxRadius || hullMax < boxCenterProjection - boxRadius;
+        };
+
+        const math::vec3 boxAxes[3] = { math::vec3(1, 0, 0), math::vec3(0, 1, 0), math::vec3(0, 0, 1) };
+        for (auto& axis : boxAxes)
+            if (isSeperatingAxis(axis)) return false;
+
+        math::mat3 normalMatrix = math::transpose(math::inverse(math::mat3(transform)));
+        math::mat3 directionMatrix = math::mat3(transform);
+
+        for (auto face : halfEdgeFaces)
+        {
+            if (isSeperatingAxis(normalMatrix * face->normal)) return false;
+
+            HalfEdgeEdge* current = face->startEdge;
+            do
+            {
+                //every edge is shared by two faces, so only one of its half edges needs to be checked
+                if (current < current->pairingEdge)
+                {
+                    math::vec3 edgeDirection = directionMatrix * current->getLocalEdgeDirection();
+                    for (auto& boxAxis : boxAxes)
+                    {
+                        math::vec3 axis = math::cross(edgeDirection, boxAxis);
+                        if (math::length2(axis) > math::epsilon<float>() && isSeperatingAxis(axis)) return false;
+                    }
+                }
+
+                current = current->nextEdge;
+            } while (current != face->startEdge);
+        }
+
+        return true;
+    }
+
     void ConvexCollider::DrawColliderRepresentation(const math::mat4& transform,math::color usedColor, float width, float time,bool ignoreDepth)
     {
         if (!shouldBeDrawn) { return; }
@@ -268,6 +553,8 @@ namespace legion::physics
     void ConvexCollider::ConstructConvexHullWithMesh(mesh& mesh, math::vec3 spacingAmount,bool shouldDebug)
     {
         OPTICK_EVENT();
+        isBox = false;
+
        // log::debug("-------------------------------- ConstructConvexHullWithMesh ----------------------------------");
         // Step 0 - Create inital hull
         /*if (step == 0)
@@ -303,13 +590,13 @@ namespace legion::physics
         vertices.push_back(mesh.vertices.at(index0));
         vertices.push_back(mesh.vertices.at(index1));
         vertices.push_back(mesh.vertices.at(index2));
-        HalfEdgeEdge* edge0 = new HalfEdgeEdge(vertices.at(0));
-        HalfEdgeEdge* edge1 = new HalfEdgeEdge(vertices.at(1));
-        HalfEdgeEdge* edge2 = new HalfEdgeEdge(vertices.at(2));
+        HalfEdgeEdge* edge0 = halfEdgeArena.createEdge(vertices.at(0));
+        HalfEdgeEdge* edge1 = halfEdgeArena.createEdge(vertices.at(1));
+        HalfEdgeEdge* edge2 = halfEdgeArena.createEdge(vertices.at(2));
         edge0->setNextAndPrevEdge(edge2, edge1); //goes from 0 to 1
         edge1->setNextAndPrevEdge(edge0, edge2); //goes from 1 to 2
         edge2->setNextAndPrevEdge(edge1, edge0); //goes from 2 to 0
-        HalfEdgeFace* face012 = new HalfEdgeFace(edge0, normal012);
+        HalfEdgeFace* face012 = halfEdgeArena.createFace(edge0, normal012);
         halfEdgeFaces.push_back(face012);
         faceIndexMap.emplace(halfEdgeFaces[0], 0);
 
@@ -345,36 +632,36 @@ namespace legion::physics
         //HalfEdgeFace* face012 = new HalfEdgeFace(edge0, normal012);
 
         // Face 1 - edges: 3, 4, 5 - vertices: 3, 1, 0
-        HalfEdgeEdge* edge3 = new HalfEdgeEdge(vertices.at(3));
-        HalfEdgeEdge* edge4 = new HalfEdgeEdge(vertices.at(1));
-        HalfEdgeEdge* edge5 = new HalfEdgeEdge(vertices.at(0));
+        HalfEdgeEdge* edge3 = halfEdgeArena.createEdge(vertices.at(3));
+        HalfEdgeEdge* edge4 = halfEdgeArena.createEdge(vertices.at(1));
+        HalfEdgeEdge* edge5 = halfEdgeArena.createEdge(vertices.at(0));
         edge3->setNextAndPrevEdge(edge5, edge4); // goes from 3 to 1
         edge4->setNextAndPrevEdge(edge3, edge5); // goes from 1 to 0
         edge5->setNextAndPrevEdge(edge4, edge3); // goes from 0 to 3
         math::vec3 normal310 = math::normalize(math::cross((mesh.vertices.at(index1) - mesh.vertices.at(index3)), (mesh.vertices.at(index0) - mesh.vertices.at(index3))));
-        HalfEdgeFace* face310 = new HalfEdgeFace(edge3, normal310);
+        HalfEdgeFace* face310 = halfEdgeArena.createFace(edge3, normal310);
 
 
         // Face 2 - edges: 6, 7, 8 - vertices 2, 1, 3
-        HalfEdgeEdge* edge6 = new HalfEdgeEdge(vertices.at(2));
-        HalfEdgeEdge* edge7 = new HalfEdgeEdge(vertices.at(1));
-        HalfEdgeEdge* edge8 = new HalfEdgeEdge(vertices.at(3));
+        HalfEdgeEdge* edge6 = halfEdgeArena.createEdge(vertices.at(2));
+        HalfEdgeEdge* edge7 = halfEdgeArena.createEdge(vertices.at(1));
+        HalfEdgeEdge* edge8 = halfEdgeArena.createEdge(vertices.at(3));
         edge6->setNextAndPrevEdge(edge8, edge7); // goes from 2 to 1
         edge7->setNextAndPrevEdge(edge6, edge8); // goes from 1 to 3
         edge8->setNextAndPrevEdge(edge7, edge6); // goes from 3 to 2
         math::vec3 normal213 = math::normalize(math::cross((mesh.vertices.at(index1) - mesh.vertices.at(index2)), (mesh.vertices.at(index3) - mesh.vertices.at(index2))));
-        HalfEdgeFace* face213 = new HalfEdgeFace(edge6, normal213);
+        HalfEdgeFace* face213 = halfEdgeArena.createFace(edge6, normal213);
 
 
         // Face 3 - edges: 9, 10, 11 - vertices: 3, 0, 2
-        HalfEdgeEdge* edge9 = new HalfEdgeEdge(vertices.at(3));
-        HalfEdgeEdge* edge10 = new HalfEdgeEdge(vertices.at(0));
-        HalfEdgeEdge* edge11 = new HalfEdgeEdge(vertices.at(2));
+        HalfEdgeEdge* edge9 = halfEdgeArena.createEdge(vertices.at(3));
+        HalfEdgeEdge* edge10 = halfEdgeArena.createEdge(vertices.at(0));
+        HalfEdgeEdge* edge11 = halfEdgeArena.createEdge(vertices.at(2));
         edge9->setNextAndPrevEdge(edge11, edge10); // goes from 3 to 0
         edge10->setNextAndPrevEdge(edge9, edge11); // goes from 0 to 2
         edge11->setNextAndPrevEdge(edge10, edge9); // goes from 2 to 3
         math::vec3 normal302 = math::normalize(math::cross((mesh.vertices.at(index0) - mesh.vertices.at(index3)), (mesh.vertices.at(index2) - mesh.vertices.at(index3))));
-        HalfEdgeFace* face302 = new HalfEdgeFace(edge9, normal302);
+        HalfEdgeFace* face302 = halfEdgeArena.createFace(edge9, normal302);
 
         // Pair edges
         edge0->setPairingEdge(edge4);
@@ -562,9 +849,9 @@ namespace legion::physics
                 facesToBeDeleted.emplace(edges.at(i)->face);
 
                 // Create the edges for the new face of the hull
-                HalfEdgeEdge* edge0 = new HalfEdgeEdge(edges.at(i)->edgePosition);
-                HalfEdgeEdge* edge1 = new HalfEdgeEdge(edges.at(i)->nextEdge->edgePosition); // Tail of edge
-                HalfEdgeEdge* edge2 = new HalfEdgeEdge(faceVertMap.at(faceIndex).at(vertIndex)); // Vertex positon
+                HalfEdgeEdge* edge0 = halfEdgeArena.createEdge(edges.at(i)->edgePosition);
+                HalfEdgeEdge* edge1 = halfEdgeArena.createEdge(edges.at(i)->nextEdge->edgePosition); // Tail of edge
+                HalfEdgeEdge* edge2 = halfEdgeArena.createEdge(faceVertMap.at(faceIndex).at(vertIndex)); // Vertex positon
 
 
                 // Setup next and previous edges of the edges we just created
@@ -603,7 +890,7 @@ namespace legion::physics
                 math::vec3 normal = math::normalize(math::cross(edge1->edgePosition - edge0->edgePosition, edge2->edgePosition - edge0->edgePosition));
 
                 //Create Face
-                HalfEdgeFace* face = new HalfEdgeFace(edge0, normal);
+                HalfEdgeFace* face = halfEdgeArena.createFace(edge0, normal);
                 face->setFaceForAllEdges();
 
                 //Add Face to Faces
@@ -630,8 +917,8 @@ namespace legion::physics
                 }
             }
 
-            // Now the old edges edges and faces that have been replaced with new faces will be deleted
-            // Edges will be deleted by the destructor of HalfEdgeFace
+            // Now the old edges edges and faces that have been replaced with new faces will be removed
+            // They stay in the arena until the hull is done
             for (auto& face : facesToBeDeleted)
             {
                 // Remove face from faces map
@@ -682,6 +969,11 @@ namespace legion::physics
         //    iter = std::remove(halfEdgeFaces.begin(), halfEdgeFaces.end(), removed.at(i));
         //}
         ////convexHullMergeFaces(halfEdgeFaces,true);
+
+        // Throw away all the edges and faces that were replaced while growing the hull
+        halfEdgeArena.compact(halfEdgeFaces);
+        faceIndexMap.clear();
+
         AssertEdgeValidity();
         //log::debug("-> Finish ConstructConvexHullWithMesh ----------------------------------");
     }
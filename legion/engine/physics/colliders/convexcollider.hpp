@@ -6,8 +6,9 @@
 #include <physics/cube_collider_params.hpp>
 #include <physics/halfedgeedge.hpp>
 #include <physics/halfedgeface.hpp>
-#include <physics/data/convex_convergance_identifier.hpp>
+#include <physics/halfedgearena.hpp>
 #include <physics/data/physics_manifold.hpp>
+#include <physics/shape_collision.hpp>
 #include <rendering/debugrendering.hpp>
 
 namespace legion::physics
@@ -19,22 +20,20 @@ namespace legion::physics
         int step = 0;
         ConvexCollider() = default;
 
-        ~ConvexCollider()
+        /**@brief Creates a new collider with the same shape as another collider.
+         * The half-edge mesh is copied in one go instead of being rebuilt, which makes this a cheap way to create lots of colliders of the same shape.
+         */
+        ConvexCollider(const ConvexCollider& other) : PhysicsCollider(other), vertices(other.vertices),
+            isBox(other.isBox), boxCenter(other.boxCenter), boxHalfExtents(other.boxHalfExtents), halfEdgeArena(other.halfEdgeArena)
         {
-            for (auto face : halfEdgeFaces)
+            halfEdgeFaces.reserve(other.halfEdgeFaces.size());
+            for (auto face : other.halfEdgeFaces)
             {
-                delete face;
+                halfEdgeFaces.push_back(halfEdgeArena.translate(face));
             }
         }
 
-        /** @brief Given a physics_contact that has been resolved, use its label and lambdas in order to create a ConvexConverganceIdentifier
-       */
-        void AddConverganceIdentifier(const physics_contact& contact) override
-        {
-            converganceIdentifiers.push_back(
-                std::make_unique<ConvexConverganceIdentifier>(contact.label, contact.totalLambda,
-                    contact.tangent1Lambda, contact.tangent2Lambda, GetColliderID()));
-        }
+        ConvexCollider& operator=(const ConvexCollider& other) = delete;
 
         void CheckCollision(PhysicsCollider* physicsCollider, physics_manifold& manifold) override
         {
@@ -53,6 +52,41 @@ namespace legion::physics
 
         void PopulateContactPointsWith(ConvexCollider* convexCollider, physics_manifold& manifold) override;
 
+        /** @brief Collides the hull with the sphere in closed form, see CollideWithSphere
+        */
+        void CheckCollisionWith(SphereCollider* sphereCollider, physics_manifold& manifold) override;
+
+        /** @brief Collides the hull with the capsule in closed form, see CollideWithCapsule
+        */
+        void CheckCollisionWith(CapsuleCollider* capsuleCollider, physics_manifold& manifold) override;
+
+        void PopulateContactPointsWith(SphereCollider* sphereCollider, physics_manifold& manifold) override;
+
+        void PopulateContactPointsWith(CapsuleCollider* capsuleCollider, physics_manifold& manifold) override;
+
+        /** @brief Collides the hull with a sphere and stores the result in the manifold, the hull is the reference collider of the collision.
+        * Boxes use ShapeCollision::BoxSphere, other hulls use ShapeCollision::HullSphere.
+        * @param isHullA Whether this hull is colliderA of the manifold
+        */
+        void CollideWithSphere(const world_sphere& sphere, physics_manifold& manifold, bool isHullA);
+
+        /** @brief Collides the hull with a capsule and stores the result in the manifold, the hull is the reference collider of the collision.
+        * @param isHullA Whether this hull is colliderA of the manifold
+        */
+        void CollideWithCapsule(const world_capsule& capsule, physics_manifold& manifold, bool isHullA);
+
+        /** @brief Whether this hull was created by CreateBox, boxes can use the closed form tests of ShapeCollision.
+        */
+        bool IsBox() const noexcept
+        {
+            return isBox;
+        }
+
+        /** @brief Gets the box of this hull in world space.
+        * @note Only valid if IsBox returns true
+        */
+        world_box GetWorldBox(const math::mat4& transform) const;
+
         void UpdateTransformedTightBoundingVolume(const math::mat4& transform) override
         {
             UpdateTightAABB(transform);
@@ -66,6 +100,20 @@ namespace legion::physics
         /**@brief Using the vertices of the convexCollider,creates a ;
        */
         void UpdateLocalAABB() override;
+
+        /** @brief Clips the ray against the planes of all the faces of the convex hull.
+        */
+        bool Raycast(const math::mat4& transform, const math::vec3& origin, const math::vec3& direction, float maxDistance,
+            float& distance, math::vec3& normal) const override;
+
+        /** @brief Finds the closest point on the faces in front of the center of the sphere, or finds that the center is inside the convex hull.
+        */
+        bool OverlapsSphere(const math::mat4& transform, const math::vec3& center, float radius) const override;
+
+        /** @brief Seperating axis test between the convex hull and the AABB,
+        * using the axes of the AABB, the normals of the faces and the cross products of the edges with the axes of the AABB.
+        */
+        bool OverlapsAABB(const math::mat4& transform, const math::vec3& min, const math::vec3& max) const override;
        
         virtual void DrawColliderRepresentation(const math::mat4& transform, math::color usedColor, float width,float time,bool ignoreDepth = false) override;
         
@@ -171,6 +219,10 @@ namespace legion::physics
             vertices.push_back(maxVertexMinusWidthMinusBreadth);
             vertices.push_back(maxVertexMinusBreadth);
 
+            isBox = true;
+            boxCenter = cubeParams.offset;
+            boxHalfExtents = math::vec3(halfWidth, halfHeight, halfBreath);
+
             for (auto& vertex : vertices)
             {
                 vertex += cubeParams.offset;
@@ -194,97 +246,97 @@ namespace legion::physics
 
             //[1] create face eghf
 
-            HalfEdgeEdge* eg = new HalfEdgeEdge(e);
-            HalfEdgeEdge* gh = new HalfEdgeEdge(g);
-            HalfEdgeEdge* hf = new HalfEdgeEdge(h);
-            HalfEdgeEdge* fe = new HalfEdgeEdge(f);
+            HalfEdgeEdge* eg = halfEdgeArena.createEdge(e);
+            HalfEdgeEdge* gh = halfEdgeArena.createEdge(g);
+            HalfEdgeEdge* hf = halfEdgeArena.createEdge(h);
+            HalfEdgeEdge* fe = halfEdgeArena.createEdge(f);
 
             eg->setNextAndPrevEdge(fe, gh);
             gh->setNextAndPrevEdge(eg, hf);
             hf->setNextAndPrevEdge(gh, fe);
             fe->setNextAndPrevEdge(hf, eg);
 
-            HalfEdgeFace* eghf = new HalfEdgeFace(eg, math::vec3(0, 1, 0));
+            HalfEdgeFace* eghf = halfEdgeArena.createFace(eg, math::vec3(0, 1, 0));
             halfEdgeFaces.push_back(eghf);
             //eghf->id = " eghf";
 
             //[2] create face hgcd
 
-            HalfEdgeEdge* hg = new HalfEdgeEdge(h);
-            HalfEdgeEdge* gc = new HalfEdgeEdge(g);
-            HalfEdgeEdge* cd = new HalfEdgeEdge(c);
-            HalfEdgeEdge* dh = new HalfEdgeEdge(d);
+            HalfEdgeEdge* hg = halfEdgeArena.createEdge(h);
+            HalfEdgeEdge* gc = halfEdgeArena.createEdge(g);
+            HalfEdgeEdge* cd = halfEdgeArena.createEdge(c);
+            HalfEdgeEdge* dh = halfEdgeArena.createEdge(d);
 
             hg->setNextAndPrevEdge(dh, gc);
             gc->setNextAndPrevEdge(hg, cd);
             cd->setNextAndPrevEdge(gc, dh);
             dh->setNextAndPrevEdge(cd, hg);
 
-            HalfEdgeFace* hgcd = new HalfEdgeFace(hg, math::vec3(0, 0, -1));
+            HalfEdgeFace* hgcd = halfEdgeArena.createFace(hg, math::vec3(0, 0, -1));
             halfEdgeFaces.push_back(hgcd);
             //hgcd->id = "hgcd";
 
             //[3] create face fhdb
 
-            HalfEdgeEdge* fh = new HalfEdgeEdge(f);
-            HalfEdgeEdge* hd = new HalfEdgeEdge(h);
-            HalfEdgeEdge* db = new HalfEdgeEdge(d);
-            HalfEdgeEdge* bf = new HalfEdgeEdge(b);
+            HalfEdgeEdge* fh = halfEdgeArena.createEdge(f);
+            HalfEdgeEdge* hd = halfEdgeArena.createEdge(h);
+            HalfEdgeEdge* db = halfEdgeArena.createEdge(d);
+            HalfEdgeEdge* bf = halfEdgeArena.createEdge(b);
 
             fh->setNextAndPrevEdge(bf, hd);
             hd->setNextAndPrevEdge(fh, db);
             db->setNextAndPrevEdge(hd, bf);
             bf->setNextAndPrevEdge(db, fh);
 
-            HalfEdgeFace* fhdb = new HalfEdgeFace(fh, math::vec3(1, 0, 0));
+            HalfEdgeFace* fhdb = halfEdgeArena.createFace(fh, math::vec3(1, 0, 0));
             halfEdgeFaces.push_back(fhdb);
             //fhdb->id = "fhdb";
 
             //[4] create face efba
 
-            HalfEdgeEdge* ef = new HalfEdgeEdge(e);
-            HalfEdgeEdge* fb = new HalfEdgeEdge(f);
-            HalfEdgeEdge* ba = new HalfEdgeEdge(b);
-            HalfEdgeEdge* ae = new HalfEdgeEdge(a);
+            HalfEdgeEdge* ef = halfEdgeArena.createEdge(e);
+            HalfEdgeEdge* fb = halfEdgeArena.createEdge(f);
+            HalfEdgeEdge* ba = halfEdgeArena.createEdge(b);
+            HalfEdgeEdge* ae = halfEdgeArena.createEdge(a);
 
             ef->setNextAndPrevEdge(ae, fb);
             fb->setNextAndPrevEdge(ef, ba);
             ba->setNextAndPrevEdge(fb, ae);
             ae->setNextAndPrevEdge(ba, ef);
 
-            HalfEdgeFace* efba = new HalfEdgeFace(ef, math::vec3(0, 0, 1));
+            HalfEdgeFace* efba = halfEdgeArena.createFace(ef, math::vec3(0, 0, 1));
             halfEdgeFaces.push_back(efba);
             //efba->id = "efba";
 
             //[5] create face geac
 
-            HalfEdgeEdge* ge = new HalfEdgeEdge(g);
-            HalfEdgeEdge* ea = new HalfEdgeEdge(e);
-            HalfEdgeEdge* ac = new HalfEdgeEdge(a);
-            HalfEdgeEdge* cg = new HalfEdgeEdge(c);
+            HalfEdgeEdge* ge = halfEdgeArena.createEdge(g);
+            HalfEdgeEdge* ea = halfEdgeArena.createEdge(e);
+            HalfEdgeEdge* ac = halfEdgeArena.createEdge(a);
+            HalfEdgeEdge* cg = halfEdgeArena.createEdge(c);
 
             ge->setNextAndPrevEdge(cg, ea);
             ea->setNextAndPrevEdge(ge, ac);
             ac->setNextAndPrevEdge(ea, cg);
             cg->setNextAndPrevEdge(ac, ge);
 
-            HalfEdgeFace* geac = new HalfEdgeFace(ge, math::vec3(-1, 0, 0));
+            HalfEdgeFace* geac = halfEdgeArena.createFace(ge, math::vec3(-1, 0, 0));
             halfEdgeFaces.push_back(geac);
             //geac->id = "geac";
 
             //[6] create face abdc
 
-            HalfEdgeEdge* ab = new HalfEdgeEdge(a);
-            HalfEdgeEdge* bd = new HalfEdgeEdge(b);
-            HalfEdgeEdge* dc = new HalfEdgeEdge(d);
-            HalfEdgeEdge* ca = new HalfEdgeEdge(c);
+            HalfEdgeEdge* ab = halfEdgeArena.createEdge(a);
+            HalfEdgeEdge* bd = halfEdgeArena.createEdge(b);
+            HalfEdgeEdge* dc = halfEdgeArena.createEdge(d);
+            HalfEdgeEdge* ca = halfEdgeArena.createEdge(c);
 
             ab->setNextAndPrevEdge(ca, bd);
             bd->setNextAndPrevEdge(ab, dc);
             dc->setNextAndPrevEdge(bd, ca);
             ca->setNextAndPrevEdge(dc, ab);
 
-            HalfEdgeFace* abdc = new HalfEdgeFace(ab, math::vec3(0, -1, 0));
+            HalfEdgeFace* abdc = halfEdgeArena.createFace(ab, math::vec3(0, -1, 0));
             halfEdgeFaces.push_back(abdc);
             //abdc->id = "abdc";
 
@@ -369,6 +421,11 @@ namespace legion::physics
 
         std::vector<math::vec3> vertices;
 
+        //the shape that was given to CreateBox, so boxes can skip the half-edge mesh where a closed form test exists
+        bool isBox = false;
+        math::vec3 boxCenter;
+        math::vec3 boxHalfExtents;
+
         HalfEdgeFace* instantiateMeshFace(const std::vector<math::vec3*>& vertices, const math::vec3& faceNormal)
         {
             if (vertices.size() == 0) { return nullptr; }
@@ -377,7 +434,7 @@ namespace legion::physics
 
             for (const auto vert : vertices)
             {
-                faceEdges.push_back(new HalfEdgeEdge(*vert));
+                faceEdges.push_back(halfEdgeArena.createEdge(*vert));
             }
 
             for (size_t i = 0; i < faceEdges.size(); i++)
@@ -392,7 +449,7 @@ namespace legion::physics
 
             }
 
-            return new HalfEdgeFace(faceEdges.at(0), faceNormal);
+            return halfEdgeArena.createFace(faceEdges.at(0), faceNormal);
         }
 
         /**@brief Function to find the outer two indices with the largest distance from the mesh
@@ -639,6 +696,7 @@ namespace legion::physics
                             // We check if this is indeed the case: if the returned face is a different face
                             // we need to remove the old face and add the new face to the halfEdgeFaces vector
                             HalfEdgeFace* face = HalfEdgeFace::mergeFaces(*centerEdge);
+                            // The edges between the faces and the face that was merged away stay in the arena until the hull is done
                        
                             if (face != halfEdgeFaces.at(j))
                             {
@@ -656,6 +714,8 @@ namespace legion::physics
         }
 
         
+        //owns all the edges and faces of the collider
+        HalfEdgeArena halfEdgeArena;
         std::vector<HalfEdgeFace*> halfEdgeFaces;
 
         // Convex hull generation debug stuffs
@@ -0,0 +1,40 @@
+#include <physics/colliders/physicscollider.hpp>
+#include <physics/data/physics_manifold.hpp>
+
+namespace legion::physics
+{
+    void PhysicsCollider::PopulateContactsFromPenetrationInformation(physics_manifold& manifold)
+    {
+        OPTICK_EVENT();
+        math::mat4& refTransform = manifold.penetrationInformation->isARef ? manifold.transformA : manifold.transformB;
+        math::mat4& incTransform = manifold.penetrationInformation->isARef ? manifold.transformB : manifold.transformA;
+
+        physicsComponent* refPhysicsComp = manifold.penetrationInformation->isARef ? manifold.physicsCompA : manifold.physicsCompB;
+        physicsComponent* incPhysicsComp = manifold.penetrationInformation->isARef ? manifold.physicsCompB : manifold.physicsCompA;
+
+        PhysicsCollider* refCollider = manifold.penetrationInformation->isARef ? manifold.colliderA : manifold.colliderB;
+
+        manifold.penetrationInformation->populateContactList(manifold, refTransform, incTransform, refCollider);
+
+        rigidbody* refRB = manifold.penetrationInformation->isARef ? manifold.rigidbodyA : manifold.rigidbodyB;
+        rigidbody* incRB = manifold.penetrationInformation->isARef ? manifold.rigidbodyB : manifold.rigidbodyA;
+
+        math::vec3 refWorldCentroid = refTransform * math::vec4(refPhysicsComp->localCenterOfMass,1);
+        math::vec3 incWorldCentroid = incTransform * math::vec4(incPhysicsComp->localCenterOfMass,1);
+
+        for ( auto& contact : manifold.contacts)
+        {
+            contact.incTransform = incTransform;
+            contact.refTransform = refTransform;
+
+            contact.rbInc = incRB;
+            contact.rbRef = refRB;
+           
+            contact.collisionNormal = manifold.penetrationInformation->normal;
+
+            contact.refRBCentroid = refWorldCentroid;
+            contact.incRBCentroid = incWorldCentroid;
+
+        }
+    }
+}
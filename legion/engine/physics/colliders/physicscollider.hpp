@@ -1,60 +1,61 @@
 #pragma once
 
 #include <core/core.hpp>
+#include <atomic>
 #include <memory>
 #include <physics/halfedgeface.hpp>
-#include <physics/data/convergance_identifier.hpp>
 #include <physics/physics_contact.hpp>
 
 namespace legion::physics
 {
     struct physics_manifold;
     class ConvexCollider;
+    class SphereCollider;
+    class CapsuleCollider;
 
 
     class PhysicsCollider
     {
     public:
         bool shouldBeDrawn = true;
-        std::vector<std::unique_ptr<ConverganceIdentifier>> converganceIdentifiers;
 
         PhysicsCollider()
         {
-            static int colliderID = 0;
-            id = colliderID++;
+            // Colliders are created on the job threads when fractures get processed.
+            static std::atomic<int> colliderID{ 0 };
+            id = colliderID.fetch_add(1, std::memory_order_relaxed);
         }
 
-        virtual void AddConverganceIdentifier(const  physics_contact& contact) = 0;
-
-        void AttemptFindAndCopyConverganceID(physics_contact& contact)
+        /** @brief Copies the bounds of another collider. The copy is a different collider, so it gets a new id.
+        */
+        PhysicsCollider(const PhysicsCollider& other) : PhysicsCollider()
         {
-            if (!constants::applyWarmStarting) { return; }
-
-            for (auto&& converganceId : converganceIdentifiers)
-            {
-                if (converganceId->refColliderID == contact.refCollider->GetColliderID())
-                {
-                    if (converganceId->IsEqual(contact))
-                    {
-                        converganceId->CopyLambdasToContact(contact);
-                        return;
-                    }
-                }
-            }
+            shouldBeDrawn = other.shouldBeDrawn;
+            localColliderCentroid = other.localColliderCentroid;
+            minMaxLocalAABB = other.minMaxLocalAABB;
+            minMaxWorldAABB = other.minMaxWorldAABB;
         }
-            
+
         /** @brief given a PhysicsCollider, CheckCollision calls "CheckCollisionWith". Both colliders are then passed through
         * to the correct "CheckCollisionWith" function with double dispatch.
         * @param physicsCollider The collider we would like to check collision against
         * @param [in/out] manifold A physics_manifold that holds information about the collision
         */
         virtual void CheckCollision(
-            PhysicsCollider* physicsCollider, physics_manifold& manifold) {};
+            L_MAYBEUNUSED PhysicsCollider* physicsCollider, L_MAYBEUNUSED physics_manifold& manifold) {};
 
         /** @brief given a convexCollider checks if this collider collides the convexCollider. The information
         * the information is then passed to the manifold.
         */
-        virtual void CheckCollisionWith(ConvexCollider* convexCollider, physics_manifold& manifold) {};
+        virtual void CheckCollisionWith(L_MAYBEUNUSED ConvexCollider* convexCollider, L_MAYBEUNUSED physics_manifold& manifold) {};
+
+        /** @brief given a SphereCollider checks if this collider collides the SphereCollider.
+        */
+        virtual void CheckCollisionWith(L_MAYBEUNUSED SphereCollider* sphereCollider, L_MAYBEUNUSED physics_manifold& manifold) {};
+
+        /** @brief given a CapsuleCollider checks if this collider collides the CapsuleCollider.
+        */
+        virtual void CheckCollisionWith(L_MAYBEUNUSED CapsuleCollider* capsuleCollider, L_MAYBEUNUSED physics_manifold& manifold) {};
 
         /** @brief Gets the unique id of this collider
         */
@@ -67,25 +68,51 @@ namespace legion::physics
         * to the corrent FillManifoldWith function with double dispatch.
         */
         virtual void PopulateContactPoints(
-            PhysicsCollider* physicsCollider, physics_manifold& manifold) {};
+            L_MAYBEUNUSED PhysicsCollider* physicsCollider, L_MAYBEUNUSED physics_manifold& manifold) {};
 
         /** @brief Creates the contact points between this physics collider and the given ConvexCollider and
         * stores them in the manifold
         */
         virtual void PopulateContactPointsWith(
-            ConvexCollider* convexCollider, physics_manifold& manifold) {};
+            L_MAYBEUNUSED ConvexCollider* convexCollider, L_MAYBEUNUSED physics_manifold& manifold) {};
+
+        virtual void PopulateContactPointsWith(
+            L_MAYBEUNUSED SphereCollider* sphereCollider, L_MAYBEUNUSED physics_manifold& manifold) {};
+
+        virtual void PopulateContactPointsWith(
+            L_MAYBEUNUSED CapsuleCollider* capsuleCollider, L_MAYBEUNUSED physics_manifold& manifold) {};
 
 
         /** @brief Given the transform of the entity that the collider is attached to, draws a visual representation
         * of the collider.
         * @note This is called internally by PhysicsSysten
         */
-        virtual void DrawColliderRepresentation(const math::mat4& transform, math::color usedColor, float width, float time, bool ignoreDepth = false) {};
+        virtual void DrawColliderRepresentation(L_MAYBEUNUSED const math::mat4& transform, L_MAYBEUNUSED math::color usedColor, L_MAYBEUNUSED float width, L_MAYBEUNUSED float time, L_MAYBEUNUSED bool ignoreDepth = false) {};
 
-        virtual void UpdateTransformedTightBoundingVolume(const math::mat4& transform) {};
+        virtual void UpdateTransformedTightBoundingVolume(L_MAYBEUNUSED const math::mat4& transform) {};
 
         virtual void UpdateLocalAABB() {};
 
+        /** @brief Checks if a ray hits the shape of this collider.
+        * @param transform The world transform of the entity the collider is attached to
+        * @param direction The normalized direction of the ray
+        * @param distance [out] The distance along the ray to the point where the ray enters the collider, 0 if the ray starts inside of it
+        * @param normal [out] The world space normal of the collider where the ray hits it
+        * @return Whether the ray hits the collider before maxDistance
+        */
+        virtual bool Raycast(L_MAYBEUNUSED const math::mat4& transform, L_MAYBEUNUSED const math::vec3& origin, L_MAYBEUNUSED const math::vec3& direction,
+            L_MAYBEUNUSED float maxDistance, L_MAYBEUNUSED float& distance, L_MAYBEUNUSED math::vec3& normal) const { return false; };
+
+        /** @brief Checks if a sphere in world space overlaps the shape of this collider.
+        * @param transform The world transform of the entity the collider is attached to
+        */
+        virtual bool OverlapsSphere(L_MAYBEUNUSED const math::mat4& transform, L_MAYBEUNUSED const math::vec3& center, L_MAYBEUNUSED float radius) const { return false; };
+
+        /** @brief Checks if an AABB in world space overlaps the shape of this collider.
+        * @param transform The world transform of the entity the collider is attached to
+        */
+        virtual bool OverlapsAABB(L_MAYBEUNUSED const math::mat4& transform, L_MAYBEUNUSED const math::vec3& min, L_MAYBEUNUSED const math::vec3& max) const { return false; };
+
         inline virtual std::vector<HalfEdgeFace*>& GetHalfEdgeFaces()
         {
             return dummyHalfEdges;
@@ -109,6 +136,11 @@ namespace legion::physics
 
     protected:
 
+        /** @brief Lets the penetration information of the manifold create the contacts,
+        * and gives them the transforms, rigidbodies and centers of mass of both colliders.
+        */
+        static void PopulateContactsFromPenetrationInformation(physics_manifold& manifold);
+
         math::vec3 localColliderCentroid = math::vec3(0, 0, 0);
         std::pair<math::vec3, math::vec3> minMaxLocalAABB;
         std::pair<math::vec3, math::vec3> minMaxWorldAABB;
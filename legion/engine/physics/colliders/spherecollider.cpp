@@ -0,0 +1,171 @@
+#include <physics/colliders/spherecollider.hpp>
+#include <physics/colliders/convexcollider.hpp>
+#include <physics/colliders/capsulecollider.hpp>
+#include <physics/data/analyticpenetrationquery.hpp>
+#include <physics/physics_statics.hpp>
+#include <rendering/debugrendering.hpp>
+
+namespace legion::physics
+{
+    SphereCollider::SphereCollider(float radius, const math::vec3& offset) : radius(radius)
+    {
+        localColliderCentroid = offset;
+        UpdateLocalAABB();
+    }
+
+    void SphereCollider::CheckCollisionWith(ConvexCollider* convexCollider, physics_manifold& manifold)
+    {
+        OPTICK_EVENT();
+        //'this' is colliderB and 'convexCollider' is colliderA
+        if (!PhysicsStatics::CollideAABB(minMaxWorldAABB, convexCollider->GetMinMaxWorldAABB()))
+        {
+            manifold.isColliding = false;
+            return;
+        }
+
+        convexCollider->CollideWithSphere(GetWorldSphere(manifold.transformB), manifold, true);
+    }
+
+    void SphereCollider::CheckCollisionWith(SphereCollider* sphereCollider, physics_manifold& manifold)
+    {
+        OPTICK_EVENT();
+        //'this' is colliderB and 'sphereCollider' is colliderA
+        if (!PhysicsStatics::CollideAABB(minMaxWorldAABB, sphereCollider->GetMinMaxWorldAABB()))
+        {
+            manifold.isColliding = false;
+            return;
+        }
+
+        analytic_collision collision;
+        manifold.isColliding = ShapeCollision::SphereSphere(sphereCollider->GetWorldSphere(manifold.transformA), GetWorldSphere(manifold.transformB), collision);
+
+        if (manifold.isColliding)
+        {
+            manifold.penetrationInformation = std::make_unique<AnalyticPenetrationQuery>(collision, true);
+        }
+    }
+
+    void SphereCollider::CheckCollisionWith(CapsuleCollider* capsuleCollider, physics_manifold& manifold)
+    {
+        OPTICK_EVENT();
+        //'this' is colliderB and 'capsuleCollider' is colliderA
+        if (!PhysicsStatics::CollideAABB(minMaxWorldAABB, capsuleCollider->GetMinMaxWorldAABB()))
+        {
+            manifold.isColliding = false;
+            return;
+        }
+
+        //the sphere is the reference shape, so colliderB is the reference collider
+        analytic_collision collision;
+        manifold.isColliding = ShapeCollision::SphereCapsule(GetWorldSphere(manifold.transformB), capsuleCollider->GetWorldCapsule(manifold.transformA), collision);
+
+        if (manifold.isColliding)
+        {
+            manifold.penetrationInformation = std::make_unique<AnalyticPenetrationQuery>(collision, false);
+        }
+    }
+
+    void SphereCollider::PopulateContactPointsWith(L_MAYBEUNUSED ConvexCollider* convexCollider, physics_manifold& manifold)
+    {
+        PopulateContactsFromPenetrationInformation(manifold);
+    }
+
+    void SphereCollider::PopulateContactPointsWith(L_MAYBEUNUSED SphereCollider* sphereCollider, physics_manifold& manifold)
+    {
+        PopulateContactsFromPenetrationInformation(manifold);
+    }
+
+    void SphereCollider::PopulateContactPointsWith(L_MAYBEUNUSED CapsuleCollider* capsuleCollider, physics_manifold& manifold)
+    {
+        PopulateContactsFromPenetrationInformation(manifold);
+    }
+
+    void SphereCollider::UpdateTransformedTightBoundingVolume(const math::mat4& transform)
+    {
+        world_sphere sphere = GetWorldSphere(transform);
+        minMaxWorldAABB = std::make_pair(sphere.center - math::vec3(sphere.radius), sphere.center + math::vec3(sphere.radius));
+    }
+
+    void SphereCollider::UpdateLocalAABB()
+    {
+        minMaxLocalAABB = std::make_pair(localColliderCentroid - math::vec3(radius), localColliderCentroid + math::vec3(radius));
+    }
+
+    bool SphereCollider::Raycast(const math::mat4& transform, const math::vec3& origin, const math::vec3& direction, float maxDistance,
+        float& distance, math::vec3& normal) const
+    {
+        world_sphere sphere = GetWorldSphere(transform);
+
+        math::vec3 toOrigin = origin - sphere.center;
+        float projection = math::dot(toOrigin, direction);
+        float originDistance = math::dot(toOrigin, toOrigin) - sphere.radius * sphere.radius;
+
+        if (originDistance <= 0.0f)
+        {
+            //the ray starts inside of the sphere
+            distance = 0.0f;
+            normal = -direction;
+            return true;
+        }
+
+        //the ray starts outside of the sphere and points away from it
+        if (projection > 0.0f)
+            return false;
+
+        float discriminant = projection * projection - originDistance;
+        if (discriminant < 0.0f)
+            return false;
+
+        float t = -projection - math::sqrt(discriminant);
+        if (t > maxDistance)
+            return false;
+
+        distance = t;
+        normal = math::normalize(origin + direction * t - sphere.center);
+        return true;
+    }
+
+    bool SphereCollider::OverlapsSphere(const math::mat4& transform, const math::vec3& center, float radius) const
+    {
+        world_sphere sphere = GetWorldSphere(transform);
+        float combinedRadius = sphere.radius + radius;
+        return math::length2(center - sphere.center) <= combinedRadius * combinedRadius;
+    }
+
+    bool SphereCollider::OverlapsAABB(const math::mat4& transform, const math::vec3& min, const math::vec3& max) const
+    {
+        world_sphere sphere = GetWorldSphere(transform);
+        return math::length2(sphere.center - math::clamp(sphere.center, min, max)) <= sphere.radius * sphere.radius;
+    }
+
+    void SphereCollider::DrawColliderRepresentation(const math::mat4& transform, math::color usedColor, float width, float time, bool ignoreDepth)
+    {
+        if (!shouldBeDrawn) { return; }
+
+        world_sphere sphere = GetWorldSphere(transform);
+
+        //a circle around each of the axes of the entity
+        constexpr int segmentCount = 16;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            math::vec3 first = math::normalize(math::vec3(transform[(axis + 1) % 3])) * sphere.radius;
+            math::vec3 second = math::normalize(math::vec3(transform[(axis + 2) % 3])) * sphere.radius;
+
+            for (int i = 0; i < segmentCount; i++)
+            {
+                float startAngle = math::two_pi<float>() * i / segmentCount;
+                float endAngle = math::two_pi<float>() * (i + 1) / segmentCount;
+
+                math::vec3 start = sphere.center + first * math::cos(startAngle) + second * math::sin(startAngle);
+                math::vec3 end = sphere.center + first * math::cos(endAngle) + second * math::sin(endAngle);
+
+                debug::user_projectDrawLine(start, end, usedColor, width, time, ignoreDepth);
+            }
+        }
+    }
+
+    world_sphere SphereCollider::GetWorldSphere(const math::mat4& transform) const
+    {
+        return world_sphere{ transform * math::vec4(localColliderCentroid, 1), radius * ShapeCollision::GetMaxScale(transform) };
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <core/core.hpp>
+#include <physics/colliders/physicscollider.hpp>
+#include <physics/shape_collision.hpp>
+
+namespace legion::physics
+{
+    /**@class SphereCollider
+     * @brief A sphere that is collided in closed form by ShapeCollision, it doesn't need a half-edge mesh.
+     * The radius is scaled by the largest scale of the entity, so the sphere stays round.
+     */
+    class SphereCollider : public PhysicsCollider
+    {
+    public:
+        /**@param radius The radius of the sphere before the entity is scaled
+         * @param offset The position of the center of the sphere relative to the entity
+         */
+        SphereCollider(float radius = 0.5f, const math::vec3& offset = math::vec3());
+
+        void CheckCollision(PhysicsCollider* physicsCollider, physics_manifold& manifold) override
+        {
+            physicsCollider->CheckCollisionWith(this, manifold);
+        }
+
+        void CheckCollisionWith(ConvexCollider* convexCollider, physics_manifold& manifold) override;
+
+        void CheckCollisionWith(SphereCollider* sphereCollider, physics_manifold& manifold) override;
+
+        void CheckCollisionWith(CapsuleCollider* capsuleCollider, physics_manifold& manifold) override;
+
+        void PopulateContactPoints(PhysicsCollider* physicsCollider, physics_manifold& manifold) override
+        {
+            physicsCollider->PopulateContactPointsWith(this, manifold);
+        }
+
+        void PopulateContactPointsWith(ConvexCollider* convexCollider, physics_manifold& manifold) override;
+
+        void PopulateContactPointsWith(SphereCollider* sphereCollider, physics_manifold& manifold) override;
+
+        void PopulateContactPointsWith(CapsuleCollider* capsuleCollider, physics_manifold& manifold) override;
+
+        void UpdateTransformedTightBoundingVolume(const math::mat4& transform) override;
+
+        void UpdateLocalAABB() override;
+
+        bool Raycast(const math::mat4& transform, const math::vec3& origin, const math::vec3& direction, float maxDistance,
+            float& distance, math::vec3& normal) const override;
+
+        bool OverlapsSphere(const math::mat4& transform, const math::vec3& center, float radius) const override;
+
+        bool OverlapsAABB(const math::mat4& transform, const math::vec3& min, const math::vec3& max) const override;
+
+        void DrawColliderRepresentation(const math::mat4& transform, math::color usedColor, float width, float time, bool ignoreDepth = false) override;
+
+        L_NODISCARD world_sphere GetWorldSphere(const math::mat4& transform) const;
+
+        L_NODISCARD float GetRadius() const noexcept
+        {
+            return radius;
+        }
+
+    private:
+        float radius;
+    };
+}
@@ -4,16 +4,18 @@
 #include <physics/colliders/convexcollider.hpp>
 #include <physics/data/identifier.hpp>
 #include <physics/physics_statics.hpp>
+#include <physics/data/fracture_pattern_cache.hpp>
+#include <random>
 
 namespace legion::physics
 {
     ecs::EcsRegistry* Fracturer::registry = nullptr;
 
-    void Fracturer::HandleFracture(physics_manifold& manifold, bool& manifoldValid,bool isfracturingA)
+    std::shared_ptr<fracture_task> Fracturer::HandleFracture(physics_manifold& manifold, bool& manifoldValid,bool isfracturingA)
     {
-        return;
+        return nullptr;
         OPTICK_EVENT();
-        if (!IsFractureConditionMet(manifold,isfracturingA) || manifold.contacts.empty()) { return; }
+        if (!IsFractureConditionMet(manifold,isfracturingA) || manifold.contacts.empty()) { return nullptr; }
         
         //log::debug("manifold invalidated");
         manifoldValid = false;
@@ -25,62 +27,62 @@ namespace legion::physics
         auto collider = isfracturingA ? manifold.colliderA : manifold.colliderB;
 
         FractureParams params(impactPoint, 0.0f);
-        ExplodeEntity(fracturedEnt, params, collider);
+        return RequestFracture(fracturedEnt, params, collider);
     }
 
     void Fracturer::ExplodeEntity(ecs::entity_handle ownerEntity, const FractureParams& fractureParams, PhysicsCollider* entityCollider)
     {
         log::debug("------------------------------------- ExplodeEntity ---------------------------------------");
 
-        if (!entityCollider)
-        {
-            log::debug("colliders size {} "
-                , ownerEntity.read_component<physicsComponent>().colliders.size());
+        auto task = RequestFracture(ownerEntity, fractureParams, entityCollider);
+        if (!task) { return; }
 
-            auto physicsComp = ownerEntity.get_component_handle<physicsComponent>().read();
-            entityCollider = physicsComp.colliders.at(0).get();
+        if (!task->IsDone())
+        {
+            PrepareFractureCells(*task);
 
+            for (size_type cell = 0; cell < task->voronoiPoints.size(); cell++)
+            {
+                SplitFractureCell(*task, cell);
+            }
         }
-        
-        //ownerEntity.read_component<physicsComponent>().colliders.at(0)
-        auto [min, max] = entityCollider->GetMinMaxWorldAABB();
 
-        //-----------------------------------------------------------------------------------------------------------------------------//
-                                //Generate a Voronoi Diagram, for now, the points are manually generated //
-        //-----------------------------------------------------------------------------------------------------------------------------//
+        CommitFracture(*task);
+    }
 
-        std::vector<math::vec3> voronoiPoints;
+    std::shared_ptr<fracture_task> Fracturer::RequestFracture(ecs::entity_handle ownerEntity, const FractureParams& fractureParams, PhysicsCollider* entityCollider)
+    {
+        OPTICK_EVENT();
 
-        QuadrantVoronoi(min, max, voronoiPoints);
+        //an entity is only fractured once, it stays alive until the fragments of its fracture are committed
+        if (fractureCount > 0) { return nullptr; }
 
-        //math::vec3 six = third + math::vec3(-0.2f, 0.0f, -0.0f);
-        //voronoiPoints.push_back(six);
+        if (!entityCollider)
+        {
+            log::debug("colliders size {} "
+                , ownerEntity.read_component<physicsComponent>().colliders.size());
+
+            auto physicsComp = ownerEntity.get_component_handle<physicsComponent>().read();
+            entityCollider = physicsComp.colliders.at(0).get();
 
-        for (auto point : voronoiPoints)
-        {/*
-            debug::drawLine(point,
-                point + math::vec3(0, 0.1f, 0), math::colors::magenta, 8.0f, FLT_MAX, true);*/
         }
 
-        std::vector<std::vector<math::vec3>> groupedPoints(voronoiPoints.size());
+        auto task = std::make_shared<fracture_task>(ownerEntity, fractureParams);
 
-        GetVoronoiPoints(groupedPoints,
-            voronoiPoints, min, max);
+        std::tie(task->min, task->max) = entityCollider->GetMinMaxWorldAABB();
 
         //-----------------------------------------------------------------------------------------------------------------------------//
-                                //Using the voronoi points, generate a set of colliders  //
+                                //Generate the Voronoi points, for now, the points are manually generated //
         //-----------------------------------------------------------------------------------------------------------------------------//
 
-        std::vector<std::shared_ptr<ConvexCollider>> voronoiColliders;
-
-        InstantiateVoronoiColliders(voronoiColliders, groupedPoints);
-
-        std::vector< FracturerColliderToMeshPairing> colliderToMeshPairings;
+        QuadrantVoronoi(task->min, task->max, task->voronoiPoints);
 
         //-----------------------------------------------------------------------------------------------------------------------------//
                                 //From the mesh about to be fractured, get the pairs of colliders to Mesh  //
         //-----------------------------------------------------------------------------------------------------------------------------//
 
+        std::vector< FracturerColliderToMeshPairing> colliderToMeshPairings;
+
         InstantiateColliderMeshPairingWithEntity(ownerEntity,
             colliderToMeshPairings);
 
@@ -92,209 +94,227 @@ namespace legion::physics
                 colliderToMeshPairings);
         }
 
-        std::vector<ecs::entity_handle> entitiesGenerated;
+        for (auto& meshToColliderPairing : colliderToMeshPairings)
+        {
+            auto sourceEntity = meshToColliderPairing.meshSplitterPairing.entity;
+            auto [posH, rotH, scaleH] = sourceEntity.get_component_handles<transform>();
 
-        //-----------------------------------------------------------------------------------------------------------------------------//
-                                //From the mesh about to be fractured, get the pairs of colliders to Mesh  //
-        //-----------------------------------------------------------------------------------------------------------------------------//
+            auto meshFilterH = sourceEntity.get_component_handle<mesh_filter>();
 
-        GenerateFractureFragments(entitiesGenerated, colliderToMeshPairings,
-            voronoiColliders, ownerEntity);
+            fracture_source source{ sourceEntity, meshToColliderPairing.meshSplitterPairing.read(),
+                math::compose(scaleH.read(), rotH.read(), posH.read()), rotH.read(), scaleH.read(),
+                meshFilterH ? meshFilterH.read().id : invalid_id };
 
+            task->sources.push_back(std::move(source));
+        }
 
-        auto originalRB = ownerEntity.get_component_handle<rigidbody>().read();
-        float fragmentMass = 1.0f / originalRB.inverseMass;
-        fragmentMass /= entitiesGenerated.size();
+        task->remainingCells = task->voronoiPoints.size();
+        fractureCount++;
 
-        int colliderIter = 0;
-        for (auto ent : entitiesGenerated)
+        //pre-fractured meshes only need their fragments instanced, there's nothing left to process
+        if (FracturePatternCache::instantiate(*task))
         {
-            auto [posH, rotH, scaleH] = ent.get_component_handles<transform>();
-            math::mat4 trans = math::compose(scaleH.read(), rotH.read(), posH.read());
-            //generate hull
-            auto physicsCompHandle = ent.add_component<physicsComponent>();
-            auto physicsComp = physicsCompHandle.read();
-            auto meshFilter = ent.read_component<mesh_filter>();
-            auto convexCollider = physicsComp.ConstructConvexHull(meshFilter);
-            physicsCompHandle.write(physicsComp);
-
-            //add rigidbody 
-            auto posHandle = ent.get_component_handle<position>();
-            auto rbH = ent.add_component<rigidbody>();
-            auto fragmentRB = rbH.read();
-            fragmentRB.globalCentreOfMass = posH.read();
-
-            //add force based on distance from explosion point
-            math::vec3 distanceFromCentroid = posH.read() - fractureParams.explosionCentroid ;
-            math::vec3 forceDir = math::normalize(distanceFromCentroid);
-            float forceAmount = (1.0f / (math::length(distanceFromCentroid))) * fractureParams.strength;
-
-            //crude estimation of explosion point
-            float smallestDot = std::numeric_limits<float>::max();
-            HalfEdgeFace* chosenFace = nullptr;
-
-            for (auto face : convexCollider->GetHalfEdgeFaces())
-            {
-                float currentDot = math::dot(forceDir, face->normal);
+            task->isDone.store(true, std::memory_order_release);
+        }
 
-                if (currentDot < smallestDot)
-                {
-                    smallestDot = currentDot;
-                    chosenFace = face;
-                }
-            }
+        return task;
+    }
+
+    void Fracturer::QueueFractureJobs(const std::shared_ptr<fracture_task>& task, scheduling::Scheduler& scheduler)
+    {
+        OPTICK_EVENT();
 
-            math::vec3 explosionPoint = trans * math::vec4(chosenFace->centroid, 1);
+        if (task->IsDone()) { return; }
 
-            fragmentRB.addForceAt(explosionPoint,forceDir * forceAmount);
-            rbH.write(fragmentRB);
-           
-            colliderIter++;
+        if (task->voronoiPoints.empty())
+        {
+            task->isDone.store(true, std::memory_order_release);
+            return;
         }
 
-        registry->destroyEntity(ownerEntity );
+        //the jobs keep the task alive, the physics system is free to forget about it in the meantime
+        auto prepareOperation = scheduler.queueJobs(1, [task]() { PrepareFractureCells(*task); });
 
+        scheduler.queueJobsAfter(prepareOperation, task->voronoiPoints.size(), [task]()
+            {
+                SplitFractureCell(*task, async::this_job::get_id());
 
-        fractureCount++;
+                if (task->remainingCells.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    task->isDone.store(true, std::memory_order_release);
+                }
+            });
     }
 
-
-    void Fracturer::GetVoronoiPoints(std::vector<std::vector<math::vec3>>& groupedPoints,
-        std::vector<math::vec3>& voronoiPoints,math::vec3 min,math::vec3 max)
+    void Fracturer::PrepareFractureCells(fracture_task& task)
     {
-        time::timer tick;
+        OPTICK_EVENT();
 
-        auto vectorList = PhysicsStatics::GenerateVoronoi(voronoiPoints, min.x, max.x, min.y, max.y, min.z, max.z, 1, 1, 1);
+        //-----------------------------------------------------------------------------------------------------------------------------//
+                                //Generate a Voronoi Diagram using the voronoi points  //
+        //-----------------------------------------------------------------------------------------------------------------------------//
 
-        vectorList.pop_back();
+        task.cellPoints.resize(task.voronoiPoints.size());
 
-        //groupedPoints.reserve( voronoiPoints.size() );
+        GetVoronoiPoints(task.cellPoints,
+            task.voronoiPoints, task.min, task.max);
 
-        for (std::vector<math::vec4>& vector : vectorList)
-        {
-            for (const math::vec4& position : vector)
-            {
-                int id = position.w;
+        task.cellFragments.resize(task.voronoiPoints.size());
+    }
 
-                //log::debug("position {} id {} ",math::to_string(math::vec3(position)), id);
-                groupedPoints.at(id).push_back(position);
+    void Fracturer::SplitFractureCell(fracture_task& task, size_type cell)
+    {
+        OPTICK_EVENT();
 
-            }
-        }
+        //-----------------------------------------------------------------------------------------------------------------------------//
+                                //Using the points of the voronoi cell, generate a collider  //
+        //-----------------------------------------------------------------------------------------------------------------------------//
 
-    }
+        auto voronoiCollider = std::make_shared<ConvexCollider>();
+        voronoiCollider->ConstructConvexHullWithVertices(task.cellPoints[cell]);
 
-    void Fracturer::InstantiateVoronoiColliders(std::vector<std::shared_ptr<ConvexCollider>>& voronoiColliders
-        ,std::vector<std::vector<math::vec3>>& groupedPoints)
-    {
-        time::timer tick;
-        int i = 1;
+        //a cell with too few points doesn't have a hull, without splitting planes it would duplicate the whole mesh
+        if (voronoiCollider->GetHalfEdgeFaces().empty()) { return; }
 
-        for (std::vector<math::vec3>& vector : groupedPoints)
+        std::vector<MeshSplitParams> splittingParams;
+        FracturerColliderToMeshPairing::GenerateSplittingParamsFromCollider(voronoiCollider, splittingParams);
+
+        //-----------------------------------------------------------------------------------------------------------------------------//
+                                //Split the meshes with the collider and build the fragments  //
+        //-----------------------------------------------------------------------------------------------------------------------------//
+
+        for (size_type sourceIndex = 0; sourceIndex < task.sources.size(); sourceIndex++)
         {
-            //// if (i != 1) { continue; }
-            //math::color debugColor =
-            //    math::color(math::linearRand(0.0f, 0.3f), math::linearRand(0.0f, 0.3f), math::linearRand(0.0f, 0.3f));
-            //// i * 2.0f, 0, 0
-            math::vec3 debugOffset = math::vec3();
-            //math::mat4 transform =
-            //    math::compose(math::vec3(1.0f), math::identity<math::quat>(), debugOffset);
-
-            for (math::vec3 vertex : vector)
-            {
-                //
-                math::vec3 vertPos = vertex + debugOffset;
-                //debug::user_projectDrawLine(vertPos, vertPos + math::vec3(0,0.5,0), debugColor,10.0f,FLT_MAX);
-            }
+            fracture_source& source = task.sources[sourceIndex];
 
-            auto newCollider = std::make_shared<ConvexCollider>();
+            if (!source.splitter.splitMesh) { continue; }
 
-            debugVectorcolliders.push_back(newCollider);
-            voronoiColliders.push_back(newCollider);
+            //every job thread keeps its own splitter, so the scratch buffers are reused by every cell the thread splits
+            thread_local IndexedMeshSplitter splitter;
 
-            verticesList.push_back(vector);
+            std::vector<split_mesh_data> islands;
+            splitter.Split(*source.splitter.splitMesh, splittingParams, source.transform, islands);
+
+            for (auto& island : islands)
+            {
+                fracture_fragment fragment;
+                fragment.sourceIndex = sourceIndex;
 
-            newCollider->ConstructConvexHullWithVertices(vector);
+                math::vec3 offset;
+                IndexedMeshSplitter::BuildMesh(island, source.transform, source.scale, fragment.fragmentMesh, offset);
 
+                fragment.localOffset = math::inverse(source.rotation) * offset;
 
-            //transforms.push_back(transform);
-            //newCollider->DrawColliderRepresentation(transform,math::colors::green,6.0f,FLT_MAX);
-            i++;
+                fragment.collider = std::make_shared<ConvexCollider>();
+                fragment.collider->ConstructConvexHullWithMesh(fragment.fragmentMesh);
+
+                task.cellFragments[cell].push_back(std::move(fragment));
+            }
         }
     }
 
-    void Fracturer::GenerateFractureFragments(std::vector<ecs::entity_handle>& entitiesGenerated
-        , std::vector< FracturerColliderToMeshPairing>& colliderToMeshPairings
-        ,std::vector< std::shared_ptr<ConvexCollider>>& voronoiColliders
-        ,ecs::entity_handle fracturedEnt)
+    void Fracturer::CommitFracture(fracture_task& task)
     {
-        
-        fast_time totalMeshSplitting = 0;
+        OPTICK_EVENT();
 
-        fast_time totalCollisionDetection = 0;
+        //the fractured entity might have been destroyed while its fracture was being processed
+        if (!task.ownerEntity.valid()) { return; }
 
-        int fractureID = 0;
-        //for each instantiated convex collider
-        for (std::shared_ptr<ConvexCollider> instantiatedVoronoiCollider : voronoiColliders)
+        auto ownerRigidbodyH = task.ownerEntity.get_component_handle<rigidbody>();
+
+        // The fragments get their physics components in one batch instead of locking the component families for every fragment.
+        ecs::command_buffer commands(registry);
+
+        for (auto& cellFragments : task.cellFragments)
         {
-            for (auto& meshToColliderPairing : colliderToMeshPairings)
+            for (auto& fragment : cellFragments)
             {
-                //check if it collides with one of the colliders in the original physics component
-                physics_manifold manifold;
-                ConvexConvexCollisionInfo collisionInfo;
+                fracture_source& source = task.sources[fragment.sourceIndex];
+
+                //the fractured entity kept moving while its fracture was being processed
+                auto [sourcePosH, sourceRotH, sourceScaleH] = source.entity.get_component_handles<transform>();
+                math::quat fragmentRotation = sourceRotH.read();
+                math::vec3 fragmentPosition = sourcePosH.read() + fragmentRotation * fragment.localOffset;
+
+                auto ent = fragment.meshHandle.id != invalid_id ?
+                    PrimitiveMesh::InstantiateMesh(fragment.meshHandle, source.splitter.ownerMaterialH, fragmentPosition, fragmentRotation) :
+                    PrimitiveMesh::InstantiateMesh(fragment.fragmentMesh, source.splitter.ownerMaterialH, fragmentPosition, fragmentRotation);
 
+                math::mat4 trans = math::compose(math::vec3(1.0f), fragmentRotation, fragmentPosition);
 
-                auto ownerEntity = meshToColliderPairing.meshSplitterPairing.
-                    entity;
-                auto [posH, rotH, scaleH] = ownerEntity.get_component_handles<transform>();
+                physicsComponent physicsComp;
+                physicsComp.colliders.push_back(fragment.collider);
+                physicsComp.calculateNewLocalCenterOfMass();
 
-                auto transformB = math::compose(scaleH.read(), rotH.read(), posH.read());
+                //add rigidbody, it keeps moving the way the part of the fractured entity it came from was moving
+                rigidbody fragmentRB;
+                fragmentRB.globalCentreOfMass = fragmentPosition;
 
-                time::timer convexConvexCollision;
- /*               PhysicsStatics::DetectConvexConvexCollision(instantiatedVoronoiCollider.get()
-                    , meshToColliderPairing.colliderPair.get(), math::mat4(1.0f), transformB, collisionInfo, manifold);*/
-                manifold.isColliding = true;
-                totalCollisionDetection += convexConvexCollision.elapsedTime().milliseconds();
+                if (ownerRigidbodyH)
+                {
+                    auto ownerRB = ownerRigidbodyH.read();
+                    fragmentRB.velocity = ownerRB.velocity + math::cross(ownerRB.angularVelocity, fragmentPosition - ownerRB.globalCentreOfMass);
+                    fragmentRB.angularVelocity = ownerRB.angularVelocity;
+                }
+
+                //add force based on distance from explosion point
+                math::vec3 distanceFromCentroid = fragmentPosition - task.params.explosionCentroid;
+                math::vec3 forceDir = math::normalize(distanceFromCentroid);
+                float forceAmount = (1.0f / (math::length(distanceFromCentroid))) * task.params.strength;
+
+                //crude estimation of explosion point
+                float smallestDot = std::numeric_limits<float>::max();
+                HalfEdgeFace* chosenFace = nullptr;
 
-                if (manifold.isColliding)
+                for (auto face : fragment.collider->GetHalfEdgeFaces())
                 {
-                    if (fractureID < 999) //2
+                    float currentDot = math::dot(forceDir, face->normal);
+
+                    if (currentDot < smallestDot)
                     {
-                        //log::debug("-> Collision Found");
+                        smallestDot = currentDot;
+                        chosenFace = face;
+                    }
+                }
 
-                        std::vector<MeshSplitParams> splittingParams;
-                        meshToColliderPairing.GenerateSplittingParamsFromCollider(instantiatedVoronoiCollider, splittingParams);
-                        //log::debug("splittingParams {} ", splittingParams.size());
+                if (chosenFace)
+                {
+                    math::vec3 explosionPoint = trans * math::vec4(chosenFace->centroid, 1);
+                    fragmentRB.addForceAt(explosionPoint, forceDir * forceAmount);
+                }
 
-                        for (size_t i = 0; i < splittingParams.size(); i++)
-                        {
-                            float interpolant = (float)i / splittingParams.size();
+                commands.add_component(ent, std::move(physicsComp));
+                commands.add_component(ent, std::move(fragmentRB));
+            }
+        }
 
-                            math::vec3 color = math::color(1, 0, 0) * interpolant;
+        commands.destroy_entity(task.ownerEntity);
+        commands.playback();
+    }
 
-                            /*debug::user_projectDrawLine(splittingParams.at(i).planePostion
-                                , splittingParams.at(i).planePostion + splittingParams.at(i).planeNormal,
-                                math::color(color.x, color.y, color.z, 1), 15.0f, FLT_MAX, true);*/
-                        }
+    void Fracturer::GetVoronoiPoints(std::vector<std::vector<math::vec3>>& groupedPoints,
+        std::vector<math::vec3>& voronoiPoints,math::vec3 min,math::vec3 max)
+    {
+        time::timer tick;
 
-                        auto splitter = meshToColliderPairing.meshSplitterPairing.read();
-                        time::timer meshSplitting;
-                        splitter.MultipleSplitMesh(splittingParams, entitiesGenerated, true, -1);
-                        totalMeshSplitting += meshSplitting.elapsedTime().milliseconds();
+        auto vectorList = PhysicsStatics::GenerateVoronoi(voronoiPoints, min.x, max.x, min.y, max.y, min.z, max.z, 1, 1, 1);
 
-                        meshToColliderPairing.meshSplitterPairing.write(splitter);
+        vectorList.pop_back();
 
-                    }
+        //groupedPoints.reserve( voronoiPoints.size() );
 
-                }
-                fractureID++;
+        for (std::vector<math::vec4>& vector : vectorList)
+        {
+            for (const math::vec4& position : vector)
+            {
+                int id = position.w;
+
+                //log::debug("position {} id {} ",math::to_string(math::vec3(position)), id);
+                groupedPoints.at(id).push_back(position);
 
             }
         }
 
-        registry->destroyEntity(fracturedEnt);
-
-       
     }
 
     void Fracturer::QuadrantVoronoi(math::vec3& min,math::vec3& max, std::vector<math::vec3>& voronoiPoints)
@@ -343,6 +363,26 @@ namespace legion::physics
         voronoiPoints.push_back(first);
     }
 
+    void Fracturer::ImpactVoronoi(const math::vec3& min, const math::vec3& max, const math::vec3& impactPoint,
+        size_type pointCount, uint seed, std::vector<math::vec3>& voronoiPoints)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+
+        math::vec3 difference = max - min;
+
+        for (size_type i = 0; i < pointCount; i++)
+        {
+            math::vec3 randomPoint = min + difference * math::vec3(distribution(generator), distribution(generator), distribution(generator));
+
+            //squaring pulls most of the points towards the impact, they never end up exactly on it so they stay inside of the bounds
+            float interpolant = distribution(generator);
+            interpolant = 0.1f + 0.9f * interpolant * interpolant;
+
+            voronoiPoints.push_back(math::mix(impactPoint, randomPoint, interpolant));
+        }
+    }
+
     bool Fracturer::IsFractureConditionMet(physics_manifold& manifold, bool isfracturingA)
     {
         //TODO the user should be able to create their own fracture condition, but for now
@@ -422,7 +462,7 @@ namespace legion::physics
         return impactPoint;
     }
 
-    void FracturerColliderToMeshPairing::GenerateSplittingParamsFromCollider(std::shared_ptr<ConvexCollider> instantiatedCollider, std::vector<physics::MeshSplitParams>& meshSplitParams)
+    void FracturerColliderToMeshPairing::GenerateSplittingParamsFromCollider(const std::shared_ptr<ConvexCollider>& instantiatedCollider, std::vector<physics::MeshSplitParams>& meshSplitParams)
     {
         int until = 5;//convex bug at 3
         int count = 0;
@@ -3,10 +3,72 @@
 #include <physics/components/physics_component.hpp>
 #include <physics/mesh_splitter_utils/mesh_splitter.hpp>
 #include <physics/data/fractureparams.hpp>
+#include <atomic>
 namespace legion::physics
 {
     struct physics_manifold;
 
+    /** @struct fracture_source
+    * @brief Snapshot of an entity whose mesh gets split by a fracture.
+    * Taken when the fracture is requested, so the fracture jobs never have to read any components.
+    * The jobs only read the flat mesh of the splitter, which is immutable and shared with the component.
+    */
+    struct fracture_source
+    {
+        ecs::entity_handle entity;
+        MeshSplitter splitter;
+        math::mat4 transform;
+        math::quat rotation;
+        math::vec3 scale;
+        id_type meshId = invalid_id;
+    };
+
+    /** @struct fracture_fragment
+    * @brief A piece of a fractured mesh, built by a fracture job. It only becomes an entity once the fracture is committed.
+    */
+    struct fracture_fragment
+    {
+        size_type sourceIndex;
+        mesh fragmentMesh;
+        //fragments of a pre-fractured pattern already have their mesh in the mesh cache, their entities share it
+        mesh_handle meshHandle = invalid_mesh_handle;
+        std::shared_ptr<ConvexCollider> collider;
+        //offset from the source entity to the fragment, in the space of the rotation of the source entity
+        math::vec3 localOffset;
+    };
+
+    /** @struct fracture_task
+    * @brief A fracture that is being processed by the job system.
+    * The fractured entity keeps being simulated until the task is done and the fragments get committed.
+    */
+    struct fracture_task
+    {
+        fracture_task(ecs::entity_handle pOwnerEntity, const FractureParams& pParams) :
+            ownerEntity(pOwnerEntity), params(pParams)
+        {
+        }
+
+        ecs::entity_handle ownerEntity;
+        FractureParams params;
+
+        math::vec3 min;
+        math::vec3 max;
+        std::vector<math::vec3> voronoiPoints;
+        std::vector<fracture_source> sources;
+
+        //one entry per voronoi cell, every cell is only touched by the job that splits it
+        std::vector<std::vector<math::vec3>> cellPoints;
+        std::vector<std::vector<fracture_fragment>> cellFragments;
+
+        std::atomic<size_type> remainingCells{ 0 };
+        std::atomic_bool isDone{ false };
+
+        bool IsDone() const noexcept
+        {
+            return isDone.load(std::memory_order_acquire);
+        }
+    };
+
     struct FracturerColliderToMeshPairing
     {
         FracturerColliderToMeshPairing(
@@ -20,7 +82,7 @@ namespace legion::physics
         std::shared_ptr<ConvexCollider> colliderPair;
         ecs::component_handle<MeshSplitter> meshSplitterPairing;
 
-        void GenerateSplittingParamsFromCollider(std::shared_ptr<ConvexCollider> instantiatedCollider
+        static void GenerateSplittingParamsFromCollider(const std::shared_ptr<ConvexCollider>& instantiatedCollider
             , std::vector<physics::MeshSplitParams>& meshSplitParams);
         
 
@@ -30,11 +92,41 @@ namespace legion::physics
 	{
 
 
-		void HandleFracture(physics_manifold& manifold,bool& manifoldValid, bool isfracturingA);
+        /** @brief Checks if the manifold should fracture one of its entities, and requests the fracture if it should.
+        * @return The requested fracture, nullptr if nothing gets fractured
+        */
+		std::shared_ptr<fracture_task> HandleFracture(physics_manifold& manifold,bool& manifoldValid, bool isfracturingA);
 
+        /** @brief Fractures the entity immediately, the mesh splitting happens on the calling thread.
+        */
         void ExplodeEntity(ecs::entity_handle ownerEntity,
             const FractureParams& fractureParams, PhysicsCollider* entityCollider = nullptr);;
 
+        /** @brief Takes a snapshot of everything needed to fracture the entity, the actual fracture is done by QueueFractureJobs.
+        * If the meshes of the entity have pre-fractured patterns the task is done immediately.
+        * @return The requested fracture, nullptr if the entity is already being fractured
+        */
+        std::shared_ptr<fracture_task> RequestFracture(ecs::entity_handle ownerEntity,
+            const FractureParams& fractureParams, PhysicsCollider* entityCollider = nullptr);
+
+        /** @brief Queues a job that generates the voronoi diagram, followed by a job per voronoi cell that splits the mesh
+        * and builds the convex colliders of the fragments. The task is done once all the cells are split.
+        */
+        static void QueueFractureJobs(const std::shared_ptr<fracture_task>& task, scheduling::Scheduler& scheduler);
+
+        /** @brief Generates the voronoi cells of the task.
+        */
+        static void PrepareFractureCells(fracture_task& task);
+
+        /** @brief Splits the meshes of the task with one voronoi cell, only touches the data of that cell.
+        */
+        static void SplitFractureCell(fracture_task& task, size_type cell);
+
+        /** @brief Replaces the fractured entity by the fragments of a finished task, needs to be called from the physics thread.
+        * The fragments are placed relative to where the fractured entity is now and inherit its velocity.
+        */
+        static void CommitFracture(fracture_task& task);
+
         bool IsFractureConditionMet(physics_manifold& manifold, bool isfracturingA);
 
         void InitializeVoronoi(ecs::component_handle<physicsComponent> physicsComponent);
@@ -45,27 +137,24 @@ namespace legion::physics
         void InstantiateColliderMeshPairingWithEntity(ecs::entity_handle ent,
             std::vector< FracturerColliderToMeshPairing>& colliderToMeshPairings);
 
-        void GetVoronoiPoints(std::vector<std::vector<math::vec3>>& groupedPoints,
+        static void GetVoronoiPoints(std::vector<std::vector<math::vec3>>& groupedPoints,
             std::vector<math::vec3>& voronoiPoints, math::vec3 min, math::vec3 max);
 
-        void InstantiateVoronoiColliders(std::vector<std::shared_ptr<ConvexCollider>>& voronoiColliders
-            , std::vector<std::vector<math::vec3>>& groupedPoints);
-
-        void GenerateFractureFragments(std::vector<ecs::entity_handle>& entitiesGenerated
-            , std::vector< FracturerColliderToMeshPairing>& colliderToMeshPairings
-            , std::vector< std::shared_ptr<ConvexCollider>>& voronoiColliders
-            , ecs::entity_handle fracturedEnt);
 
         void QuadrantVoronoi(math::vec3& min, math::vec3& max, std::vector<math::vec3>& voronoiPoints);
 
         void BalancedVoronoi(math::vec3& min, math::vec3& max, std::vector<math::vec3>& voronoiPoints);
 
+        /** @brief Generates voronoi points that get denser close to the impact point, so the fragments there are smaller.
+        * @param seed The same seed always results in the same points
+        */
+        static void ImpactVoronoi(const math::vec3& min, const math::vec3& max, const math::vec3& impactPoint,
+            size_type pointCount, uint seed, std::vector<math::vec3>& voronoiPoints);
+
         math::vec3 GetImpactPointFromManifold(physics_manifold& manifold);
 
         int fractureCount = 0;
 
-        std::vector<std::vector<math::vec3>> verticesList;
-        std::vector<std::shared_ptr<ConvexCollider>> debugVectorcolliders;
         std::vector<math::mat4> transforms;
         static ecs::EcsRegistry* registry;
 	};
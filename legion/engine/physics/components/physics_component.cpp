@@ -1,6 +1,8 @@
 
 #include <physics/components/physics_component.hpp>
 #include <physics/colliders/convexcollider.hpp>
+#include <physics/colliders/spherecollider.hpp>
+#include <physics/colliders/capsulecollider.hpp>
 
 namespace legion::physics
 {
@@ -53,8 +55,17 @@ namespace legion::physics
         calculateNewLocalCenterOfMass();
     }
 
-    void physicsComponent::AddSphere()
+    void physicsComponent::AddSphere(float radius, const math::vec3& offset)
     {
+        colliders.push_back(std::make_shared<SphereCollider>(radius, offset));
+
+        calculateNewLocalCenterOfMass();
+    }
+
+    void physicsComponent::AddCapsule(float radius, float height, const math::vec3& offset)
+    {
+        colliders.push_back(std::make_shared<CapsuleCollider>(radius, height, offset));
+
         calculateNewLocalCenterOfMass();
     }
 }
@@ -41,10 +41,18 @@ namespace legion::physics
         */
 		void AddBox(const cube_collider_params& cubeParams);
 
-        /** @brief Instantiates a SphereCollider and creates a sphere that encompasses the given mesh. This
-         * ConvexCollider is then added to the list of PhysicsColliders
+        /** @brief Instantiates a SphereCollider with the given radius. This
+         * SphereCollider is then added to the list of PhysicsColliders
+         * @param offset The position of the center of the sphere relative to the entity
+        */
+		void AddSphere(float radius = 0.5f, const math::vec3& offset = math::vec3());
+
+        /** @brief Instantiates a CapsuleCollider along the local y axis. This
+         * CapsuleCollider is then added to the list of PhysicsColliders
+         * @param height The height of the capsule including both caps
+         * @param offset The position of the center of the capsule relative to the entity
         */
-		void AddSphere(/*mesh*/);
+		void AddCapsule(float radius = 0.5f, float height = 2.0f, const math::vec3& offset = math::vec3());
 
 	};
 }
@@ -31,7 +31,11 @@ namespace legion::physics
         float restitution = 0.3f;
         float friction = 0.3f;
 
-        bool isAsleep;
+        //sleeping component
+        bool isAsleep = false;
+        float sleepTimer = 0.0f;
+        math::vec3 sleepPosition = math::vec3(0.0);
+        math::quat sleepRotation = math::quat(1, 0, 0, 0);
 
         template<typename Archive>
         void serialize(Archive& archive)
@@ -62,6 +66,7 @@ namespace legion::physics
         void addForce(math::vec3 force)
         {
             forceAccumulator += force;
+            wakeUp();
         }
 
         /** @brief Adds a force in the direction of 'force' and
@@ -71,6 +76,35 @@ namespace legion::physics
             forceAccumulator += force;
             math::vec3 axis = worldForcePosition - globalCentreOfMass;
             torqueAccumulator += math::cross(axis, force);
+            wakeUp();
+        }
+
+        /** @brief Makes the rigidbody take part in the simulation again and restarts the time it needs to be at rest before it can fall asleep.
+        */
+        void wakeUp()
+        {
+            isAsleep = false;
+            sleepTimer = 0.0f;
+        }
+
+        /** @brief Stops simulating the rigidbody until it gets woken up by a force, a contact with an awake rigidbody or by moving its entity.
+        * @param currentPosition The position of the entity, the rigidbody wakes up when the entity gets moved away from it.
+        * @param currentRotation The rotation of the entity, the rigidbody wakes up when the entity gets rotated away from it.
+        */
+        void sleep(math::vec3 currentPosition, math::quat currentRotation)
+        {
+            isAsleep = true;
+            velocity = math::vec3(0.0);
+            angularVelocity = math::vec3(0.0);
+            sleepPosition = currentPosition;
+            sleepRotation = currentRotation;
+        }
+
+        /** @brief Whether the rigidbody has been slow enough for long enough to fall asleep.
+        */
+        bool isSleepy() const
+        {
+            return sleepTimer >= constants::timeToSleep;
         }
 
         void setMass(float mass)
@@ -0,0 +1,31 @@
+#include <physics/data/analyticpenetrationquery.hpp>
+#include <physics/data/physics_manifold.hpp>
+#include <physics/physics_contact.hpp>
+
+namespace legion::physics
+{
+    AnalyticPenetrationQuery::AnalyticPenetrationQuery(const analytic_collision& pCollision, bool pIsARef) :
+        PenetrationQuery(pCollision.contacts[0].refPoint, pCollision.normal, pCollision.seperation, pIsARef), collision(pCollision)
+    {
+        debugID = "AnalyticPenetrationQuery";
+    }
+
+    void AnalyticPenetrationQuery::populateContactList(physics_manifold& manifold, math::mat4& /*refTransform*/,
+        math::mat4 /*incTransform*/, PhysicsCollider* refCollider)
+    {
+        OPTICK_EVENT();
+
+        for (size_type i = 0; i < collision.contactCount; i++)
+        {
+            const auto& analyticContact = collision.contacts[i];
+
+            physics_contact contact;
+            contact.refCollider = refCollider;
+            contact.RefWorldContact = analyticContact.refPoint;
+            contact.IncWorldContact = analyticContact.incPoint;
+            contact.label = analyticContact.label;
+
+            manifold.contacts.push_back(contact);
+        }
+    }
+}
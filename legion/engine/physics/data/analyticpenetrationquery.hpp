@@ -0,0 +1,68 @@
+#pragma once
+#include <core/core.hpp>
+#include <physics/data/penetrationquery.hpp>
+#include <physics/data/edge_label.hpp>
+#include <array>
+
+namespace legion::physics
+{
+    /**@struct analytic_contact
+     * @brief A contact point that was calculated in closed form by ShapeCollision.
+     */
+    struct analytic_contact
+    {
+        //world position of the contact on the surface of the reference shape
+        math::vec3 refPoint;
+        //world position of the deepest point of the incident shape
+        math::vec3 incPoint;
+        //contacts with the same label are warm started with each other in the next step
+        EdgeLabel label;
+    };
+
+    /**@struct analytic_collision
+     * @brief The result of a closed form collision test between two shapes.
+     */
+    struct analytic_collision
+    {
+        static constexpr size_type maxContacts = 2;
+
+        //points from the reference shape towards the incident shape
+        math::vec3 normal = math::vec3(0, 1, 0);
+        //distance between the surfaces along the normal, negative when the shapes overlap
+        float seperation = 0.0f;
+
+        std::array<analytic_contact, maxContacts> contacts;
+        size_type contactCount = 0;
+
+        /**@brief Adds a contact if there is room for it.
+         * @param refFeature Index of the feature of the reference shape that created the contact, like a face or the end of a capsule
+         * @param incFeature Index of the feature of the incident shape that created the contact
+         */
+        void addContact(const math::vec3& refPoint, const math::vec3& incPoint, int refFeature, int incFeature)
+        {
+            if (contactCount >= maxContacts)
+                return;
+
+            auto& contact = contacts[contactCount];
+            contact.refPoint = refPoint;
+            contact.incPoint = incPoint;
+            contact.label = EdgeLabel(std::make_pair(refFeature, static_cast<int>(contactCount)), std::make_pair(incFeature, 0));
+            contactCount++;
+        }
+    };
+
+    /**@class AnalyticPenetrationQuery
+     * @brief Stores the contacts that were already found by a closed form collision test,
+     * so no clipping is needed to populate the contact list.
+     */
+    class AnalyticPenetrationQuery : public PenetrationQuery
+    {
+    public:
+        analytic_collision collision;
+
+        AnalyticPenetrationQuery(const analytic_collision& pCollision, bool pIsARef);
+
+        virtual void populateContactList(physics_manifold& manifold, math::mat4& refTransform,
+            math::mat4 incTransform, PhysicsCollider* refCollider) override;
+    };
+}
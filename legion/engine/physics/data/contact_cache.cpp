@@ -0,0 +1,77 @@
+#include <physics/data/contact_cache.hpp>
+#include <physics/data/physics_manifold.hpp>
+
+namespace legion::physics
+{
+    void ContactCache::storeSeperatingAxis(const key_type& key, const seperating_axis& axis)
+    {
+        cached_collider_pair& pair = m_pairs[key];
+        pair.seperatingAxis = axis;
+        pair.lastUsed = m_step;
+
+        //a seperated pair doesn't have any contacts to warm start
+        pair.contacts.clear();
+    }
+
+    void ContactCache::keep(const key_type& key)
+    {
+        auto iter = m_pairs.find(key);
+        if (iter != m_pairs.end())
+            iter->second.lastUsed = m_step;
+    }
+
+    void ContactCache::storeContacts(const physics_manifold& manifold)
+    {
+        cached_collider_pair& pair = m_pairs[makeKey(manifold.colliderA->GetColliderID(), manifold.colliderB->GetColliderID())];
+        pair.lastUsed = m_step;
+
+        //the pair is colliding, so there is no seperating axis anymore
+        pair.seperatingAxis = seperating_axis();
+
+        pair.contacts.clear();
+        for (auto& contact : manifold.contacts)
+        {
+            pair.contacts.push_back(cached_contact{ contact.refCollider->GetColliderID(), contact.label,
+                contact.totalLambda, contact.tangent1Lambda, contact.tangent2Lambda });
+        }
+    }
+
+    void ContactCache::warmStart(physics_manifold& manifold) const
+    {
+        if (!constants::applyWarmStarting) { return; }
+
+        const cached_collider_pair* pair = find(manifold.colliderA->GetColliderID(), manifold.colliderB->GetColliderID());
+        if (!pair) { return; }
+
+        for (auto& contact : manifold.contacts)
+        {
+            int refColliderID = contact.refCollider->GetColliderID();
+
+            for (auto& cachedContact : pair->contacts)
+            {
+                if (cachedContact.refColliderID == refColliderID && cachedContact.label == contact.label)
+                {
+                    contact.totalLambda = cachedContact.totalLambda;
+                    contact.tangent1Lambda = cachedContact.tangent1Lambda;
+                    contact.tangent2Lambda = cachedContact.tangent2Lambda;
+                    break;
+                }
+            }
+        }
+    }
+
+    void ContactCache::nextStep()
+    {
+        OPTICK_EVENT();
+
+        for (auto iter = m_pairs.begin(); iter != m_pairs.end();)
+        {
+            if (iter->second.lastUsed != m_step)
+                iter = m_pairs.erase(iter);
+            else
+                ++iter;
+        }
+
+        m_step++;
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <core/core.hpp>
+#include <physics/data/edge_label.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace legion::physics
+{
+    struct physics_manifold;
+    class HalfEdgeFace;
+
+    /** @struct seperating_axis
+    * @brief A face of one of the colliders of a pair that seperated the pair. Coherent pairs are usually still seperated by the same face
+    * in the next step, so it is tested first before doing the full seperating axis test.
+    */
+    struct seperating_axis
+    {
+        //collider that owns the face, -1 if no seperating face was found
+        int colliderID = -1;
+        HalfEdgeFace* face = nullptr;
+
+        bool isValid() const
+        {
+            return face != nullptr;
+        }
+    };
+
+    /** @struct cached_contact
+    * @brief The accumulated impulses of a contact identified by its reference collider and the features that created it.
+    */
+    struct cached_contact
+    {
+        int refColliderID;
+        EdgeLabel label;
+
+        float totalLambda;
+        float tangent1Lambda;
+        float tangent2Lambda;
+    };
+
+    /** @struct cached_collider_pair
+    * @brief Everything the contact cache remembers about a pair of colliders between steps.
+    */
+    struct cached_collider_pair
+    {
+        seperating_axis seperatingAxis;
+        std::vector<cached_contact> contacts;
+        size_type lastUsed = 0;
+    };
+
+    /** @class ContactCache
+    * @brief Persistent storage of the contacts and seperating axes of all collider pairs that were checked in the narrowphase.
+    * Pairs are keyed by the ids of their colliders, contacts within a pair by their reference collider and feature label.
+    * Pairs that don't get stored or kept for a whole step are dropped.
+    * @note Looking up is safe from multiple threads as long as nothing gets stored at the same time.
+    */
+    class ContactCache
+    {
+    public:
+        using key_type = std::pair<int, int>;
+
+        static key_type makeKey(int colliderIDA, int colliderIDB)
+        {
+            return colliderIDA < colliderIDB ? key_type(colliderIDA, colliderIDB) : key_type(colliderIDB, colliderIDA);
+        }
+
+        /** @brief Returns the cached data of the pair of colliders, nullptr if the pair wasn't checked last step.
+        */
+        const cached_collider_pair* find(int colliderIDA, int colliderIDB) const
+        {
+            auto iter = m_pairs.find(makeKey(colliderIDA, colliderIDB));
+            return iter == m_pairs.end() ? nullptr : &iter->second;
+        }
+
+        /** @brief Remembers the face that seperated a pair of colliders this step, or that the pair was checked without finding a seperating face.
+        */
+        void storeSeperatingAxis(const key_type& key, const seperating_axis& axis);
+
+        /** @brief Keeps the cached data of a pair of colliders that wasn't checked this step, because both of them are asleep or static.
+        */
+        void keep(const key_type& key);
+
+        /** @brief Remembers the accumulated impulses of all contacts in a solved manifold.
+        */
+        void storeContacts(const physics_manifold& manifold);
+
+        /** @brief Copies the impulses that were accumulated last step into the contacts of the manifold that were created by the same features.
+        */
+        void warmStart(physics_manifold& manifold) const;
+
+        /** @brief Drops all pairs that weren't stored since the last call and starts a new step.
+        */
+        void nextStep();
+
+        size_type size() const
+        {
+            return m_pairs.size();
+        }
+
+        void clear()
+        {
+            m_pairs.clear();
+        }
+
+    private:
+        struct key_hash
+        {
+            size_t operator()(const key_type& key) const
+            {
+                return std::hash<uint64>{}((static_cast<uint64>(static_cast<uint32>(key.first)) << 32) | static_cast<uint32>(key.second));
+            }
+        };
+
+        std::unordered_map<key_type, cached_collider_pair, key_hash> m_pairs;
+        size_type m_step = 1;
+    };
+}
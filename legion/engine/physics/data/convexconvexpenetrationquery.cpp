@@ -83,7 +83,6 @@ namespace legion::physics
                 contact.RefWorldContact = referenceContact;
                 contact.label = incidentContact.label;
 
-                refCollider->AttemptFindAndCopyConverganceID(contact);
 
                 manifold.contacts.push_back(contact);
              
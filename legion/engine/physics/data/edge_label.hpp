@@ -28,13 +28,10 @@ namespace legion::physics
 
         }
 
-        EdgeLabel(const EdgeLabel& rhs)
-        {
-            firstEdge = rhs.firstEdge;
-            nextEdge = rhs.nextEdge;
-        }
+        EdgeLabel(const EdgeLabel& rhs) = default;
+        EdgeLabel& operator=(const EdgeLabel& rhs) = default;
 
-        bool operator==(const EdgeLabel& rhs)
+        bool operator==(const EdgeLabel& rhs) const
         {
             return firstEdge == rhs.firstEdge && nextEdge == rhs.nextEdge;
         }
@@ -48,7 +48,6 @@ namespace legion::physics
         contact.IncWorldContact = incContactPoint;
         contact.RefWorldContact = refContactPoint;
 
-        refCollider->AttemptFindAndCopyConverganceID(contact);
 
         manifold.contacts.push_back(contact);
 
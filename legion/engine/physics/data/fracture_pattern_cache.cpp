@@ -0,0 +1,357 @@
+#include <physics/data/fracture_pattern_cache.hpp>
+
+namespace legion::physics
+{
+    std::unordered_map<id_type, FracturePatternCache::pattern_set> FracturePatternCache::m_patternSets;
+    async::rw_spinlock FracturePatternCache::m_patternSetsLock;
+    std::atomic<size_type> FracturePatternCache::m_generation{ 0 };
+
+    namespace
+    {
+        const std::string_view patternMagic = "\xabLEGION FRACTURE\xbb\r\n\x13\n";
+
+        template<typename T>
+        bool readBinaryData(T& value, byte_vec::const_iterator& start, byte_vec::const_iterator end)
+        {
+            if (static_cast<size_type>(end - start) < sizeof(T))
+                return false;
+
+            retrieveBinaryData(value, start);
+            return true;
+        }
+
+        template<typename T>
+        bool readBinaryData(std::vector<T>& value, byte_vec::const_iterator& start, byte_vec::const_iterator end)
+        {
+            //arrays are stored as their size in bytes followed by the elements
+            uint64 byteCount;
+            byte_vec::const_iterator elements = start;
+            if (!readBinaryData(byteCount, elements, end))
+                return false;
+
+            if (byteCount % sizeof(T) != 0 || byteCount > static_cast<uint64>(end - elements))
+                return false;
+
+            retrieveBinaryData(value, start);
+            return true;
+        }
+    }
+
+    bool FracturePatternCache::generate(ecs::entity_handle entity, size_type patternCount, size_type cellCount)
+    {
+        OPTICK_EVENT();
+
+        auto physicsCompHandle = entity.get_component_handle<physicsComponent>();
+        auto meshSplitterHandle = entity.get_component_handle<MeshSplitter>();
+        auto meshFilterHandle = entity.get_component_handle<mesh_filter>();
+        auto scaleHandle = entity.get_component_handle<scale>();
+
+        if (!physicsCompHandle || !meshSplitterHandle || !meshFilterHandle || !scaleHandle)
+        {
+            log::warn("Fracture patterns can only be generated for entities with a MeshSplitter, physicsComponent and mesh_filter");
+            return false;
+        }
+
+        auto colliders = physicsCompHandle.read().colliders;
+        if (colliders.empty()) { return false; }
+
+        id_type meshId = meshFilterHandle.read().id;
+        math::vec3 entityScale = scaleHandle.read();
+
+        //the patterns are generated in the space of the entity, without its rotation and position
+        auto [localMin, localMax] = colliders.at(0)->GetMinMaxLocalAABB();
+        math::vec3 min = math::min(localMin * entityScale, localMax * entityScale);
+        math::vec3 max = math::max(localMin * entityScale, localMax * entityScale);
+
+        math::vec3 center = (min + max) * 0.5f;
+        math::vec3 halfExtents = (max - min) * 0.5f;
+
+        fracture_source source{ entity, meshSplitterHandle.read(),
+            math::compose(entityScale, math::identity<math::quat>(), math::vec3(0.0f)), math::identity<math::quat>(), entityScale, meshId };
+
+        pattern_set patternSet;
+        patternSet.scale = entityScale;
+
+        size_type generation = m_generation.fetch_add(1, std::memory_order_relaxed);
+
+        for (size_type patternIndex = 0; patternIndex < patternCount; patternIndex++)
+        {
+            //spread the impact points over the bounds with a fibonacci sphere
+            float height = 1.0f - 2.0f * (patternIndex + 0.5f) / patternCount;
+            float radius = math::sqrt(1.0f - height * height);
+            float angle = patternIndex * 2.39996323f;
+            math::vec3 direction(math::cos(angle) * radius, height, math::sin(angle) * radius);
+
+            float distance = std::numeric_limits<float>::max();
+            for (int axis = 0; axis < 3; axis++)
+            {
+                if (math::abs(direction[axis]) > math::epsilon<float>())
+                    distance = math::min(distance, halfExtents[axis] / math::abs(direction[axis]));
+            }
+
+            math::vec3 impactPoint = center + direction * distance;
+
+            fracture_task task(entity, FractureParams(impactPoint));
+            task.min = min;
+            task.max = max;
+            task.sources.push_back(source);
+
+            Fracturer::ImpactVoronoi(min, max, impactPoint, cellCount, static_cast<uint>(patternIndex), task.voronoiPoints);
+            Fracturer::PrepareFractureCells(task);
+
+            for (size_type cell = 0; cell < task.voronoiPoints.size(); cell++)
+            {
+                Fracturer::SplitFractureCell(task, cell);
+            }
+
+            fracture_pattern pattern;
+            pattern.impactPoint = impactPoint;
+
+            for (auto& cellFragments : task.cellFragments)
+            {
+                for (auto& fragment : cellFragments)
+                {
+                    mesh_handle meshHandle = MeshCache::create_mesh(patternMeshName(meshId, generation, patternIndex, pattern.fragments.size()), fragment.fragmentMesh);
+                    pattern.fragments.push_back(fracture_pattern_fragment{ meshHandle, fragment.collider, fragment.localOffset });
+                }
+            }
+
+            if (!pattern.fragments.empty())
+                patternSet.patterns.push_back(std::move(pattern));
+        }
+
+        if (patternSet.patterns.empty()) { return false; }
+
+        async::readwrite_guard guard(m_patternSetsLock);
+        m_patternSets[meshId] = std::move(patternSet);
+        return true;
+    }
+
+    bool FracturePatternCache::store(id_type meshId, const filesystem::view& file)
+    {
+        OPTICK_EVENT();
+
+        if (!file.is_valid(true) || !file.file_info().can_be_written)
+            return false;
+
+        filesystem::basic_resource resource(nullptr);
+        byte_vec& data = resource.get();
+
+        for (auto item : patternMagic)
+            data.push_back(item);
+
+        {
+            async::readonly_guard guard(m_patternSetsLock);
+
+            auto it = m_patternSets.find(meshId);
+            if (it == m_patternSets.end())
+                return false;
+
+            auto& [patternScale, patterns] = it->second;
+
+            appendBinaryData(&patternScale, data);
+
+            uint64 patternCount = patterns.size();
+            appendBinaryData(&patternCount, data);
+
+            for (auto& pattern : patterns)
+            {
+                appendBinaryData(&pattern.impactPoint, data);
+
+                uint64 fragmentCount = pattern.fragments.size();
+                appendBinaryData(&fragmentCount, data);
+
+                for (auto& fragment : pattern.fragments)
+                {
+                    appendBinaryData(&fragment.localOffset, data);
+
+                    //the hull is stored as its vertices, rebuilding it from those is far cheaper than from the whole mesh
+                    appendBinaryData(&fragment.collider->GetVertices(), data);
+
+                    filesystem::basic_resource meshResource(nullptr);
+                    {
+                        auto [lock, fragmentMesh] = fragment.meshHandle.get();
+                        async::readonly_guard meshGuard(lock);
+                        mesh::to_resource(&meshResource, fragmentMesh);
+                    }
+                    appendBinaryData(&meshResource.get(), data);
+                }
+            }
+        }
+
+        bool stored = true;
+        filesystem::view target = file;
+        target.set(resource).except([&](fs_error err)
+            {
+                log::error("error occurred in {} at {} line {}: {}", err.file(), err.func(), err.line(), err.what());
+                stored = false;
+                return common::ok_proxy<void>();
+            });
+
+        return stored;
+    }
+
+    bool FracturePatternCache::load(id_type meshId, const filesystem::view& file)
+    {
+        OPTICK_EVENT();
+
+        auto result = file.get();
+        if (result != common::valid)
+            return false;
+
+        auto resource = result.decay();
+
+        if (resource.size() <= patternMagic.size() + sizeof(math::vec3) + sizeof(uint64))
+            return false;
+
+        const byte_vec& data = resource.get();
+
+        std::string_view magic(reinterpret_cast<const char*>(data.data()), patternMagic.size());
+        if (magic != patternMagic)
+            return false;
+
+        auto start = data.cbegin() + patternMagic.size();
+        auto end = data.cend();
+
+        struct loaded_fragment
+        {
+            math::vec3 localOffset;
+            std::vector<math::vec3> hullVertices;
+            byte_vec meshData;
+        };
+
+        //everything is read before any meshes are created, so a truncated file doesn't leave meshes behind in the cache
+        math::vec3 patternScale;
+        uint64 patternCount;
+        if (!readBinaryData(patternScale, start, end) || !readBinaryData(patternCount, start, end))
+            return false;
+
+        std::vector<std::pair<math::vec3, std::vector<loaded_fragment>>> loadedPatterns;
+
+        for (size_type patternIndex = 0; patternIndex < patternCount; patternIndex++)
+        {
+            auto& [impactPoint, fragments] = loadedPatterns.emplace_back();
+
+            uint64 fragmentCount;
+            if (!readBinaryData(impactPoint, start, end) || !readBinaryData(fragmentCount, start, end))
+                return false;
+
+            for (size_type fragmentIndex = 0; fragmentIndex < fragmentCount; fragmentIndex++)
+            {
+                loaded_fragment& fragment = fragments.emplace_back();
+
+                if (!readBinaryData(fragment.localOffset, start, end) ||
+                    !readBinaryData(fragment.hullVertices, start, end) ||
+                    !readBinaryData(fragment.meshData, start, end))
+                    return false;
+            }
+        }
+
+        pattern_set patternSet;
+        patternSet.scale = patternScale;
+
+        size_type generation = m_generation.fetch_add(1, std::memory_order_relaxed);
+
+        for (size_type patternIndex = 0; patternIndex < loadedPatterns.size(); patternIndex++)
+        {
+            auto& [impactPoint, fragments] = loadedPatterns[patternIndex];
+
+            fracture_pattern pattern;
+            pattern.impactPoint = impactPoint;
+
+            for (size_type fragmentIndex = 0; fragmentIndex < fragments.size(); fragmentIndex++)
+            {
+                loaded_fragment& loadedFragment = fragments[fragmentIndex];
+
+                fracture_pattern_fragment fragment;
+                fragment.localOffset = loadedFragment.localOffset;
+
+                mesh fragmentMesh;
+                mesh::from_resource(&fragmentMesh, filesystem::basic_resource(std::move(loadedFragment.meshData)));
+
+                fragment.meshHandle = MeshCache::create_mesh(patternMeshName(meshId, generation, patternIndex, fragmentIndex), fragmentMesh);
+
+                fragment.collider = std::make_shared<ConvexCollider>();
+                fragment.collider->ConstructConvexHullWithVertices(loadedFragment.hullVertices);
+
+                pattern.fragments.push_back(std::move(fragment));
+            }
+
+            patternSet.patterns.push_back(std::move(pattern));
+        }
+
+        async::readwrite_guard guard(m_patternSetsLock);
+        m_patternSets[meshId] = std::move(patternSet);
+        return true;
+    }
+
+    bool FracturePatternCache::instantiate(fracture_task& task)
+    {
+        OPTICK_EVENT();
+
+        if (task.sources.empty()) { return false; }
+
+        async::readonly_guard guard(m_patternSetsLock);
+
+        //every source needs a pattern, otherwise the sources would be fractured in different ways
+        std::vector<const fracture_pattern*> chosenPatterns;
+        chosenPatterns.reserve(task.sources.size());
+
+        for (auto& source : task.sources)
+        {
+            auto it = m_patternSets.find(source.meshId);
+            if (it == m_patternSets.end() || math::distance(it->second.scale, source.scale) > math::epsilon<float>())
+                return false;
+
+            math::vec3 localImpactPoint = math::inverse(source.rotation) * (task.params.explosionCentroid - math::vec3(source.transform[3]));
+
+            const fracture_pattern* closestPattern = nullptr;
+            float closestDistance = std::numeric_limits<float>::max();
+
+            for (auto& pattern : it->second.patterns)
+            {
+                float distance = math::distance2(pattern.impactPoint, localImpactPoint);
+                if (distance < closestDistance)
+                {
+                    closestDistance = distance;
+                    closestPattern = &pattern;
+                }
+            }
+
+            if (!closestPattern) { return false; }
+
+            chosenPatterns.push_back(closestPattern);
+        }
+
+        task.cellFragments.resize(1);
+        auto& fragments = task.cellFragments[0];
+
+        for (size_type sourceIndex = 0; sourceIndex < chosenPatterns.size(); sourceIndex++)
+        {
+            for (auto& patternFragment : chosenPatterns[sourceIndex]->fragments)
+            {
+                fracture_fragment fragment;
+                fragment.sourceIndex = sourceIndex;
+                fragment.meshHandle = patternFragment.meshHandle;
+                fragment.collider = std::make_shared<ConvexCollider>(*patternFragment.collider);
+                fragment.localOffset = patternFragment.localOffset;
+
+                fragments.push_back(std::move(fragment));
+            }
+        }
+
+        return true;
+    }
+
+    bool FracturePatternCache::has(id_type meshId)
+    {
+        async::readonly_guard guard(m_patternSetsLock);
+        return m_patternSets.count(meshId);
+    }
+
+    void FracturePatternCache::clear()
+    {
+        async::readwrite_guard guard(m_patternSetsLock);
+        m_patternSets.clear();
+    }
+}
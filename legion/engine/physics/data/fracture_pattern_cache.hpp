@@ -0,0 +1,84 @@
+#pragma once
+#include <core/core.hpp>
+#include <physics/components/fracturer.hpp>
+#include <physics/colliders/convexcollider.hpp>
+
+namespace legion::physics
+{
+    /** @struct fracture_pattern_fragment
+    * @brief A fragment of a fracture pattern. Its mesh lives in the mesh cache, so every fragment entity created from it shares the mesh.
+    */
+    struct fracture_pattern_fragment
+    {
+        mesh_handle meshHandle;
+        //every fragment entity gets its own copy of this collider
+        std::shared_ptr<ConvexCollider> collider;
+        //offset from the fractured entity to the fragment, in the space of the rotation of the fractured entity
+        math::vec3 localOffset;
+    };
+
+    /** @struct fracture_pattern
+    * @brief A fracture of a mesh that was generated ahead of time, in the space of the entity that gets fractured.
+    */
+    struct fracture_pattern
+    {
+        //the point the pattern was generated around, fractures pick the pattern closest to their impact
+        math::vec3 impactPoint;
+        std::vector<fracture_pattern_fragment> fragments;
+    };
+
+    /** @class FracturePatternCache
+    * @brief Stores pre-fractured patterns per mesh. Fracturing an entity whose meshes all have patterns doesn't split anything,
+    * the fragments of the patterns closest to the impact are instanced instead.
+    * @note Patterns are generated for the scale of the entity they were generated with, entities with a different scale are fractured at runtime.
+    */
+    class FracturePatternCache
+    {
+    public:
+        /** @brief Generates fracture patterns for the mesh of the entity, this is as expensive as fracturing the entity patternCount times.
+        * The entity needs a MeshSplitter, a physicsComponent and a mesh_filter. Children have to be generated separately.
+        * @param patternCount The amount of patterns to generate, the impact points are spread evenly around the entity
+        * @param cellCount The amount of voronoi cells every pattern is split into
+        * @return Whether any patterns were generated
+        */
+        static bool generate(ecs::entity_handle entity, size_type patternCount, size_type cellCount = 5);
+
+        /** @brief Writes the patterns of a mesh to a file, so they can be loaded instead of generated.
+        * @return Whether the patterns were written
+        */
+        static bool store(id_type meshId, const filesystem::view& file);
+
+        /** @brief Loads patterns that were written with store, replacing any patterns of the mesh that were already in the cache.
+        * @return Whether the file contained valid patterns
+        */
+        static bool load(id_type meshId, const filesystem::view& file);
+
+        /** @brief Fills the fragments of a fracture task with the patterns closest to its impact.
+        * @return false if one of the sources of the task has no patterns for its mesh and scale, the task has to be processed then
+        */
+        static bool instantiate(fracture_task& task);
+
+        static bool has(id_type meshId);
+
+        static void clear();
+
+    private:
+        struct pattern_set
+        {
+            math::vec3 scale;
+            std::vector<fracture_pattern> patterns;
+        };
+
+        static std::unordered_map<id_type, pattern_set> m_patternSets;
+        static async::rw_spinlock m_patternSetsLock;
+
+        //every generated or loaded pattern set gets a new generation, the mesh cache keeps the first mesh created with a name
+        //and fragment entities of replaced patterns might still use their meshes
+        static std::atomic<size_type> m_generation;
+
+        static std::string patternMeshName(id_type meshId, size_type generation, size_type pattern, size_type fragment)
+        {
+            return "fracture_pattern_" + std::to_string(meshId) + "_" + std::to_string(generation) + "_" + std::to_string(pattern) + "_" + std::to_string(fragment);
+        }
+    };
+}
@@ -17,7 +17,7 @@ namespace legion::physics
         bool isARef;
         std::string debugID = "na";
 
-        PenetrationQuery(math::vec3& pFaceCentroid,math::vec3& pNormal,float pPenetration,bool pIsARef) :
+        PenetrationQuery(const math::vec3& pFaceCentroid,const math::vec3& pNormal,float pPenetration,bool pIsARef) :
             faceCentroid(pFaceCentroid),normal(pNormal),penetration(pPenetration),isARef(pIsARef)
         {
 
@@ -6,6 +6,7 @@
 #include <core/core.hpp>
 #include <physics/components/physics_component.hpp>
 #include <physics/data/penetrationquery.hpp>
+#include <physics/data/contact_cache.hpp>
 
 namespace legion::physics
 {
@@ -35,6 +36,11 @@ namespace legion::physics
 
         std::unique_ptr<PenetrationQuery> penetrationInformation;
 
+        //the face that seperated the colliders last step, it gets tested before the full seperating axis test
+        seperating_axis cachedSeperatingAxis;
+        //[out] the face that seperated the colliders this step, if any
+        seperating_axis seperatingAxis;
+
         bool isColliding;
 
         /*void DEBUG_checkIDAndBreak(std::string firstID,std::string secondID) const
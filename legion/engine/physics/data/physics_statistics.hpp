@@ -0,0 +1,35 @@
+#pragma once
+#include <core/core.hpp>
+
+namespace legion::physics
+{
+    /** @struct physics_statistics
+    * @brief What the last step of the PhysicsSystem spent its time on and how much work it did.
+    * All times are in milliseconds, stages that didn't run in a step stay at 0.
+    */
+    struct physics_statistics
+    {
+        //reading the components before the step and writing them back after it
+        float dataTime = 0.0f;
+        //updating the bounds of the colliders, the scene query and collecting the pairs that might collide
+        float broadphaseTime = 0.0f;
+        //checking the pairs for collisions and generating their contacts
+        float narrowphaseTime = 0.0f;
+        //building the islands, solving them, updating sleep states and the contact cache
+        float solverTime = 0.0f;
+        //integrating the velocities and the transforms of the rigidbodies
+        float integrationTime = 0.0f;
+        //requesting fractures and committing the ones that were finished by the job system
+        float fractureTime = 0.0f;
+        float totalTime = 0.0f;
+
+        size_type physicsComponentCount = 0;
+        size_type awakeRigidbodyCount = 0;
+        size_type broadphasePairCount = 0;
+        size_type manifoldCount = 0;
+        size_type contactCount = 0;
+        size_type islandCount = 0;
+        //fractures that are still being processed by the job system at the end of the step
+        size_type pendingFractureCount = 0;
+    };
+}
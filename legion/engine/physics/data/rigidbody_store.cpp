@@ -0,0 +1,249 @@
+#include <physics/data/rigidbody_store.hpp>
+#include <physics/data/simd_lanes.hpp>
+
+namespace legion::physics
+{
+    namespace
+    {
+        using simd::lanes;
+
+        static_assert(RigidbodyStore::batch_size % lanes::width == 0, "A batch needs to be a whole number of SIMD registers.");
+    }
+
+    void RigidbodyStore::collect(const std::vector<byte>& hasRigidBodies, ecs::component_container<rigidbody>& rigidbodies)
+    {
+        OPTICK_EVENT();
+
+        m_dirty = false;
+        m_bodies.clear();
+        for (size_type index = 0; index < hasRigidBodies.size(); index++)
+        {
+            if (hasRigidBodies[index] && !rigidbodies[index].isAsleep)
+                m_bodies.push_back(index);
+        }
+
+        const size_type paddedSize = batchCount() * batch_size;
+
+        m_inverseMass.resize(paddedSize);
+        for (int i = 0; i < 3; i++)
+        {
+            m_velocity[i].resize(paddedSize);
+            m_angularVelocity[i].resize(paddedSize);
+            m_force[i].resize(paddedSize);
+            m_torque[i].resize(paddedSize);
+            m_position[i].resize(paddedSize);
+        }
+        for (int i = 0; i < 4; i++)
+            m_rotation[i].resize(paddedSize);
+        for (int i = 0; i < 9; i++)
+        {
+            m_localInverseInertia[i].resize(paddedSize);
+            m_globalInverseInertia[i].resize(paddedSize);
+        }
+    }
+
+    void RigidbodyStore::integrateVelocities(const async::job_range& batches, ecs::component_container<rigidbody>& rigidbodies, float deltaTime)
+    {
+        const size_type start = batches.start * batch_size;
+        const size_type stop = batches.stop * batch_size;
+        const size_type bodyStop = math::min(stop, m_bodies.size());
+
+        for (size_type i = start; i < bodyStop; i++)
+        {
+            const rigidbody& rb = rigidbodies[m_bodies[i]];
+
+            m_inverseMass[i] = rb.inverseMass;
+            for (int axis = 0; axis < 3; axis++)
+            {
+                m_velocity[axis][i] = rb.velocity[axis];
+                m_angularVelocity[axis][i] = rb.angularVelocity[axis];
+                m_force[axis][i] = rb.forceAccumulator[axis];
+                m_torque[axis][i] = rb.torqueAccumulator[axis];
+            }
+            for (int col = 0; col < 3; col++)
+                for (int row = 0; row < 3; row++)
+                    m_globalInverseInertia[col * 3 + row][i] = rb.globalInverseInertiaTensor[col][row];
+        }
+
+        velocityKernel(start, stop, deltaTime);
+
+        for (size_type i = start; i < bodyStop; i++)
+        {
+            rigidbody& rb = rigidbodies[m_bodies[i]];
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                rb.velocity[axis] = m_velocity[axis][i];
+                rb.angularVelocity[axis] = m_angularVelocity[axis][i];
+            }
+
+            rb.resetAccumulators();
+        }
+    }
+
+    void RigidbodyStore::integrateTransforms(const async::job_range& batches, ecs::component_container<rigidbody>& rigidbodies,
+        ecs::component_container<position>& positions, ecs::component_container<rotation>& rotations, float deltaTime)
+    {
+        const size_type start = batches.start * batch_size;
+        const size_type stop = batches.stop * batch_size;
+        const size_type bodyStop = math::min(stop, m_bodies.size());
+
+        for (size_type i = start; i < bodyStop; i++)
+        {
+            const size_type index = m_bodies[i];
+            const rigidbody& rb = rigidbodies[index];
+            const position& pos = positions[index];
+            const rotation& rot = rotations[index];
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                m_velocity[axis][i] = rb.velocity[axis];
+                m_angularVelocity[axis][i] = rb.angularVelocity[axis];
+                m_position[axis][i] = pos[axis];
+            }
+
+            m_rotation[0][i] = rot.w;
+            m_rotation[1][i] = rot.x;
+            m_rotation[2][i] = rot.y;
+            m_rotation[3][i] = rot.z;
+
+            for (int col = 0; col < 3; col++)
+                for (int row = 0; row < 3; row++)
+                    m_localInverseInertia[col * 3 + row][i] = rb.localInverseInertiaTensor[col][row];
+        }
+
+        positionKernel(start, stop, deltaTime);
+        rotationKernel(start, bodyStop, deltaTime);
+        inertiaTensorKernel(start, stop);
+
+        for (size_type i = start; i < bodyStop; i++)
+        {
+            const size_type index = m_bodies[i];
+            rigidbody& rb = rigidbodies[index];
+
+            math::vec3 pos(m_position[0][i], m_position[1][i], m_position[2][i]);
+            positions[index] = pos;
+            rotations[index] = math::quat(m_rotation[0][i], m_rotation[1][i], m_rotation[2][i], m_rotation[3][i]);
+
+            //for now assume that there is no offset from bodyP
+            rb.globalCentreOfMass = pos;
+
+            for (int col = 0; col < 3; col++)
+                for (int row = 0; row < 3; row++)
+                    rb.globalInverseInertiaTensor[col][row] = m_globalInverseInertia[col * 3 + row][i];
+        }
+    }
+
+    void RigidbodyStore::velocityKernel(size_type start, size_type stop, float deltaTime)
+    {
+        const lanes dt = lanes::set(deltaTime);
+        const lanes gravity[3] = { lanes::set(constants::gravity.x), lanes::set(constants::gravity.y), lanes::set(constants::gravity.z) };
+
+        for (size_type i = start; i < stop; i += lanes::width)
+        {
+            ////-------------------- update velocity ------------------//
+            const lanes inverseMass = lanes::load(&m_inverseMass[i]);
+            for (int axis = 0; axis < 3; axis++)
+            {
+                lanes acc = lanes::load(&m_force[axis][i]) * inverseMass;
+                lanes velocity = lanes::load(&m_velocity[axis][i]) + (acc + gravity[axis]) * dt;
+                velocity.store(&m_velocity[axis][i]);
+            }
+
+            ////-------------------- update angular velocity ------------------//
+            const lanes torque[3] = { lanes::load(&m_torque[0][i]), lanes::load(&m_torque[1][i]), lanes::load(&m_torque[2][i]) };
+            for (int col = 0; col < 3; col++)
+            {
+                //torque is a row vector, so every column of the tensor gives one component
+                lanes angularAcc = torque[0] * lanes::load(&m_globalInverseInertia[col * 3][i])
+                    + torque[1] * lanes::load(&m_globalInverseInertia[col * 3 + 1][i])
+                    + torque[2] * lanes::load(&m_globalInverseInertia[col * 3 + 2][i]);
+
+                lanes angularVelocity = lanes::load(&m_angularVelocity[col][i]) + angularAcc * dt;
+                angularVelocity.store(&m_angularVelocity[col][i]);
+            }
+        }
+    }
+
+    void RigidbodyStore::positionKernel(size_type start, size_type stop, float deltaTime)
+    {
+        const lanes dt = lanes::set(deltaTime);
+
+        for (size_type i = start; i < stop; i += lanes::width)
+        {
+            for (int axis = 0; axis < 3; axis++)
+            {
+                lanes pos = lanes::load(&m_position[axis][i]) + lanes::load(&m_velocity[axis][i]) * dt;
+                pos.store(&m_position[axis][i]);
+            }
+        }
+    }
+
+    void RigidbodyStore::rotationKernel(size_type start, size_type stop, float deltaTime)
+    {
+        //glm has no SIMD versions of the trigonometric functions, so the rotation is integrated one rigidbody at a time
+        for (size_type i = start; i < stop; i++)
+        {
+            math::vec3 angularVelocity(m_angularVelocity[0][i], m_angularVelocity[1][i], m_angularVelocity[2][i]);
+
+            float angle = math::clamp(math::length(angularVelocity), 0.0f, 32.0f);
+            float dtAngle = angle * deltaTime;
+
+            if (math::epsilonEqual(dtAngle, 0.0f, math::epsilon<float>()))
+                continue;
+
+            math::vec3 axis = math::normalize(angularVelocity);
+
+            math::quat rot(m_rotation[0][i], m_rotation[1][i], m_rotation[2][i], m_rotation[3][i]);
+            rot = math::normalize(math::angleAxis(dtAngle, axis) * rot);
+
+            m_rotation[0][i] = rot.w;
+            m_rotation[1][i] = rot.x;
+            m_rotation[2][i] = rot.y;
+            m_rotation[3][i] = rot.z;
+        }
+    }
+
+    void RigidbodyStore::inertiaTensorKernel(size_type start, size_type stop)
+    {
+        const lanes one = lanes::set(1.f);
+        const lanes two = lanes::set(2.f);
+
+        for (size_type i = start; i < stop; i += lanes::width)
+        {
+            const lanes w = lanes::load(&m_rotation[0][i]);
+            const lanes x = lanes::load(&m_rotation[1][i]);
+            const lanes y = lanes::load(&m_rotation[2][i]);
+            const lanes z = lanes::load(&m_rotation[3][i]);
+
+            //rotation matrix of the quaternion, the same as math::toMat3
+            lanes rot[9];
+            rot[0] = one - two * (y * y + z * z);
+            rot[1] = two * (x * y + w * z);
+            rot[2] = two * (x * z - w * y);
+            rot[3] = two * (x * y - w * z);
+            rot[4] = one - two * (x * x + z * z);
+            rot[5] = two * (y * z + w * x);
+            rot[6] = two * (x * z + w * y);
+            rot[7] = two * (y * z - w * x);
+            rot[8] = one - two * (x * x + y * y);
+
+            lanes local[9];
+            for (int j = 0; j < 9; j++)
+                local[j] = lanes::load(&m_localInverseInertia[j][i]);
+
+            //the inverse of a rotation matrix is its transpose, so this is inverse(rot) * local * rot
+            lanes localRot[9];
+            for (int col = 0; col < 3; col++)
+                for (int row = 0; row < 3; row++)
+                    localRot[col * 3 + row] = local[row] * rot[col * 3] + local[3 + row] * rot[col * 3 + 1] + local[6 + row] * rot[col * 3 + 2];
+
+            for (int col = 0; col < 3; col++)
+                for (int row = 0; row < 3; row++)
+                {
+                    lanes global = rot[row * 3] * localRot[col * 3] + rot[row * 3 + 1] * localRot[col * 3 + 1] + rot[row * 3 + 2] * localRot[col * 3 + 2];
+                    global.store(&m_globalInverseInertia[col * 3 + row][i]);
+                }
+        }
+    }
+}
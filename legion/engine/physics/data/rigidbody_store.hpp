@@ -0,0 +1,85 @@
+#pragma once
+#include <core/core.hpp>
+#include <physics/components/rigidbody.hpp>
+
+namespace legion::physics
+{
+    /** @class RigidbodyStore
+    * @brief Physics owned copy of the state of the awake rigidbodies, stored as a structure of arrays so the integration can run on a batch of rigidbodies at once.
+    * The state of a batch is loaded from the rigidbody components right before it gets integrated and stored back right after, while it is still in cache.
+    * Sleeping rigidbodies don't change, so they are left out completely.
+    * Every array is padded to a whole number of batches, so the kernels never have to handle a partial batch.
+    */
+    class RigidbodyStore
+    {
+    public:
+        static constexpr size_type batch_size = 4;
+
+        /** @brief Collects the rigidbodies that are awake, which are the ones that the next integrations will run on.
+        * Needs to be called once every step after the rigidbodies got fetched, the indices of the query can change between steps.
+        */
+        void collect(const std::vector<byte>& hasRigidBodies, ecs::component_container<rigidbody>& rigidbodies);
+
+        /** @brief Collects the rigidbodies again if they were marked dirty since the last collect, otherwise the collected rigidbodies are kept.
+        */
+        void refresh(const std::vector<byte>& hasRigidBodies, ecs::component_container<rigidbody>& rigidbodies)
+        {
+            if (m_dirty)
+                collect(hasRigidBodies, rigidbodies);
+        }
+
+        /** @brief Marks the collected rigidbodies as outdated, needs to be called when a rigidbody fell asleep or woke up after the last collect.
+        */
+        void markDirty()
+        {
+            m_dirty = true;
+        }
+
+        /** @brief The amount of collected rigidbodies.
+        */
+        size_type size() const
+        {
+            return m_bodies.size();
+        }
+
+        /** @brief The amount of batches the collected rigidbodies are split into, the integration functions take a range of these.
+        */
+        size_type batchCount() const
+        {
+            return (m_bodies.size() + batch_size - 1) / batch_size;
+        }
+
+        /** @brief Applies gravity and the accumulated forces and torques of the rigidbodies in a range of batches to their velocities,
+        * and resets the accumulators.
+        */
+        void integrateVelocities(const async::job_range& batches, ecs::component_container<rigidbody>& rigidbodies, float deltaTime);
+
+        /** @brief Moves and rotates the entities of the rigidbodies in a range of batches by their velocities,
+        * and updates the global centre of mass and the global inverse inertia tensor to the new transform.
+        */
+        void integrateTransforms(const async::job_range& batches, ecs::component_container<rigidbody>& rigidbodies,
+            ecs::component_container<position>& positions, ecs::component_container<rotation>& rotations, float deltaTime);
+
+    private:
+        //index in the query of every collected rigidbody
+        std::vector<size_type> m_bodies;
+        bool m_dirty = true;
+
+        //one array per component of every vector, quaternion and matrix, matrices are stored column by column
+        std::vector<float> m_inverseMass;
+        std::vector<float> m_velocity[3];
+        std::vector<float> m_angularVelocity[3];
+        std::vector<float> m_force[3];
+        std::vector<float> m_torque[3];
+        std::vector<float> m_position[3];
+        //w, x, y, z
+        std::vector<float> m_rotation[4];
+        std::vector<float> m_localInverseInertia[9];
+        std::vector<float> m_globalInverseInertia[9];
+
+        void velocityKernel(size_type start, size_type stop, float deltaTime);
+        void positionKernel(size_type start, size_type stop, float deltaTime);
+        void rotationKernel(size_type start, size_type stop, float deltaTime);
+        void inertiaTensorKernel(size_type start, size_type stop);
+    };
+}
@@ -0,0 +1,145 @@
+#include <physics/data/scene_query.hpp>
+#include <physics/physics_statics.hpp>
+
+namespace legion::physics
+{
+    void SceneQuery::update(const std::vector<physics_manifold_precursor>& manifoldPrecursors)
+    {
+        OPTICK_EVENT();
+
+        m_entities.resize(manifoldPrecursors.size());
+        m_transforms.resize(manifoldPrecursors.size());
+        m_colliderOffsets.resize(manifoldPrecursors.size() + 1);
+        m_colliders.clear();
+        m_bounds.clear();
+
+        for (size_type i = 0; i < manifoldPrecursors.size(); i++)
+        {
+            auto& precursor = manifoldPrecursors[i];
+            m_entities[i] = precursor.entity;
+            m_transforms[i] = precursor.worldTransform;
+            m_colliderOffsets[i] = m_colliders.size();
+
+            for (auto& collider : precursor.physicsComp->colliders)
+            {
+                m_colliders.push_back(collider);
+                m_bounds.push_back(collider->GetMinMaxWorldAABB());
+            }
+        }
+
+        m_colliderOffsets.back() = m_colliders.size();
+    }
+
+    void SceneQuery::clear()
+    {
+        m_entities.clear();
+        m_transforms.clear();
+        m_colliderOffsets.clear();
+        m_colliders.clear();
+        m_bounds.clear();
+    }
+
+    bool SceneQuery::raycast(const BroadPhaseCollisionAlgorithm& broadphase, const ray& query, raycast_hit& hit) const
+    {
+        OPTICK_EVENT();
+
+        std::vector<size_type> candidates;
+        if (!broadphase.queryRay(query.origin, query.direction, query.maxDistance, candidates))
+        {
+            candidates.resize(m_entities.size());
+            std::iota(candidates.begin(), candidates.end(), 0);
+        }
+
+        const math::vec3 inverseDirection = 1.f / query.direction;
+
+        size_type closestCollider = m_colliders.size();
+        size_type closestEntity = 0;
+        float closestDistance = query.maxDistance;
+        math::vec3 closestNormal;
+
+        for (size_type candidate : candidates)
+        {
+            for (size_type i = m_colliderOffsets[candidate]; i < m_colliderOffsets[candidate + 1]; i++)
+            {
+                //only hits closer than the closest hit so far are interesting
+                auto& [low, high] = m_bounds[i];
+                if (!PhysicsStatics::RaycastAABB(query.origin, inverseDirection, closestDistance, low, high))
+                    continue;
+
+                float distance;
+                math::vec3 normal;
+                if (m_colliders[i]->Raycast(m_transforms[candidate], query.origin, query.direction, closestDistance, distance, normal))
+                {
+                    closestCollider = i;
+                    closestEntity = candidate;
+                    closestDistance = distance;
+                    closestNormal = normal;
+                }
+            }
+        }
+
+        if (closestCollider == m_colliders.size())
+            return false;
+
+        hit.entity = m_entities[closestEntity];
+        hit.collider = m_colliders[closestCollider];
+        hit.point = query.origin + query.direction * closestDistance;
+        hit.normal = closestNormal;
+        hit.distance = closestDistance;
+        return true;
+    }
+
+    void SceneQuery::overlapSphere(const BroadPhaseCollisionAlgorithm& broadphase, const math::vec3& center, float radius, std::vector<ecs::entity_handle>& entities) const
+    {
+        OPTICK_EVENT();
+
+        const math::vec3 min = center - math::vec3(radius);
+        const math::vec3 max = center + math::vec3(radius);
+
+        std::vector<size_type> candidates;
+        collectAABBCandidates(broadphase, min, max, candidates);
+
+        for (size_type candidate : candidates)
+        {
+            for (size_type i = m_colliderOffsets[candidate]; i < m_colliderOffsets[candidate + 1]; i++)
+            {
+                if (PhysicsStatics::CollideAABB(m_bounds[i], std::make_pair(min, max)) &&
+                    m_colliders[i]->OverlapsSphere(m_transforms[candidate], center, radius))
+                {
+                    entities.push_back(m_entities[candidate]);
+                    break;
+                }
+            }
+        }
+    }
+
+    void SceneQuery::overlapAABB(const BroadPhaseCollisionAlgorithm& broadphase, const math::vec3& min, const math::vec3& max, std::vector<ecs::entity_handle>& entities) const
+    {
+        OPTICK_EVENT();
+
+        std::vector<size_type> candidates;
+        collectAABBCandidates(broadphase, min, max, candidates);
+
+        for (size_type candidate : candidates)
+        {
+            for (size_type i = m_colliderOffsets[candidate]; i < m_colliderOffsets[candidate + 1]; i++)
+            {
+                if (PhysicsStatics::CollideAABB(m_bounds[i], std::make_pair(min, max)) &&
+                    m_colliders[i]->OverlapsAABB(m_transforms[candidate], min, max))
+                {
+                    entities.push_back(m_entities[candidate]);
+                    break;
+                }
+            }
+        }
+    }
+
+    void SceneQuery::collectAABBCandidates(const BroadPhaseCollisionAlgorithm& broadphase, const math::vec3& min, const math::vec3& max, std::vector<size_type>& candidates) const
+    {
+        if (broadphase.queryAABB(min, max, candidates))
+            return;
+
+        candidates.resize(m_entities.size());
+        std::iota(candidates.begin(), candidates.end(), 0);
+    }
+}
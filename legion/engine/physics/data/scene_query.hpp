@@ -0,0 +1,92 @@
+#pragma once
+#include <core/core.hpp>
+#include <physics/broadphasecollisionalgorithms/broadphasecollisionalgorithm.hpp>
+#include <physics/data/physics_manifold_precursor.hpp>
+#include <physics/colliders/physicscollider.hpp>
+
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace legion::physics
+{
+    /** @struct ray
+    * @brief A ray in world space for scene queries.
+    */
+    struct ray
+    {
+        math::vec3 origin;
+        //normalized direction of the ray
+        math::vec3 direction;
+        float maxDistance = std::numeric_limits<float>::max();
+    };
+
+    /** @struct raycast_hit
+    * @brief The closest collider a ray hit.
+    */
+    struct raycast_hit
+    {
+        ecs::entity_handle entity;
+        std::shared_ptr<PhysicsCollider> collider;
+        math::vec3 point = math::vec3(0.0f);
+        math::vec3 normal = math::vec3(0.0f);
+        float distance = std::numeric_limits<float>::max();
+
+        bool hasHit() const
+        {
+            return collider != nullptr;
+        }
+    };
+
+    /** @class SceneQuery
+    * @brief Answers raycasts and overlap queries against the colliders as they were during the last physics step.
+    * Candidates are found with the broadphase, after which their bounds and the exact shape of their colliders are tested.
+    * The transforms and bounds are copied every step, so queries never read data the physics system is writing to.
+    * The colliders themselves are shared, their shape only changes when they get replaced by fracturing.
+    * @note Queries can run on multiple threads at once, as long as the SceneQuery and the broadphase aren't updated at the same time.
+    */
+    class SceneQuery
+    {
+    public:
+        /** @brief Copies the colliders of all physics components, in the same order as the precursors the broadphase gets.
+        * Needs to be called after the bounds of the colliders were updated.
+        */
+        void update(const std::vector<physics_manifold_precursor>& manifoldPrecursors);
+
+        /** @brief Finds the closest collider that the ray hits.
+        * @param hit [out] the hit, only changed when the ray hits something
+        * @return Whether the ray hit anything
+        */
+        bool raycast(const BroadPhaseCollisionAlgorithm& broadphase, const ray& query, raycast_hit& hit) const;
+
+        /** @brief Finds all entities that have a collider that overlaps the sphere, every entity is reported once.
+        */
+        void overlapSphere(const BroadPhaseCollisionAlgorithm& broadphase, const math::vec3& center, float radius, std::vector<ecs::entity_handle>& entities) const;
+
+        /** @brief Finds all entities that have a collider that overlaps the AABB, every entity is reported once.
+        */
+        void overlapAABB(const BroadPhaseCollisionAlgorithm& broadphase, const math::vec3& min, const math::vec3& max, std::vector<ecs::entity_handle>& entities) const;
+
+        size_type size() const
+        {
+            return m_entities.size();
+        }
+
+        void clear();
+
+    private:
+        //one entry per physics component
+        std::vector<ecs::entity_handle> m_entities;
+        std::vector<math::mat4> m_transforms;
+        //the colliders of physics component i are at [m_colliderOffsets[i], m_colliderOffsets[i + 1])
+        std::vector<size_type> m_colliderOffsets;
+
+        //one entry per collider
+        std::vector<std::shared_ptr<PhysicsCollider>> m_colliders;
+        std::vector<std::pair<math::vec3, math::vec3>> m_bounds;
+
+        /** @brief Collects candidates from the broadphase, or every physics component if the broadphase can't answer queries.
+        */
+        void collectAABBCandidates(const BroadPhaseCollisionAlgorithm& broadphase, const math::vec3& min, const math::vec3& max, std::vector<size_type>& candidates) const;
+    };
+}
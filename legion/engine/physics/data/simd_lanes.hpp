@@ -0,0 +1,41 @@
+#pragma once
+#include <core/core.hpp>
+
+namespace legion::physics::simd
+{
+    /** @struct lanes
+    * @brief Holds as many floats as the SIMD layer of glm can process at once.
+    * Kernels are written once against this type and fall back to one float at a time when glm has no SIMD support.
+    */
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    struct lanes
+    {
+        static constexpr size_type width = 4;
+
+        glm_f32vec4 value;
+
+        static lanes load(const float* src) { return { _mm_loadu_ps(src) }; }
+        static lanes set(float src) { return { _mm_set1_ps(src) }; }
+        void store(float* dst) const { _mm_storeu_ps(dst, value); }
+
+        friend lanes operator+(lanes a, lanes b) { return { _mm_add_ps(a.value, b.value) }; }
+        friend lanes operator-(lanes a, lanes b) { return { _mm_sub_ps(a.value, b.value) }; }
+        friend lanes operator*(lanes a, lanes b) { return { _mm_mul_ps(a.value, b.value) }; }
+    };
+#else
+    struct lanes
+    {
+        static constexpr size_type width = 1;
+
+        float value;
+
+        static lanes load(const float* src) { return { *src }; }
+        static lanes set(float src) { return { src }; }
+        void store(float* dst) const { *dst = value; }
+
+        friend lanes operator+(lanes a, lanes b) { return { a.value + b.value }; }
+        friend lanes operator-(lanes a, lanes b) { return { a.value - b.value }; }
+        friend lanes operator*(lanes a, lanes b) { return { a.value * b.value }; }
+    };
+#endif
+}
@@ -0,0 +1,91 @@
+#include <physics/halfedgearena.hpp>
+
+namespace legion::physics
+{
+    HalfEdgeArena::HalfEdgeArena(const HalfEdgeArena& other)
+    {
+        OPTICK_EVENT();
+
+        for (uint32 i = 0; i < other.m_edges.count; i++)
+        {
+            m_edges.emplace(other.m_edges[i]);
+        }
+
+        for (uint32 i = 0; i < other.m_faces.count; i++)
+        {
+            m_faces.emplace(other.m_faces[i]);
+        }
+
+        // Copies are at the same index as their original, so the links can be remapped by index
+        for (uint32 i = 0; i < m_edges.count; i++)
+        {
+            HalfEdgeEdge& edge = m_edges[i];
+            edge.pairingEdge = translate(edge.pairingEdge);
+            edge.nextEdge = translate(edge.nextEdge);
+            edge.prevEdge = translate(edge.prevEdge);
+            edge.face = translate(edge.face);
+        }
+
+        for (uint32 i = 0; i < m_faces.count; i++)
+        {
+            HalfEdgeFace& face = m_faces[i];
+            face.startEdge = translate(face.startEdge);
+        }
+    }
+
+    void HalfEdgeArena::compact(std::vector<HalfEdgeFace*>& faces)
+    {
+        OPTICK_EVENT();
+
+        HalfEdgeArena compacted;
+
+        std::vector<uint32> edgeRemap(m_edges.count, invalid_index);
+        std::vector<uint32> faceRemap(m_faces.count, invalid_index);
+
+        for (HalfEdgeFace* face : faces)
+        {
+            faceRemap[face->arenaIndex] = compacted.m_faces.emplace(*face)->arenaIndex;
+
+            HalfEdgeEdge* current = face->startEdge;
+            do
+            {
+                edgeRemap[current->arenaIndex] = compacted.m_edges.emplace(*current)->arenaIndex;
+                current = current->nextEdge;
+            } while (current != face->startEdge);
+        }
+
+        auto remapEdge = [&](HalfEdgeEdge* edge) -> HalfEdgeEdge*
+        {
+            if (!edge || edgeRemap[edge->arenaIndex] == invalid_index) return nullptr;
+            return &compacted.m_edges[edgeRemap[edge->arenaIndex]];
+        };
+
+        auto remapFace = [&](HalfEdgeFace* face) -> HalfEdgeFace*
+        {
+            if (!face || faceRemap[face->arenaIndex] == invalid_index) return nullptr;
+            return &compacted.m_faces[faceRemap[face->arenaIndex]];
+        };
+
+        for (uint32 i = 0; i < compacted.m_edges.count; i++)
+        {
+            HalfEdgeEdge& edge = compacted.m_edges[i];
+            edge.pairingEdge = remapEdge(edge.pairingEdge);
+            edge.nextEdge = remapEdge(edge.nextEdge);
+            edge.prevEdge = remapEdge(edge.prevEdge);
+            edge.face = remapFace(edge.face);
+        }
+
+        for (uint32 i = 0; i < compacted.m_faces.count; i++)
+        {
+            HalfEdgeFace& face = compacted.m_faces[i];
+            face.startEdge = remapEdge(face.startEdge);
+        }
+
+        for (uint32 i = 0; i < faces.size(); i++)
+        {
+            faces[i] = &compacted.m_faces[i];
+        }
+
+        *this = std::move(compacted);
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include <core/core.hpp>
+#include <physics/halfedgeedge.hpp>
+#include <physics/halfedgeface.hpp>
+
+namespace legion::physics
+{
+    /**@class HalfEdgeArena
+     * @brief Owns the edges and faces of a half-edge mesh. They are stored in chunks of contiguous memory and addressed by 32 bit indices,
+     * so building a mesh doesn't need an allocation per edge or face and walking over a mesh mostly stays within a few cache lines.
+     * Edges and faces never move while the arena is alive, so they can still be linked through pointers.
+     * Everything is released at once when the arena is destroyed.
+     */
+    class HalfEdgeArena
+    {
+    public:
+        static constexpr uint32 invalid_index = std::numeric_limits<uint32>::max();
+
+        HalfEdgeArena() = default;
+
+        /**@brief Copies all the edges and faces of another arena, the links between them are remapped to the copies.
+         */
+        HalfEdgeArena(const HalfEdgeArena& other);
+        HalfEdgeArena(HalfEdgeArena&& other) = default;
+
+        HalfEdgeArena& operator=(const HalfEdgeArena& other) = delete;
+        HalfEdgeArena& operator=(HalfEdgeArena&& other) = default;
+
+        HalfEdgeEdge* createEdge(const math::vec3& edgePosition)
+        {
+            return m_edges.emplace(edgePosition);
+        }
+
+        /**@brief Creates a face from a loop of edges that was already linked, also sets the face of all the edges in the loop.
+         */
+        HalfEdgeFace* createFace(HalfEdgeEdge* startEdge, const math::vec3& normal)
+        {
+            return m_faces.emplace(startEdge, normal);
+        }
+
+        HalfEdgeEdge& getEdge(uint32 index)
+        {
+            return m_edges[index];
+        }
+
+        HalfEdgeFace& getFace(uint32 index)
+        {
+            return m_faces[index];
+        }
+
+        uint32 edgeCount() const
+        {
+            return m_edges.count;
+        }
+
+        uint32 faceCount() const
+        {
+            return m_faces.count;
+        }
+
+        /**@brief Finds the copy in this arena of an edge of the arena this one was copied from.
+         */
+        HalfEdgeEdge* translate(const HalfEdgeEdge* edge)
+        {
+            return edge ? &m_edges[edge->arenaIndex] : nullptr;
+        }
+
+        /**@brief Finds the copy in this arena of a face of the arena this one was copied from.
+         */
+        HalfEdgeFace* translate(const HalfEdgeFace* face)
+        {
+            return face ? &m_faces[face->arenaIndex] : nullptr;
+        }
+
+        /**@brief Throws away every edge and face that isn't part of the given faces, for example the faces that got replaced while building a convex hull.
+         * The remaining edges and faces are moved to the front of the arena in the order of the given faces.
+         * @param faces [in/out] The faces to keep, they are replaced by the pointers to their new location.
+         */
+        void compact(std::vector<HalfEdgeFace*>& faces);
+
+        void clear()
+        {
+            m_faces.clear();
+            m_edges.clear();
+        }
+
+    private:
+        static constexpr uint32 chunk_size = 64;
+
+        /**@brief Grows in chunks that never reallocate, so items keep their address.
+         */
+        template<typename item_type>
+        struct chunk_list
+        {
+            std::vector<std::vector<item_type>> chunks;
+            uint32 count = 0;
+
+            template<typename... arguments>
+            item_type* emplace(arguments&&... args)
+            {
+                if (count == chunks.size() * chunk_size)
+                {
+                    chunks.emplace_back();
+                    chunks.back().reserve(chunk_size);
+                }
+
+                item_type* item = &chunks.back().emplace_back(std::forward<arguments>(args)...);
+                item->arenaIndex = count++;
+                return item;
+            }
+
+            item_type& operator[](uint32 index)
+            {
+                return chunks[index / chunk_size][index % chunk_size];
+            }
+
+            const item_type& operator[](uint32 index) const
+            {
+                return chunks[index / chunk_size][index % chunk_size];
+            }
+
+            void clear()
+            {
+                chunks.clear();
+                count = 0;
+            }
+        };
+
+        chunk_list<HalfEdgeEdge> m_edges;
+        chunk_list<HalfEdgeFace> m_faces;
+    };
+}
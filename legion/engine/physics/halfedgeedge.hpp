@@ -19,6 +19,9 @@ namespace legion::physics
 		math::vec3 edgePosition;
         std::string id;
 
+        //index of the edge in the HalfEdgeArena that owns it
+        uint32 arenaIndex = 0;
+
         HalfEdgeEdge() = default;
 
 		HalfEdgeEdge(math::vec3 newEdgePositionPtr) : edgePosition{ newEdgePositionPtr }
@@ -24,14 +24,12 @@ namespace legion::physics
 		math::vec3 normal;
 		math::vec3 centroid;
         math::color DEBUG_color;
+
+        //index of the face in the HalfEdgeArena that owns it
+        uint32 arenaIndex = 0;
         
 		HalfEdgeFace(HalfEdgeEdge* newStartEdge, math::vec3 newNormal);
 
-        /**@brief Deletes all the edges of this face
-         * Warning: pairing edges are not deleted because their face may still exist
-         */
-        void deleteEdges();
-
         /**@brief set the face of all the edges to this face
          */
         void setFaceForAllEdges();
@@ -82,8 +80,9 @@ namespace legion::physics
         static HalfEdgeEdge* findMiddleEdge(const HalfEdgeFace& first, const HalfEdgeFace& second);
 
         /**@brief Merges two faces
-         * Warning: Only the face middleEdge.face will be usable after the merge, the other face will be deleted
-         * Warning: The passed middleEdge will also be deleted
+         * Warning: Only the face middleEdge.face will be usable after the merge, the other face is no longer part of the mesh
+         * Warning: The passed middleEdge and its pairing edge are no longer part of the mesh either,
+         * their memory stays in the HalfEdgeArena until it gets compacted
          * @param middleEdge The edge that seperates the two faces7
          * @return Pointer to the merged HalfEdgeFace
          */
@@ -103,7 +102,5 @@ namespace legion::physics
         }
 
         void DEBUG_DrawFace(const math::mat4& transform, const math::color& debugColor,  float time = 20.0f);
-
-		~HalfEdgeFace();
 	};
 }
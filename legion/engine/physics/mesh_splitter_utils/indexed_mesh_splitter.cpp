@@ -0,0 +1,696 @@
+#include <physics/mesh_splitter_utils/indexed_mesh_splitter.hpp>
+#include <physics/data/simd_lanes.hpp>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <tuple>
+
+namespace legion::physics
+{
+    namespace
+    {
+        constexpr uint invalid_index = std::numeric_limits<uint>::max();
+
+        //positions are snapped to a grid with 1 / weldPrecision sized cells, vertices that end up in the same cell are welded together
+        constexpr float weldPrecision = 1e5f;
+
+        float cross2(const math::vec2& a, const math::vec2& b) noexcept
+        {
+            return a.x * b.y - a.y * b.x;
+        }
+
+        float signedArea(const std::vector<uint>& loop, const std::vector<math::vec2>& points, uint firstVertex)
+        {
+            float area = 0.0f;
+            for (size_type i = 0; i < loop.size(); i++)
+            {
+                area += cross2(points[loop[i] - firstVertex], points[loop[(i + 1) % loop.size()] - firstVertex]);
+            }
+            return area * 0.5f;
+        }
+
+        //whether p lies inside or on the border of the counter clockwise triangle abc
+        bool inTriangle(const math::vec2& p, const math::vec2& a, const math::vec2& b, const math::vec2& c) noexcept
+        {
+            return cross2(b - a, p - a) >= 0.0f && cross2(c - b, p - b) >= 0.0f && cross2(a - c, p - c) >= 0.0f;
+        }
+
+        bool inPolygon(const math::vec2& p, const std::vector<uint>& loop, const std::vector<math::vec2>& points, uint firstVertex)
+        {
+            bool inside = false;
+            for (size_type i = 0, j = loop.size() - 1; i < loop.size(); j = i++)
+            {
+                const math::vec2& a = points[loop[i] - firstVertex];
+                const math::vec2& b = points[loop[j] - firstVertex];
+
+                if ((a.y > p.y) != (b.y > p.y) && p.x < a.x + (p.y - a.y) / (b.y - a.y) * (b.x - a.x))
+                    inside = !inside;
+            }
+            return inside;
+        }
+
+        //whether the segments cross each other, segments that only touch at their ends don't count
+        bool segmentsCross(const math::vec2& a, const math::vec2& b, const math::vec2& c, const math::vec2& d) noexcept
+        {
+            if (a == c || a == d || b == c || b == d) { return false; }
+
+            const float abC = cross2(b - a, c - a);
+            const float abD = cross2(b - a, d - a);
+            const float cdA = cross2(d - c, a - c);
+            const float cdB = cross2(d - c, b - c);
+
+            return ((abC > 0.0f) != (abD > 0.0f)) && ((cdA > 0.0f) != (cdB > 0.0f));
+        }
+    }
+
+    void IndexedMeshSplitter::FromMesh(const mesh& source, split_mesh_data& result)
+    {
+        OPTICK_EVENT();
+
+        result.clear();
+
+        std::map<std::tuple<int64, int64, int64>, uint> weldLookup;
+
+        for (size_type i = 0; i < source.vertices.size(); i++)
+        {
+            const math::vec3& position = source.vertices[i];
+            const math::vec2 uv = i < source.uvs.size() ? source.uvs[i] : math::vec2(0.0f);
+
+            auto key = std::make_tuple(
+                static_cast<int64>(math::round(position.x * weldPrecision)),
+                static_cast<int64>(math::round(position.y * weldPrecision)),
+                static_cast<int64>(math::round(position.z * weldPrecision)));
+
+            auto [it, inserted] = weldLookup.emplace(key, result.weldCount);
+            if (inserted)
+                result.weldCount++;
+
+            result.addVertex(position, uv, it->second);
+        }
+
+        result.indices.reserve(source.indices.size());
+
+        for (size_type i = 0; i + 2 < source.indices.size(); i += 3)
+        {
+            uint a = source.indices[i];
+            uint b = source.indices[i + 1];
+            uint c = source.indices[i + 2];
+
+            //triangles that collapsed into a line or a point would only create degenerate fragments
+            uint weldA = result.welds[a];
+            uint weldB = result.welds[b];
+            uint weldC = result.welds[c];
+            if (weldA == weldB || weldB == weldC || weldC == weldA) { continue; }
+
+            result.indices.push_back(a);
+            result.indices.push_back(b);
+            result.indices.push_back(c);
+        }
+    }
+
+    void IndexedMeshSplitter::Split(const split_mesh_data& source, const std::vector<MeshSplitParams>& splittingPlanes,
+        const math::mat4& transform, std::vector<split_mesh_data>& resultingIslands, bool keepBelow)
+    {
+        OPTICK_EVENT();
+
+        static const float splitEpsilon = math::sqrt(math::epsilon<float>());
+
+        const math::mat3 basis(transform);
+        const math::vec3 origin = transform[3];
+
+        const split_mesh_data* current = &source;
+        size_type target = 0;
+
+        for (auto& plane : splittingPlanes)
+        {
+            //dot(n, T * x - p) == dot(transpose(M) * n, x) - dot(n, p - t), so the planes can be tested against the local positions
+            math::vec3 localNormal = math::transpose(basis) * plane.planeNormal;
+            float planeDistance = math::dot(plane.planeNormal, plane.planePostion - origin);
+
+            //the distances are positive on the side that is kept
+            if (keepBelow)
+            {
+                localNormal = -localNormal;
+                planeDistance = -planeDistance;
+            }
+
+            float minDistance;
+            float maxDistance;
+            ClassifyVertices(*current, localNormal, planeDistance, minDistance, maxDistance);
+
+            //the plane doesn't cut anything off
+            if (minDistance >= -splitEpsilon) { continue; }
+
+            //the plane cuts everything off
+            if (maxDistance <= splitEpsilon) { return; }
+
+            split_mesh_data& result = m_buffers[target];
+            SplitByPlane(*current, localNormal, result);
+
+            current = &result;
+            target = 1 - target;
+        }
+
+        SeparateIslands(*current, resultingIslands);
+    }
+
+    void IndexedMeshSplitter::ClassifyVertices(const split_mesh_data& source, const math::vec3& localNormal, float planeDistance,
+        float& minDistance, float& maxDistance)
+    {
+        using simd::lanes;
+
+        const size_type vertexCount = source.vertexCount();
+        m_distances.resize(vertexCount);
+
+        const lanes normalX = lanes::set(localNormal.x);
+        const lanes normalY = lanes::set(localNormal.y);
+        const lanes normalZ = lanes::set(localNormal.z);
+        const lanes distance = lanes::set(planeDistance);
+
+        size_type i = 0;
+        for (; i + lanes::width <= vertexCount; i += lanes::width)
+        {
+            (lanes::load(&source.x[i]) * normalX + lanes::load(&source.y[i]) * normalY
+                + lanes::load(&source.z[i]) * normalZ - distance).store(&m_distances[i]);
+        }
+
+        for (; i < vertexCount; i++)
+        {
+            m_distances[i] = source.x[i] * localNormal.x + source.y[i] * localNormal.y + source.z[i] * localNormal.z - planeDistance;
+        }
+
+        minDistance = std::numeric_limits<float>::max();
+        maxDistance = std::numeric_limits<float>::lowest();
+
+        for (float vertexDistance : m_distances)
+        {
+            minDistance = math::min(minDistance, vertexDistance);
+            maxDistance = math::max(maxDistance, vertexDistance);
+        }
+    }
+
+    void IndexedMeshSplitter::SplitByPlane(const split_mesh_data& source, const math::vec3& localNormal, split_mesh_data& result)
+    {
+        OPTICK_EVENT();
+
+        static const float splitEpsilon = math::sqrt(math::epsilon<float>());
+
+        result.clear();
+        result.weldCount = source.weldCount;
+
+        m_onPlane.clear();
+        m_edgeVertices.clear();
+        m_edgeWelds.clear();
+        m_planeEdges.clear();
+        m_weldVertices.clear();
+        m_vertexRemap.assign(source.vertexCount(), invalid_index);
+
+        //vertices are only copied when a triangle that is kept uses them
+        auto keepVertex = [&](uint vertex)
+        {
+            uint& remapped = m_vertexRemap[vertex];
+            if (remapped == invalid_index)
+            {
+                remapped = result.addVertex(source.position(vertex), source.uvs[vertex], source.welds[vertex]);
+                m_onPlane.push_back(math::abs(m_distances[vertex]) <= splitEpsilon);
+            }
+            return remapped;
+        };
+
+        //both triangles that share an edge get the same vertex on it
+        auto intersectEdge = [&](uint first, uint second)
+        {
+            //the edge is always interpolated in the same direction, so welded copies of the edge end up at the exact same position
+            if (source.welds[second] < source.welds[first])
+                std::swap(first, second);
+
+            auto [vertexIt, vertexInserted] = m_edgeVertices.emplace(EdgeKey(first, second), 0);
+            if (!vertexInserted)
+                return vertexIt->second;
+
+            auto [weldIt, weldInserted] = m_edgeWelds.emplace(EdgeKey(source.welds[first], source.welds[second]), result.weldCount);
+            if (weldInserted)
+                result.weldCount++;
+
+            const float interpolant = m_distances[first] / (m_distances[first] - m_distances[second]);
+
+            vertexIt->second = result.addVertex(
+                math::mix(source.position(first), source.position(second), interpolant),
+                math::mix(source.uvs[first], source.uvs[second], interpolant),
+                weldIt->second);
+            m_onPlane.push_back(true);
+
+            return vertexIt->second;
+        };
+
+        auto addTriangle = [&](uint a, uint b, uint c)
+        {
+            const uint triangle[3] = { a, b, c };
+
+            for (int i = 0; i < 3; i++)
+            {
+                uint from = triangle[i];
+                uint to = triangle[(i + 1) % 3];
+
+                result.indices.push_back(from);
+
+                if (m_onPlane[from] && m_onPlane[to] && result.welds[from] != result.welds[to])
+                {
+                    m_planeEdges.insert(EdgeKey(result.welds[from], result.welds[to]));
+                    m_weldVertices.emplace(result.welds[from], from);
+                }
+            }
+        };
+
+        for (size_type i = 0; i < source.indices.size(); i += 3)
+        {
+            const uint triangle[3] = { source.indices[i], source.indices[i + 1], source.indices[i + 2] };
+
+            int outsideCount = 0;
+            int insideCount = 0;
+
+            for (uint vertex : triangle)
+            {
+                outsideCount += m_distances[vertex] < -splitEpsilon;
+                insideCount += m_distances[vertex] > splitEpsilon;
+            }
+
+            if (outsideCount == 0)
+            {
+                addTriangle(keepVertex(triangle[0]), keepVertex(triangle[1]), keepVertex(triangle[2]));
+                continue;
+            }
+
+            if (insideCount == 0) { continue; }
+
+            //clip the triangle to the kept side of the plane, which leaves a triangle or a quad
+            uint polygon[4];
+            int polygonSize = 0;
+
+            for (int edge = 0; edge < 3; edge++)
+            {
+                uint from = triangle[edge];
+                uint to = triangle[(edge + 1) % 3];
+
+                float fromDistance = m_distances[from];
+                float toDistance = m_distances[to];
+
+                if (fromDistance >= -splitEpsilon)
+                    polygon[polygonSize++] = keepVertex(from);
+
+                if ((fromDistance > splitEpsilon && toDistance < -splitEpsilon) || (fromDistance < -splitEpsilon && toDistance > splitEpsilon))
+                    polygon[polygonSize++] = intersectEdge(from, to);
+            }
+
+            addTriangle(polygon[0], polygon[1], polygon[2]);
+
+            if (polygonSize == 4)
+                addTriangle(polygon[0], polygon[2], polygon[3]);
+        }
+
+        CapHoles(result, localNormal);
+    }
+
+    void IndexedMeshSplitter::CapHoles(split_mesh_data& result, const math::vec3& localNormal)
+    {
+        OPTICK_EVENT();
+
+        //an edge on the plane without a twin borders the hole, the cap runs along it in the opposite direction.
+        //where the hole touches itself a weld starts more than one edge, so all of them are kept
+        m_capEdges.clear();
+
+        for (uint64 edge : m_planeEdges)
+        {
+            uint from = static_cast<uint>(edge >> 32);
+            uint to = static_cast<uint>(edge);
+
+            if (!m_planeEdges.count(EdgeKey(to, from)))
+                m_capEdges.emplace(to, from);
+        }
+
+        if (m_capEdges.empty()) { return; }
+
+        //the cap is triangulated in 2D, on two axes that lie in the plane
+        const math::vec3 normal = math::normalize(localNormal);
+        const math::vec3 tangent = math::normalize(math::cross(math::abs(normal.x) < 0.9f ? math::vec3(1.0f, 0.0f, 0.0f) : math::vec3(0.0f, 1.0f, 0.0f), normal));
+        const math::vec3 bitangent = math::cross(normal, tangent);
+
+        //the cap gets its own vertices, it shouldn't use the uvs of the triangles around it
+        const uint firstVertex = static_cast<uint>(result.vertexCount());
+        m_capPoints.clear();
+        m_capAreas.clear();
+        size_type loopCount = 0;
+
+        while (!m_capEdges.empty())
+        {
+            if (m_capLoops.size() <= loopCount)
+                m_capLoops.emplace_back();
+
+            std::vector<uint>& loop = m_capLoops[loopCount];
+            loop.clear();
+
+            uint start = m_capEdges.begin()->first;
+            uint current = start;
+
+            do
+            {
+                auto it = m_capEdges.find(current);
+                if (it == m_capEdges.end()) { break; }
+
+                const math::vec3 position = result.position(m_weldVertices[current]);
+                loop.push_back(result.addVertex(position, math::vec2(0.0f), current));
+                m_capPoints.emplace_back(math::dot(position, tangent), math::dot(position, bitangent));
+
+                current = it->second;
+                m_capEdges.erase(it);
+            } while (current != start);
+
+            if (loop.size() < 3) { continue; }
+
+            m_capAreas.push_back(signedArea(loop, m_capPoints, firstVertex));
+            loopCount++;
+        }
+
+        if (loopCount == 0) { return; }
+
+        //the outer borders of the hole all run in the direction the cap is wound in and the biggest loop is always an outer border,
+        //mirroring the points so that direction is counter clockwise lets the rest of the triangulation assume it
+        size_type largestLoop = 0;
+        for (size_type i = 1; i < loopCount; i++)
+        {
+            if (math::abs(m_capAreas[i]) > math::abs(m_capAreas[largestLoop]))
+                largestLoop = i;
+        }
+
+        if (m_capAreas[largestLoop] < 0.0f)
+        {
+            for (auto& point : m_capPoints)
+                point.y = -point.y;
+
+            for (size_type i = 0; i < loopCount; i++)
+                m_capAreas[i] = -m_capAreas[i];
+        }
+
+        //every loop that runs the other way is a hole in the smallest outer border around it
+        static const float areaEpsilon = math::epsilon<float>();
+
+        m_capOwners.assign(loopCount, invalid_index);
+        for (size_type i = 0; i < loopCount; i++)
+        {
+            if (m_capAreas[i] > -areaEpsilon) { continue; }
+
+            const math::vec2& point = m_capPoints[m_capLoops[i][0] - firstVertex];
+
+            for (size_type outer = 0; outer < loopCount; outer++)
+            {
+                if (m_capAreas[outer] <= areaEpsilon) { continue; }
+
+                if (m_capOwners[i] != invalid_index && m_capAreas[outer] >= m_capAreas[m_capOwners[i]]) { continue; }
+
+                if (inPolygon(point, m_capLoops[outer], m_capPoints, firstVertex))
+                    m_capOwners[i] = static_cast<uint>(outer);
+            }
+        }
+
+        for (size_type outer = 0; outer < loopCount; outer++)
+        {
+            if (m_capAreas[outer] <= areaEpsilon) { continue; }
+
+            m_capPolygon = m_capLoops[outer];
+
+            //holes are bridged into the border from right to left, so a bridge never has to cross a hole that is bridged later
+            m_capHoles.clear();
+            for (size_type hole = 0; hole < loopCount; hole++)
+            {
+                if (m_capOwners[hole] == outer)
+                    m_capHoles.push_back(static_cast<uint>(hole));
+            }
+
+            auto rightmost = [&](uint hole)
+            {
+                const std::vector<uint>& loop = m_capLoops[hole];
+                size_type best = 0;
+                for (size_type i = 1; i < loop.size(); i++)
+                {
+                    if (m_capPoints[loop[i] - firstVertex].x > m_capPoints[loop[best] - firstVertex].x)
+                        best = i;
+                }
+                return best;
+            };
+
+            std::sort(m_capHoles.begin(), m_capHoles.end(), [&](uint lhs, uint rhs)
+                {
+                    return m_capPoints[m_capLoops[lhs][rightmost(lhs)] - firstVertex].x > m_capPoints[m_capLoops[rhs][rightmost(rhs)] - firstVertex].x;
+                });
+
+            for (size_type holeIndex = 0; holeIndex < m_capHoles.size(); holeIndex++)
+            {
+                const std::vector<uint>& hole = m_capLoops[m_capHoles[holeIndex]];
+                const size_type holeStart = rightmost(m_capHoles[holeIndex]);
+                const math::vec2& holePoint = m_capPoints[hole[holeStart] - firstVertex];
+
+                auto crossesLoop = [&](const math::vec2& bridgeEnd, const std::vector<uint>& loop)
+                {
+                    for (size_type i = 0; i < loop.size(); i++)
+                    {
+                        if (segmentsCross(holePoint, bridgeEnd, m_capPoints[loop[i] - firstVertex], m_capPoints[loop[(i + 1) % loop.size()] - firstVertex]))
+                            return true;
+                    }
+                    return false;
+                };
+
+                //bridge to the closest vertex of the border that can be reached without crossing the border or another hole
+                size_type bridge = std::numeric_limits<size_type>::max();
+                float bridgeDistance = std::numeric_limits<float>::max();
+
+                for (size_type i = 0; i < m_capPolygon.size(); i++)
+                {
+                    const math::vec2& point = m_capPoints[m_capPolygon[i] - firstVertex];
+                    const float distance = math::dot(point - holePoint, point - holePoint);
+                    if (distance >= bridgeDistance) { continue; }
+
+                    bool visible = !crossesLoop(point, m_capPolygon);
+                    for (size_type other = holeIndex; visible && other < m_capHoles.size(); other++)
+                    {
+                        visible = !crossesLoop(point, m_capLoops[m_capHoles[other]]);
+                    }
+
+                    if (visible)
+                    {
+                        bridge = i;
+                        bridgeDistance = distance;
+                    }
+                }
+
+                if (bridge == std::numeric_limits<size_type>::max()) { continue; }
+
+                //walk into the hole and around it, then come back along the bridge
+                m_capBridge.clear();
+                for (size_type i = 0; i <= hole.size(); i++)
+                {
+                    m_capBridge.push_back(hole[(holeStart + i) % hole.size()]);
+                }
+                m_capBridge.push_back(m_capPolygon[bridge]);
+
+                m_capPolygon.insert(m_capPolygon.begin() + bridge + 1, m_capBridge.begin(), m_capBridge.end());
+            }
+
+            TriangulateCap(result, firstVertex);
+        }
+    }
+
+    void IndexedMeshSplitter::TriangulateCap(split_mesh_data& result, uint firstVertex)
+    {
+        //ear clipping, the polygon is counter clockwise and the triangles keep the order of its vertices
+        std::vector<uint>& polygon = m_capPolygon;
+
+        auto point = [&](size_type i) -> const math::vec2& { return m_capPoints[polygon[i] - firstVertex]; };
+
+        auto addTriangle = [&](size_type a, size_type b, size_type c)
+        {
+            result.indices.push_back(polygon[a]);
+            result.indices.push_back(polygon[b]);
+            result.indices.push_back(polygon[c]);
+        };
+
+        size_type current = 0;
+        size_type attempts = 0;
+
+        while (polygon.size() > 3)
+        {
+            const size_type size = polygon.size();
+            const size_type prev = (current + size - 1) % size;
+            const size_type next = (current + 1) % size;
+
+            const math::vec2& a = point(prev);
+            const math::vec2& b = point(current);
+            const math::vec2& c = point(next);
+
+            bool isEar = cross2(b - a, c - b) > 0.0f;
+
+            for (size_type i = 0; isEar && i < size; i++)
+            {
+                if (i == prev || i == current || i == next) { continue; }
+
+                //the vertices at either end of a bridge are in the polygon twice
+                const math::vec2& p = point(i);
+                if (p == a || p == b || p == c) { continue; }
+
+                isEar = !inTriangle(p, a, b, c);
+            }
+
+            //a polygon without ears is degenerate, clipping anyway guarantees the loop ends
+            if (isEar || attempts >= size)
+            {
+                if (cross2(b - a, c - b) > 0.0f)
+                    addTriangle(prev, current, next);
+
+                polygon.erase(polygon.begin() + current);
+                current = current == 0 ? 0 : current - 1;
+                if (current >= polygon.size())
+                    current = 0;
+                attempts = 0;
+                continue;
+            }
+
+            current = next;
+            attempts++;
+        }
+
+        if (polygon.size() == 3 && cross2(point(1) - point(0), point(2) - point(1)) > 0.0f)
+            addTriangle(0, 1, 2);
+    }
+
+    void IndexedMeshSplitter::SeparateIslands(const split_mesh_data& source, std::vector<split_mesh_data>& resultingIslands)
+    {
+        OPTICK_EVENT();
+
+        m_islandParents.resize(source.weldCount);
+        std::iota(m_islandParents.begin(), m_islandParents.end(), 0);
+
+        for (size_type i = 0; i < source.indices.size(); i += 3)
+        {
+            uint root = FindIslandRoot(source.welds[source.indices[i]]);
+
+            for (size_type corner = 1; corner < 3; corner++)
+            {
+                uint otherRoot = FindIslandRoot(source.welds[source.indices[i + corner]]);
+                m_islandParents[otherRoot] = root;
+            }
+        }
+
+        m_islandIndices.assign(source.weldCount, invalid_index);
+        m_vertexRemap.assign(source.vertexCount(), invalid_index);
+
+        for (size_type i = 0; i < source.indices.size(); i += 3)
+        {
+            uint& islandIndex = m_islandIndices[FindIslandRoot(source.welds[source.indices[i]])];
+            if (islandIndex == invalid_index)
+            {
+                islandIndex = static_cast<uint>(resultingIslands.size());
+                resultingIslands.emplace_back().weldCount = source.weldCount;
+            }
+
+            split_mesh_data& island = resultingIslands[islandIndex];
+
+            for (size_type corner = 0; corner < 3; corner++)
+            {
+                uint vertex = source.indices[i + corner];
+                uint& remapped = m_vertexRemap[vertex];
+
+                if (remapped == invalid_index)
+                    remapped = island.addVertex(source.position(vertex), source.uvs[vertex], source.welds[vertex]);
+
+                island.indices.push_back(remapped);
+            }
+        }
+    }
+
+    uint IndexedMeshSplitter::FindIslandRoot(uint weld)
+    {
+        while (m_islandParents[weld] != weld)
+        {
+            m_islandParents[weld] = m_islandParents[m_islandParents[weld]];
+            weld = m_islandParents[weld];
+        }
+
+        return weld;
+    }
+
+    void IndexedMeshSplitter::BuildMesh(const split_mesh_data& island, const math::mat4& transform, const math::vec3& scale,
+        mesh& result, math::vec3& outOffset)
+    {
+        OPTICK_EVENT();
+
+        std::vector<math::vec3>& vertices = result.vertices;
+        std::vector<math::vec2>& uvs = result.uvs;
+        std::vector<math::vec3>& normals = result.normals;
+        std::vector<uint>& indices = result.indices;
+
+        vertices.reserve(island.indices.size());
+        uvs.reserve(island.indices.size());
+
+        for (uint vertex : island.indices)
+        {
+            vertices.push_back(island.position(vertex));
+            uvs.push_back(island.uvs[vertex]);
+        }
+
+        if (vertices.empty())
+        {
+            outOffset = math::vec3(0.0f);
+            return;
+        }
+
+        //get centroid of vertices
+        math::vec3 worldCentroid = math::vec3();
+
+        for (const auto& vertex : vertices)
+        {
+            worldCentroid += vertex;
+        }
+
+        worldCentroid /= static_cast<float>(vertices.size());
+
+        worldCentroid = transform * math::vec4(worldCentroid, 1);
+        math::vec3 originalPosition = transform[3];
+
+        outOffset = worldCentroid - originalPosition;
+
+        math::vec3 localOffset = math::inverse(transform) * math::vec4(outOffset, 0);
+
+        //shift vertices by offset
+        for (auto& vertex : vertices)
+        {
+            vertex -= localOffset;
+            vertex *= scale;
+        }
+
+        indices.resize(vertices.size());
+        std::iota(indices.begin(), indices.end(), 0);
+
+        normals.reserve(vertices.size());
+
+        for (size_type i = 0; i < vertices.size(); i += 3)
+        {
+            math::vec3 normal = math::cross(vertices[i + 1] - vertices[i], vertices[i + 2] - vertices[i]);
+            float length = math::length(normal);
+
+            if (length > math::epsilon<float>())
+                normal /= length;
+
+            normals.push_back(normal);
+            normals.push_back(normal);
+            normals.push_back(normal);
+        }
+
+        mesh::calculate_tangents(&result);
+
+        sub_mesh newSubMesh;
+        newSubMesh.indexCount = indices.size();
+        newSubMesh.indexOffset = 0;
+
+        result.submeshes.push_back(newSubMesh);
+    }
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <core/core.hpp>
+#include <physics/mesh_splitter_utils/mesh_split_params.hpp>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace legion::physics
+{
+    /** @struct split_mesh_data
+    * @brief A triangle mesh stored as flat arrays, the positions are stored per axis so planes can be tested against them with SIMD.
+    * Vertices at the same position share a weld, so triangles stay connected across uv seams and hard edges.
+    */
+    struct split_mesh_data
+    {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+        std::vector<math::vec2> uvs;
+        std::vector<uint> welds;
+        uint weldCount = 0;
+
+        //3 vertex indices per triangle
+        std::vector<uint> indices;
+
+        size_type vertexCount() const noexcept
+        {
+            return x.size();
+        }
+
+        size_type triangleCount() const noexcept
+        {
+            return indices.size() / 3;
+        }
+
+        math::vec3 position(uint vertex) const
+        {
+            return math::vec3(x[vertex], y[vertex], z[vertex]);
+        }
+
+        uint addVertex(const math::vec3& position, const math::vec2& uv, uint weld)
+        {
+            x.push_back(position.x);
+            y.push_back(position.y);
+            z.push_back(position.z);
+            uvs.push_back(uv);
+            welds.push_back(weld);
+            return static_cast<uint>(x.size() - 1);
+        }
+
+        void clear()
+        {
+            x.clear();
+            y.clear();
+            z.clear();
+            uvs.clear();
+            welds.clear();
+            weldCount = 0;
+            indices.clear();
+        }
+    };
+
+    /** @class IndexedMeshSplitter
+    * @brief Splits a split_mesh_data with a list of planes and keeps the part of the mesh on one side of all of them.
+    * All vertices are classified against a plane at once, only the triangles that straddle the plane are clipped
+    * and the hole left by the plane is capped. The scratch buffers keep their memory between planes and between splits,
+    * so a splitter that is reused (for example one per thread) barely allocates.
+    * @note A splitter can only split one mesh at a time, the source mesh is never changed so it can be shared between splitters.
+    */
+    class IndexedMeshSplitter
+    {
+    public:
+        /** @brief Converts a mesh into split_mesh_data, welding vertices with the same position.
+        */
+        static void FromMesh(const mesh& source, split_mesh_data& result);
+
+        /** @brief Keeps the part of the mesh that is on the requested side of all the planes and separates it into islands.
+        * @param source The mesh in the local space of 'transform'
+        * @param splittingPlanes The planes in world space
+        * @param transform The transform of the entity the mesh belongs to
+        * @param resultingIslands [out] every part of the mesh that is not connected to the other parts
+        * @param keepBelow Whether the part behind the planes is kept, or the part in front of them
+        */
+        void Split(const split_mesh_data& source, const std::vector<MeshSplitParams>& splittingPlanes,
+            const math::mat4& transform, std::vector<split_mesh_data>& resultingIslands, bool keepBelow = true);
+
+        /** @brief Builds a renderable mesh out of an island, in the same way PrimitiveMesh builds the mesh of split polygons.
+        * @param transform The transform of the entity the island was split from
+        * @param scale The scale of the entity the island was split from
+        * @param outOffset [out] World space offset from the original entity to the centroid of the new mesh
+        */
+        static void BuildMesh(const split_mesh_data& island, const math::mat4& transform, const math::vec3& scale,
+            mesh& result, math::vec3& outOffset);
+
+    private:
+        //the result of one plane is the source of the next plane
+        split_mesh_data m_buffers[2];
+
+        //distance of every vertex to the current plane, positive on the side that is kept
+        std::vector<float> m_distances;
+        //whether a vertex of the result of the current plane lies on the plane
+        std::vector<byte> m_onPlane;
+
+        //vertices and welds created on the edges that cross the current plane, keyed by the pair of vertices or welds of the edge
+        std::unordered_map<uint64, uint> m_edgeVertices;
+        std::unordered_map<uint64, uint> m_edgeWelds;
+
+        //edges of the result that lie on the current plane, as pairs of welds
+        std::unordered_set<uint64> m_planeEdges;
+        //the edges of the hole left by the current plane, from the weld they start at to the weld they end at
+        std::unordered_multimap<uint, uint> m_capEdges;
+        std::unordered_map<uint, uint> m_weldVertices;
+
+        //the loops around the hole as vertices of the cap, their signed area and the outer loop each hole belongs to
+        std::vector<std::vector<uint>> m_capLoops;
+        std::vector<float> m_capAreas;
+        std::vector<uint> m_capOwners;
+        std::vector<uint> m_capHoles;
+        std::vector<uint> m_capBridge;
+        //the polygon that is being triangulated, an outer loop with its holes bridged into it
+        std::vector<uint> m_capPolygon;
+        //the vertices of the cap projected onto the plane, starting at the first vertex of the cap
+        std::vector<math::vec2> m_capPoints;
+
+        //maps the vertices of the source of a split to the vertices of its result
+        std::vector<uint> m_vertexRemap;
+
+        std::vector<uint> m_islandParents;
+        std::vector<uint> m_islandIndices;
+
+        /** @brief Calculates the distances of all vertices to the plane and finds the closest and furthest one.
+        */
+        void ClassifyVertices(const split_mesh_data& source, const math::vec3& localNormal, float planeDistance,
+            float& minDistance, float& maxDistance);
+
+        /** @brief Clips the triangles of 'source' to the kept side of the plane that was classified last and caps the hole.
+        */
+        void SplitByPlane(const split_mesh_data& source, const math::vec3& localNormal, split_mesh_data& result);
+
+        /** @brief Closes the holes that the plane left in the mesh. The loops around the holes may be concave and may
+        * contain other loops, which are bridged into the loop around them before it is triangulated.
+        */
+        void CapHoles(split_mesh_data& result, const math::vec3& localNormal);
+
+        /** @brief Ear clips the counter clockwise polygon in m_capPolygon into the indices of 'result'.
+        */
+        void TriangulateCap(split_mesh_data& result, uint firstVertex);
+
+        void SeparateIslands(const split_mesh_data& source, std::vector<split_mesh_data>& resultingIslands);
+
+        uint FindIslandRoot(uint weld);
+
+        static uint64 EdgeKey(uint from, uint to) noexcept
+        {
+            return (static_cast<uint64>(from) << 32) | to;
+        }
+    };
+}
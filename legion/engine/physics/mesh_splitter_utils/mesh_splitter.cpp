@@ -28,6 +28,10 @@ namespace legion::physics
 
             BFSPolygonize(meshHalfEdges, transform);
 
+            auto indexedMesh = std::make_shared<split_mesh_data>();
+            IndexedMeshSplitter::FromMesh(mesh, *indexedMesh);
+            splitMesh = std::move(indexedMesh);
+
             log::debug("Mesh vertices {}, Mesh indices {}", mesh.vertices.size(), mesh.indices.size());
 
         }
@@ -52,19 +56,35 @@ namespace legion::physics
     void MeshSplitter::MultipleSplitMesh(const std::vector<MeshSplitParams>& splittingPlanes,
         std::vector<ecs::entity_handle>& entitiesGenerated, bool keepBelow, int debugAt)
     {
-        int currentDebug = 0;
-
         auto [posH, rotH, scaleH] = owner.get_component_handles<transform>();
         const math::mat4& transform = math::compose(scaleH.read(), rotH.read(), posH.read());
 
-        //-------------------------------- copy polygons of original mesh and add it to the output list -----------------------------------------//
-
-        std::vector< std::vector<SplittablePolygonPtr>> outputPolygonIslandsGenerated;
+        //-------------------------------- copy polygons of original mesh and split them -----------------------------------------//
 
         std::vector<SplittablePolygonPtr> copiedPolygons;
         CopyPolygons(meshPolygons, copiedPolygons);
 
-        outputPolygonIslandsGenerated.push_back(std::move(copiedPolygons));
+        std::vector< std::vector<SplittablePolygonPtr>> outputPolygonIslandsGenerated;
+        SplitPolygonsIntoIslands(std::move(copiedPolygons), splittingPlanes, transform, outputPolygonIslandsGenerated, keepBelow, debugAt);
+
+        //-------------------------------- use each polygon list to create a new object -----------------------------------------//
+
+        for (auto& polygonIsland : outputPolygonIslandsGenerated)
+        {
+            PrimitiveMesh newMesh(owner, polygonIsland, ownerMaterialH);
+            auto newEnt = newMesh.InstantiateNewGameObject();
+
+            entitiesGenerated.push_back(newEnt);
+        }
+    }
+
+    void MeshSplitter::SplitPolygonsIntoIslands(std::vector<SplittablePolygonPtr>&& polygons, const std::vector<MeshSplitParams>& splittingPlanes,
+        const math::mat4& transform, std::vector<std::vector<SplittablePolygonPtr>>& resultingIslands, bool keepBelow, int debugAt)
+    {
+        int currentDebug = 0;
+
+        std::vector< std::vector<SplittablePolygonPtr>> outputPolygonIslandsGenerated;
+        outputPolygonIslandsGenerated.push_back(std::move(polygons));
 
         //-------------------------------- spllit mesh based on list of splitting planes -----------------------------------------//
         for (const MeshSplitParams& splitParam : splittingPlanes)
@@ -89,14 +109,9 @@ namespace legion::physics
             currentDebug++;
         }
 
-        //-------------------------------- use each polygon list to create a new object -----------------------------------------//
-
         for (auto& polygonIsland : outputPolygonIslandsGenerated)
         {
-            PrimitiveMesh newMesh(owner, polygonIsland, ownerMaterialH);
-            auto newEnt = newMesh.InstantiateNewGameObject();
-
-            entitiesGenerated.push_back(newEnt);
+            resultingIslands.push_back(std::move(polygonIsland));
         }
     }
 
@@ -12,6 +12,7 @@
 #include <physics/mesh_splitter_utils/intersecting_polygon_organizer.hpp>
 #include <physics/mesh_splitter_utils/mesh_split_params.hpp>
 #include <physics/mesh_splitter_utils/intersection_edge_info.hpp>
+#include <physics/mesh_splitter_utils/indexed_mesh_splitter.hpp>
 
 namespace legion::physics
 {
@@ -25,6 +26,9 @@ namespace legion::physics
 
         std::vector<SplittablePolygonPtr> meshPolygons;
 
+        //the mesh in the flat layout of the IndexedMeshSplitter, shared by every copy of this splitter
+        std::shared_ptr<const split_mesh_data> splitMesh;
+
         //MeshSplitterDebugHelper debugHelper;
 
       
@@ -147,6 +151,16 @@ namespace legion::physics
         */
         void MultipleSplitMesh(const std::vector<MeshSplitParams>& splittingPlanes, std::vector<ecs::entity_handle>& entitiesGenerated,
             bool keepBelow = true,int debugAt = -1);
+
+        /** @brief Given a list of splitting planes, splits already copied polygons into islands without creating any entities.
+        * Only touches the given polygons, so different copies can be split on different threads at the same time.
+        * @param polygons A copy of the polygons of the mesh, created with CopyPolygons
+        * @param transform The transform of the entity the mesh belongs to
+        * @param resultingIslands [out] the polygons of every piece of the mesh that is left after splitting
+        */
+        void SplitPolygonsIntoIslands(std::vector<SplittablePolygonPtr>&& polygons, const std::vector<MeshSplitParams>& splittingPlanes,
+            const math::mat4& transform, std::vector<std::vector<SplittablePolygonPtr>>& resultingIslands,
+            bool keepBelow = true, int debugAt = -1);
        
         /** @brief Given a list of polygons to split in 'polygonsToSplit', splits them based on a splitting plane defined by
         * 'planePosition' and 'planeNormal'. The result is then placed in 'resultingIslands.
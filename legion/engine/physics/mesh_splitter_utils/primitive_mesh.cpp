@@ -17,15 +17,18 @@ namespace legion::physics
     {
         auto [originalPosH, originalRotH, originalScaleH] = originalEntity.get_component_handles<transform>();
         math::mat4 trans = math::compose(originalScaleH.read(), originalRotH.read(), originalPosH.read());
-      
-        auto ent = m_ecs->createEntity();
-        math::vec3 offset;
 
+        math::vec3 offset;
         mesh newMesh;
+        BuildMesh(newMesh, trans, originalScaleH.read(), offset);
+
+        return InstantiateMesh(newMesh, originalMaterial, originalPosH.read() + offset, originalRotH.read());
+    }
+
+    void PrimitiveMesh::BuildMesh(mesh& newMesh, const math::mat4& originalTransform, const math::vec3& scale, math::vec3& outOffset)
+    {
+        populateMesh(newMesh, originalTransform, outOffset, scale);
 
-        math::vec3 scale = originalScaleH.read();
-        populateMesh(newMesh, trans, offset, scale);
-      
         newMesh.calculate_tangents(&newMesh);
 
         sub_mesh newSubMesh;
@@ -33,29 +36,34 @@ namespace legion::physics
         newSubMesh.indexOffset = 0;
 
         newMesh.submeshes.push_back(newSubMesh);
+    }
 
+    ecs::entity_handle PrimitiveMesh::InstantiateMesh(const mesh& newMesh, rendering::material_handle material,
+        const math::vec3& position, const math::quat& rotation)
+    {
         //creaate modelH
         mesh_handle meshH = core::MeshCache::create_mesh("newMesh" + std::to_string(count), newMesh);
-        auto modelH = rendering::ModelCache::create_model(meshH);
         count++;
 
+        return InstantiateMesh(meshH, material, position, rotation);
+    }
+
+    ecs::entity_handle PrimitiveMesh::InstantiateMesh(mesh_handle meshH, rendering::material_handle material,
+        const math::vec3& position, const math::quat& rotation)
+    {
+        auto ent = m_ecs->createEntity();
+
+        auto modelH = rendering::ModelCache::create_model(meshH);
+
         //create renderable
         mesh_filter meshFilter = mesh_filter( meshH );
 
-        ent.add_components<rendering::mesh_renderable>(meshFilter,rendering::mesh_renderer( originalMaterial));
+        ent.add_components<rendering::mesh_renderable>(meshFilter,rendering::mesh_renderer(material));
 
         //create transform
-      
         auto [posH, rotH ,scaleH] = m_ecs->createComponents<transform>(ent);
-        math::vec3 newEntityPos = originalPosH.read() + offset;
-        posH.write(newEntityPos);
-        rotH.write(originalRotH.read());
-        //scaleH.write(originalScaleH.read());
-
-        math::vec3 initialPos = originalPosH.read();
-        //+ math::vec3(7, 0, 0)
-        originalPosH.write(initialPos );
-        //m_ecs->destroyEntity(originalEntity);
+        posH.write(position);
+        rotH.write(rotation);
 
         return ent;
     }
@@ -66,7 +74,7 @@ namespace legion::physics
     }
 
     void PrimitiveMesh::populateMesh(mesh& mesh,
-        const math::mat4& originalTransform , math::vec3& outOffset,math::vec3& scale)
+        const math::mat4& originalTransform , math::vec3& outOffset,const math::vec3& scale)
     {
         std::vector<uint>& indices = mesh.indices;
         std::vector<math::vec3>& vertices = mesh.vertices;
@@ -18,11 +18,28 @@ namespace legion::physics
 
 		ecs::entity_handle InstantiateNewGameObject();
 
+		/** @brief Builds the mesh of the polygons. Doesn't touch the ECS or the mesh cache, so it can be called from a job.
+		* @param originalTransform The transform of the entity the polygons were split from
+		* @param scale The scale of the entity the polygons were split from
+		* @param outOffset [out] World space offset from the original entity to the centroid of the new mesh
+		*/
+		void BuildMesh(mesh& newMesh, const math::mat4& originalTransform, const math::vec3& scale, math::vec3& outOffset);
+
+		/** @brief Creates an entity that renders the given mesh with the given material.
+		*/
+		static ecs::entity_handle InstantiateMesh(const mesh& newMesh, rendering::material_handle material,
+			const math::vec3& position, const math::quat& rotation);
+
+		/** @brief Creates an entity that renders a mesh that is already in the mesh cache, entities created from the same mesh share it.
+		*/
+		static ecs::entity_handle InstantiateMesh(mesh_handle meshH, rendering::material_handle material,
+			const math::vec3& position, const math::quat& rotation);
+
 		static void SetECSRegistry(ecs::EcsRegistry* ecs);
 
 	private:
 
-		void populateMesh(mesh& mesh,const math::mat4& originalTransform,math::vec3& outOffset,math::vec3& scale);
+		void populateMesh(mesh& mesh,const math::mat4& originalTransform,math::vec3& outOffset,const math::vec3& scale);
 
 		rendering::material_handle originalMaterial;
 
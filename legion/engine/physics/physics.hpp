@@ -4,11 +4,15 @@
 #include <physics/components/rigidbody.hpp>
 #include <physics/colliders/convexcollider.hpp>
 #include <physics/colliders/physicscollider.hpp>
+#include <physics/colliders/spherecollider.hpp>
+#include <physics/colliders/capsulecollider.hpp>
 #include <physics/cube_collider_params.hpp>
 #include <physics/physicsconstants.hpp>
 #include <physics/physics_statics.hpp>
+#include <physics/shape_collision.hpp>
 #include <physics/data/convexconvexpenetrationquery.hpp>
 #include <physics/data/edgepenetrationquery.hpp>
+#include <physics/data/analyticpenetrationquery.hpp>
 #include <physics/data/penetrationquery.hpp>
 #include <physics/data/physics_manifold.hpp>
 #include <physics/data/physics_manifold_precursor.hpp>
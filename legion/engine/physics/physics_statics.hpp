@@ -143,6 +143,25 @@ namespace legion::physics
             return false;
         }
 
+        /** @brief Given 2 ConvexColliders, checks how far a single face of convexB seperates the 2 ConvexColliders.
+         * Used to quickly reject pairs that were seperated by the same face in the previous step.
+         * @param convexA the reference collider
+         * @param transformA the transform of convexA
+         * @param face a HalfEdgeFace of convexB
+         * @param transformB the transform of convexB
+         * @return the seperation on the normal of the face, a positive seperation means the face is a seperating axis
+         */
+        static float GetFaceSeperation(ConvexCollider* convexA, const math::mat4& transformA, HalfEdgeFace* face, const math::mat4& transformB)
+        {
+            math::vec3 seperatingAxis = math::normalize(transformB * math::vec4((face->normal), 0));
+            math::vec3 transformedPositionB = transformB * math::vec4(face->centroid, 1);
+
+            math::vec3 worldSupportPoint;
+            GetSupportPoint(transformedPositionB, -seperatingAxis, convexA, transformA, worldSupportPoint);
+
+            return math::dot(worldSupportPoint - transformedPositionB, seperatingAxis);
+        }
+
         /** @brief Given 2 ConvexColliders, Goes through every single possible edge combination in order to check for a valid seperating axis. This is done
          * by creating a minkowski face with each edge combination.
          * @param convexA the reference collider
@@ -515,6 +534,34 @@ namespace legion::physics
             return CollideAABB(low0, high0, low1, high1);
         }
 
+        /**@brief Checks if a ray hits an AABB by clipping the ray against the slabs of the box
+         * @param origin the start of the ray
+         * @param inverseDirection one divided by every component of the normalized direction of the ray, the ray can then be clipped without dividing
+         * @param maxDistance the length of the ray
+         * @param low the lower bounds of the AABB
+         * @param high the higher bounds of the AABB
+         * @return Whether the ray hits the AABB, rays that start inside of the AABB always hit it
+         */
+        static bool RaycastAABB(const math::vec3& origin, const math::vec3& inverseDirection, float maxDistance, const math::vec3& low, const math::vec3& high)
+        {
+            float enter = 0.0f;
+            float exit = maxDistance;
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                float t0 = (low[axis] - origin[axis]) * inverseDirection[axis];
+                float t1 = (high[axis] - origin[axis]) * inverseDirection[axis];
+                if (t0 > t1) std::swap(t0, t1);
+
+                //comparing this way round ignores the NaN of a ray that lies exactly in the plane of a side of the box, which counts as a hit
+                enter = t0 > enter ? t0 : enter;
+                exit = t1 < exit ? t1 : exit;
+                if (enter > exit) return false;
+            }
+
+            return true;
+        }
+
     private:
 
         /** @brief Given 2 HalfEdgeEdges and their respective transforms, transforms their normals and checks if they create a minkowski face
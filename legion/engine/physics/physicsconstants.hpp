@@ -22,6 +22,8 @@ namespace legion::physics::constants
 
     static constexpr float contactOffset = 0.01f;
 
+    static constexpr float boxSeperationTolerance = 0.001f;
+
     static constexpr float sutherlandHodgmanClippingThreshold = 0.01f;
 
     static constexpr bool applyWarmStarting = true;
@@ -29,4 +31,12 @@ namespace legion::physics::constants
     static constexpr float polygonItersectionEpsilon = 0.01f;
 
     static constexpr float polygonSplitterEpsilon = 0.01f;
+
+    static constexpr bool enableSleeping = true;
+
+    static constexpr float sleepLinearVelocityThreshold = 0.08f;
+
+    static constexpr float sleepAngularVelocityThreshold = 0.1f;
+
+    static constexpr float timeToSleep = 0.5f;
 }
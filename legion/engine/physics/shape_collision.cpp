@@ -0,0 +1,684 @@
+#include <physics/shape_collision.hpp>
+#include <physics/colliders/convexcollider.hpp>
+#include <physics/physicsconstants.hpp>
+#include <limits>
+
+namespace legion::physics
+{
+    namespace
+    {
+        //any normalized direction that is perpendicular to the given direction
+        math::vec3 anyPerpendicular(const math::vec3& direction)
+        {
+            if (math::length2(direction) < math::epsilon<float>())
+                return math::vec3(0, 1, 0);
+
+            math::vec3 other = math::abs(direction.x) < 0.9f * math::length(direction) ? math::vec3(1, 0, 0) : math::vec3(0, 1, 0);
+            return math::normalize(math::cross(direction, other));
+        }
+
+        //the planes of the faces of a hull in world space
+        struct world_face
+        {
+            HalfEdgeFace* face;
+            math::vec3 normal;
+            math::vec3 centroid;
+        };
+
+        void getWorldFaces(ConvexCollider* hull, const math::mat4& transform, std::vector<world_face>& worldFaces)
+        {
+            math::mat3 normalMatrix = math::transpose(math::inverse(math::mat3(transform)));
+
+            auto& faces = hull->GetHalfEdgeFaces();
+            worldFaces.reserve(faces.size());
+            for (auto face : faces)
+            {
+                worldFaces.push_back(world_face{ face, math::normalize(normalMatrix * face->normal), transform * math::vec4(face->centroid, 1) });
+            }
+        }
+
+        //checks if a point projects onto a face, the winding of the face doesn't matter as long as the point is on the same side of all edges
+        bool projectsOntoFace(const world_face& worldFace, const math::mat4& transform, const math::vec3& point)
+        {
+            bool isAbove = true;
+            bool isBelow = true;
+
+            HalfEdgeEdge* current = worldFace.face->startEdge;
+            do
+            {
+                math::vec3 start = transform * math::vec4(current->edgePosition, 1);
+                math::vec3 end = transform * math::vec4(current->nextEdge->edgePosition, 1);
+
+                float side = math::dot(math::cross(end - start, point - start), worldFace.normal);
+                isAbove &= side >= 0.0f;
+                isBelow &= side <= 0.0f;
+
+                current = current->nextEdge;
+            } while (current != worldFace.face->startEdge);
+
+            return isAbove || isBelow;
+        }
+
+        //clips the segment of the capsule against the sides of a face and creates a contact at both ends of what is left
+        bool clipCapsuleAgainstFace(const world_face& worldFace, int faceIndex, const math::mat4& transform,
+            const world_capsule& capsule, analytic_collision& collision)
+        {
+            const math::vec3 segment = capsule.end - capsule.start;
+            float enter = 0.0f;
+            float exit = 1.0f;
+
+            HalfEdgeEdge* current = worldFace.face->startEdge;
+            do
+            {
+                math::vec3 start = transform * math::vec4(current->edgePosition, 1);
+                math::vec3 end = transform * math::vec4(current->nextEdge->edgePosition, 1);
+
+                //the normal of the side plane of this edge, pointing away from the face
+                math::vec3 sideNormal = math::cross(end - start, worldFace.normal);
+                if (math::dot(sideNormal, worldFace.centroid - start) > 0.0f)
+                    sideNormal = -sideNormal;
+
+                float startDistance = math::dot(sideNormal, capsule.start - start);
+                float endDistance = math::dot(sideNormal, capsule.end - start);
+
+                if (startDistance > 0.0f && endDistance > 0.0f)
+                    return false;
+
+                if (startDistance > 0.0f)
+                    enter = math::max(enter, startDistance / (startDistance - endDistance));
+                else if (endDistance > 0.0f)
+                    exit = math::min(exit, startDistance / (startDistance - endDistance));
+
+                current = current->nextEdge;
+            } while (current != worldFace.face->startEdge);
+
+            if (enter > exit)
+                return false;
+
+            collision.contactCount = 0;
+            collision.normal = worldFace.normal;
+            collision.seperation = std::numeric_limits<float>::max();
+
+            const float clipped[2] = { enter, exit };
+            const int clipCount = exit - enter > math::epsilon<float>() ? 2 : 1;
+
+            for (int i = 0; i < clipCount; i++)
+            {
+                math::vec3 point = capsule.start + segment * clipped[i];
+                float distance = math::dot(worldFace.normal, point - worldFace.centroid);
+
+                if (distance - capsule.radius >= constants::contactOffset)
+                    continue;
+
+                collision.addContact(point - worldFace.normal * distance, point - worldFace.normal * capsule.radius, faceIndex, i);
+                collision.seperation = math::min(collision.seperation, distance - capsule.radius);
+            }
+
+            return collision.contactCount > 0;
+        }
+    }
+
+    bool ShapeCollision::SphereSphere(const world_sphere& first, const world_sphere& second, analytic_collision& collision)
+    {
+        math::vec3 difference = second.center - first.center;
+        float distance = math::length(difference);
+
+        float seperation = distance - first.radius - second.radius;
+        if (seperation >= constants::contactOffset)
+            return false;
+
+        //spheres with the same center can be pushed apart in any direction
+        math::vec3 normal = distance > math::epsilon<float>() ? difference / distance : math::vec3(0, 1, 0);
+
+        collision.normal = normal;
+        collision.seperation = seperation;
+        collision.addContact(first.center + normal * first.radius, second.center - normal * second.radius, 0, 0);
+        return true;
+    }
+
+    bool ShapeCollision::SphereCapsule(const world_sphere& sphere, const world_capsule& capsule, analytic_collision& collision)
+    {
+        math::vec3 closest = ClosestPointOnSegment(capsule.start, capsule.end, sphere.center);
+        return SphereSphere(sphere, world_sphere{ closest, capsule.radius }, collision);
+    }
+
+    bool ShapeCollision::CapsuleCapsule(const world_capsule& first, const world_capsule& second, analytic_collision& collision)
+    {
+        float firstT, secondT;
+        math::vec3 firstClosest, secondClosest;
+        ClosestPointsBetweenSegments(first.start, first.end, second.start, second.end, firstT, secondT, firstClosest, secondClosest);
+
+        math::vec3 difference = secondClosest - firstClosest;
+        float distance = math::length(difference);
+
+        float seperation = distance - first.radius - second.radius;
+        if (seperation >= constants::contactOffset)
+            return false;
+
+        const math::vec3 firstSegment = first.end - first.start;
+        const math::vec3 secondSegment = second.end - second.start;
+
+        math::vec3 normal = distance > math::epsilon<float>() ? difference / distance : anyPerpendicular(firstSegment);
+
+        collision.normal = normal;
+        collision.seperation = seperation;
+
+        //capsules that lie next to each other get a contact at both ends of the part where they overlap, otherwise they would roll over each other
+        const float firstLength2 = math::length2(firstSegment);
+        const float secondLength2 = math::length2(secondSegment);
+
+        if (firstLength2 > math::epsilon<float>() && secondLength2 > math::epsilon<float>())
+        {
+            math::vec3 axisCross = math::cross(firstSegment, secondSegment);
+            bool isParallel = math::length2(axisCross) < 1e-4f * firstLength2 * secondLength2;
+
+            if (isParallel)
+            {
+                float secondStartT = math::dot(second.start - first.start, firstSegment) / firstLength2;
+                float secondEndT = math::dot(second.end - first.start, firstSegment) / firstLength2;
+
+                float overlapStart = math::max(0.0f, math::min(secondStartT, secondEndT));
+                float overlapEnd = math::min(1.0f, math::max(secondStartT, secondEndT));
+
+                if ((overlapEnd - overlapStart) * math::sqrt(firstLength2) > constants::contactOffset)
+                {
+                    const float overlap[2] = { overlapStart, overlapEnd };
+                    for (int i = 0; i < 2; i++)
+                    {
+                        math::vec3 firstPoint = first.start + firstSegment * overlap[i];
+                        math::vec3 secondPoint = ClosestPointOnSegment(second.start, second.end, firstPoint);
+                        collision.addContact(firstPoint + normal * first.radius, secondPoint - normal * second.radius, i, 0);
+                    }
+
+                    return true;
+                }
+            }
+        }
+
+        collision.addContact(firstClosest + normal * first.radius, secondClosest - normal * second.radius, 0, 0);
+        return true;
+    }
+
+    bool ShapeCollision::BoxSphere(const world_box& box, const world_sphere& sphere, analytic_collision& collision)
+    {
+        const math::vec3 difference = sphere.center - box.center;
+        const math::vec3 local(math::dot(difference, box.axes[0]), math::dot(difference, box.axes[1]), math::dot(difference, box.axes[2]));
+        const math::vec3 clamped = math::clamp(local, -box.halfExtents, box.halfExtents);
+
+        math::vec3 normal;
+        math::vec3 refPoint;
+        float seperation;
+        int feature = 0;
+
+        if (clamped != local)
+        {
+            //the center is outside of the box, the clamped point is the closest point on its surface
+            refPoint = box.center + box.axes[0] * clamped.x + box.axes[1] * clamped.y + box.axes[2] * clamped.z;
+
+            math::vec3 toCenter = sphere.center - refPoint;
+            float distance = math::length(toCenter);
+
+            seperation = distance - sphere.radius;
+            if (seperation >= constants::contactOffset)
+                return false;
+
+            for (int i = 0; i < 3; i++)
+            {
+                if (local[i] != clamped[i])
+                {
+                    feature = i * 2 + (local[i] > 0.0f ? 0 : 1);
+                    break;
+                }
+            }
+
+            normal = distance > math::epsilon<float>() ? toCenter / distance : box.axes[feature / 2] * (feature % 2 ? -1.0f : 1.0f);
+        }
+        else
+        {
+            //the center is inside of the box, push it out through the closest face
+            int axis = 0;
+            float closestDepth = std::numeric_limits<float>::max();
+            for (int i = 0; i < 3; i++)
+            {
+                float depth = box.halfExtents[i] - math::abs(local[i]);
+                if (depth < closestDepth)
+                {
+                    closestDepth = depth;
+                    axis = i;
+                }
+            }
+
+            const float sign = local[axis] >= 0.0f ? 1.0f : -1.0f;
+            feature = axis * 2 + (sign > 0.0f ? 0 : 1);
+
+            normal = box.axes[axis] * sign;
+            refPoint = sphere.center + normal * closestDepth;
+            seperation = -closestDepth - sphere.radius;
+        }
+
+        collision.normal = normal;
+        collision.seperation = seperation;
+        collision.addContact(refPoint, sphere.center - normal * sphere.radius, feature, 0);
+        return true;
+    }
+
+    bool ShapeCollision::HullSphere(ConvexCollider* hull, const math::mat4& transform, const world_sphere& sphere,
+        analytic_collision& collision, HalfEdgeFace*& seperatingFace)
+    {
+        seperatingFace = nullptr;
+
+        std::vector<world_face> worldFaces;
+        getWorldFaces(hull, transform, worldFaces);
+
+        float deepestSeperation = std::numeric_limits<float>::lowest();
+        int deepestFace = -1;
+
+        float closestDistanceSquared = std::numeric_limits<float>::max();
+        math::vec3 closestPoint;
+        int closestFace = -1;
+
+        for (int i = 0; i < static_cast<int>(worldFaces.size()); i++)
+        {
+            auto& worldFace = worldFaces[i];
+
+            float seperation = math::dot(worldFace.normal, sphere.center - worldFace.centroid);
+            if (seperation - sphere.radius >= constants::contactOffset)
+            {
+                seperatingFace = worldFace.face;
+                return false;
+            }
+
+            if (seperation > deepestSeperation)
+            {
+                deepestSeperation = seperation;
+                deepestFace = i;
+            }
+
+            if (seperation <= 0.0f)
+                continue;
+
+            //the center is in front of this face, so the closest point of the hull is on this face or on one of its edges
+            if (projectsOntoFace(worldFace, transform, sphere.center))
+            {
+                if (seperation * seperation < closestDistanceSquared)
+                {
+                    closestDistanceSquared = seperation * seperation;
+                    closestPoint = sphere.center - worldFace.normal * seperation;
+                    closestFace = i;
+                }
+                continue;
+            }
+
+            HalfEdgeEdge* current = worldFace.face->startEdge;
+            do
+            {
+                math::vec3 start = transform * math::vec4(current->edgePosition, 1);
+                math::vec3 end = transform * math::vec4(current->nextEdge->edgePosition, 1);
+
+                math::vec3 closest = ClosestPointOnSegment(start, end, sphere.center);
+                float distanceSquared = math::length2(sphere.center - closest);
+                if (distanceSquared < closestDistanceSquared)
+                {
+                    closestDistanceSquared = distanceSquared;
+                    closestPoint = closest;
+                    closestFace = i;
+                }
+
+                current = current->nextEdge;
+            } while (current != worldFace.face->startEdge);
+        }
+
+        if (deepestFace == -1)
+            return false;
+
+        math::vec3 normal;
+        math::vec3 refPoint;
+        float seperation;
+        int feature;
+
+        if (deepestSeperation <= 0.0f || closestFace == -1)
+        {
+            //the center is inside of the hull, push it out through the face it is closest to
+            normal = worldFaces[deepestFace].normal;
+            refPoint = sphere.center - normal * deepestSeperation;
+            seperation = deepestSeperation - sphere.radius;
+            feature = deepestFace;
+        }
+        else
+        {
+            float distance = math::sqrt(closestDistanceSquared);
+
+            seperation = distance - sphere.radius;
+            if (seperation >= constants::contactOffset)
+                return false;
+
+            normal = distance > math::epsilon<float>() ? (sphere.center - closestPoint) / distance : worldFaces[deepestFace].normal;
+            refPoint = closestPoint;
+            feature = closestFace;
+        }
+
+        collision.normal = normal;
+        collision.seperation = seperation;
+        collision.addContact(refPoint, sphere.center - normal * sphere.radius, feature, 0);
+        return true;
+    }
+
+    bool ShapeCollision::HullCapsule(ConvexCollider* hull, const math::mat4& transform, const world_capsule& capsule,
+        analytic_collision& collision, HalfEdgeFace*& seperatingFace)
+    {
+        seperatingFace = nullptr;
+
+        std::vector<world_face> worldFaces;
+        getWorldFaces(hull, transform, worldFaces);
+
+        float deepestSeperation = std::numeric_limits<float>::lowest();
+        int deepestFace = -1;
+
+        //the segment of the capsule is clipped against the planes of all faces, anything left is inside of the hull
+        float enter = 0.0f;
+        float exit = 1.0f;
+        bool isSegmentInside = true;
+
+        for (int i = 0; i < static_cast<int>(worldFaces.size()); i++)
+        {
+            auto& worldFace = worldFaces[i];
+
+            float startDistance = math::dot(worldFace.normal, capsule.start - worldFace.centroid);
+            float endDistance = math::dot(worldFace.normal, capsule.end - worldFace.centroid);
+            float seperation = math::min(startDistance, endDistance);
+
+            if (seperation - capsule.radius >= constants::contactOffset)
+            {
+                seperatingFace = worldFace.face;
+                return false;
+            }
+
+            if (seperation > deepestSeperation)
+            {
+                deepestSeperation = seperation;
+                deepestFace = i;
+            }
+
+            if (startDistance > 0.0f && endDistance > 0.0f)
+                isSegmentInside = false;
+            else if (startDistance > 0.0f)
+                enter = math::max(enter, startDistance / (startDistance - endDistance));
+            else if (endDistance > 0.0f)
+                exit = math::min(exit, startDistance / (startDistance - endDistance));
+        }
+
+        if (deepestFace == -1)
+            return false;
+
+        isSegmentInside &= enter <= exit;
+
+        const world_face& referenceFace = worldFaces[deepestFace];
+
+        if (isSegmentInside)
+        {
+            if (clipCapsuleAgainstFace(referenceFace, deepestFace, transform, capsule, collision))
+                return true;
+
+            //the segment pokes through the face next to it, push out the deepest end
+            math::vec3 deepestPoint = math::dot(referenceFace.normal, capsule.start - capsule.end) < 0.0f ? capsule.start : capsule.end;
+            float distance = math::dot(referenceFace.normal, deepestPoint - referenceFace.centroid);
+
+            collision.normal = referenceFace.normal;
+            collision.seperation = distance - capsule.radius;
+            collision.addContact(deepestPoint - referenceFace.normal * distance, deepestPoint - referenceFace.normal * capsule.radius, deepestFace, 0);
+            return true;
+        }
+
+        //the segment is outside of the hull, find the closest points between the segment and the surface of the hull
+        float closestDistanceSquared = std::numeric_limits<float>::max();
+        math::vec3 segmentPoint;
+        math::vec3 hullPoint;
+        int closestFace = deepestFace;
+
+        const math::vec3 ends[2] = { capsule.start, capsule.end };
+
+        for (int i = 0; i < static_cast<int>(worldFaces.size()); i++)
+        {
+            auto& worldFace = worldFaces[i];
+
+            bool isInFront = false;
+            for (auto& end : ends)
+            {
+                float distance = math::dot(worldFace.normal, end - worldFace.centroid);
+                if (distance <= 0.0f)
+                    continue;
+
+                isInFront = true;
+                if (distance * distance < closestDistanceSquared && projectsOntoFace(worldFace, transform, end))
+                {
+                    closestDistanceSquared = distance * distance;
+                    segmentPoint = end;
+                    hullPoint = end - worldFace.normal * distance;
+                    closestFace = i;
+                }
+            }
+
+            if (!isInFront)
+                continue;
+
+            HalfEdgeEdge* current = worldFace.face->startEdge;
+            do
+            {
+                math::vec3 start = transform * math::vec4(current->edgePosition, 1);
+                math::vec3 end = transform * math::vec4(current->nextEdge->edgePosition, 1);
+
+                float segmentT, edgeT;
+                math::vec3 closestOnSegment, closestOnEdge;
+                ClosestPointsBetweenSegments(capsule.start, capsule.end, start, end, segmentT, edgeT, closestOnSegment, closestOnEdge);
+
+                float distanceSquared = math::length2(closestOnSegment - closestOnEdge);
+                if (distanceSquared < closestDistanceSquared)
+                {
+                    closestDistanceSquared = distanceSquared;
+                    segmentPoint = closestOnSegment;
+                    hullPoint = closestOnEdge;
+                    closestFace = i;
+                }
+
+                current = current->nextEdge;
+            } while (current != worldFace.face->startEdge);
+        }
+
+        float distance = math::sqrt(closestDistanceSquared);
+        if (distance - capsule.radius >= constants::contactOffset)
+            return false;
+
+        math::vec3 normal = distance > math::epsilon<float>() ? (segmentPoint - hullPoint) / distance : referenceFace.normal;
+
+        //a capsule that lies on a face gets a contact at both ends of the part that is above the face
+        if (math::dot(normal, referenceFace.normal) > 0.999f && clipCapsuleAgainstFace(referenceFace, deepestFace, transform, capsule, collision))
+            return true;
+
+        collision.normal = normal;
+        collision.seperation = distance - capsule.radius;
+        collision.addContact(hullPoint, segmentPoint - normal * capsule.radius, closestFace, 0);
+        return true;
+    }
+
+    bool ShapeCollision::AreBoxesSeperated(const world_box& first, const world_box& second, float margin)
+    {
+        const math::vec3 difference = second.center - first.center;
+
+        auto isSeperatingAxis = [&](const math::vec3& axis)
+        {
+            float firstRadius = 0.0f;
+            float secondRadius = 0.0f;
+            for (int i = 0; i < 3; i++)
+            {
+                firstRadius += first.halfExtents[i] * math::abs(math::dot(first.axes[i], axis));
+                secondRadius += second.halfExtents[i] * math::abs(math::dot(second.axes[i], axis));
+            }
+
+            //the axis isn't normalized, so the margin is scaled with it
+            return math::abs(math::dot(difference, axis)) > firstRadius + secondRadius + margin * math::length(axis);
+        };
+
+        for (int i = 0; i < 3; i++)
+        {
+            if (isSeperatingAxis(first.axes[i]) || isSeperatingAxis(second.axes[i]))
+                return true;
+        }
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                math::vec3 axis = math::cross(first.axes[i], second.axes[j]);
+
+                //parallel edges don't create a new axis, the face axes already covered it
+                if (math::length2(axis) > 1e-6f && isSeperatingAxis(axis))
+                    return true;
+            }
+        }
+
+        return false;
+    }
+
+    float ShapeCollision::GetFaceSeperation(HalfEdgeFace* face, const math::mat4& transform, const world_sphere& sphere)
+    {
+        math::vec3 worldNormal = math::normalize(math::transpose(math::inverse(math::mat3(transform))) * face->normal);
+        math::vec3 worldCentroid = transform * math::vec4(face->centroid, 1);
+
+        return math::dot(worldNormal, sphere.center - worldCentroid) - sphere.radius;
+    }
+
+    float ShapeCollision::GetFaceSeperation(HalfEdgeFace* face, const math::mat4& transform, const world_capsule& capsule)
+    {
+        math::vec3 worldNormal = math::normalize(math::transpose(math::inverse(math::mat3(transform))) * face->normal);
+        math::vec3 worldCentroid = transform * math::vec4(face->centroid, 1);
+
+        return math::min(math::dot(worldNormal, capsule.start - worldCentroid), math::dot(worldNormal, capsule.end - worldCentroid)) - capsule.radius;
+    }
+
+    math::vec3 ShapeCollision::ClosestPointOnSegment(const math::vec3& start, const math::vec3& end, const math::vec3& point)
+    {
+        math::vec3 segment = end - start;
+        float t = math::clamp(math::dot(point - start, segment) / math::max(math::length2(segment), math::epsilon<float>()), 0.0f, 1.0f);
+        return start + segment * t;
+    }
+
+    void ShapeCollision::ClosestPointsBetweenSegments(const math::vec3& firstStart, const math::vec3& firstEnd,
+        const math::vec3& secondStart, const math::vec3& secondEnd,
+        float& firstT, float& secondT, math::vec3& firstClosest, math::vec3& secondClosest)
+    {
+        const math::vec3 firstSegment = firstEnd - firstStart;
+        const math::vec3 secondSegment = secondEnd - secondStart;
+        const math::vec3 startDifference = firstStart - secondStart;
+
+        const float firstLength2 = math::length2(firstSegment);
+        const float secondLength2 = math::length2(secondSegment);
+        const float secondProjection = math::dot(secondSegment, startDifference);
+
+        constexpr float epsilon = 1e-10f;
+
+        if (firstLength2 <= epsilon && secondLength2 <= epsilon)
+        {
+            //both segments are points
+            firstT = 0.0f;
+            secondT = 0.0f;
+        }
+        else if (firstLength2 <= epsilon)
+        {
+            firstT = 0.0f;
+            secondT = math::clamp(secondProjection / secondLength2, 0.0f, 1.0f);
+        }
+        else
+        {
+            const float firstProjection = math::dot(firstSegment, startDifference);
+
+            if (secondLength2 <= epsilon)
+            {
+                secondT = 0.0f;
+                firstT = math::clamp(-firstProjection / firstLength2, 0.0f, 1.0f);
+            }
+            else
+            {
+                const float segmentDot = math::dot(firstSegment, secondSegment);
+                const float denominator = firstLength2 * secondLength2 - segmentDot * segmentDot;
+
+                //parallel segments have infinitely many closest points, any point on the first segment works
+                firstT = denominator > epsilon ? math::clamp((segmentDot * secondProjection - firstProjection * secondLength2) / denominator, 0.0f, 1.0f) : 0.0f;
+                secondT = (segmentDot * firstT + secondProjection) / secondLength2;
+
+                //clamping secondT moves the closest point on the second segment, so the point on the first segment has to be found again
+                if (secondT < 0.0f)
+                {
+                    secondT = 0.0f;
+                    firstT = math::clamp(-firstProjection / firstLength2, 0.0f, 1.0f);
+                }
+                else if (secondT > 1.0f)
+                {
+                    secondT = 1.0f;
+                    firstT = math::clamp((segmentDot - firstProjection) / firstLength2, 0.0f, 1.0f);
+                }
+            }
+        }
+
+        firstClosest = firstStart + firstSegment * firstT;
+        secondClosest = secondStart + secondSegment * secondT;
+    }
+
+    float ShapeCollision::SegmentAABBDistanceSquared(const math::vec3& start, const math::vec3& end, const math::vec3& min, const math::vec3& max)
+    {
+        //slab test, a segment that goes through the box has no distance to it
+        const math::vec3 segment = end - start;
+        float enter = 0.0f;
+        float exit = 1.0f;
+        bool intersects = true;
+
+        for (int i = 0; i < 3 && intersects; i++)
+        {
+            if (math::abs(segment[i]) < math::epsilon<float>())
+            {
+                intersects = start[i] >= min[i] && start[i] <= max[i];
+                continue;
+            }
+
+            float first = (min[i] - start[i]) / segment[i];
+            float second = (max[i] - start[i]) / segment[i];
+            enter = math::max(enter, math::min(first, second));
+            exit = math::min(exit, math::max(first, second));
+            intersects = enter <= exit;
+        }
+
+        if (intersects)
+            return 0.0f;
+
+        //otherwise the closest points are at one of the ends of the segment or on one of the edges of the box
+        float closestDistanceSquared = math::min(
+            math::length2(start - math::clamp(start, min, max)),
+            math::length2(end - math::clamp(end, min, max)));
+
+        auto corner = [&](int index)
+        {
+            return math::vec3(index & 1 ? max.x : min.x, index & 2 ? max.y : min.y, index & 4 ? max.z : min.z);
+        };
+
+        for (int index = 0; index < 8; index++)
+        {
+            for (int axisBit = 1; axisBit < 8; axisBit <<= 1)
+            {
+                if (index & axisBit)
+                    continue;
+
+                float segmentT, edgeT;
+                math::vec3 closestOnSegment, closestOnEdge;
+                ClosestPointsBetweenSegments(start, end, corner(index), corner(index | axisBit), segmentT, edgeT, closestOnSegment, closestOnEdge);
+
+                closestDistanceSquared = math::min(closestDistanceSquared, math::length2(closestOnSegment - closestOnEdge));
+            }
+        }
+
+        return closestDistanceSquared;
+    }
+
+    float ShapeCollision::GetMaxScale(const math::mat4& transform)
+    {
+        return math::max(math::length(math::vec3(transform[0])), math::max(math::length(math::vec3(transform[1])), math::length(math::vec3(transform[2]))));
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <core/core.hpp>
+#include <physics/data/analyticpenetrationquery.hpp>
+
+namespace legion::physics
+{
+    class ConvexCollider;
+    struct HalfEdgeFace;
+
+    /**@struct world_sphere
+     * @brief A sphere in world space.
+     */
+    struct world_sphere
+    {
+        math::vec3 center;
+        float radius;
+    };
+
+    /**@struct world_capsule
+     * @brief A capsule in world space, all points within radius of the segment between start and end.
+     */
+    struct world_capsule
+    {
+        math::vec3 start;
+        math::vec3 end;
+        float radius;
+    };
+
+    /**@struct world_box
+     * @brief An oriented box in world space.
+     */
+    struct world_box
+    {
+        math::vec3 center;
+        //normalized axes of the box
+        math::vec3 axes[3];
+        math::vec3 halfExtents;
+    };
+
+    /**@class ShapeCollision
+     * @brief Closed form collision tests between spheres, capsules, boxes and convex hulls.
+     * All of them write the normal from the first shape towards the second shape, so the first shape is the reference shape.
+     * Shapes that are less than constants::contactOffset apart already count as colliding.
+     */
+    class ShapeCollision
+    {
+    public:
+        static bool SphereSphere(const world_sphere& first, const world_sphere& second, analytic_collision& collision);
+
+        static bool SphereCapsule(const world_sphere& sphere, const world_capsule& capsule, analytic_collision& collision);
+
+        /**@brief Creates two contacts when the capsules lie next to each other, so they can rest on each other.
+         */
+        static bool CapsuleCapsule(const world_capsule& first, const world_capsule& second, analytic_collision& collision);
+
+        /**@brief Finds the closest point on the box in the space of the box. Centers inside of the box are pushed out through the closest face.
+         */
+        static bool BoxSphere(const world_box& box, const world_sphere& sphere, analytic_collision& collision);
+
+        /**@brief Collides a sphere with any convex hull.
+         * @param seperatingFace [out] The face of the hull that seperates the shapes, if the shapes were seperated by a face
+         */
+        static bool HullSphere(ConvexCollider* hull, const math::mat4& transform, const world_sphere& sphere,
+            analytic_collision& collision, HalfEdgeFace*& seperatingFace);
+
+        /**@brief Collides a capsule with any convex hull. A capsule that lies on a face is clipped against that face to create two contacts.
+         * @param seperatingFace [out] The face of the hull that seperates the shapes, if the shapes were seperated by a face
+         */
+        static bool HullCapsule(ConvexCollider* hull, const math::mat4& transform, const world_capsule& capsule,
+            analytic_collision& collision, HalfEdgeFace*& seperatingFace);
+
+        /**@brief Seperating axis test with the 15 axes of two oriented boxes.
+         * @return True if the boxes are further apart than margin
+         */
+        static bool AreBoxesSeperated(const world_box& first, const world_box& second, float margin);
+
+        /**@brief Calculates the distance between a face of a hull and a sphere, used to check if a cached seperating face still seperates them.
+         */
+        static float GetFaceSeperation(HalfEdgeFace* face, const math::mat4& transform, const world_sphere& sphere);
+
+        /**@brief Calculates the distance between a face of a hull and a capsule, used to check if a cached seperating face still seperates them.
+         */
+        static float GetFaceSeperation(HalfEdgeFace* face, const math::mat4& transform, const world_capsule& capsule);
+
+        static math::vec3 ClosestPointOnSegment(const math::vec3& start, const math::vec3& end, const math::vec3& point);
+
+        /**@brief Finds the closest points between the segments [firstStart, firstEnd] and [secondStart, secondEnd].
+         * Unlike PhysicsStatics::FindClosestPointsToLineSegment this handles parallel and degenerate segments.
+         * @param firstT [out] The position of firstClosest along the first segment, in the range [0, 1]
+         * @param secondT [out] The position of secondClosest along the second segment, in the range [0, 1]
+         */
+        static void ClosestPointsBetweenSegments(const math::vec3& firstStart, const math::vec3& firstEnd,
+            const math::vec3& secondStart, const math::vec3& secondEnd,
+            float& firstT, float& secondT, math::vec3& firstClosest, math::vec3& secondClosest);
+
+        static float SegmentAABBDistanceSquared(const math::vec3& start, const math::vec3& end, const math::vec3& min, const math::vec3& max);
+
+        /**@brief Gets the largest scale of a transform, radii of spheres and capsules are scaled by it so they stay round.
+         */
+        static float GetMaxScale(const math::mat4& transform);
+    };
+}
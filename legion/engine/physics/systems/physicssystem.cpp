@@ -1,5 +1,6 @@
 #include <physics/systems/physicssystem.hpp>
 #include <physics/broadphasecollisionalgorithms/broadphaseuniformgridnocaching.hpp>
+#include <physics/broadphasecollisionalgorithms/broadphaseaabbtree.hpp>
 
 namespace legion::physics
 {
@@ -8,18 +9,31 @@ namespace legion::physics
     bool PhysicsSystem::IsPaused = false;
     bool PhysicsSystem::oneTimeRunActive = false;
 
+    SceneQuery PhysicsSystem::m_sceneQuery;
+    async::rw_spinlock PhysicsSystem::m_sceneQueryLock;
+
 
     void PhysicsSystem::setup()
     {
-        createProcess<&PhysicsSystem::fixedUpdate>("Physics", m_timeStep);
+        // Fracturing creates the fragments with their renderables and destroys the fractured entity.
+        createProcess<&PhysicsSystem::fixedUpdate>("Physics", m_timeStep)
+            ->reads<scale, MeshSplitter>()
+            ->writes<position, rotation, rigidbody, physicsComponent, Fracturer, FractureCountdown, mesh_filter, rendering::mesh_renderer>();
+
+        initialize();
+    }
 
+    void PhysicsSystem::initialize()
+    {
         manifoldPrecursorQuery = createQuery<position, rotation, scale, physicsComponent>();
 
         //std::make_unique<BroadphaseUniformGrid>(math::vec3(2,2,2),1);
         //std::make_unique<BroadphaseBruteforce>();
         //std::make_unique<BroadphaseUniformGridNoCaching>(math::vec3(2, 2, 2));
+        //std::make_unique<BroadphaseAABBTree>(0.1f);
+        //std::make_unique<BroadphaseSweepAndPrune>();
 
-        m_broadPhase = std::make_unique<BroadphaseUniformGridNoCaching>(math::vec3(2, 2, 2));
+        m_broadPhase = std::make_unique<BroadphaseAABBTree>();
 
     }
 
@@ -34,117 +48,296 @@ namespace legion::physics
     {
         OPTICK_EVENT();
 
+        time::timer stageTimer;
+
         //-------------------------------------------------Broadphase Optimization-----------------------------------------------//
 
         //get all physics components from the world
         std::vector<physics_manifold_precursor> manifoldPrecursors;
-        bulkRetrievePreManifoldData(physComps, positions, rotations, scales, manifoldPrecursors);
-
-        std::vector<std::vector<physics_manifold_precursor>> manifoldPrecursorGrouping;
-        //m_optimizeBroadPhase(manifoldPrecursors, manifoldPrecursorGrouping);
-        manifoldPrecursorGrouping = m_broadPhase->collectPairs(std::move(manifoldPrecursors));
+        bulkRetrievePreManifoldData(hasRigidBodies, rigidbodies, physComps, positions, rotations, scales, manifoldPrecursors);
 
         //------------------------------------------------------ Narrowphase -----------------------------------------------------//
         std::vector<physics_manifold> manifoldsToSolve;
 
+        //indices into manifoldPrecursors of every pair that needs to be checked, every pair is only in here once
+        std::vector<std::pair<size_type, size_type>> narrowphasePairs;
+
+        //the broadphase might only support groupings, the precursors get copied so the pairs can still refer to the originals
+        const std::vector<std::vector<physics_manifold_precursor>>* manifoldPrecursorGrouping = nullptr;
+
         {
-            OPTICK_EVENT("Narrowphase");
+            //scene queries read the broadphase and the copied colliders, so they have to wait until both are up to date
+            async::readwrite_guard queryGuard(m_sceneQueryLock);
+            m_sceneQuery.update(manifoldPrecursors);
+
+            if (!m_broadPhase->collectUniquePairs(manifoldPrecursors, narrowphasePairs))
+                manifoldPrecursorGrouping = &m_broadPhase->collectPairs(std::vector<physics_manifold_precursor>(manifoldPrecursors));
+        }
+
+        if (manifoldPrecursorGrouping)
+        {
+            OPTICK_EVENT("Flatten groupings");
 
             std::set<std::pair<id_type, id_type>> idPairings;
 
-            size_type totalChecks = 0;
-            for (auto& manifoldPrecursor : manifoldPrecursorGrouping)
+            for (auto& manifoldPrecursor : *manifoldPrecursorGrouping)
             {
                 if (manifoldPrecursor.size() == 0) continue;
-                for (int i = 0; i < manifoldPrecursor.size() - 1; i++)
+                for (size_type i = 0; i < manifoldPrecursor.size() - 1; i++)
                 {
-                    for (int j = i + 1; j < manifoldPrecursor.size(); j++)
+                    for (size_type j = i + 1; j < manifoldPrecursor.size(); j++)
                     {
-                        totalChecks++;
-                        assert(j != manifoldPrecursor.size());
+                        const physics_manifold_precursor& precursorA = manifoldPrecursor.at(i);
+                        const physics_manifold_precursor& precursorB = manifoldPrecursor.at(j);
 
-                        physics_manifold_precursor& precursorA = manifoldPrecursor.at(i);
-                        physics_manifold_precursor& precursorB = manifoldPrecursor.at(j);
+                        //check if we have found this pairing before so we dont solve the collision twice
+                        if (idPairings.insert(std::make_pair(precursorA.id, precursorB.id)).second)
+                            narrowphasePairs.emplace_back(precursorA.id, precursorB.id);
+                    }
+                }
+            }
+        }
 
-                        //check if we have found this pairing before
-                        std::pair<id_type, id_type> precursorPairing = std::make_pair(precursorA.id, precursorB.id);
-                        auto foundPairingIter = idPairings.find(precursorPairing);
+        m_statistics.broadphasePairCount += narrowphasePairs.size();
+        m_statistics.broadphaseTime += stageTimer.restart().milliseconds();
 
-                        if (foundPairingIter != idPairings.end())
-                        {
-                            //early out so we dont solve the collision twice
+        {
+            OPTICK_EVENT("Narrowphase");
+
+            struct narrowphase_buffer
+            {
+                size_type start = 0;
+                std::vector<physics_manifold> manifolds;
+                std::vector<std::pair<ContactCache::key_type, seperating_axis>> seperatingAxes;
+                //pairs that were skipped because nothing can change between them as long as they stay asleep
+                std::vector<size_type> sleepingPairs;
+            };
+
+            //every block of pairs gets its own manifold buffer so the threads don't have to share a single vector.
+            //the buffers get merged in order of their first pair, so the order of the manifolds doesn't depend on how the work got split up
+            std::vector<narrowphase_buffer> manifoldBuffers;
+            async::fast_rw_spinlock bufferLock;
+
+            auto isAsleep = [&](const physics_manifold_precursor& precursor)
+            {
+                return hasRigidBodies[precursor.id] && rigidbodies[precursor.id].isAsleep;
+            };
+
+            //nothing can change between a sleeping rigidbody and something that is either asleep or doesn't have a rigidbody
+            auto isSleepingPair = [&](size_type index)
+            {
+                const physics_manifold_precursor& precursorA = manifoldPrecursors[narrowphasePairs[index].first];
+                const physics_manifold_precursor& precursorB = manifoldPrecursors[narrowphasePairs[index].second];
+
+                bool isAsleepA = isAsleep(precursorA);
+                bool isAsleepB = isAsleep(precursorB);
+
+                return (isAsleepA && (isAsleepB || !hasRigidBodies[precursorB.id])) || (isAsleepB && !hasRigidBodies[precursorA.id]);
+            };
+
+            auto checkPair = [&](size_type index, narrowphase_buffer& manifoldBuffer)
+            {
+                physics_manifold_precursor& precursorA = manifoldPrecursors[narrowphasePairs[index].first];
+                physics_manifold_precursor& precursorB = manifoldPrecursors[narrowphasePairs[index].second];
+
+                auto& precursorPhyCompA = *precursorA.physicsComp;
+                auto& precursorPhyCompB = *precursorB.physicsComp;
+
+                //only construct a manifold if at least one of these requirement are fulfilled
+                //1. One of the physicsComponents is a trigger and the other one is not
+                //2. One of the physicsComponent's entity has a rigidbody and the other one is not a trigger
+                //3. Both have a rigidbody
+
+                bool isBetweenTriggerAndNonTrigger =
+                    (precursorPhyCompA.isTrigger && !precursorPhyCompB.isTrigger) || (!precursorPhyCompA.isTrigger && precursorPhyCompB.isTrigger);
+
+                bool isBetweenRigidbodyAndNonTrigger =
+                    (hasRigidBodies[precursorA.id] && !precursorPhyCompB.isTrigger) || (hasRigidBodies[precursorB.id] && !precursorPhyCompA.isTrigger);
+
+                bool isBetween2Rigidbodies = (hasRigidBodies[precursorA.id] && hasRigidBodies[precursorB.id]);
+
+                if (isBetweenTriggerAndNonTrigger || isBetweenRigidbodyAndNonTrigger || isBetween2Rigidbodies)
+                {
+                    constructManifoldsWithPrecursors(rigidbodies, hasRigidBodies, precursorA, precursorB,
+                        manifoldBuffer.manifolds, manifoldBuffer.seperatingAxes,
+                        hasRigidBodies[precursorA.id] || hasRigidBodies[precursorB.id]
+                        , precursorPhyCompA.isTrigger || precursorPhyCompB.isTrigger);
+                }
+            };
+
+            m_scheduler->queueRangeJobs(0, narrowphasePairs.size(), 0, [&](const async::job_range& range) {
+                narrowphase_buffer manifoldBuffer;
+                manifoldBuffer.start = range.start;
+
+                for (size_type index : range)
+                {
+                    if (isSleepingPair(index))
+                        manifoldBuffer.sleepingPairs.push_back(index);
+                    else
+                        checkPair(index, manifoldBuffer);
+                }
+
+                if (manifoldBuffer.manifolds.empty() && manifoldBuffer.seperatingAxes.empty() && manifoldBuffer.sleepingPairs.empty())
+                    return;
+
+                async::readwrite_guard guard(bufferLock);
+                manifoldBuffers.push_back(std::move(manifoldBuffer));
+                }).wait();
+
+            std::sort(manifoldBuffers.begin(), manifoldBuffers.end(), [](const narrowphase_buffer& lhs, const narrowphase_buffer& rhs)
+                {
+                    return lhs.start < rhs.start;
+                });
+
+            {
+                OPTICK_EVENT("Check pairs of waking rigidbodies");
+
+                std::vector<size_type> sleepingPairs;
+                for (auto& manifoldBuffer : manifoldBuffers)
+                    sleepingPairs.insert(sleepingPairs.end(), manifoldBuffer.sleepingPairs.begin(), manifoldBuffer.sleepingPairs.end());
+
+                //a sleeping rigidbody that touches an awake one can get woken up by its island once the contacts are solved.
+                //its skipped pairs are checked as well, otherwise it would get pushed into whatever it is resting on for a step
+                std::vector<byte> waking(rigidbodies.size(), false);
+                auto markWaking = [&](const std::vector<physics_manifold>& manifolds)
+                {
+                    bool marked = false;
+                    for (auto& manifold : manifolds)
+                    {
+                        if (manifold.physicsCompA->isTrigger || manifold.physicsCompB->isTrigger)
                             continue;
-                        }
-                        else
+
+                        for (rigidbody* rb : { manifold.rigidbodyA, manifold.rigidbodyB })
                         {
-                            idPairings.insert(precursorPairing);
+                            if (!rb || !rb->isAsleep)
+                                continue;
+
+                            byte& flag = waking[static_cast<size_type>(rb - rigidbodies.data())];
+                            marked |= !flag;
+                            flag = true;
                         }
-                       
+                    }
+                    return marked;
+                };
 
-                        auto& precursorPhyCompA = *precursorA.physicsComp;
-                        auto& precursorPhyCompB = *precursorB.physicsComp;
+                bool marked = false;
+                for (auto& manifoldBuffer : manifoldBuffers)
+                    marked |= markWaking(manifoldBuffer.manifolds);
 
-                        auto& precursorRigidbodyA = rigidbodies[precursorA.id];
-                        auto& precursorRigidbodyB = rigidbodies[precursorB.id];
+                //the new contacts can wake up more sleeping rigidbodies, so this repeats until no new ones are found
+                while (marked && !sleepingPairs.empty())
+                {
+                    narrowphase_buffer manifoldBuffer;
+                    manifoldBuffer.start = narrowphasePairs.size() + manifoldBuffers.size();
 
-                        //only construct a manifold if at least one of these requirement are fulfilled
-                        //1. One of the physicsComponents is a trigger and the other one is not
-                        //2. One of the physicsComponent's entity has a rigidbody and the other one is not a trigger
-                        //3. Both have a rigidbody
+                    std::vector<size_type> stillSleeping;
+                    for (size_type index : sleepingPairs)
+                    {
+                        if (waking[manifoldPrecursors[narrowphasePairs[index].first].id] || waking[manifoldPrecursors[narrowphasePairs[index].second].id])
+                            checkPair(index, manifoldBuffer);
+                        else
+                            stillSleeping.push_back(index);
+                    }
 
-                        bool isBetweenTriggerAndNonTrigger =
-                            (precursorPhyCompA.isTrigger && !precursorPhyCompB.isTrigger) || (!precursorPhyCompA.isTrigger && precursorPhyCompB.isTrigger);
+                    sleepingPairs = std::move(stillSleeping);
+                    marked = markWaking(manifoldBuffer.manifolds);
+                    manifoldBuffers.push_back(std::move(manifoldBuffer));
+                }
 
-                        bool isBetweenRigidbodyAndNonTrigger =
-                            (hasRigidBodies[precursorA.id] && !precursorPhyCompB.isTrigger) || (hasRigidBodies[precursorB.id] && !precursorPhyCompA.isTrigger);
+                //pairs that stay asleep keep their cached contacts, so they can be warm started once they wake up
+                for (size_type index : sleepingPairs)
+                {
+                    for (auto& colliderA : manifoldPrecursors[narrowphasePairs[index].first].physicsComp->colliders)
+                        for (auto& colliderB : manifoldPrecursors[narrowphasePairs[index].second].physicsComp->colliders)
+                            m_contactCache.keep(ContactCache::makeKey(colliderA->GetColliderID(), colliderB->GetColliderID()));
+                }
+            }
 
-                        bool isBetween2Rigidbodies = (hasRigidBodies[precursorA.id] && hasRigidBodies[precursorB.id]);
+            size_type manifoldCount = 0;
+            for (auto& manifoldBuffer : manifoldBuffers)
+                manifoldCount += manifoldBuffer.manifolds.size();
 
+            manifoldsToSolve.reserve(manifoldCount);
 
-                        if (isBetweenTriggerAndNonTrigger || isBetweenRigidbodyAndNonTrigger || isBetween2Rigidbodies)
-                        {
-                            constructManifoldsWithPrecursors(rigidbodies, hasRigidBodies, precursorA, precursorB,
-                                manifoldsToSolve,
-                                hasRigidBodies[precursorA.id] || hasRigidBodies[precursorB.id]
-                                , precursorPhyCompA.isTrigger || precursorPhyCompB.isTrigger);
-                        }
+            //the cache isn't read anymore until the solver runs, so the seperating axes found this step can be stored now
+            for (auto& manifoldBuffer : manifoldBuffers)
+                for (auto& [key, axis] : manifoldBuffer.seperatingAxes)
+                    m_contactCache.storeSeperatingAxis(key, axis);
+
+            //events are raised from this thread so subscribers don't get called from the workers.
+            //they go out in one batch per type, so the subscribers are only looked up once
+            std::vector<trigger_event> triggerEvents;
+            std::vector<collision_event> collisionEvents;
+            collisionEvents.reserve(manifoldCount);
+
+            for (auto& manifoldBuffer : manifoldBuffers)
+            {
+                for (auto& manifold : manifoldBuffer.manifolds)
+                {
+                    if (manifold.physicsCompA->isTrigger || manifold.physicsCompB->isTrigger)
+                    {
+                        //notify the event-bus
+                        triggerEvents.emplace_back(&manifold, m_timeStep);
+                        //notify both the trigger and triggerer
+                        //TODO:(Developer-The-Great): the triggerer and trigger should probably received this event
+                        //TODO:(cont.) through the event bus, we should probably create a filterable system here to
+                        //TODO:(cont.) uniquely identify involved objects and then redirect only required messages
                     }
+                    else
+                        collisionEvents.emplace_back(&manifold, m_timeStep);
                 }
             }
-            //log::debug("groupings {}", manifoldPrecursorGrouping.size());
-            //log::debug("total checks {}", totalChecks);
+
+            m_eventBus->raiseEvents(std::move(triggerEvents));
+            m_eventBus->raiseEvents(std::move(collisionEvents));
+
+            //the events point into the buffers, so the manifolds can only be moved once they've been delivered
+            for (auto& manifoldBuffer : manifoldBuffers)
+                for (auto& manifold : manifoldBuffer.manifolds)
+                    if (!manifold.physicsCompA->isTrigger && !manifold.physicsCompB->isTrigger)
+                        manifoldsToSolve.emplace_back(std::move(manifold));
         }
 
+        m_statistics.manifoldCount += manifoldsToSolve.size();
+        for (auto& manifold : manifoldsToSolve)
+            m_statistics.contactCount += manifold.contacts.size();
+
+        m_statistics.narrowphaseTime += stageTimer.restart().milliseconds();
+
         //------------------------------------------------ Pre Collision Solve Events --------------------------------------------//
 
 
             //explosion event
         auto countdownQuery = createQuery<FractureCountdown>();
-        countdownQuery.queryEntities();
+        std::vector<ecs::entity_handle> explodingEntities;
 
-        for (auto ent : countdownQuery)
         {
-            auto fractureCountdown = ent.read_component<FractureCountdown>();
-            fractureCountdown.fractureTime -= 0.02f;
-            //log::debug(" fractureCountdown.fractureTime {}", fractureCountdown.fractureTime);
-
-            if (fractureCountdown.explodeNow || fractureCountdown.fractureTime < 0.0f)
-            {
-                log::debug("Entity is exploding");
+            //count down in place, fractures are requested after the view released the component locks
+            auto countdowns = countdownQuery.view<FractureCountdown>();
+            countdowns.for_each([&](ecs::entity_handle ent, FractureCountdown& fractureCountdown)
+                {
+                    fractureCountdown.fractureTime -= 0.02f;
+                    //log::debug(" fractureCountdown.fractureTime {}", fractureCountdown.fractureTime);
 
-                auto fracturerH = ent.get_component_handle<Fracturer>();
-                auto fracturer = fracturerH.read();
-                log::debug("fractureCountdown.explosionPoint {} ", fractureCountdown.explosionPoint);
-                log::debug("fractureCountdown.fractureStrength {} ", fractureCountdown.fractureStrength);
-                FractureParams params(fractureCountdown.explosionPoint, fractureCountdown.fractureStrength);
+                    if (fractureCountdown.explodeNow || fractureCountdown.fractureTime < 0.0f)
+                        explodingEntities.push_back(ent);
+                });
+        }
 
-                fracturer.ExplodeEntity(ent, params);
+        for (auto ent : explodingEntities)
+        {
+            auto fractureCountdown = ent.read_component<FractureCountdown>();
+            log::debug("Entity is exploding");
 
-                fracturerH.write(fracturer);
+            auto fracturerH = ent.get_component_handle<Fracturer>();
+            auto fracturer = fracturerH.read();
+            log::debug("fractureCountdown.explosionPoint {} ", fractureCountdown.explosionPoint);
+            log::debug("fractureCountdown.fractureStrength {} ", fractureCountdown.fractureStrength);
+            FractureParams params(fractureCountdown.explosionPoint, fractureCountdown.fractureStrength);
 
-            }
+            queueFracture(fracturer.RequestFracture(ent, params));
 
-            ent.write_component(fractureCountdown);
+            fracturerH.write(fracturer);
         }
 
 
@@ -173,7 +366,7 @@ namespace legion::physics
                 {
                     auto fracturerA = fracturerHandleA.read();
                     //log::debug(" A is fracturable");
-                    fracturerA.HandleFracture(manifold, currentManifoldValidity, true);
+                    queueFracture(fracturerA.HandleFracture(manifold, currentManifoldValidity, true));
 
                     fracturerHandleA.write(fracturerA);
                 }
@@ -184,7 +377,7 @@ namespace legion::physics
                 {
                     auto fracturerB = fracturerHandleB.read();
                     //log::debug(" B is fracturable");
-                    fracturerB.HandleFracture(manifold, currentManifoldValidity, false);
+                    queueFracture(fracturerB.HandleFracture(manifold, currentManifoldValidity, false));
 
                     fracturerHandleB.write(fracturerB);
                 }
@@ -192,6 +385,9 @@ namespace legion::physics
                 manifoldValidity.at(i) = currentManifoldValidity;
             }
         }
+
+        m_statistics.fractureTime += stageTimer.restart().milliseconds();
+
         //-------------------------------------------------- Collision Solver ---------------------------------------------------//
         //for both contact and friction resolution, an iterative algorithm is used.
         //Everytime physics_contact::resolveContactConstraint is called, the rigidbodies in question get closer to the actual
@@ -205,55 +401,261 @@ namespace legion::physics
         {
             OPTICK_EVENT("Resolve collisions");
 
-            initializeManifolds(manifoldsToSolve, manifoldValidity);
+            std::vector<std::vector<size_type>> islands;
+            buildIslands(manifoldsToSolve, manifoldValidity, islands);
+            m_statistics.islandCount += islands.size();
+
+            {
+                OPTICK_EVENT("Solve islands");
+
+                //islands don't share rigidbodies so they can be solved at the same time,
+                //within an island the manifolds are still solved one after the other like before
+                m_scheduler->queueRangeJobs(0, islands.size(), 0, [&](const async::job_range& range) {
+                    for (size_type islandIndex : range)
+                    {
+                        auto& island = islands[islandIndex];
+
+                        initializeManifolds(manifoldsToSolve, island);
+
+                        //resolve contact constraint
+                        for (size_t contactIter = 0;
+                            contactIter < constants::contactSolverIterationCount; contactIter++)
+                        {
+                            resolveContactConstraint(manifoldsToSolve, island, deltaTime, contactIter);
+                        }
+
+                        //resolve friction constraint
+                        for (size_t frictionIter = 0;
+                            frictionIter < constants::frictionSolverIterationCount; frictionIter++)
+                        {
+                            resolveFrictionConstraint(manifoldsToSolve, island);
+                        }
+                    }
+                    }).wait();
+            }
+
+            updateSleepState(hasRigidBodies, rigidbodies, positions, rotations, manifoldsToSolve, islands, deltaTime);
 
             {
-                OPTICK_EVENT("Resolve contact constraints");
+                OPTICK_EVENT("Update contact cache");
 
-                //resolve contact constraint
-                for (size_t contactIter = 0;
-                    contactIter < constants::contactSolverIterationCount; contactIter++)
+                //remember the lambdas of this time step so the next step can start from them
+                for (auto& manifold : manifoldsToSolve)
                 {
-                    resolveContactConstraint(manifoldsToSolve, manifoldValidity, deltaTime, contactIter);
+                    m_contactCache.storeContacts(manifold);
                 }
+
+                m_contactCache.nextStep();
             }
+        }
+
+        m_statistics.solverTime += stageTimer.end().milliseconds();
+    }
+
+    void PhysicsSystem::queueFracture(const std::shared_ptr<fracture_task>& task)
+    {
+        if (!task)
+            return;
+
+        Fracturer::QueueFractureJobs(task, *m_scheduler);
+        m_fractureTasks.push_back(task);
+    }
+
+    void PhysicsSystem::commitFinishedFractures()
+    {
+        OPTICK_EVENT();
+
+        auto finished = std::stable_partition(m_fractureTasks.begin(), m_fractureTasks.end(),
+            [](const std::shared_ptr<fracture_task>& task) { return !task->IsDone(); });
+
+        for (auto it = finished; it != m_fractureTasks.end(); ++it)
+            Fracturer::CommitFracture(**it);
+
+        m_fractureTasks.erase(finished, m_fractureTasks.end());
+    }
+
+    void PhysicsSystem::waitForFractures() const
+    {
+        OPTICK_EVENT();
+
+        for (auto& task : m_fractureTasks)
+        {
+            while (!task->IsDone())
+                std::this_thread::yield();
+        }
+    }
+
+    void PhysicsSystem::buildIslands(std::vector<physics_manifold>& manifoldsToSolve, std::vector<byte>& manifoldValidity, std::vector<std::vector<size_type>>& islands)
+    {
+        OPTICK_EVENT();
+
+        //union-find over the manifolds, every manifold starts in its own set
+        std::vector<size_type> parents(manifoldsToSolve.size());
+        for (size_type i = 0; i < parents.size(); i++)
+            parents[i] = i;
 
+        auto findRoot = [&](size_type index)
+        {
+            while (parents[index] != index)
             {
-                OPTICK_EVENT("Resolve friction constraints");
+                parents[index] = parents[parents[index]];
+                index = parents[index];
+            }
+            return index;
+        };
+
+        //first manifold that was found for every rigidbody, all other manifolds of that rigidbody get merged with it
+        std::unordered_map<rigidbody*, size_type> rigidbodyManifolds;
+
+        auto connect = [&](rigidbody* rb, size_type manifoldIndex)
+        {
+            //entities without a rigidbody don't get moved by the solver, so they don't connect islands
+            if (!rb)
+                return;
+
+            auto [iter, inserted] = rigidbodyManifolds.emplace(rb, manifoldIndex);
+            if (inserted)
+                return;
+
+            size_type rootA = findRoot(iter->second);
+            size_type rootB = findRoot(manifoldIndex);
+            if (rootA != rootB)
+                parents[math::max(rootA, rootB)] = math::min(rootA, rootB);
+        };
+
+        for (size_type i = 0; i < manifoldsToSolve.size(); i++)
+        {
+            if (!manifoldValidity[i])
+                continue;
+
+            connect(manifoldsToSolve[i].rigidbodyA, i);
+            connect(manifoldsToSolve[i].rigidbodyB, i);
+        }
 
-                //resolve friction constraint
-                for (size_t frictionIter = 0;
-                    frictionIter < constants::frictionSolverIterationCount; frictionIter++)
+        //collect the manifolds of every island in their original order
+        std::unordered_map<size_type, size_type> islandOfRoot;
+        islands.clear();
+
+        for (size_type i = 0; i < manifoldsToSolve.size(); i++)
+        {
+            if (!manifoldValidity[i])
+                continue;
+
+            auto [iter, inserted] = islandOfRoot.emplace(findRoot(i), islands.size());
+            if (inserted)
+                islands.emplace_back();
+
+            islands[iter->second].push_back(i);
+        }
+
+        //the largest islands take the longest to solve, so they should be picked up first
+        std::stable_sort(islands.begin(), islands.end(), [](const std::vector<size_type>& lhs, const std::vector<size_type>& rhs)
+            {
+                return lhs.size() > rhs.size();
+            });
+    }
+
+    void PhysicsSystem::updateSleepState(std::vector<byte>& hasRigidBodies, ecs::component_container<rigidbody>& rigidbodies,
+        ecs::component_container<position>& positions, ecs::component_container<rotation>& rotations,
+        std::vector<physics_manifold>& manifoldsToSolve, std::vector<std::vector<size_type>>& islands, float deltaTime)
+    {
+        if constexpr (!constants::enableSleeping)
+            return;
+
+        OPTICK_EVENT();
+
+        constexpr float linearThresholdSquared = constants::sleepLinearVelocityThreshold * constants::sleepLinearVelocityThreshold;
+        constexpr float angularThresholdSquared = constants::sleepAngularVelocityThreshold * constants::sleepAngularVelocityThreshold;
+
+        //the timers only count how long every rigidbody has been at rest, falling asleep is decided per island
+        m_scheduler->queueRangeJobs(0, rigidbodies.size(), 0, [&](const async::job_range& range) {
+            for (size_type index : range)
+            {
+                if (!hasRigidBodies[index] || rigidbodies[index].isAsleep)
+                    continue;
+
+                auto& rb = rigidbodies[index];
+
+                if (math::length2(rb.velocity) > linearThresholdSquared || math::length2(rb.angularVelocity) > angularThresholdSquared)
                 {
-                    resolveFrictionConstraint(manifoldsToSolve, manifoldValidity);
+                    rb.sleepTimer = 0.0f;
+                    continue;
                 }
+
+                rb.sleepTimer += deltaTime;
             }
+            }).wait();
+
+        //rigidbodies that touch can only sleep together, an island stays awake as long as one of its rigidbodies isn't sleepy.
+        //every rigidbody is part of at most one island, so the islands can write the flags of their rigidbodies in parallel
+        std::vector<byte> keepAwake(rigidbodies.size(), false);
+        std::atomic_bool sleepStateChanged{ false };
 
+        m_scheduler->queueRangeJobs(0, islands.size(), 0, [&](const async::job_range& range) {
+            for (size_type islandIndex : range)
             {
-                OPTICK_EVENT("Converge manifolds");
+                auto& island = islands[islandIndex];
 
-                //reset convergance identifiers for all colliders
-                for (auto& manifold : manifoldsToSolve)
+                auto isSleepy = [](rigidbody* rb) { return !rb || rb->isAsleep || rb->isSleepy(); };
+
+                bool islandIsSleepy = true;
+                for (size_type manifoldIndex : island)
                 {
-                    manifold.colliderA->converganceIdentifiers.clear();
-                    manifold.colliderB->converganceIdentifiers.clear();
+                    auto& manifold = manifoldsToSolve[manifoldIndex];
+                    if (!isSleepy(manifold.rigidbodyA) || !isSleepy(manifold.rigidbodyB))
+                    {
+                        islandIsSleepy = false;
+                        break;
+                    }
                 }
 
-                //using the known lambdas of this time step, add it as a convergance identifier
-                for (auto& manifold : manifoldsToSolve)
+                if (islandIsSleepy)
+                    continue;
+
+                //the rigidbodies are only kept awake by their island, so their own timers keep running
+                for (size_type manifoldIndex : island)
                 {
-                    for (auto& contact : manifold.contacts)
+                    auto& manifold = manifoldsToSolve[manifoldIndex];
+                    for (rigidbody* rb : { manifold.rigidbodyA, manifold.rigidbodyB })
                     {
-                        contact.refCollider->AddConverganceIdentifier(contact);
+                        if (!rb)
+                            continue;
+
+                        if (rb->isAsleep)
+                        {
+                            rb->isAsleep = false;
+                            sleepStateChanged.store(true, std::memory_order_relaxed);
+                        }
+                        keepAwake[static_cast<size_type>(rb - rigidbodies.data())] = true;
                     }
                 }
             }
-        }
+            }).wait();
+
+        //rigidbodies that are sleepy and not kept awake by their island fall asleep, rigidbodies without contacts are islands of their own
+        m_scheduler->queueRangeJobs(0, rigidbodies.size(), 0, [&](const async::job_range& range) {
+            for (size_type index : range)
+            {
+                if (!hasRigidBodies[index] || keepAwake[index])
+                    continue;
+
+                auto& rb = rigidbodies[index];
+                if (!rb.isAsleep && rb.isSleepy())
+                {
+                    rb.sleep(positions[index], rotations[index]);
+                    sleepStateChanged.store(true, std::memory_order_relaxed);
+                }
+            }
+            }).wait();
 
+        //the awake rigidbodies only need to be collected again for the transform integration if any of them changed
+        if (sleepStateChanged.load(std::memory_order_relaxed))
+            m_rigidbodyStore.markDirty();
     }
 
     void PhysicsSystem::constructManifoldsWithPrecursors(ecs::component_container<rigidbody>& rigidbodies, std::vector<byte>& hasRigidBodies, physics_manifold_precursor& precursorA, physics_manifold_precursor& precursorB,
-        std::vector<physics_manifold>& manifoldsToSolve, bool isRigidbodyInvolved, bool isTriggerInvolved)
+        std::vector<physics_manifold>& manifolds, std::vector<std::pair<ContactCache::key_type, seperating_axis>>& seperatingAxes,
+        bool isRigidbodyInvolved, bool isTriggerInvolved)
     {
         OPTICK_EVENT();
         if (!precursorA.physicsComp || !precursorB.physicsComp) return;
@@ -266,30 +668,27 @@ namespace legion::physics
         {
             for (auto colliderB : physicsComponentB.colliders)
             {
+                ContactCache::key_type key = ContactCache::makeKey(colliderA->GetColliderID(), colliderB->GetColliderID());
+
                 physics::physics_manifold m;
+                if (auto cached = m_contactCache.find(key.first, key.second))
+                    m.cachedSeperatingAxis = cached->seperatingAxis;
+
                 constructManifoldWithCollider(rigidbodies, hasRigidBodies, colliderA.get(), colliderB.get(), precursorA, precursorB, m);
 
                 if (!m.isColliding)
                 {
+                    if (m.seperatingAxis.isValid())
+                        seperatingAxes.emplace_back(key, m.seperatingAxis);
                     continue;
                 }
 
                 colliderA->PopulateContactPoints(colliderB.get(), m);
 
-                if (isTriggerInvolved)
-                {
-                    //notify the event-bus
-                    raiseEvent<trigger_event>(&m, m_timeStep);
-                    //notify both the trigger and triggerer
-                    //TODO:(Developer-The-Great): the triggerer and trigger should probably received this event
-                    //TODO:(cont.) through the event bus, we should probably create a filterable system here to
-                    //TODO:(cont.) uniquely identify involved objects and then redirect only required messages
-                }
-
-                if (isRigidbodyInvolved && !isTriggerInvolved)
+                //events are raised once all pairs are checked, trigger manifolds are kept until then as well
+                if (isTriggerInvolved || isRigidbodyInvolved)
                 {
-                    raiseEvent<collision_event>(&m, m_timeStep);
-                    manifoldsToSolve.emplace_back(std::move(m));
+                    manifolds.emplace_back(std::move(m));
                 }
             }
         }
@@ -3,9 +3,14 @@
 #include <physics/broadphasecollisionalgorithms/broadphasecollisionalgorithm.hpp>
 #include <physics/broadphasecollisionalgorithms/broadphaseuniformgrid.hpp>
 #include <physics/broadphasecollisionalgorithms/broadphasebruteforce.hpp>
+#include <physics/broadphasecollisionalgorithms/broadphaseaabbtree.hpp>
+#include <physics/broadphasecollisionalgorithms/broadphasesweepandprune.hpp>
 #include <physics/components/rigidbody.hpp>
 #include <physics/data/physics_manifold_precursor.hpp>
 #include <physics/data/physics_manifold.hpp>
+#include <physics/data/rigidbody_store.hpp>
+#include <physics/data/physics_statistics.hpp>
+#include <physics/data/scene_query.hpp>
 #include <physics/physics_contact.hpp>
 #include <physics/components/physics_component.hpp>
 #include <physics/data/identifier.hpp>
@@ -35,7 +40,24 @@ namespace legion::physics
         //TODO move implementation to a seperate cpp file
 
         virtual void setup();
-     
+
+        /**@brief Sets up the queries and the broadphase without creating the physics process.
+         * The system then only steps when fixedUpdate is called, which is how the physics benchmark drives it at a fixed time step.
+         */
+        void initialize();
+
+        /**@brief Blocks until the job system is done with every fracture that is being processed, so the next step commits all of them.
+         * This makes fractures independent of how busy the job system is, which the physics benchmark needs to be deterministic.
+         */
+        void waitForFractures() const;
+
+        /**@brief Timings and counts of the last step. Only read them from the thread that calls fixedUpdate.
+         */
+        L_NODISCARD const physics_statistics& getStatistics() const noexcept
+        {
+            return m_statistics;
+        }
+
 
         void fixedUpdate(time::time_span<fast_time> deltaTime)
         {
@@ -46,6 +68,14 @@ namespace legion::physics
             //static time::timer pt;
             //log::debug("frametime: {}ms", pt.restart().milliseconds());
 
+            m_statistics = physics_statistics();
+            time::timer stepTimer;
+            time::timer stageTimer;
+
+            //fractures that were processed in the background replace their entities before the data gets fetched
+            commitFinishedFractures();
+            m_statistics.fractureTime += stageTimer.restart().milliseconds();
+
             ecs::component_container<rigidbody> rigidbodies;
             std::vector<byte> hasRigidBodies;
 
@@ -56,17 +86,25 @@ namespace legion::physics
                 rigidbodies.resize(manifoldPrecursorQuery.size());
                 hasRigidBodies.resize(manifoldPrecursorQuery.size());
 
-                m_scheduler->queueJobs(manifoldPrecursorQuery.size(), [&]() {
-                    id_type index = async::this_job::get_id();
-                    auto entity = manifoldPrecursorQuery[index];
-                    if (entity.has_component<rigidbody>())
+                //the local view keeps the indices in line with the component containers that queryEntities just filled
+                manifoldPrecursorQuery.parallel_for(manifoldPrecursorQuery.localView<const position, const rotation>(), 0,
+                    [&](size_type index, ecs::entity_handle entity, const position& pos, const rotation& rot)
                     {
-                        hasRigidBodies[index] = true;
-                        rigidbodies[index] = entity.read_component<rigidbody>();
-                    }
-                    else
-                        hasRigidBodies[index] = false;
-                    }).wait();
+                        if (entity.has_component<rigidbody>())
+                        {
+                            hasRigidBodies[index] = true;
+                            rigidbodies[index] = entity.read_component<rigidbody>();
+
+                            //a sleeping rigidbody whose entity got moved by something else than the physics system has to wake up
+                            auto& rb = rigidbodies[index];
+                            if (rb.isAsleep && (math::vec3(pos) != rb.sleepPosition || math::quat(rot) != rb.sleepRotation))
+                                rb.wakeUp();
+                        }
+                        else
+                            hasRigidBodies[index] = false;
+                    });
+
+                m_statistics.dataTime += stageTimer.restart().milliseconds();
             }
 
             auto& physComps = manifoldPrecursorQuery.get<physicsComponent>();
@@ -92,20 +130,29 @@ namespace legion::physics
 
             {
                 OPTICK_EVENT("Writing data");
-                m_scheduler->queueJobs(manifoldPrecursorQuery.size(), [&]() {
-                    id_type index = async::this_job::get_id();
-                    if (hasRigidBodies[index])
+                stageTimer.start();
+                m_scheduler->queueRangeJobs(0, manifoldPrecursorQuery.size(), 0, [&](const async::job_range& range) {
+                    for (size_type index : range)
                     {
-                        auto entity = manifoldPrecursorQuery[index];
-                        entity.write_component(rigidbodies[index]);
+                        if (hasRigidBodies[index])
+                        {
+                            auto entity = manifoldPrecursorQuery[index];
+                            entity.write_component(rigidbodies[index]);
+                        }
                     }
                     }).wait();
 
                     manifoldPrecursorQuery.submit<physicsComponent>();
                     manifoldPrecursorQuery.submit<position>();
                     manifoldPrecursorQuery.submit<rotation>();
+
+                m_statistics.dataTime += stageTimer.restart().milliseconds();
             }
 
+            m_statistics.physicsComponentCount = manifoldPrecursorQuery.size();
+            m_statistics.pendingFractureCount = m_fractureTasks.size();
+            m_statistics.totalTime = stepTimer.end().milliseconds();
+
            /* auto splitterDrawQuery = createQuery<MeshSplitter>();
             splitterDrawQuery.queryEntities();
 
@@ -130,6 +177,8 @@ namespace legion::physics
         }
 
         void bulkRetrievePreManifoldData(
+            std::vector<byte>& hasRigidBodies,
+            ecs::component_container<rigidbody>& rigidbodies,
             ecs::component_container<physicsComponent>& physComps,
             ecs::component_container<position>& positions,
             ecs::component_container<rotation>& rotations,
@@ -139,26 +188,82 @@ namespace legion::physics
             OPTICK_EVENT();
             manifoldPrecursors.resize(physComps.size());
 
-            m_scheduler->queueJobs(physComps.size(), [&]() {
-                id_type index = async::this_job::get_id();
-                math::mat4 transf;
-                math::compose(transf, scales[index], rotations[index], positions[index]);
+            m_scheduler->queueRangeJobs(0, physComps.size(), 0, [&](const async::job_range& range) {
+                for (size_type index : range)
+                {
+                    math::mat4 transf;
+                    math::compose(transf, scales[index], rotations[index], positions[index]);
 
-                for (auto& collider : physComps[index].colliders)
-                    collider->UpdateTransformedTightBoundingVolume(transf);
+                    //sleeping rigidbodies haven't moved, so their bounds are still valid
+                    if (!hasRigidBodies[index] || !rigidbodies[index].isAsleep)
+                        for (auto& collider : physComps[index].colliders)
+                            collider->UpdateTransformedTightBoundingVolume(transf);
 
-                manifoldPrecursors[index] = { transf, &physComps[index], index, manifoldPrecursorQuery[index] };
+                    manifoldPrecursors[index] = { transf, &physComps[index], index, manifoldPrecursorQuery[index] };
+                }
                 }).wait();
         }
 
         /**@brief Sets the broad phase collision detection method
          * Use BroadPhaseBruteForce to not use any broad phase collision detection
+         * Use BroadphaseSweepAndPrune for dense scenes with lots of small moving objects, like fracture debris
          */
         template <typename BroadPhaseType, typename ...Args>
         static void setBroadPhaseCollisionDetection(Args&& ...args)
         {
             static_assert(std::is_base_of_v<BroadPhaseCollisionAlgorithm, BroadPhaseType>, "Broadphase type did not inherit from BroadPhaseCollisionAlgorithm");
+            async::readwrite_guard guard(m_sceneQueryLock);
             m_broadPhase = std::make_unique<BroadPhaseType>(std::forward<Args>(args)...);
+            //the new broadphase doesn't know any of the physics components yet, queries will work again after the next step
+            m_sceneQuery.clear();
+        }
+
+        /**@brief Finds the closest collider hit by a ray, using the state of the colliders during the last physics step.
+         * @param hit [out] the closest hit, only changed when the ray hit something
+         * @return Whether the ray hit anything
+         */
+        static bool raycast(const ray& query, raycast_hit& hit)
+        {
+            async::readonly_guard guard(m_sceneQueryLock);
+            return m_broadPhase && m_sceneQuery.raycast(*m_broadPhase, query, hit);
+        }
+
+        /**@brief Casts a batch of rays in parallel on the job pool, using the state of the colliders during the last physics step.
+         * @param hits [out] the closest hit of every ray, in the same order as the rays. Rays that didn't hit anything have no collider.
+         */
+        static void raycastMany(const std::vector<ray>& queries, std::vector<raycast_hit>& hits)
+        {
+            OPTICK_EVENT();
+            hits.assign(queries.size(), raycast_hit());
+
+            async::readonly_guard guard(m_sceneQueryLock);
+            if (!m_broadPhase)
+                return;
+
+            m_scheduler->queueRangeJobs(0, queries.size(), 0, [&](const async::job_range& range) {
+                for (size_type index : range)
+                    m_sceneQuery.raycast(*m_broadPhase, queries[index], hits[index]);
+                }).wait();
+        }
+
+        /**@brief Finds all entities with a collider that overlaps the sphere, using the state of the colliders during the last physics step.
+         * @param entities [out] every overlapping entity is added once
+         */
+        static void overlapSphere(const math::vec3& center, float radius, std::vector<ecs::entity_handle>& entities)
+        {
+            async::readonly_guard guard(m_sceneQueryLock);
+            if (m_broadPhase)
+                m_sceneQuery.overlapSphere(*m_broadPhase, center, radius, entities);
+        }
+
+        /**@brief Finds all entities with a collider that overlaps the AABB, using the state of the colliders during the last physics step.
+         * @param entities [out] every overlapping entity is added once
+         */
+        static void overlapAABB(const math::vec3& min, const math::vec3& max, std::vector<ecs::entity_handle>& entities)
+        {
+            async::readonly_guard guard(m_sceneQueryLock);
+            if (m_broadPhase)
+                m_sceneQuery.overlapAABB(*m_broadPhase, min, max, entities);
         }
 
         static void drawBroadPhase()
@@ -169,8 +274,18 @@ namespace legion::physics
     private:
 
         static std::unique_ptr<BroadPhaseCollisionAlgorithm> m_broadPhase;
+
+        static SceneQuery m_sceneQuery;
+        static async::rw_spinlock m_sceneQueryLock;
         const float m_timeStep = 0.02f;
 
+        ContactCache m_contactCache;
+        RigidbodyStore m_rigidbodyStore;
+        physics_statistics m_statistics;
+
+        //fractures that are being processed by the job system, the fractured entities keep being simulated until they're done
+        std::vector<std::shared_ptr<fracture_task>> m_fractureTasks;
+
 
         math::ivec3 uniformGridCellSize = math::ivec3(1, 1, 1);
 
@@ -187,13 +302,16 @@ namespace legion::physics
             float deltaTime);
        
         /**@brief given 2 physics_manifold_precursors precursorA and precursorB, create a manifold for each collider in precursorA
-        * with every other collider in precursorB. The manifolds that involve rigidbodies are then pushed into the given manifold list
-        * @param manifoldsToSolve [out] a std::vector of physics_manifold that will store the manifolds created
+        * with every other collider in precursorB. The colliding manifolds that involve rigidbodies or triggers are then pushed into the given manifold list
+        * @note Doesn't raise any events and only reads from the contact cache, so it's safe to call for different pairs from multiple threads.
+        * @param manifolds [out] a std::vector of physics_manifold that will store the manifolds created
+        * @param seperatingAxes [out] the faces that seperated the pairs of colliders that aren't colliding, to be stored in the contact cache
         * @param isRigidbodyInvolved A bool that indicates whether a rigidbody is involved in this manifold
         * @param isTriggerInvolved A bool that indicates whether a physicsComponent with a physicsComponent::isTrigger set to true is involved in this manifold
         */
         void constructManifoldsWithPrecursors(ecs::component_container<rigidbody>& rigidbodies, std::vector<byte>& hasRigidBodies, physics_manifold_precursor& precursorA, physics_manifold_precursor& precursorB,
-            std::vector<physics_manifold>& manifoldsToSolve, bool isRigidbodyInvolved, bool isTriggerInvolved);
+            std::vector<physics_manifold>& manifolds, std::vector<std::pair<ContactCache::key_type, seperating_axis>>& seperatingAxes,
+            bool isRigidbodyInvolved, bool isTriggerInvolved);
        
 
         void constructManifoldWithCollider(
@@ -230,29 +348,22 @@ namespace legion::physics
             colliderA->CheckCollision(colliderB, manifold);
         }
 
-        /** @brief gets all the entities with a rigidbody component and calls the integrate function on them
+        /** @brief Applies gravity and the accumulated forces of all awake rigidbodies to their velocities, in batches using the RigidbodyStore.
         */
         void integrateRigidbodies(std::vector<byte>& hasRigidBodies, ecs::component_container<rigidbody>& rigidbodies, float deltaTime)
         {
             OPTICK_EVENT();
-            m_scheduler->queueJobs(manifoldPrecursorQuery.size(), [&]() {
-                if (!hasRigidBodies[async::this_job::get_id()])
-                    return;
-
-                auto& rb = rigidbodies[async::this_job::get_id()];
-
-                ////-------------------- update velocity ------------------//
-                math::vec3 acc = rb.forceAccumulator * rb.inverseMass;
-                rb.velocity += (acc + constants::gravity) * deltaTime;
-
-                ////-------------------- update angular velocity ------------------//
-                math::vec3 angularAcc = rb.torqueAccumulator * rb.globalInverseInertiaTensor;
-                rb.angularVelocity += (angularAcc)*deltaTime;
-
-                rb.resetAccumulators();
+            time::timer integrationTimer;
+            m_rigidbodyStore.collect(hasRigidBodies, rigidbodies);
+            m_statistics.awakeRigidbodyCount = m_rigidbodyStore.size();
+            m_scheduler->queueRangeJobs(0, m_rigidbodyStore.batchCount(), 0, [&](const async::job_range& range) {
+                m_rigidbodyStore.integrateVelocities(range, rigidbodies, deltaTime);
                 }).wait();
+            m_statistics.integrationTime += integrationTimer.end().milliseconds();
         }
 
+        /** @brief Moves and rotates the entities of all awake rigidbodies by their velocities, in batches using the RigidbodyStore.
+        */
         void integrateRigidbodyQueryPositionAndRotation(
             std::vector<byte>& hasRigidBodies,
             ecs::component_container<position>& positions,
@@ -261,91 +372,75 @@ namespace legion::physics
             float deltaTime)
         {
             OPTICK_EVENT();
-            m_scheduler->queueJobs(manifoldPrecursorQuery.size(), [&]() {
-                id_type index = async::this_job::get_id();
-                if (!hasRigidBodies[index])
-                    return;
-
-                auto& rb = rigidbodies[index];
-                auto& pos = positions[index];
-                auto& rot = rotations[index];
-
-                ////-------------------- update position ------------------//
-                pos += rb.velocity * deltaTime;
-
-                ////-------------------- update rotation ------------------//
-                float angle = math::clamp(math::length(rb.angularVelocity), 0.0f, 32.0f);
-                float dtAngle = angle * deltaTime;
+            time::timer integrationTimer;
+            //the rigidbodies only get collected again if the solver put some of them to sleep or woke them up since the velocities were integrated
+            m_rigidbodyStore.refresh(hasRigidBodies, rigidbodies);
+            m_scheduler->queueRangeJobs(0, m_rigidbodyStore.batchCount(), 0, [&](const async::job_range& range) {
+                m_rigidbodyStore.integrateTransforms(range, rigidbodies, positions, rotations, deltaTime);
+                }).wait();
+            m_statistics.integrationTime += integrationTimer.end().milliseconds();
+        }
 
-                if (!math::epsilonEqual(dtAngle, 0.0f, math::epsilon<float>()))
-                {
-                    math::vec3 axis = math::normalize(rb.angularVelocity);
+        /**@brief Queues the jobs of a requested fracture, does nothing if no fracture was requested.
+         */
+        void queueFracture(const std::shared_ptr<fracture_task>& task);
 
-                    math::quat glmQuat = math::angleAxis(dtAngle, axis);
-                    rot = glmQuat * rot;
-                    rot = math::normalize(rot);
-                }
+        /**@brief Replaces the entities of all fractures whose jobs are done by their fragments.
+         */
+        void commitFinishedFractures();
 
-                //for now assume that there is no offset from bodyP
-                rb.globalCentreOfMass = pos;
+        /**@brief Splits the valid manifolds into islands of manifolds that are connected through shared rigidbodies.
+         * Islands never share a rigidbody, so they can be solved independently of each other.
+         * @param islands [out] the indices of the manifolds in every island, in the same order as in manifoldsToSolve so that solving an island gives the same result as solving it serially.
+         * Islands are sorted from large to small so that the largest ones start solving first.
+         */
+        void buildIslands(std::vector<physics_manifold>& manifoldsToSolve, std::vector<byte>& manifoldValidity, std::vector<std::vector<size_type>>& islands);
 
-                rb.UpdateInertiaTensor(rot);
-                }).wait();
-        }
+        /**@brief Updates how long every rigidbody has been at rest and puts islands to sleep once all of their rigidbodies have been at rest for long enough.
+         * Islands that contain a rigidbody that isn't sleepy yet wake up all of their rigidbodies without resetting their timers,
+         * which is how sleeping rigidbodies get woken up by contacts.
+         */
+        void updateSleepState(std::vector<byte>& hasRigidBodies, ecs::component_container<rigidbody>& rigidbodies,
+            ecs::component_container<position>& positions, ecs::component_container<rotation>& rotations,
+            std::vector<physics_manifold>& manifoldsToSolve, std::vector<std::vector<size_type>>& islands, float deltaTime);
 
-        void initializeManifolds(std::vector<physics_manifold>& manifoldsToSolve, std::vector<byte>& manifoldValidity)
+        void initializeManifolds(std::vector<physics_manifold>& manifoldsToSolve, const std::vector<size_type>& island)
         {
-            OPTICK_EVENT();
-            for (int i = 0; i < manifoldsToSolve.size(); i++)
+            for (size_type manifoldIndex : island)
             {
-                if (manifoldValidity.at(i))
-                {
-                    auto& manifold = manifoldsToSolve.at(i);
+                auto& manifold = manifoldsToSolve[manifoldIndex];
+                m_contactCache.warmStart(manifold);
 
-                    for (auto& contact : manifold.contacts)
-                    {
-                        contact.preCalculateEffectiveMass();
-                        contact.ApplyWarmStarting();
-                    }
+                for (auto& contact : manifold.contacts)
+                {
+                    contact.preCalculateEffectiveMass();
+                    contact.ApplyWarmStarting();
                 }
-
             }
         }
 
-        void resolveContactConstraint(std::vector<physics_manifold>& manifoldsToSolve, std::vector<byte>& manifoldValidity, float dt, int contactIter)
+        void resolveContactConstraint(std::vector<physics_manifold>& manifoldsToSolve, const std::vector<size_type>& island, float dt, int contactIter)
         {
-            OPTICK_EVENT();
-
-            for (int manifoldIter = 0;
-                manifoldIter < manifoldsToSolve.size(); manifoldIter++)
+            for (size_type manifoldIndex : island)
             {
-                if (manifoldValidity.at(manifoldIter))
-                {
-                    auto& manifold = manifoldsToSolve.at(manifoldIter);
+                auto& manifold = manifoldsToSolve[manifoldIndex];
 
-                    for (auto& contact : manifold.contacts)
-                    {
-                        contact.resolveContactConstraint(dt, contactIter);
-                    }
+                for (auto& contact : manifold.contacts)
+                {
+                    contact.resolveContactConstraint(dt, contactIter);
                 }
             }
         }
 
-        void resolveFrictionConstraint(std::vector<physics_manifold>& manifoldsToSolve, std::vector<byte>& manifoldValidity)
+        void resolveFrictionConstraint(std::vector<physics_manifold>& manifoldsToSolve, const std::vector<size_type>& island)
         {
-            OPTICK_EVENT();
-
-            for (int manifoldIter = 0;
-                manifoldIter < manifoldsToSolve.size(); manifoldIter++)
+            for (size_type manifoldIndex : island)
             {
-                if (manifoldValidity.at(manifoldIter))
-                {
-                    auto& manifold = manifoldsToSolve.at(manifoldIter);
+                auto& manifold = manifoldsToSolve[manifoldIndex];
 
-                    for (auto& contact : manifold.contacts)
-                    {
-                        contact.resolveFrictionConstraint();
-                    }
+                for (auto& contact : manifold.contacts)
+                {
+                    contact.resolveFrictionConstraint();
                 }
             }
         }
@@ -20,13 +20,6 @@ namespace  legion::rendering
         auto* batches = get_meta<sparse_map<material_handle, sparse_map<model_handle, std::vector<math::mat4>>>>(batchesId);
 
         static auto renderablesQuery = createQuery<position, rotation, scale, mesh_filter, mesh_renderer>();
-        renderablesQuery.queryEntities();
-
-        auto& positions = renderablesQuery.get<position>();
-        auto& rotations = renderablesQuery.get<rotation>();
-        auto& scales = renderablesQuery.get<scale>();
-        auto& filters = renderablesQuery.get<mesh_filter>();
-        auto& renderers = renderablesQuery.get<mesh_renderer>();
 
         {
             OPTICK_EVENT("Clear instances");
@@ -37,10 +30,21 @@ namespace  legion::rendering
 
         {
             OPTICK_EVENT("Calculate instances");
-            for (int i = 0; i < renderablesQuery.size(); i++)
+            // The view keeps the entity list of the query stable until the instances are sorted into the batches.
+            auto renderables = renderablesQuery.view<const position, const rotation, const scale, const mesh_filter, const mesh_renderer>();
+            m_matrices.resize(renderables.size());
+
+            renderablesQuery.parallel_for(renderables, 0,
+                [&](size_type index, ecs::entity_handle, const position& pos, const rotation& rot, const scale& scal, const mesh_filter&, const mesh_renderer&)
+                {
+                    m_matrices[index] = math::compose(scal, rot, pos);
+                });
+
+            // Inserting into the batches isn't thread-safe, but it's only a lookup and a copy per instance.
+            for (size_type i = 0; i < renderables.size(); i++)
             {
-                OPTICK_EVENT("instance");
-                (*batches)[renderers[i].material][model_handle{ filters[i].id }].push_back(math::compose(scales[i], rotations[i], positions[i]));
+                const mesh_renderer& renderer = renderables.get<const mesh_renderer>(i);
+                (*batches)[renderer.material][model_handle{ renderables.get<const mesh_filter>(i).id }].push_back(m_matrices[i]);
             }
         }
     }
@@ -7,6 +7,9 @@ namespace legion::rendering
 {
     class MeshBatchingStage : public RenderStage<MeshBatchingStage>
     {
+        // Model matrices of all renderables, calculated in parallel before they get sorted into the batches.
+        std::vector<math::mat4> m_matrices;
+
     public:
         virtual void setup(app::window& context) override;
         virtual void render(app::window& context, camera& cam, const camera::camera_input& camInput, time::span deltaTime) override;
@@ -12,7 +12,8 @@ namespace legion::rendering
     {
         void setup()
         {
-            createProcess<&LODManager::update>("Update");
+            // The query fetches the whole transform of every entity, not just the position.
+            createProcess<&LODManager::update>("Update")->reads<position, rotation, scale, camera>()->writes<lod>();
         }
         /** @brief Update queries all entities with LOD components, caclulates their distance and updates the LOD
           */
@@ -21,21 +22,20 @@ namespace legion::rendering
             //update camera position first
             UpdateCam();
 
-            //iterate all entities with an LOD
-            m_query.queryEntities();
-            for (ecs::entity_handle entity : m_query)
-            {
-                //get distance for current entity
-                float distance = CalculateDistance(entity.get_component_handle<position>());
-                //read the LOD
-                auto currentLOD = entity.get_component_handle<lod>().read();
-                //make sure it is initialized
-                if (!currentLOD.isInitialized) UpdateThresholdLinear(currentLOD);
-                //update LOD with calculated distance
-                UpdateLOD(currentLOD, distance);
-                //write any LOD changes
-                entity.get_component_handle<lod>().write(currentLOD);
-            }
+            //iterate the LODs in contiguous arrays, every entity only updates its own LOD in place.
+            //the loop is cheap enough that splitting it up into jobs costs more than it saves, and waiting on jobs here would keep the storage locked
+            m_query.forEachChunk<const position, lod>([&](size_type count, const ecs::entity_handle*, const position* positions, lod* lods)
+                {
+                    for (size_type i = 0; i < count; i++)
+                    {
+                        //get distance for current entity
+                        float distance = CalculateDistance(positions[i]);
+                        //make sure it is initialized
+                        if (!lods[i].isInitialized) UpdateThresholdLinear(lods[i]);
+                        //update LOD with calculated distance
+                        UpdateLOD(lods[i], distance);
+                    }
+                });
         }
 
     private:
@@ -80,9 +80,9 @@ namespace legion::rendering
             }
         }
         //calculates distince between cam and input positon
-        float CalculateDistance(ecs::component_handle<position> pos)
+        float CalculateDistance(const position& pos)
         {
-            return math::distance(pos.read(), m_camPosition);
+            return math::distance(pos, m_camPosition);
         }
         math::vec3 m_camPosition;
         //query for the lod components
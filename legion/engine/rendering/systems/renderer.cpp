@@ -1,5 +1,7 @@
 #include <rendering/systems/renderer.hpp>
 #include <rendering/debugrendering.hpp>
+#include <rendering/components/light.hpp>
+#include <rendering/components/renderable.hpp>
 #include <Optick/optick.h>
 
 namespace legion::rendering
@@ -315,7 +317,10 @@ namespace legion::rendering
 
         bindToEvent<events::exit, &Renderer::onExit>();
 
-        createProcess<&Renderer::render>("Rendering");
+        // The pipeline needs the graphics context, which belongs to the thread of the rendering chain.
+        createProcess<&Renderer::render>("Rendering")
+            ->reads<camera, light, position, rotation, scale, mesh_filter, mesh_renderer, app::window>()
+            ->bindToChainThread();
 
         m_scheduler->sendCommand(m_scheduler->getChainThreadId("Rendering"), [&]()
             {
@@ -50,6 +50,9 @@ include "legion/engine/audio/build-audio.lua"
 include "legion/engine/application/build-application.lua"
 include "legion/engine/rendering/build-rendering.lua"
 
+-- applications
+include "applications/physics_benchmark/build-physics-benchmark.lua"
+
 project "*"
     includedirs { "deps/include/" }
 